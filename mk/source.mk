@@ -61,10 +61,13 @@ COMMON_SRC = \
             common/crc.c \
             common/encoding.c \
             common/explog_approx.c \
+            common/fft.c \
             common/filter.c \
+            common/goertzel.c \
             common/gps_conversion.c \
             common/huffman.c \
             common/huffman_table.c \
+            common/lz.c \
             common/maths.c \
             common/printf.c \
             common/printf_serial.c \
@@ -137,6 +140,7 @@ COMMON_SRC = \
             msp/msp_build_info.c \
             msp/msp_serial.c \
             scheduler/scheduler.c \
+            scheduler/scheduler_trace.c \
             sensors/adcinternal.c \
             sensors/battery.c \
             sensors/current.c \
@@ -427,7 +431,9 @@ endif
 
 SPEED_OPTIMISED_SRC += \
             common/encoding.c \
+            common/fft.c \
             common/filter.c \
+            common/goertzel.c \
             common/maths.c \
             common/pwl.c \
             common/sdft.c \
@@ -463,6 +469,7 @@ SPEED_OPTIMISED_SRC += \
             rx/xbus.c \
             rx/fport.c \
             scheduler/scheduler.c \
+            scheduler/scheduler_trace.c \
             sensors/acceleration.c \
             sensors/boardalignment.c \
             sensors/gyro.c \
@@ -459,6 +459,53 @@ static blackboxMainState_t blackboxHistoryRing[3];
 // These point into blackboxHistoryRing, use them to know where to store history of a given age (0, 1 or 2 generations old)
 static blackboxMainState_t* blackboxHistory[3];
 
+#ifdef USE_BLACKBOX_TASK
+/*
+ * The PID loop only takes a snapshot of the main state of each logged iteration into this single producer/single
+ * consumer ring, TASK_BLACKBOX encodes the frames and writes them to the device.
+ */
+#ifndef BLACKBOX_RING_SIZE
+#define BLACKBOX_RING_SIZE 32   // main frames, must be a power of 2
+#endif
+#define BLACKBOX_RING_MASK (BLACKBOX_RING_SIZE - 1)
+
+STATIC_ASSERT((BLACKBOX_RING_SIZE & BLACKBOX_RING_MASK) == 0, blackbox_ring_size_not_power_of_2);
+
+typedef struct blackboxRingEntry_s {
+    blackboxMainState_t state;
+    blackboxSlowState_t slowState;
+    uint32_t armingBeepTimeUs;
+    uint32_t iteration;
+    bool intraframe;
+    bool resume;                // log a LOGGING_RESUME event before this frame
+} blackboxRingEntry_t;
+
+static blackboxRingEntry_t blackboxRing[BLACKBOX_RING_SIZE];
+// head is only written by the PID loop and tail only by the blackbox task, both are free running
+static uint32_t blackboxRingHead;
+static uint32_t blackboxRingTail;
+// Set when the ring was full, P-frames are dropped until the next I-frame
+static bool blackboxRingOverflow;
+
+/*
+ * Events logged by other tasks are queued too, each is written before the frame which was queued next so the log
+ * keeps the order the events happened in.
+ */
+#define BLACKBOX_EVENT_QUEUE_SIZE 8     // must be a power of 2
+#define BLACKBOX_EVENT_QUEUE_MASK (BLACKBOX_EVENT_QUEUE_SIZE - 1)
+
+STATIC_ASSERT((BLACKBOX_EVENT_QUEUE_SIZE & BLACKBOX_EVENT_QUEUE_MASK) == 0, blackbox_event_queue_size_not_power_of_2);
+
+typedef struct blackboxQueuedEvent_s {
+    flightLogEvent_t event;
+    uint32_t ringHead;          // frames queued before the event
+} blackboxQueuedEvent_t;
+
+static blackboxQueuedEvent_t blackboxEventQueue[BLACKBOX_EVENT_QUEUE_SIZE];
+static uint32_t blackboxEventHead;
+static uint32_t blackboxEventTail;
+#endif
+
 static bool blackboxModeActivationConditionPresent = false;
 
 /**
@@ -649,13 +696,14 @@ static void blackboxSetState(BlackboxState newState)
     blackboxState = newState;
 }
 
-static void writeIntraframe(void)
+static void writeIntraframe(uint32_t iteration)
 {
     blackboxMainState_t *blackboxCurrent = blackboxHistory[0];
 
+    blackboxFrameBegin();
     blackboxWrite('I');
 
-    blackboxWriteUnsignedVB(blackboxIteration);
+    blackboxWriteUnsignedVB(iteration);
     blackboxWriteUnsignedVB(blackboxCurrent->time);
 
     if (testBlackboxCondition(CONDITION(PID))) {
@@ -788,6 +836,8 @@ static void writeIntraframe(void)
     }
 #endif
 
+    blackboxFrameEnd();
+
     //Rotate our history buffers:
 
     //The current state becomes the new "before" state
@@ -819,6 +869,7 @@ static void writeInterframe(void)
     blackboxMainState_t *blackboxCurrent = blackboxHistory[0];
     blackboxMainState_t *blackboxLast = blackboxHistory[1];
 
+    blackboxFrameBegin();
     blackboxWrite('P');
 
     //No need to store iteration count since its delta is always 1
@@ -967,6 +1018,8 @@ static void writeInterframe(void)
     }
 #endif
 
+    blackboxFrameEnd();
+
     //Rotate our history buffers
     blackboxHistory[2] = blackboxHistory[1];
     blackboxHistory[1] = blackboxHistory[0];
@@ -981,6 +1034,7 @@ static void writeSlowFrame(void)
 {
     int32_t values[3];
 
+    blackboxFrameBegin();
     blackboxWrite('S');
 
     blackboxWriteUnsignedVB(slowHistory.flightModeFlags);
@@ -993,6 +1047,7 @@ static void writeSlowFrame(void)
     values[1] = slowHistory.rxSignalReceived ? 1 : 0;
     values[2] = slowHistory.rxFlightChannelsValid ? 1 : 0;
     blackboxWriteTag2_3S32(values);
+    blackboxFrameEnd();
 
     blackboxSlowFrameIterationTimer = 0;
 }
@@ -1015,24 +1070,16 @@ static void loadSlowState(blackboxSlowState_t *slow)
  * If allowPeriodicWrite is true, the frame is also logged if it has been more than blackboxSInterval logging iterations
  * since the field was last logged.
  */
-STATIC_UNIT_TESTED bool writeSlowFrameIfNeeded(void)
+static bool writeSlowFrameIfChanged(const blackboxSlowState_t *newSlowState)
 {
     // Write the slow frame peridocially so it can be recovered if we ever lose sync
     bool shouldWrite = blackboxSlowFrameIterationTimer >= blackboxSInterval;
 
-    if (shouldWrite) {
-        loadSlowState(&slowHistory);
-    } else {
-        blackboxSlowState_t newSlowState;
-
-        loadSlowState(&newSlowState);
-
-        // Only write a slow frame if it was different from the previous state
-        if (memcmp(&newSlowState, &slowHistory, sizeof(slowHistory)) != 0) {
-            // Use the new state as our new history
-            memcpy(&slowHistory, &newSlowState, sizeof(slowHistory));
-            shouldWrite = true;
-        }
+    // Otherwise only write a slow frame if it was different from the previous state
+    if (shouldWrite || memcmp(newSlowState, &slowHistory, sizeof(slowHistory)) != 0) {
+        // Use the new state as our new history
+        memcpy(&slowHistory, newSlowState, sizeof(slowHistory));
+        shouldWrite = true;
     }
 
     if (shouldWrite) {
@@ -1041,6 +1088,17 @@ STATIC_UNIT_TESTED bool writeSlowFrameIfNeeded(void)
     return shouldWrite;
 }
 
+#if !defined(USE_BLACKBOX_TASK) || defined(UNIT_TEST)
+STATIC_UNIT_TESTED bool writeSlowFrameIfNeeded(void)
+{
+    blackboxSlowState_t newSlowState;
+
+    loadSlowState(&newSlowState);
+
+    return writeSlowFrameIfChanged(&newSlowState);
+}
+#endif
+
 void blackboxValidateConfig(void)
 {
     // If we've chosen an unsupported device, change the device to NONE
@@ -1090,6 +1148,12 @@ static void blackboxStart(void)
     blackboxHistory[1] = &blackboxHistoryRing[1];
     blackboxHistory[2] = &blackboxHistoryRing[2];
 
+#ifdef USE_BLACKBOX_TASK
+    blackboxRingTail = blackboxRingHead;
+    blackboxRingOverflow = false;
+    blackboxEventTail = blackboxEventHead;
+#endif
+
     vbatReference = getBatteryVoltageLatest();
 
     //No need to clear the content of blackboxHistoryRing since our first frame will be an intra which overwrites it
@@ -1188,18 +1252,21 @@ static bool inMotorTestMode(void)
 #ifdef USE_GPS
 static void writeGPSHomeFrame(void)
 {
+    blackboxFrameBegin();
     blackboxWrite('H');
 
     blackboxWriteSignedVB(GPS_home_llh.lat);
     blackboxWriteSignedVB(GPS_home_llh.lon);
     blackboxWriteSignedVB(GPS_home_llh.altCm / 10); //log homes altitude, in increments of 0.1m
     //TODO it'd be great if we could grab the GPS current time and write that too
+    blackboxFrameEnd();
 
     gpsHistory.GPS_home = GPS_home_llh;
 }
 
 static void writeGPSFrame(timeUs_t currentTimeUs)
 {
+    blackboxFrameBegin();
     blackboxWrite('G');
 
     /*
@@ -1225,6 +1292,7 @@ static void writeGPSFrame(timeUs_t currentTimeUs)
     }
 
     blackboxWriteUnsignedVB(gpsSol.groundCourse);
+    blackboxFrameEnd();
 
     gpsHistory.GPS_numSat = gpsSol.numSat;
     gpsHistory.GPS_coord = gpsSol.llh;
@@ -1234,12 +1302,10 @@ static void writeGPSFrame(timeUs_t currentTimeUs)
 /**
  * Fill the current state of the blackbox using values read from the flight controller
  */
-static void loadMainState(timeUs_t currentTimeUs)
+static void loadMainState(blackboxMainState_t *blackboxCurrent, timeUs_t currentTimeUs)
 {
-#ifndef UNIT_TEST
-    blackboxMainState_t *blackboxCurrent = blackboxHistory[0];
-
     blackboxCurrent->time = currentTimeUs;
+#ifndef UNIT_TEST
     for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
         blackboxCurrent->axisPID_P[i] = lrintf(pidData[i].P);
         blackboxCurrent->axisPID_I[i] = lrintf(pidData[i].I);
@@ -1314,8 +1380,6 @@ static void loadMainState(timeUs_t currentTimeUs)
         blackboxCurrent->servo[i] = servo[i];
     }
 #endif
-#else
-    UNUSED(currentTimeUs);
 #endif // UNIT_TEST
 }
 
@@ -1694,6 +1758,9 @@ static bool blackboxWriteSysinfo(void)
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_DYN_NOTCH_COUNT, "%d",        dynNotchConfig()->dyn_notch_count);
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_DYN_NOTCH_Q, "%d",            dynNotchConfig()->dyn_notch_q);
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_DYN_NOTCH_MIN_HZ, "%d",       dynNotchConfig()->dyn_notch_min_hz);
+        BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_DYN_NOTCH_ESTIMATOR, "%d",    dynNotchConfig()->dyn_notch_estimator);
+        BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_DYN_NOTCH_FFT_SIZE, "%d",     dynNotchConfig()->dyn_notch_fft_size);
+        BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_DYN_NOTCH_BUDGET, "%d",       dynNotchConfig()->dyn_notch_budget);
 #endif
 #ifdef USE_DSHOT_TELEMETRY
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_DSHOT_BIDIR, "%d",            useDshotTelemetry);
@@ -1876,21 +1943,17 @@ static bool blackboxWriteSysinfo(void)
     }
 
     xmitState.headerIndex++;
-#endif // UNIT_TEST
     return false;
+#else
+    // The unit tests log no system information
+    return true;
+#endif // UNIT_TEST
 }
 
-/**
- * Write the given event to the log immediately
- */
-void blackboxLogEvent(FlightLogEvent event, flightLogEventData_t *data)
+static void writeEventFrame(FlightLogEvent event, flightLogEventData_t *data)
 {
-    // Only allow events to be logged after headers have been written
-    if (!(blackboxState == BLACKBOX_STATE_RUNNING || blackboxState == BLACKBOX_STATE_PAUSED)) {
-        return;
-    }
-
     //Shared header for event frames
+    blackboxFrameBegin();
     blackboxWrite('E');
     blackboxWrite(event);
 
@@ -1926,33 +1989,71 @@ void blackboxLogEvent(FlightLogEvent event, flightLogEventData_t *data)
     default:
         break;
     }
+    blackboxFrameEnd();
+}
+
+/**
+ * Write the given event to the log, or with USE_BLACKBOX_TASK queue it for TASK_BLACKBOX
+ */
+void blackboxLogEvent(FlightLogEvent event, flightLogEventData_t *data)
+{
+    // Only allow events to be logged after headers have been written
+    if (!(blackboxState == BLACKBOX_STATE_RUNNING || blackboxState == BLACKBOX_STATE_PAUSED)) {
+        return;
+    }
+
+#ifdef USE_BLACKBOX_TASK
+    const uint32_t head = blackboxEventHead;
+    if (head - blackboxEventTail >= BLACKBOX_EVENT_QUEUE_SIZE) {
+        // TASK_BLACKBOX hasn't run for a while, drop the event
+        return;
+    }
+
+    blackboxQueuedEvent_t *queued = &blackboxEventQueue[head & BLACKBOX_EVENT_QUEUE_MASK];
+    queued->event.event = event;
+    if (data) {
+        queued->event.data = *data;
+    }
+    queued->ringHead = blackboxRingHead;
+
+    blackboxEventHead = head + 1;
+#else
+    writeEventFrame(event, data);
+#endif
 }
 
 /* If an arming beep has played since it was last logged, write the time of the arming beep to the log as a synchronization point */
-static void blackboxCheckAndLogArmingBeep(void)
+static void blackboxCheckAndLogArmingBeep(uint32_t armingBeepTimeUs)
 {
     // Use != so that we can still detect a change if the counter wraps
-    if (getArmingBeepTimeMicros() != blackboxLastArmingBeep) {
-        blackboxLastArmingBeep = getArmingBeepTimeMicros();
+    if (armingBeepTimeUs != blackboxLastArmingBeep) {
+        blackboxLastArmingBeep = armingBeepTimeUs;
         flightLogEvent_syncBeep_t eventData;
         eventData.time = blackboxLastArmingBeep;
-        blackboxLogEvent(FLIGHT_LOG_EVENT_SYNC_BEEP, (flightLogEventData_t *)&eventData);
+        writeEventFrame(FLIGHT_LOG_EVENT_SYNC_BEEP, (flightLogEventData_t *)&eventData);
     }
 }
 
 /* monitor the flight mode event status and trigger an event record if the state changes */
-static void blackboxCheckAndLogFlightMode(void)
+static void blackboxCheckAndLogFlightMode(uint32_t flightModeFlags)
 {
     // Use != so that we can still detect a change if the counter wraps
-    if (memcmp(&rcModeActivationMask, &blackboxLastFlightModeFlags, sizeof(blackboxLastFlightModeFlags))) {
+    if (flightModeFlags != blackboxLastFlightModeFlags) {
         flightLogEvent_flightMode_t eventData; // Add new data for current flight mode flags
         eventData.lastFlags = blackboxLastFlightModeFlags;
-        memcpy(&blackboxLastFlightModeFlags, &rcModeActivationMask, sizeof(blackboxLastFlightModeFlags));
-        memcpy(&eventData.flags, &rcModeActivationMask, sizeof(eventData.flags));
-        blackboxLogEvent(FLIGHT_LOG_EVENT_FLIGHTMODE, (flightLogEventData_t *)&eventData);
+        blackboxLastFlightModeFlags = flightModeFlags;
+        eventData.flags = flightModeFlags;
+        writeEventFrame(FLIGHT_LOG_EVENT_FLIGHTMODE, (flightLogEventData_t *)&eventData);
     }
 }
 
+static uint32_t blackboxGetFlightModeFlags(void)
+{
+    uint32_t flightModeFlags;
+    memcpy(&flightModeFlags, &rcModeActivationMask, sizeof(flightModeFlags));
+    return flightModeFlags;
+}
+
 STATIC_UNIT_TESTED bool blackboxShouldLogPFrame(void)
 {
     return blackboxPFrameIndex == 0 && blackboxPInterval != 0;
@@ -1998,6 +2099,24 @@ STATIC_UNIT_TESTED void blackboxAdvanceIterationTimers(void)
     }
 }
 
+#ifdef USE_GPS
+static void writeGPSFramesIfNeeded(timeUs_t currentTimeUs)
+{
+    if (featureIsEnabled(FEATURE_GPS) && isFieldEnabled(FIELD_SELECT(GPS))) {
+        if (blackboxShouldLogGpsHomeFrame()) {
+            writeGPSHomeFrame();
+            writeGPSFrame(currentTimeUs);
+        } else if (gpsSol.numSat != gpsHistory.GPS_numSat
+                   || gpsSol.llh.lat != gpsHistory.GPS_coord.lat
+                   || gpsSol.llh.lon != gpsHistory.GPS_coord.lon) {
+            //We could check for velocity changes as well but I doubt it changes independent of position
+            writeGPSFrame(currentTimeUs);
+        }
+    }
+}
+#endif
+
+#if !defined(USE_BLACKBOX_TASK) || defined(UNIT_TEST)
 // Called once every FC loop in order to log the current state
 STATIC_UNIT_TESTED void blackboxLogIteration(timeUs_t currentTimeUs)
 {
@@ -2011,11 +2130,11 @@ STATIC_UNIT_TESTED void blackboxLogIteration(timeUs_t currentTimeUs)
             writeSlowFrameIfNeeded();
         }
 
-        loadMainState(currentTimeUs);
-        writeIntraframe();
+        loadMainState(blackboxHistory[0], currentTimeUs);
+        writeIntraframe(blackboxIteration);
     } else {
-        blackboxCheckAndLogArmingBeep();
-        blackboxCheckAndLogFlightMode(); // Check for FlightMode status change event
+        blackboxCheckAndLogArmingBeep(getArmingBeepTimeMicros());
+        blackboxCheckAndLogFlightMode(blackboxGetFlightModeFlags()); // Check for FlightMode status change event
 
         if (blackboxShouldLogPFrame()) {
             /*
@@ -2024,27 +2143,150 @@ STATIC_UNIT_TESTED void blackboxLogIteration(timeUs_t currentTimeUs)
              */
             writeSlowFrameIfNeeded();
 
-            loadMainState(currentTimeUs);
+            loadMainState(blackboxHistory[0], currentTimeUs);
             writeInterframe();
         }
 #ifdef USE_GPS
-        if (featureIsEnabled(FEATURE_GPS) && isFieldEnabled(FIELD_SELECT(GPS))) {
-            if (blackboxShouldLogGpsHomeFrame()) {
-                writeGPSHomeFrame();
-                writeGPSFrame(currentTimeUs);
-            } else if (gpsSol.numSat != gpsHistory.GPS_numSat
-                       || gpsSol.llh.lat != gpsHistory.GPS_coord.lat
-                       || gpsSol.llh.lon != gpsHistory.GPS_coord.lon) {
-                //We could check for velocity changes as well but I doubt it changes independent of position
-                writeGPSFrame(currentTimeUs);
-            }
-        }
+        writeGPSFramesIfNeeded(currentTimeUs);
 #endif
     }
 
     //Flush every iteration so that our runtime variance is minimized
     blackboxDeviceFlush();
 }
+#endif
+
+#ifdef USE_BLACKBOX_TASK
+/*
+ * Called once every FC loop in place of blackboxLogIteration(), only takes a snapshot of the main state for
+ * TASK_BLACKBOX to encode. resume logs a LOGGING_RESUME event, which is only valid before an I-frame.
+ */
+STATIC_UNIT_TESTED void blackboxQueueIteration(timeUs_t currentTimeUs, bool resume)
+{
+    const bool intraframe = blackboxShouldLogIFrame();
+
+    if (!intraframe && (!blackboxShouldLogPFrame() || blackboxRingOverflow)) {
+        return;
+    }
+
+    const uint32_t head = blackboxRingHead;
+    if (head - __atomic_load_n(&blackboxRingTail, __ATOMIC_ACQUIRE) >= BLACKBOX_RING_SIZE) {
+        // The P-frames which follow can't be decoded without this one, resume logging at the next I-frame
+        blackboxRingOverflow = true;
+        return;
+    }
+
+    blackboxRingEntry_t *entry = &blackboxRing[head & BLACKBOX_RING_MASK];
+    loadMainState(&entry->state, currentTimeUs);
+    loadSlowState(&entry->slowState);
+    entry->armingBeepTimeUs = getArmingBeepTimeMicros();
+    entry->iteration = blackboxIteration;
+    entry->intraframe = intraframe;
+    entry->resume = resume || blackboxRingOverflow;
+    blackboxRingOverflow = false;
+
+    __atomic_store_n(&blackboxRingHead, head + 1, __ATOMIC_RELEASE);
+}
+
+STATIC_UNIT_TESTED uint32_t blackboxQueuedFrames(void)
+{
+    return __atomic_load_n(&blackboxRingHead, __ATOMIC_ACQUIRE) - blackboxRingTail;
+}
+
+STATIC_UNIT_TESTED uint32_t blackboxQueuedEvents(void)
+{
+    return blackboxEventHead - blackboxEventTail;
+}
+
+// Write the queued events which were logged before the frame at ringPosition was queued
+static void blackboxWriteQueuedEvents(uint32_t ringPosition)
+{
+    while (blackboxQueuedEvents()) {
+        blackboxQueuedEvent_t *queued = &blackboxEventQueue[blackboxEventTail & BLACKBOX_EVENT_QUEUE_MASK];
+        if ((int32_t)(queued->ringHead - ringPosition) > 0) {
+            break;
+        }
+        writeEventFrame(queued->event.event, &queued->event.data);
+        blackboxEventTail++;
+    }
+}
+
+// Encode the frames and events queued by the PID loop and other tasks and pass them to the device
+static void blackboxEncodeQueuedFrames(void)
+{
+    while (blackboxQueuedFrames()) {
+        blackboxWriteQueuedEvents(blackboxRingTail);
+
+        const blackboxRingEntry_t *entry = &blackboxRing[blackboxRingTail & BLACKBOX_RING_MASK];
+
+        if (entry->resume) {
+            // Tell the decoder that the time/iteration skip up to this I-frame is intended
+            flightLogEvent_loggingResume_t resume;
+
+            resume.logIteration = entry->iteration;
+            resume.currentTime = entry->state.time;
+
+            writeEventFrame(FLIGHT_LOG_EVENT_LOGGING_RESUME, (flightLogEventData_t *) &resume);
+        }
+
+        if (!entry->intraframe) {
+            blackboxCheckAndLogArmingBeep(entry->armingBeepTimeUs);
+            blackboxCheckAndLogFlightMode(entry->slowState.flightModeFlags); // Check for FlightMode status change event
+        }
+
+        // Decide on the slow frame as of the queued iteration
+        const uint32_t iterationsSinceQueued = blackboxIteration - entry->iteration;
+        blackboxSlowFrameIterationTimer -= iterationsSinceQueued;
+        if (!entry->intraframe || blackboxIsOnlyLoggingIntraframes()) {
+            writeSlowFrameIfChanged(&entry->slowState);
+        }
+        blackboxSlowFrameIterationTimer += iterationsSinceQueued;
+
+        memcpy(blackboxHistory[0], &entry->state, sizeof(*blackboxHistory[0]));
+        if (entry->intraframe) {
+            writeIntraframe(entry->iteration);
+        } else {
+            writeInterframe();
+        }
+
+        __atomic_store_n(&blackboxRingTail, blackboxRingTail + 1, __ATOMIC_RELEASE);
+    }
+    blackboxWriteQueuedEvents(blackboxRingTail);
+}
+
+/**
+ * Blackbox task, encodes the frames queued by blackboxUpdate() and writes them to the device together with the
+ * event and GPS frames.
+ */
+void taskBlackbox(timeUs_t currentTimeUs)
+{
+    if (blackboxState == BLACKBOX_STATE_SHUTTING_DOWN) {
+        // Write what was logged before the end of the log
+        blackboxEncodeQueuedFrames();
+        blackboxDeviceFlush();
+        return;
+    }
+    if (blackboxState != BLACKBOX_STATE_RUNNING && blackboxState != BLACKBOX_STATE_PAUSED) {
+        return;
+    }
+
+    blackboxEncodeQueuedFrames();
+
+    // Catch changes during iterations without a frame to log
+    blackboxCheckAndLogArmingBeep(getArmingBeepTimeMicros());
+    blackboxCheckAndLogFlightMode(blackboxGetFlightModeFlags());
+
+#ifdef USE_GPS
+    if (blackboxLoggedAnyFrames) {
+        writeGPSFramesIfNeeded(currentTimeUs);
+    }
+#else
+    UNUSED(currentTimeUs);
+#endif
+
+    blackboxDeviceFlush();
+}
+#endif // USE_BLACKBOX_TASK
 
 /**
  * Call each flight loop iteration to perform blackbox logging.
@@ -2154,6 +2396,11 @@ void blackboxUpdate(timeUs_t currentTimeUs)
     case BLACKBOX_STATE_PAUSED:
         // Only allow resume to occur during an I-frame iteration, so that we have an "I" base to work from
         if (IS_RC_MODE_ACTIVE(BOXBLACKBOX) && blackboxShouldLogIFrame()) {
+#ifdef USE_BLACKBOX_TASK
+            blackboxSetState(BLACKBOX_STATE_RUNNING);
+
+            blackboxQueueIteration(currentTimeUs, true);
+#else
             // Write a log entry so the decoder is aware that our large time/iteration skip is intended
             flightLogEvent_loggingResume_t resume;
 
@@ -2164,6 +2411,7 @@ void blackboxUpdate(timeUs_t currentTimeUs)
             blackboxSetState(BLACKBOX_STATE_RUNNING);
 
             blackboxLogIteration(currentTimeUs);
+#endif
         }
         // Keep the logging timers ticking so our log iteration continues to advance
         blackboxAdvanceIterationTimers();
@@ -2174,7 +2422,11 @@ void blackboxUpdate(timeUs_t currentTimeUs)
         if (blackboxModeActivationConditionPresent && !IS_RC_MODE_ACTIVE(BOXBLACKBOX) && !startedLoggingInTestMode) {
             blackboxSetState(BLACKBOX_STATE_PAUSED);
         } else {
+#ifdef USE_BLACKBOX_TASK
+            blackboxQueueIteration(currentTimeUs, false);
+#else
             blackboxLogIteration(currentTimeUs);
+#endif
         }
         blackboxAdvanceIterationTimers();
         break;
@@ -2186,6 +2438,12 @@ void blackboxUpdate(timeUs_t currentTimeUs)
          *
          * Don't wait longer than it could possibly take if something funky happens.
          */
+#ifdef USE_BLACKBOX_TASK
+        // TASK_BLACKBOX writes the frames and events queued before the end of the log first
+        if ((blackboxQueuedFrames() || blackboxQueuedEvents()) && millis() <= xmitState.u.startTime + BLACKBOX_SHUTDOWN_TIMEOUT_MILLIS) {
+            break;
+        }
+#endif
         if (blackboxDeviceEndLog(blackboxLoggedAnyFrames) && (millis() > xmitState.u.startTime + BLACKBOX_SHUTDOWN_TIMEOUT_MILLIS || blackboxDeviceFlushForce())) {
             blackboxDeviceClose();
             blackboxSetState(BLACKBOX_STATE_STOPPED);
@@ -110,46 +110,57 @@ static uint16_t bbRateMax;
 static uint32_t bbDrops;
 #endif
 
-void blackboxWrite(uint8_t value)
+// Frames are encoded into here and handed to the device in one write, see blackboxFrameBegin()
+static uint8_t blackboxFrameBuffer[BLACKBOX_FRAME_BUFFER_SIZE];
+static uint16_t blackboxFrameLength;
+static bool blackboxFrameActive;
+
+/**
+ * Write the given bytes to the blackbox device. Bytes which don't fit in the serial transmit buffer are dropped.
+ */
+void blackboxWriteBuffer(const uint8_t *buffer, unsigned len)
 {
 #ifdef DEBUG_BB_OUTPUT
-    bbBits += 8;
+    bbBits += 8 * len;
 #endif
 
     switch (blackboxConfig()->device) {
 #ifdef USE_FLASHFS
     case BLACKBOX_DEVICE_FLASH:
-        flashfsWriteByte(value); // Write byte asynchronously
+        flashfsWrite(buffer, len, false); // Write asynchronously
         break;
 #endif
 #ifdef USE_SDCARD
     case BLACKBOX_DEVICE_SDCARD:
-        afatfs_fputc(blackboxSDCard.logFile, value);
+        afatfs_fwrite(blackboxSDCard.logFile, buffer, len); // Ignore failures due to buffers filling up
         break;
 #endif
 #ifdef USE_BLACKBOX_VIRTUAL
     case BLACKBOX_DEVICE_VIRTUAL:
-        blackboxVirtualPutChar(value);
+        blackboxVirtualWrite(buffer, len);
         break;
 #endif
     case BLACKBOX_DEVICE_SERIAL:
     default:
         {
-            int txBytesFree = serialTxBytesFree(blackboxPort);
+            const unsigned txBytesFree = serialTxBytesFree(blackboxPort);
+            const unsigned txLen = MIN(len, txBytesFree);
 
 #ifdef DEBUG_BB_OUTPUT
-            bbBits += 2;
+            bbBits += 2 * len;
             DEBUG_SET(DEBUG_BLACKBOX_OUTPUT, 3, txBytesFree);
 #endif
 
-            if (txBytesFree == 0) {
+            if (txLen < len) {
 #ifdef DEBUG_BB_OUTPUT
-                ++bbDrops;
+                bbDrops += len - txLen;
                 DEBUG_SET(DEBUG_BLACKBOX_OUTPUT, 2, bbDrops);
 #endif
-                return;
+                if (txLen == 0) {
+                    return;
+                }
             }
-            serialWrite(blackboxPort, value);
+            serialWriteBuf(blackboxPort, buffer, txLen);
         }
         break;
     }
@@ -170,45 +181,50 @@ void blackboxWrite(uint8_t value)
 #endif
 }
 
-// Print the null-terminated string 's' to the blackbox device and return the number of bytes written
-int blackboxWriteString(const char *s)
+void blackboxWrite(uint8_t value)
 {
-    int length;
-    const uint8_t *pos;
-
-    switch (blackboxConfig()->device) {
+    if (blackboxFrameActive) {
+        blackboxFrameBuffer[blackboxFrameLength++] = value;
+        if (blackboxFrameLength == sizeof(blackboxFrameBuffer)) {
+            // Unusually large frame, pass on what we have so far
+            blackboxWriteBuffer(blackboxFrameBuffer, blackboxFrameLength);
+            blackboxFrameLength = 0;
+        }
+    } else {
+        blackboxWriteBuffer(&value, 1);
+    }
+}
 
-#ifdef USE_FLASHFS
-    case BLACKBOX_DEVICE_FLASH:
-        length = strlen(s);
-        flashfsWrite((const uint8_t*) s, length, false); // Write asynchronously
-        break;
-#endif // USE_FLASHFS
+/**
+ * Collect the bytes written by blackboxWrite() until blackboxFrameEnd(), which writes them to the device in one go
+ * instead of one byte at a time.
+ */
+void blackboxFrameBegin(void)
+{
+    blackboxFrameLength = 0;
+    blackboxFrameActive = true;
+}
 
-#ifdef USE_SDCARD
-    case BLACKBOX_DEVICE_SDCARD:
-        length = strlen(s);
-        afatfs_fwrite(blackboxSDCard.logFile, (const uint8_t*) s, length); // Ignore failures due to buffers filling up
-        break;
-#endif // USE_SDCARD
+void blackboxFrameEnd(void)
+{
+    blackboxFrameActive = false;
+    if (blackboxFrameLength) {
+        blackboxWriteBuffer(blackboxFrameBuffer, blackboxFrameLength);
+        blackboxFrameLength = 0;
+    }
+}
 
-#ifdef USE_BLACKBOX_VIRTUAL
-    case BLACKBOX_DEVICE_VIRTUAL:
-        length = strlen(s);
-        blackboxVirtualWrite((const uint8_t*) s, length);
-        break;
-#endif
+// Print the null-terminated string 's' to the blackbox device and return the number of bytes written
+int blackboxWriteString(const char *s)
+{
+    const int length = strlen(s);
 
-    case BLACKBOX_DEVICE_SERIAL:
-    default:
-        pos = (uint8_t*) s;
-        while (*pos) {
-            blackboxWrite(*pos);
-            pos++;
+    if (blackboxFrameActive) {
+        for (int i = 0; i < length; i++) {
+            blackboxWrite(s[i]);
         }
-
-        length = pos - (uint8_t*) s;
-        break;
+    } else {
+        blackboxWriteBuffer((const uint8_t *)s, length);
     }
 
     return length;
@@ -231,11 +247,6 @@ void blackboxDeviceFlush(void)
         flashfsFlushAsync(false);
         break;
 #endif // USE_FLASHFS
-#ifdef USE_BLACKBOX_VIRTUAL
-    case BLACKBOX_DEVICE_VIRTUAL:
-        blackboxVirtualFlush();
-        break;
-#endif
 
     default:
         ;
@@ -38,11 +38,20 @@ typedef enum {
  */
 #define BLACKBOX_TARGET_HEADER_BUDGET_PER_ITERATION 64
 
+/*
+ * Frames are collected in a buffer of this size and written to the device in one go. Longer frames are written in
+ * several parts:
+ */
+#define BLACKBOX_FRAME_BUFFER_SIZE 256
+
 extern int32_t blackboxHeaderBudget;
 
 void blackboxOpen(void);
 void blackboxWrite(uint8_t value);
+void blackboxWriteBuffer(const uint8_t *buffer, unsigned len);
 int blackboxWriteString(const char *s);
+void blackboxFrameBegin(void);
+void blackboxFrameEnd(void);
 
 void blackboxDeviceFlush(void);
 bool blackboxDeviceFlushForce(void);
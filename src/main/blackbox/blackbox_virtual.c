@@ -26,14 +26,106 @@
 #include <stdint.h>
 #include <string.h>
 #include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
 #include <common/maths.h>
+#include <common/utils.h>
+
+#include "blackbox_virtual.h"
 
 #define LOGFILE_PREFIX "LOG"
 #define LOGFILE_SUFFIX "BFL"
 
-static FILE *blackboxVirtualFile = NULL;
+// Log data is collected in one buffer while the other one is written to the file by a background thread,
+// so the flight loop never waits on file I/O unless the writer falls a whole buffer behind.
+#define BLACKBOX_VIRTUAL_BUFFER_SIZE (256 * 1024)
+#define BLACKBOX_VIRTUAL_BUFFER_ALIGN 4096
+
+static uint8_t blackboxVirtualBuffer[2][BLACKBOX_VIRTUAL_BUFFER_SIZE] __attribute__((aligned(BLACKBOX_VIRTUAL_BUFFER_ALIGN)));
+static unsigned blackboxVirtualFillIndex;
+static uint32_t blackboxVirtualFillLength;
+
+static int blackboxVirtualFd = -1;
 static int32_t largestLogFileNumber = 0;
 
+static pthread_t blackboxVirtualWriter;
+static bool blackboxVirtualWriterStarted;
+static pthread_mutex_t blackboxVirtualLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t blackboxVirtualCond = PTHREAD_COND_INITIALIZER;
+// Buffer handed to the writer thread, NULL once it has been written
+static const uint8_t *blackboxVirtualPendingData;
+static uint32_t blackboxVirtualPendingLength;
+
+static void blackboxVirtualWriteFile(const uint8_t *data, uint32_t len)
+{
+    while (len) {
+        const ssize_t written = write(blackboxVirtualFd, data, len);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("[blackbox] write");
+            return;
+        }
+        data += written;
+        len -= written;
+    }
+}
+
+static void *blackboxVirtualWriterThread(void *arg)
+{
+    UNUSED(arg);
+
+    pthread_mutex_lock(&blackboxVirtualLock);
+    while (true) {
+        while (blackboxVirtualPendingData == NULL) {
+            pthread_cond_wait(&blackboxVirtualCond, &blackboxVirtualLock);
+        }
+        const uint8_t *data = blackboxVirtualPendingData;
+        const uint32_t len = blackboxVirtualPendingLength;
+        pthread_mutex_unlock(&blackboxVirtualLock);
+
+        blackboxVirtualWriteFile(data, len);
+
+        pthread_mutex_lock(&blackboxVirtualLock);
+        blackboxVirtualPendingData = NULL;
+        pthread_cond_broadcast(&blackboxVirtualCond);
+    }
+
+    return NULL;
+}
+
+static void blackboxVirtualWaitIdle(void)
+{
+    pthread_mutex_lock(&blackboxVirtualLock);
+    while (blackboxVirtualPendingData != NULL) {
+        pthread_cond_wait(&blackboxVirtualCond, &blackboxVirtualLock);
+    }
+    pthread_mutex_unlock(&blackboxVirtualLock);
+}
+
+// Hand the buffer being filled to the writer thread and continue in the other one
+static void blackboxVirtualSwapBuffers(void)
+{
+    if (blackboxVirtualFillLength == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&blackboxVirtualLock);
+    while (blackboxVirtualPendingData != NULL) {
+        pthread_cond_wait(&blackboxVirtualCond, &blackboxVirtualLock);
+    }
+    blackboxVirtualPendingData = blackboxVirtualBuffer[blackboxVirtualFillIndex];
+    blackboxVirtualPendingLength = blackboxVirtualFillLength;
+    pthread_cond_broadcast(&blackboxVirtualCond);
+    pthread_mutex_unlock(&blackboxVirtualLock);
+
+    blackboxVirtualFillIndex ^= 1;
+    blackboxVirtualFillLength = 0;
+}
+
 bool blackboxVirtualOpen(void)
 {
     const size_t log_name_length = strlen(LOGFILE_PREFIX) + 5 + strlen(LOGFILE_SUFFIX) + 1; //file name template: LOG00001.BFL
@@ -55,53 +147,69 @@ bool blackboxVirtualOpen(void)
         }
     }
     closedir(dir);
-    return true;
-}
 
-void blackboxVirtualPutChar(uint8_t value)
-{
-    if (blackboxVirtualFile != NULL) {
-        fputc(value, blackboxVirtualFile);
+    if (!blackboxVirtualWriterStarted) {
+        if (pthread_create(&blackboxVirtualWriter, NULL, blackboxVirtualWriterThread, NULL) != 0) {
+            return false;
+        }
+        blackboxVirtualWriterStarted = true;
     }
+    return true;
 }
 
 void blackboxVirtualWrite(const uint8_t *buffer, uint32_t len)
 {
-    if (blackboxVirtualFile != NULL) {
-        fwrite(buffer, len, 1, blackboxVirtualFile);
+    if (blackboxVirtualFd < 0) {
+        return;
+    }
+
+    while (len) {
+        const uint32_t chunk = MIN(len, BLACKBOX_VIRTUAL_BUFFER_SIZE - blackboxVirtualFillLength);
+        memcpy(&blackboxVirtualBuffer[blackboxVirtualFillIndex][blackboxVirtualFillLength], buffer, chunk);
+        blackboxVirtualFillLength += chunk;
+        buffer += chunk;
+        len -= chunk;
+
+        if (blackboxVirtualFillLength == BLACKBOX_VIRTUAL_BUFFER_SIZE) {
+            blackboxVirtualSwapBuffers();
+        }
     }
 }
 
+// Write everything logged so far to the file, returns once it has been written
 bool blackboxVirtualFlush(void)
 {
-    if (blackboxVirtualFile != NULL) {
-        fflush(blackboxVirtualFile);
-        return true;
-    } else {
+    if (blackboxVirtualFd < 0) {
         return false;
     }
+
+    blackboxVirtualSwapBuffers();
+    blackboxVirtualWaitIdle();
+    return true;
 }
 
 bool blackboxVirtualBeginLog(void)
 {
-    if (blackboxVirtualFile != NULL) {
+    if (blackboxVirtualFd >= 0) {
         return false;
     }
     const size_t name_buffer_length = snprintf(NULL, 0, "%s%05u.%s", LOGFILE_PREFIX, (largestLogFileNumber + 1) % 100000, LOGFILE_SUFFIX);
-    char filename[name_buffer_length];
+    char filename[name_buffer_length + 1];
     snprintf(filename, sizeof(filename), "%s%05u.%s", LOGFILE_PREFIX, (largestLogFileNumber + 1) % 100000, LOGFILE_SUFFIX);
-    blackboxVirtualFile = fopen(filename, "w");
-    if (blackboxVirtualFile != NULL) {
+    blackboxVirtualFd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (blackboxVirtualFd >= 0) {
         largestLogFileNumber++;
+        blackboxVirtualFillLength = 0;
     }
-    return blackboxVirtualFile != NULL;
+    return blackboxVirtualFd >= 0;
 }
 
 bool blackboxVirtualEndLog(void)
 {
-    if (blackboxVirtualFile != NULL) {
-        fclose(blackboxVirtualFile);
-        blackboxVirtualFile = NULL;
+    if (blackboxVirtualFd >= 0) {
+        blackboxVirtualFlush();
+        close(blackboxVirtualFd);
+        blackboxVirtualFd = -1;
     }
     return true;
 }
@@ -26,7 +26,6 @@
 #endif
 
 bool blackboxVirtualOpen(void);
-void blackboxVirtualPutChar(uint8_t value);
 void blackboxVirtualWrite(const uint8_t *buffer, uint32_t len);
 bool blackboxVirtualFlush(void);
 bool blackboxVirtualBeginLog(void);
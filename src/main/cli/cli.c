@@ -157,6 +157,7 @@ bool cliMode = false;
 #include "rx/rx_spi.h"
 
 #include "scheduler/scheduler.h"
+#include "scheduler/scheduler_trace.h"
 
 #include "sensors/acceleration.h"
 #include "sensors/adcinternal.h"
@@ -198,6 +199,17 @@ static int8_t rateProfileIndexToUse = CURRENT_PROFILE_INDEX;
 #ifdef USE_CLI_BATCH
 static bool commandBatchActive = false;
 static bool commandBatchError = false;
+// A quiet batch applies a configuration script as one transaction, see cliBatch()
+static bool commandBatchQuiet = false;
+// Input lines since "batch start", including blank and comment lines, so errors are reported by their line
+STATIC_UNIT_TESTED uint16_t commandBatchLine = 0;
+STATIC_UNIT_TESTED uint16_t commandBatchCommandCount = 0;
+STATIC_UNIT_TESTED uint16_t commandBatchErrorCount = 0;
+STATIC_UNIT_TESTED uint16_t commandBatchFirstErrorLine = 0;
+static bool commandBatchCommandFailed = false;
+static char commandBatchLastCharacter = 0;
+// The PG copies hold the configuration a quiet batch started from
+static bool commandBatchSnapshot = false;
 #endif
 
 #if defined(USE_BOARD_INFO)
@@ -454,6 +466,14 @@ static void cliPrintErrorVa(const char *cmdName, const char *format, va_list va)
 
 #ifdef USE_CLI_BATCH
     if (commandBatchActive) {
+        // count the commands that failed, not the error lines they printed
+        if (!commandBatchCommandFailed) {
+            commandBatchCommandFailed = true;
+            commandBatchErrorCount++;
+        }
+        if (!commandBatchError) {
+            commandBatchFirstErrorLine = commandBatchLine;
+        }
         commandBatchError = true;
     }
 #endif
@@ -700,6 +720,9 @@ static void backupConfigs(void)
     }
 
     configIsInCopy = true;
+#ifdef USE_CLI_BATCH
+    commandBatchSnapshot = false;
+#endif
 }
 
 static void restoreConfigs(uint16_t notToRestoreGroupId)
@@ -4224,18 +4247,73 @@ static void resetCommandBatch(void)
 {
     commandBatchActive = false;
     commandBatchError = false;
+    commandBatchQuiet = false;
+    commandBatchLine = 0;
+    commandBatchCommandCount = 0;
+    commandBatchErrorCount = 0;
+    commandBatchFirstErrorLine = 0;
+    commandBatchCommandFailed = false;
+    commandBatchSnapshot = false;
+}
+
+static void snapshotCommandBatchConfigs(void)
+{
+    PG_FOREACH(pg) {
+        backupPgConfig(pg);
+    }
+    commandBatchSnapshot = true;
+}
+
+// One line summary of a quiet batch, printed through the error writer as the normal output is muted
+static void cliPrintCommandBatchReport(void)
+{
+    char report[100];
+    if (commandBatchError) {
+        tfp_sprintf(report, "# batch: %d commands, %d failed, first at line %d after 'batch start', changes discarded\r\n",
+            commandBatchCommandCount, commandBatchErrorCount, commandBatchFirstErrorLine);
+    } else {
+        tfp_sprintf(report, "# batch: %d commands, ok\r\n", commandBatchCommandCount);
+    }
+    cliPrintInternal(cliErrorWriter, report);
+}
+
+// A quiet batch that failed leaves the configuration as it was before the batch, unsaved changes included.
+// A diff or dump in the batch reuses the copies, the configuration is then read back as it was last saved.
+static void endQuietCommandBatch(void)
+{
+    cliPrintCommandBatchReport();
+    if (commandBatchError) {
+        if (commandBatchSnapshot) {
+            PG_FOREACH(pg) {
+                restorePgConfig(pg, 0);
+            }
+        } else {
+            readEEPROM();
+        }
+    }
 }
 
+// "batch start quiet" is for applying a whole diff or dump: commands are not echoed and their output is muted,
+// errors are still shown. The batch ends with a one line report, and if any command failed the changes are
+// discarded instead of being left half applied.
 static void cliBatch(const char *cmdName, char *cmdline)
 {
     if (strncasecmp(cmdline, "start", 5) == 0) {
         if (!commandBatchActive) {
+            resetCommandBatch();
             commandBatchActive = true;
-            commandBatchError = false;
+            commandBatchQuiet = strcasestr(cmdline + 5, "quiet") != NULL;
+            if (commandBatchQuiet) {
+                snapshotCommandBatchConfigs();
+            }
+        }
+        if (!commandBatchQuiet) {
+            cliPrintLine("Command batch started");
         }
-        cliPrintLine("Command batch started");
     } else if (strncasecmp(cmdline, "end", 3) == 0) {
-        if (commandBatchActive && commandBatchError) {
+        if (commandBatchActive && commandBatchQuiet) {
+            endQuietCommandBatch();
+        } else if (commandBatchActive && commandBatchError) {
             cliPrintCommandBatchWarning(cmdName, NULL);
         } else {
             cliPrintLine("Command batch ended");
@@ -4274,6 +4352,12 @@ static bool tryPrepareSave(const char *cmdName)
 {
     bool success = prepareSave();
 #if defined(USE_CLI_BATCH)
+    if (commandBatchActive && commandBatchQuiet) {
+        endQuietCommandBatch();
+        resetCommandBatch();
+
+        return success;
+    }
     if (!success) {
         cliPrintCommandBatchWarning(cmdName, "PLEASE FIX ERRORS THEN 'SAVE'");
         resetCommandBatch();
@@ -4354,6 +4438,8 @@ static void cliDefaults(const char *cmdName, char *cmdline)
     // only reset the current error state but the batch will still be active
     // for subsequent commands.
     commandBatchError = false;
+    commandBatchErrorCount = 0;
+    commandBatchFirstErrorLine = 0;
 #endif
 
 #if defined(USE_SIMPLIFIED_TUNING)
@@ -4444,14 +4530,58 @@ static uint8_t getWordLength(const char *bufBegin, const char *bufEnd)
     return bufEnd - bufBegin;
 }
 
-STATIC_UNIT_TESTED uint16_t cliGetSettingIndex(const char *name, size_t length)
+static bool valueTableNameIndexValid = false;
+
+// Orders the name index with a shell sort, the table is only sorted once so no need for anything faster
+static void buildValueTableNameIndex(void)
 {
     for (uint32_t i = 0; i < valueTableEntryCount; i++) {
-        const char *settingName = valueTable[i].name;
+        valueTableNameIndex[i] = i;
+    }
+
+    for (uint32_t gap = valueTableEntryCount / 2; gap > 0; gap /= 2) {
+        for (uint32_t i = gap; i < valueTableEntryCount; i++) {
+            const uint16_t index = valueTableNameIndex[i];
+            uint32_t j = i;
+            while (j >= gap && strcasecmp(valueTable[valueTableNameIndex[j - gap]].name, valueTable[index].name) > 0) {
+                valueTableNameIndex[j] = valueTableNameIndex[j - gap];
+                j -= gap;
+            }
+            valueTableNameIndex[j] = index;
+        }
+    }
+
+    valueTableNameIndexValid = true;
+}
+
+// Compares the first length characters of name with the whole of settingName
+static int compareSettingName(const char *name, size_t length, const char *settingName)
+{
+    const int result = strncasecmp(name, settingName, length);
+    if (result != 0) {
+        return result;
+    }
+    return settingName[length] == '\0' ? 0 : -1;
+}
 
-        // ensure exact match when setting to prevent setting variables with longer names
-        if (strncasecmp(name, settingName, length) == 0 && length == strlen(settingName)) {
-            return i;
+STATIC_UNIT_TESTED uint16_t cliGetSettingIndex(const char *name, size_t length)
+{
+    if (!valueTableNameIndexValid) {
+        buildValueTableNameIndex();
+    }
+
+    // ensure exact match when setting to prevent setting variables with longer names
+    uint32_t low = 0;
+    uint32_t high = valueTableEntryCount;
+    while (low < high) {
+        const uint32_t mid = (low + high) / 2;
+        const int result = compareSettingName(name, length, valueTable[valueTableNameIndex[mid]].name);
+        if (result == 0) {
+            return valueTableNameIndex[mid];
+        } else if (result < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
         }
     }
     return valueTableEntryCount;
@@ -4951,6 +5081,41 @@ static void cliTasks(const char *cmdName, char *cmdline)
     }
 }
 
+#ifdef USE_SCHEDULER_TRACE
+static void cliSchedTrace(const char *cmdName, char *cmdline)
+{
+    if (isEmpty(cmdline)) {
+        cliPrintLinef("Scheduler trace %s, %u events pending, %u dropped",
+            schedTraceIsActive() ? "running" : "stopped", schedTracePending(), schedTraceDropped());
+    } else if (schedTraceIsStreaming()) {
+        // The ring has a single consumer, which is already draining it
+        cliPrintErrorLinef(cmdName, "TRACE IS STREAMED TO A FILE");
+    } else if (strncasecmp(cmdline, "start", 5) == 0) {
+        schedTraceClear();
+        schedTraceStart();
+    } else if (strncasecmp(cmdline, "stop", 4) == 0) {
+        schedTraceStop();
+    } else if (strncasecmp(cmdline, "dump", 4) == 0) {
+        // Stop recording so the trace ends where the dump starts
+        schedTraceStop();
+
+        // Chrome trace JSON array, can be loaded as is into chrome://tracing or Perfetto
+        char buf[SCHED_TRACE_JSON_MAX];
+        schedTraceEvent_t event;
+        const char *separator = "";
+        cliPrintLine("[");
+        while (schedTraceRead(&event, 1)) {
+            schedTraceFormatEvent(&event, buf);
+            cliPrintLinef("%s%s", separator, buf);
+            separator = ",";
+        }
+        cliPrintLine("]");
+    } else {
+        cliShowParseError(cmdName);
+    }
+}
+#endif
+
 static void printVersion(bool printBoardInfo)
 {
     cliPrintf("# %s / %s (%s) %s %s / %s (%s) MSP API: %s",
@@ -6548,7 +6713,7 @@ const clicmd_t cmdTable[] = {
     CLI_COMMAND_DEF("adjrange", "configure adjustment ranges", "<index> <unused> <range channel> <start> <end> <function> <select channel> [<center> <scale>]", cliAdjustmentRange),
     CLI_COMMAND_DEF("aux", "configure modes", "<index> <mode> <aux> <start> <end> <logic>", cliAux),
 #ifdef USE_CLI_BATCH
-    CLI_COMMAND_DEF("batch", "start or end a batch of commands", "start | end", cliBatch),
+    CLI_COMMAND_DEF("batch", "start or end a batch of commands", "start [quiet] | end", cliBatch),
 #endif
 #if defined(USE_BEEPER)
 #if defined(USE_DSHOT)
@@ -6656,6 +6821,9 @@ const clicmd_t cmdTable[] = {
     CLI_COMMAND_DEF("rxfail", "show/set rx failsafe settings", NULL, cliRxFailsafe),
     CLI_COMMAND_DEF("rxrange", "configure rx channel ranges", NULL, cliRxRange),
     CLI_COMMAND_DEF("save", "save and reboot (default)", "[noreboot]", cliSave),
+#ifdef USE_SCHEDULER_TRACE
+    CLI_COMMAND_DEF("sched_trace", "record scheduler timeline", "[start|stop|dump]", cliSchedTrace),
+#endif
 #ifdef USE_SDCARD
     CLI_COMMAND_DEF("sd_info", "sdcard info", NULL, cliSdInfo),
 #endif
@@ -6739,10 +6907,27 @@ static void cliHelp(const char *cmdName, char *cmdline)
     }
 }
 
-static void processCharacter(const char c)
+static bool isCommandBatchQuiet(void)
+{
+#ifdef USE_CLI_BATCH
+    return commandBatchQuiet;
+#else
+    return false;
+#endif
+}
+
+STATIC_UNIT_TESTED void processCharacter(const char c)
 {
+#ifdef USE_CLI_BATCH
+    // a "\r\n" pair ends a single line
+    if (commandBatchActive && (c == '\r' || (c == '\n' && commandBatchLastCharacter != '\r'))) {
+        commandBatchLine++;
+    }
+    commandBatchLastCharacter = c;
+#endif
+
     if (bufferIndex && (c == '\n' || c == '\r')) {
-        if (cliInteractive) {
+        if (cliInteractive && !isCommandBatchQuiet()) {
             // echo new line back to terminal
             cliPrintLinefeed();
         }
@@ -6770,12 +6955,19 @@ static void processCharacter(const char c)
                     break;
                 }
             }
+#ifdef USE_CLI_BATCH
+            if (commandBatchActive) {
+                commandBatchCommandCount++;
+                commandBatchCommandFailed = false;
+            }
+            bufWriter_t *writer = cliWriter;
+            if (commandBatchQuiet) {
+                // errors still go to cliErrorWriter
+                cliWriter = NULL;
+            }
+#endif
             if (cmd < cmdTable + ARRAYLEN(cmdTable)) {
                 cmd->cliCommand(cmd->name, options);
-                if (!cliMode) {
-                    // cli session ended
-                    return;
-                }
             } else {
                 if (cliInteractive) {
                     cliPrintError("input", "UNKNOWN COMMAND, TRY 'HELP'");
@@ -6784,12 +6976,19 @@ static void processCharacter(const char c)
                     cliPrintLine(cliBuffer);
                 }
             }
+#ifdef USE_CLI_BATCH
+            cliWriter = writer;
+#endif
+            if (!cliMode) {
+                // cli session ended
+                return;
+            }
         }
 
         cliClearInputBuffer();
 
         // prompt if in interactive mode
-        if (cliInteractive) {
+        if (cliInteractive && !isCommandBatchQuiet()) {
             cliPrompt();
         }
 
@@ -6800,7 +6999,7 @@ static void processCharacter(const char c)
         cliBuffer[bufferIndex++] = c;
 
         // echo the character if interactive
-        if (cliInteractive) {
+        if (cliInteractive && !isCommandBatchQuiet()) {
             cliWrite(c);
         }
     }
@@ -6911,6 +7110,10 @@ void cliEnter(serialPort_t *serialPort, bool interactive)
     cliEntryTime = millis();
     cliClearInputBuffer();
 
+    if (!valueTableNameIndexValid) {
+        buildValueTableNameIndex();
+    }
+
     if (interactive) {
         setPrintfSerialPort(cliPort);
     }
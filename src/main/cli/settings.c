@@ -378,6 +378,16 @@ static const char * const lookupTableDtermLowpassType[] = {
     "PT3",
 };
 
+#ifdef USE_DYN_NOTCH_FILTER
+static const char * const lookupTableDynNotchEstimator[] = {
+    "SDFT", "FFT", "GOERTZEL"
+};
+
+static const char * const lookupTableDynNotchFftSize[] = {
+    "64", "128", "256"
+};
+#endif
+
 static const char * const lookupTableFailsafe[] = {
     "AUTO-LAND", "DROP", "GPS-RESCUE"
 };
@@ -654,6 +664,10 @@ const lookupTableEntry_t lookupTables[] = {
 #endif
     LOOKUP_TABLE_ENTRY(lookupTableLowpassType),
     LOOKUP_TABLE_ENTRY(lookupTableDtermLowpassType),
+#ifdef USE_DYN_NOTCH_FILTER
+    LOOKUP_TABLE_ENTRY(lookupTableDynNotchEstimator),
+    LOOKUP_TABLE_ENTRY(lookupTableDynNotchFftSize),
+#endif
     LOOKUP_TABLE_ENTRY(lookupTableFailsafe),
     LOOKUP_TABLE_ENTRY(lookupTableFailsafeSwitchMode),
     LOOKUP_TABLE_ENTRY(lookupTableCrashRecovery),
@@ -803,6 +817,9 @@ const clivalue_t valueTable[] = {
     { PARAM_NAME_DYN_NOTCH_Q,       VAR_UINT16  | MASTER_VALUE, .config.minmaxUnsigned = { 1, 1000 }, PG_DYN_NOTCH_CONFIG, offsetof(dynNotchConfig_t, dyn_notch_q) },
     { PARAM_NAME_DYN_NOTCH_MIN_HZ,  VAR_UINT16  | MASTER_VALUE, .config.minmaxUnsigned = { 20, 250 }, PG_DYN_NOTCH_CONFIG, offsetof(dynNotchConfig_t, dyn_notch_min_hz) },
     { PARAM_NAME_DYN_NOTCH_MAX_HZ,  VAR_UINT16  | MASTER_VALUE, .config.minmaxUnsigned = { 200, 1000 }, PG_DYN_NOTCH_CONFIG, offsetof(dynNotchConfig_t, dyn_notch_max_hz) },
+    { PARAM_NAME_DYN_NOTCH_ESTIMATOR, VAR_UINT8 | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_DYN_NOTCH_ESTIMATOR }, PG_DYN_NOTCH_CONFIG, offsetof(dynNotchConfig_t, dyn_notch_estimator) },
+    { PARAM_NAME_DYN_NOTCH_FFT_SIZE, VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_DYN_NOTCH_FFT_SIZE }, PG_DYN_NOTCH_CONFIG, offsetof(dynNotchConfig_t, dyn_notch_fft_size) },
+    { PARAM_NAME_DYN_NOTCH_BUDGET,  VAR_UINT8   | MASTER_VALUE, .config.minmaxUnsigned = { 8, 255 }, PG_DYN_NOTCH_CONFIG, offsetof(dynNotchConfig_t, dyn_notch_budget) },
 #endif
 #ifdef USE_DYN_LPF
     { "gyro_lpf1_dyn_min_hz",       VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 0, DYN_LPF_MAX_HZ }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_lpf1_dyn_min_hz) },
@@ -2029,5 +2046,6 @@ const clivalue_t valueTable[] = {
 };
 
 const uint16_t valueTableEntryCount = ARRAYLEN(valueTable);
+uint16_t valueTableNameIndex[ARRAYLEN(valueTable)];
 
 STATIC_ASSERT(LOOKUP_TABLE_COUNT == ARRAYLEN(lookupTables), LOOKUP_TABLE_COUNT_incorrect);
@@ -69,6 +69,10 @@ typedef enum {
 #endif
     TABLE_GYRO_LPF_TYPE,
     TABLE_DTERM_LPF_TYPE,
+#ifdef USE_DYN_NOTCH_FILTER
+    TABLE_DYN_NOTCH_ESTIMATOR,
+    TABLE_DYN_NOTCH_FFT_SIZE,
+#endif
     TABLE_FAILSAFE,
     TABLE_FAILSAFE_SWITCH_MODE,
     TABLE_CRASH_RECOVERY,
@@ -248,6 +252,8 @@ extern const lookupTableEntry_t lookupTables[];
 extern const uint16_t valueTableEntryCount;
 
 extern const clivalue_t valueTable[];
+// valueTable indices ordered by name, filled in by the CLI on first lookup
+extern uint16_t valueTableNameIndex[];
 //extern const uint8_t lookupTablesEntryCount;
 
 extern const char * const lookupTableGyroHardware[];
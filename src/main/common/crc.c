@@ -18,6 +18,7 @@
  * If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "common/crc.h"
@@ -26,8 +27,538 @@
 
 #include "streambuf.h"
 
+// CRC engine, selected at build time, targets may override CRC_TABLE_SLICES:
+//  0 - bit serial, no tables
+//  1 - one 256 entry table per polynomial, one lookup per byte
+//  4 - slicing-by-4, four tables per polynomial, four bytes per step
+//  8 - slicing-by-8, eight tables per polynomial, eight bytes per step
+// The tables for CRC16 CCITT, CRC8 DVB-S2 and CRC8 0xBA cost 1kB of flash per slice. Other CRC8
+// polynomials always use the bit serial engine.
+#ifndef CRC_TABLE_SLICES
+#if !defined(TARGET_FLASH_SIZE) || TARGET_FLASH_SIZE >= 1024
+#define CRC_TABLE_SLICES 4
+#elif TARGET_FLASH_SIZE > 256
+#define CRC_TABLE_SLICES 1
+#else
+#define CRC_TABLE_SLICES 0
+#endif
+#endif
+
+#if CRC_TABLE_SLICES != 0 && CRC_TABLE_SLICES != 1 && CRC_TABLE_SLICES != 4 && CRC_TABLE_SLICES != 8
+#error "CRC_TABLE_SLICES must be 0, 1, 4 or 8"
+#endif
+
+#if CRC_TABLE_SLICES > 0
+// Table k holds the CRC of byte i followed by k zero bytes, starting from a CRC of zero
+
+static const uint16_t crc16CcittTable[CRC_TABLE_SLICES][256] = {
+    {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7, 0x8108, 0x9129, 0xa14a, 0xb16b,
+        0xc18c, 0xd1ad, 0xe1ce, 0xf1ef, 0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6,
+        0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de, 0x2462, 0x3443, 0x0420, 0x1401,
+        0x64e6, 0x74c7, 0x44a4, 0x5485, 0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d,
+        0x3653, 0x2672, 0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4, 0xb75b, 0xa77a, 0x9719, 0x8738,
+        0xf7df, 0xe7fe, 0xd79d, 0xc7bc, 0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861, 0x2802, 0x3823,
+        0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b, 0x5af5, 0x4ad4, 0x7ab7, 0x6a96,
+        0x1a71, 0x0a50, 0x3a33, 0x2a12, 0xdbfd, 0xcbdc, 0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a,
+        0x6ca6, 0x7c87, 0x4ce4, 0x5cc5, 0x2c22, 0x3c03, 0x0c60, 0x1c41, 0xedae, 0xfd8f, 0xcdec, 0xddcd,
+        0xad2a, 0xbd0b, 0x8d68, 0x9d49, 0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70,
+        0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78, 0x9188, 0x81a9, 0xb1ca, 0xa1eb,
+        0xd10c, 0xc12d, 0xf14e, 0xe16f, 0x1080, 0x00a1, 0x30c2, 0x20e3, 0x5004, 0x4025, 0x7046, 0x6067,
+        0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c, 0xe37f, 0xf35e, 0x02b1, 0x1290, 0x22f3, 0x32d2,
+        0x4235, 0x5214, 0x6277, 0x7256, 0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d,
+        0x34e2, 0x24c3, 0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405, 0xa7db, 0xb7fa, 0x8799, 0x97b8,
+        0xe75f, 0xf77e, 0xc71d, 0xd73c, 0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676, 0x4615, 0x5634,
+        0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab, 0x5844, 0x4865, 0x7806, 0x6827,
+        0x18c0, 0x08e1, 0x3882, 0x28a3, 0xcb7d, 0xdb5c, 0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a,
+        0x4a75, 0x5a54, 0x6a37, 0x7a16, 0x0af1, 0x1ad0, 0x2ab3, 0x3a92, 0xfd2e, 0xed0f, 0xdd6c, 0xcd4d,
+        0xbdaa, 0xad8b, 0x9de8, 0x8dc9, 0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1,
+        0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8, 0x6e17, 0x7e36, 0x4e55, 0x5e74,
+        0x2e93, 0x3eb2, 0x0ed1, 0x1ef0,
+    },
+#if CRC_TABLE_SLICES >= 4
+    {
+        0x0000, 0x3331, 0x6662, 0x5553, 0xccc4, 0xfff5, 0xaaa6, 0x9997, 0x89a9, 0xba98, 0xefcb, 0xdcfa,
+        0x456d, 0x765c, 0x230f, 0x103e, 0x0373, 0x3042, 0x6511, 0x5620, 0xcfb7, 0xfc86, 0xa9d5, 0x9ae4,
+        0x8ada, 0xb9eb, 0xecb8, 0xdf89, 0x461e, 0x752f, 0x207c, 0x134d, 0x06e6, 0x35d7, 0x6084, 0x53b5,
+        0xca22, 0xf913, 0xac40, 0x9f71, 0x8f4f, 0xbc7e, 0xe92d, 0xda1c, 0x438b, 0x70ba, 0x25e9, 0x16d8,
+        0x0595, 0x36a4, 0x63f7, 0x50c6, 0xc951, 0xfa60, 0xaf33, 0x9c02, 0x8c3c, 0xbf0d, 0xea5e, 0xd96f,
+        0x40f8, 0x73c9, 0x269a, 0x15ab, 0x0dcc, 0x3efd, 0x6bae, 0x589f, 0xc108, 0xf239, 0xa76a, 0x945b,
+        0x8465, 0xb754, 0xe207, 0xd136, 0x48a1, 0x7b90, 0x2ec3, 0x1df2, 0x0ebf, 0x3d8e, 0x68dd, 0x5bec,
+        0xc27b, 0xf14a, 0xa419, 0x9728, 0x8716, 0xb427, 0xe174, 0xd245, 0x4bd2, 0x78e3, 0x2db0, 0x1e81,
+        0x0b2a, 0x381b, 0x6d48, 0x5e79, 0xc7ee, 0xf4df, 0xa18c, 0x92bd, 0x8283, 0xb1b2, 0xe4e1, 0xd7d0,
+        0x4e47, 0x7d76, 0x2825, 0x1b14, 0x0859, 0x3b68, 0x6e3b, 0x5d0a, 0xc49d, 0xf7ac, 0xa2ff, 0x91ce,
+        0x81f0, 0xb2c1, 0xe792, 0xd4a3, 0x4d34, 0x7e05, 0x2b56, 0x1867, 0x1b98, 0x28a9, 0x7dfa, 0x4ecb,
+        0xd75c, 0xe46d, 0xb13e, 0x820f, 0x9231, 0xa100, 0xf453, 0xc762, 0x5ef5, 0x6dc4, 0x3897, 0x0ba6,
+        0x18eb, 0x2bda, 0x7e89, 0x4db8, 0xd42f, 0xe71e, 0xb24d, 0x817c, 0x9142, 0xa273, 0xf720, 0xc411,
+        0x5d86, 0x6eb7, 0x3be4, 0x08d5, 0x1d7e, 0x2e4f, 0x7b1c, 0x482d, 0xd1ba, 0xe28b, 0xb7d8, 0x84e9,
+        0x94d7, 0xa7e6, 0xf2b5, 0xc184, 0x5813, 0x6b22, 0x3e71, 0x0d40, 0x1e0d, 0x2d3c, 0x786f, 0x4b5e,
+        0xd2c9, 0xe1f8, 0xb4ab, 0x879a, 0x97a4, 0xa495, 0xf1c6, 0xc2f7, 0x5b60, 0x6851, 0x3d02, 0x0e33,
+        0x1654, 0x2565, 0x7036, 0x4307, 0xda90, 0xe9a1, 0xbcf2, 0x8fc3, 0x9ffd, 0xaccc, 0xf99f, 0xcaae,
+        0x5339, 0x6008, 0x355b, 0x066a, 0x1527, 0x2616, 0x7345, 0x4074, 0xd9e3, 0xead2, 0xbf81, 0x8cb0,
+        0x9c8e, 0xafbf, 0xfaec, 0xc9dd, 0x504a, 0x637b, 0x3628, 0x0519, 0x10b2, 0x2383, 0x76d0, 0x45e1,
+        0xdc76, 0xef47, 0xba14, 0x8925, 0x991b, 0xaa2a, 0xff79, 0xcc48, 0x55df, 0x66ee, 0x33bd, 0x008c,
+        0x13c1, 0x20f0, 0x75a3, 0x4692, 0xdf05, 0xec34, 0xb967, 0x8a56, 0x9a68, 0xa959, 0xfc0a, 0xcf3b,
+        0x56ac, 0x659d, 0x30ce, 0x03ff,
+    },
+    {
+        0x0000, 0x3730, 0x6e60, 0x5950, 0xdcc0, 0xebf0, 0xb2a0, 0x8590, 0xa9a1, 0x9e91, 0xc7c1, 0xf0f1,
+        0x7561, 0x4251, 0x1b01, 0x2c31, 0x4363, 0x7453, 0x2d03, 0x1a33, 0x9fa3, 0xa893, 0xf1c3, 0xc6f3,
+        0xeac2, 0xddf2, 0x84a2, 0xb392, 0x3602, 0x0132, 0x5862, 0x6f52, 0x86c6, 0xb1f6, 0xe8a6, 0xdf96,
+        0x5a06, 0x6d36, 0x3466, 0x0356, 0x2f67, 0x1857, 0x4107, 0x7637, 0xf3a7, 0xc497, 0x9dc7, 0xaaf7,
+        0xc5a5, 0xf295, 0xabc5, 0x9cf5, 0x1965, 0x2e55, 0x7705, 0x4035, 0x6c04, 0x5b34, 0x0264, 0x3554,
+        0xb0c4, 0x87f4, 0xdea4, 0xe994, 0x1dad, 0x2a9d, 0x73cd, 0x44fd, 0xc16d, 0xf65d, 0xaf0d, 0x983d,
+        0xb40c, 0x833c, 0xda6c, 0xed5c, 0x68cc, 0x5ffc, 0x06ac, 0x319c, 0x5ece, 0x69fe, 0x30ae, 0x079e,
+        0x820e, 0xb53e, 0xec6e, 0xdb5e, 0xf76f, 0xc05f, 0x990f, 0xae3f, 0x2baf, 0x1c9f, 0x45cf, 0x72ff,
+        0x9b6b, 0xac5b, 0xf50b, 0xc23b, 0x47ab, 0x709b, 0x29cb, 0x1efb, 0x32ca, 0x05fa, 0x5caa, 0x6b9a,
+        0xee0a, 0xd93a, 0x806a, 0xb75a, 0xd808, 0xef38, 0xb668, 0x8158, 0x04c8, 0x33f8, 0x6aa8, 0x5d98,
+        0x71a9, 0x4699, 0x1fc9, 0x28f9, 0xad69, 0x9a59, 0xc309, 0xf439, 0x3b5a, 0x0c6a, 0x553a, 0x620a,
+        0xe79a, 0xd0aa, 0x89fa, 0xbeca, 0x92fb, 0xa5cb, 0xfc9b, 0xcbab, 0x4e3b, 0x790b, 0x205b, 0x176b,
+        0x7839, 0x4f09, 0x1659, 0x2169, 0xa4f9, 0x93c9, 0xca99, 0xfda9, 0xd198, 0xe6a8, 0xbff8, 0x88c8,
+        0x0d58, 0x3a68, 0x6338, 0x5408, 0xbd9c, 0x8aac, 0xd3fc, 0xe4cc, 0x615c, 0x566c, 0x0f3c, 0x380c,
+        0x143d, 0x230d, 0x7a5d, 0x4d6d, 0xc8fd, 0xffcd, 0xa69d, 0x91ad, 0xfeff, 0xc9cf, 0x909f, 0xa7af,
+        0x223f, 0x150f, 0x4c5f, 0x7b6f, 0x575e, 0x606e, 0x393e, 0x0e0e, 0x8b9e, 0xbcae, 0xe5fe, 0xd2ce,
+        0x26f7, 0x11c7, 0x4897, 0x7fa7, 0xfa37, 0xcd07, 0x9457, 0xa367, 0x8f56, 0xb866, 0xe136, 0xd606,
+        0x5396, 0x64a6, 0x3df6, 0x0ac6, 0x6594, 0x52a4, 0x0bf4, 0x3cc4, 0xb954, 0x8e64, 0xd734, 0xe004,
+        0xcc35, 0xfb05, 0xa255, 0x9565, 0x10f5, 0x27c5, 0x7e95, 0x49a5, 0xa031, 0x9701, 0xce51, 0xf961,
+        0x7cf1, 0x4bc1, 0x1291, 0x25a1, 0x0990, 0x3ea0, 0x67f0, 0x50c0, 0xd550, 0xe260, 0xbb30, 0x8c00,
+        0xe352, 0xd462, 0x8d32, 0xba02, 0x3f92, 0x08a2, 0x51f2, 0x66c2, 0x4af3, 0x7dc3, 0x2493, 0x13a3,
+        0x9633, 0xa103, 0xf853, 0xcf63,
+    },
+    {
+        0x0000, 0x76b4, 0xed68, 0x9bdc, 0xcaf1, 0xbc45, 0x2799, 0x512d, 0x85c3, 0xf377, 0x68ab, 0x1e1f,
+        0x4f32, 0x3986, 0xa25a, 0xd4ee, 0x1ba7, 0x6d13, 0xf6cf, 0x807b, 0xd156, 0xa7e2, 0x3c3e, 0x4a8a,
+        0x9e64, 0xe8d0, 0x730c, 0x05b8, 0x5495, 0x2221, 0xb9fd, 0xcf49, 0x374e, 0x41fa, 0xda26, 0xac92,
+        0xfdbf, 0x8b0b, 0x10d7, 0x6663, 0xb28d, 0xc439, 0x5fe5, 0x2951, 0x787c, 0x0ec8, 0x9514, 0xe3a0,
+        0x2ce9, 0x5a5d, 0xc181, 0xb735, 0xe618, 0x90ac, 0x0b70, 0x7dc4, 0xa92a, 0xdf9e, 0x4442, 0x32f6,
+        0x63db, 0x156f, 0x8eb3, 0xf807, 0x6e9c, 0x1828, 0x83f4, 0xf540, 0xa46d, 0xd2d9, 0x4905, 0x3fb1,
+        0xeb5f, 0x9deb, 0x0637, 0x7083, 0x21ae, 0x571a, 0xccc6, 0xba72, 0x753b, 0x038f, 0x9853, 0xeee7,
+        0xbfca, 0xc97e, 0x52a2, 0x2416, 0xf0f8, 0x864c, 0x1d90, 0x6b24, 0x3a09, 0x4cbd, 0xd761, 0xa1d5,
+        0x59d2, 0x2f66, 0xb4ba, 0xc20e, 0x9323, 0xe597, 0x7e4b, 0x08ff, 0xdc11, 0xaaa5, 0x3179, 0x47cd,
+        0x16e0, 0x6054, 0xfb88, 0x8d3c, 0x4275, 0x34c1, 0xaf1d, 0xd9a9, 0x8884, 0xfe30, 0x65ec, 0x1358,
+        0xc7b6, 0xb102, 0x2ade, 0x5c6a, 0x0d47, 0x7bf3, 0xe02f, 0x969b, 0xdd38, 0xab8c, 0x3050, 0x46e4,
+        0x17c9, 0x617d, 0xfaa1, 0x8c15, 0x58fb, 0x2e4f, 0xb593, 0xc327, 0x920a, 0xe4be, 0x7f62, 0x09d6,
+        0xc69f, 0xb02b, 0x2bf7, 0x5d43, 0x0c6e, 0x7ada, 0xe106, 0x97b2, 0x435c, 0x35e8, 0xae34, 0xd880,
+        0x89ad, 0xff19, 0x64c5, 0x1271, 0xea76, 0x9cc2, 0x071e, 0x71aa, 0x2087, 0x5633, 0xcdef, 0xbb5b,
+        0x6fb5, 0x1901, 0x82dd, 0xf469, 0xa544, 0xd3f0, 0x482c, 0x3e98, 0xf1d1, 0x8765, 0x1cb9, 0x6a0d,
+        0x3b20, 0x4d94, 0xd648, 0xa0fc, 0x7412, 0x02a6, 0x997a, 0xefce, 0xbee3, 0xc857, 0x538b, 0x253f,
+        0xb3a4, 0xc510, 0x5ecc, 0x2878, 0x7955, 0x0fe1, 0x943d, 0xe289, 0x3667, 0x40d3, 0xdb0f, 0xadbb,
+        0xfc96, 0x8a22, 0x11fe, 0x674a, 0xa803, 0xdeb7, 0x456b, 0x33df, 0x62f2, 0x1446, 0x8f9a, 0xf92e,
+        0x2dc0, 0x5b74, 0xc0a8, 0xb61c, 0xe731, 0x9185, 0x0a59, 0x7ced, 0x84ea, 0xf25e, 0x6982, 0x1f36,
+        0x4e1b, 0x38af, 0xa373, 0xd5c7, 0x0129, 0x779d, 0xec41, 0x9af5, 0xcbd8, 0xbd6c, 0x26b0, 0x5004,
+        0x9f4d, 0xe9f9, 0x7225, 0x0491, 0x55bc, 0x2308, 0xb8d4, 0xce60, 0x1a8e, 0x6c3a, 0xf7e6, 0x8152,
+        0xd07f, 0xa6cb, 0x3d17, 0x4ba3,
+    },
+#endif
+#if CRC_TABLE_SLICES >= 8
+    {
+        0x0000, 0xaa51, 0x4483, 0xeed2, 0x8906, 0x2357, 0xcd85, 0x67d4, 0x022d, 0xa87c, 0x46ae, 0xecff,
+        0x8b2b, 0x217a, 0xcfa8, 0x65f9, 0x045a, 0xae0b, 0x40d9, 0xea88, 0x8d5c, 0x270d, 0xc9df, 0x638e,
+        0x0677, 0xac26, 0x42f4, 0xe8a5, 0x8f71, 0x2520, 0xcbf2, 0x61a3, 0x08b4, 0xa2e5, 0x4c37, 0xe666,
+        0x81b2, 0x2be3, 0xc531, 0x6f60, 0x0a99, 0xa0c8, 0x4e1a, 0xe44b, 0x839f, 0x29ce, 0xc71c, 0x6d4d,
+        0x0cee, 0xa6bf, 0x486d, 0xe23c, 0x85e8, 0x2fb9, 0xc16b, 0x6b3a, 0x0ec3, 0xa492, 0x4a40, 0xe011,
+        0x87c5, 0x2d94, 0xc346, 0x6917, 0x1168, 0xbb39, 0x55eb, 0xffba, 0x986e, 0x323f, 0xdced, 0x76bc,
+        0x1345, 0xb914, 0x57c6, 0xfd97, 0x9a43, 0x3012, 0xdec0, 0x7491, 0x1532, 0xbf63, 0x51b1, 0xfbe0,
+        0x9c34, 0x3665, 0xd8b7, 0x72e6, 0x171f, 0xbd4e, 0x539c, 0xf9cd, 0x9e19, 0x3448, 0xda9a, 0x70cb,
+        0x19dc, 0xb38d, 0x5d5f, 0xf70e, 0x90da, 0x3a8b, 0xd459, 0x7e08, 0x1bf1, 0xb1a0, 0x5f72, 0xf523,
+        0x92f7, 0x38a6, 0xd674, 0x7c25, 0x1d86, 0xb7d7, 0x5905, 0xf354, 0x9480, 0x3ed1, 0xd003, 0x7a52,
+        0x1fab, 0xb5fa, 0x5b28, 0xf179, 0x96ad, 0x3cfc, 0xd22e, 0x787f, 0x22d0, 0x8881, 0x6653, 0xcc02,
+        0xabd6, 0x0187, 0xef55, 0x4504, 0x20fd, 0x8aac, 0x647e, 0xce2f, 0xa9fb, 0x03aa, 0xed78, 0x4729,
+        0x268a, 0x8cdb, 0x6209, 0xc858, 0xaf8c, 0x05dd, 0xeb0f, 0x415e, 0x24a7, 0x8ef6, 0x6024, 0xca75,
+        0xada1, 0x07f0, 0xe922, 0x4373, 0x2a64, 0x8035, 0x6ee7, 0xc4b6, 0xa362, 0x0933, 0xe7e1, 0x4db0,
+        0x2849, 0x8218, 0x6cca, 0xc69b, 0xa14f, 0x0b1e, 0xe5cc, 0x4f9d, 0x2e3e, 0x846f, 0x6abd, 0xc0ec,
+        0xa738, 0x0d69, 0xe3bb, 0x49ea, 0x2c13, 0x8642, 0x6890, 0xc2c1, 0xa515, 0x0f44, 0xe196, 0x4bc7,
+        0x33b8, 0x99e9, 0x773b, 0xdd6a, 0xbabe, 0x10ef, 0xfe3d, 0x546c, 0x3195, 0x9bc4, 0x7516, 0xdf47,
+        0xb893, 0x12c2, 0xfc10, 0x5641, 0x37e2, 0x9db3, 0x7361, 0xd930, 0xbee4, 0x14b5, 0xfa67, 0x5036,
+        0x35cf, 0x9f9e, 0x714c, 0xdb1d, 0xbcc9, 0x1698, 0xf84a, 0x521b, 0x3b0c, 0x915d, 0x7f8f, 0xd5de,
+        0xb20a, 0x185b, 0xf689, 0x5cd8, 0x3921, 0x9370, 0x7da2, 0xd7f3, 0xb027, 0x1a76, 0xf4a4, 0x5ef5,
+        0x3f56, 0x9507, 0x7bd5, 0xd184, 0xb650, 0x1c01, 0xf2d3, 0x5882, 0x3d7b, 0x972a, 0x79f8, 0xd3a9,
+        0xb47d, 0x1e2c, 0xf0fe, 0x5aaf,
+    },
+    {
+        0x0000, 0x45a0, 0x8b40, 0xcee0, 0x06a1, 0x4301, 0x8de1, 0xc841, 0x0d42, 0x48e2, 0x8602, 0xc3a2,
+        0x0be3, 0x4e43, 0x80a3, 0xc503, 0x1a84, 0x5f24, 0x91c4, 0xd464, 0x1c25, 0x5985, 0x9765, 0xd2c5,
+        0x17c6, 0x5266, 0x9c86, 0xd926, 0x1167, 0x54c7, 0x9a27, 0xdf87, 0x3508, 0x70a8, 0xbe48, 0xfbe8,
+        0x33a9, 0x7609, 0xb8e9, 0xfd49, 0x384a, 0x7dea, 0xb30a, 0xf6aa, 0x3eeb, 0x7b4b, 0xb5ab, 0xf00b,
+        0x2f8c, 0x6a2c, 0xa4cc, 0xe16c, 0x292d, 0x6c8d, 0xa26d, 0xe7cd, 0x22ce, 0x676e, 0xa98e, 0xec2e,
+        0x246f, 0x61cf, 0xaf2f, 0xea8f, 0x6a10, 0x2fb0, 0xe150, 0xa4f0, 0x6cb1, 0x2911, 0xe7f1, 0xa251,
+        0x6752, 0x22f2, 0xec12, 0xa9b2, 0x61f3, 0x2453, 0xeab3, 0xaf13, 0x7094, 0x3534, 0xfbd4, 0xbe74,
+        0x7635, 0x3395, 0xfd75, 0xb8d5, 0x7dd6, 0x3876, 0xf696, 0xb336, 0x7b77, 0x3ed7, 0xf037, 0xb597,
+        0x5f18, 0x1ab8, 0xd458, 0x91f8, 0x59b9, 0x1c19, 0xd2f9, 0x9759, 0x525a, 0x17fa, 0xd91a, 0x9cba,
+        0x54fb, 0x115b, 0xdfbb, 0x9a1b, 0x459c, 0x003c, 0xcedc, 0x8b7c, 0x433d, 0x069d, 0xc87d, 0x8ddd,
+        0x48de, 0x0d7e, 0xc39e, 0x863e, 0x4e7f, 0x0bdf, 0xc53f, 0x809f, 0xd420, 0x9180, 0x5f60, 0x1ac0,
+        0xd281, 0x9721, 0x59c1, 0x1c61, 0xd962, 0x9cc2, 0x5222, 0x1782, 0xdfc3, 0x9a63, 0x5483, 0x1123,
+        0xcea4, 0x8b04, 0x45e4, 0x0044, 0xc805, 0x8da5, 0x4345, 0x06e5, 0xc3e6, 0x8646, 0x48a6, 0x0d06,
+        0xc547, 0x80e7, 0x4e07, 0x0ba7, 0xe128, 0xa488, 0x6a68, 0x2fc8, 0xe789, 0xa229, 0x6cc9, 0x2969,
+        0xec6a, 0xa9ca, 0x672a, 0x228a, 0xeacb, 0xaf6b, 0x618b, 0x242b, 0xfbac, 0xbe0c, 0x70ec, 0x354c,
+        0xfd0d, 0xb8ad, 0x764d, 0x33ed, 0xf6ee, 0xb34e, 0x7dae, 0x380e, 0xf04f, 0xb5ef, 0x7b0f, 0x3eaf,
+        0xbe30, 0xfb90, 0x3570, 0x70d0, 0xb891, 0xfd31, 0x33d1, 0x7671, 0xb372, 0xf6d2, 0x3832, 0x7d92,
+        0xb5d3, 0xf073, 0x3e93, 0x7b33, 0xa4b4, 0xe114, 0x2ff4, 0x6a54, 0xa215, 0xe7b5, 0x2955, 0x6cf5,
+        0xa9f6, 0xec56, 0x22b6, 0x6716, 0xaf57, 0xeaf7, 0x2417, 0x61b7, 0x8b38, 0xce98, 0x0078, 0x45d8,
+        0x8d99, 0xc839, 0x06d9, 0x4379, 0x867a, 0xc3da, 0x0d3a, 0x489a, 0x80db, 0xc57b, 0x0b9b, 0x4e3b,
+        0x91bc, 0xd41c, 0x1afc, 0x5f5c, 0x971d, 0xd2bd, 0x1c5d, 0x59fd, 0x9cfe, 0xd95e, 0x17be, 0x521e,
+        0x9a5f, 0xdfff, 0x111f, 0x54bf,
+    },
+    {
+        0x0000, 0xb861, 0x60e3, 0xd882, 0xc1c6, 0x79a7, 0xa125, 0x1944, 0x93ad, 0x2bcc, 0xf34e, 0x4b2f,
+        0x526b, 0xea0a, 0x3288, 0x8ae9, 0x377b, 0x8f1a, 0x5798, 0xeff9, 0xf6bd, 0x4edc, 0x965e, 0x2e3f,
+        0xa4d6, 0x1cb7, 0xc435, 0x7c54, 0x6510, 0xdd71, 0x05f3, 0xbd92, 0x6ef6, 0xd697, 0x0e15, 0xb674,
+        0xaf30, 0x1751, 0xcfd3, 0x77b2, 0xfd5b, 0x453a, 0x9db8, 0x25d9, 0x3c9d, 0x84fc, 0x5c7e, 0xe41f,
+        0x598d, 0xe1ec, 0x396e, 0x810f, 0x984b, 0x202a, 0xf8a8, 0x40c9, 0xca20, 0x7241, 0xaac3, 0x12a2,
+        0x0be6, 0xb387, 0x6b05, 0xd364, 0xddec, 0x658d, 0xbd0f, 0x056e, 0x1c2a, 0xa44b, 0x7cc9, 0xc4a8,
+        0x4e41, 0xf620, 0x2ea2, 0x96c3, 0x8f87, 0x37e6, 0xef64, 0x5705, 0xea97, 0x52f6, 0x8a74, 0x3215,
+        0x2b51, 0x9330, 0x4bb2, 0xf3d3, 0x793a, 0xc15b, 0x19d9, 0xa1b8, 0xb8fc, 0x009d, 0xd81f, 0x607e,
+        0xb31a, 0x0b7b, 0xd3f9, 0x6b98, 0x72dc, 0xcabd, 0x123f, 0xaa5e, 0x20b7, 0x98d6, 0x4054, 0xf835,
+        0xe171, 0x5910, 0x8192, 0x39f3, 0x8461, 0x3c00, 0xe482, 0x5ce3, 0x45a7, 0xfdc6, 0x2544, 0x9d25,
+        0x17cc, 0xafad, 0x772f, 0xcf4e, 0xd60a, 0x6e6b, 0xb6e9, 0x0e88, 0xabf9, 0x1398, 0xcb1a, 0x737b,
+        0x6a3f, 0xd25e, 0x0adc, 0xb2bd, 0x3854, 0x8035, 0x58b7, 0xe0d6, 0xf992, 0x41f3, 0x9971, 0x2110,
+        0x9c82, 0x24e3, 0xfc61, 0x4400, 0x5d44, 0xe525, 0x3da7, 0x85c6, 0x0f2f, 0xb74e, 0x6fcc, 0xd7ad,
+        0xcee9, 0x7688, 0xae0a, 0x166b, 0xc50f, 0x7d6e, 0xa5ec, 0x1d8d, 0x04c9, 0xbca8, 0x642a, 0xdc4b,
+        0x56a2, 0xeec3, 0x3641, 0x8e20, 0x9764, 0x2f05, 0xf787, 0x4fe6, 0xf274, 0x4a15, 0x9297, 0x2af6,
+        0x33b2, 0x8bd3, 0x5351, 0xeb30, 0x61d9, 0xd9b8, 0x013a, 0xb95b, 0xa01f, 0x187e, 0xc0fc, 0x789d,
+        0x7615, 0xce74, 0x16f6, 0xae97, 0xb7d3, 0x0fb2, 0xd730, 0x6f51, 0xe5b8, 0x5dd9, 0x855b, 0x3d3a,
+        0x247e, 0x9c1f, 0x449d, 0xfcfc, 0x416e, 0xf90f, 0x218d, 0x99ec, 0x80a8, 0x38c9, 0xe04b, 0x582a,
+        0xd2c3, 0x6aa2, 0xb220, 0x0a41, 0x1305, 0xab64, 0x73e6, 0xcb87, 0x18e3, 0xa082, 0x7800, 0xc061,
+        0xd925, 0x6144, 0xb9c6, 0x01a7, 0x8b4e, 0x332f, 0xebad, 0x53cc, 0x4a88, 0xf2e9, 0x2a6b, 0x920a,
+        0x2f98, 0x97f9, 0x4f7b, 0xf71a, 0xee5e, 0x563f, 0x8ebd, 0x36dc, 0xbc35, 0x0454, 0xdcd6, 0x64b7,
+        0x7df3, 0xc592, 0x1d10, 0xa571,
+    },
+    {
+        0x0000, 0x47d3, 0x8fa6, 0xc875, 0x0f6d, 0x48be, 0x80cb, 0xc718, 0x1eda, 0x5909, 0x917c, 0xd6af,
+        0x11b7, 0x5664, 0x9e11, 0xd9c2, 0x3db4, 0x7a67, 0xb212, 0xf5c1, 0x32d9, 0x750a, 0xbd7f, 0xfaac,
+        0x236e, 0x64bd, 0xacc8, 0xeb1b, 0x2c03, 0x6bd0, 0xa3a5, 0xe476, 0x7b68, 0x3cbb, 0xf4ce, 0xb31d,
+        0x7405, 0x33d6, 0xfba3, 0xbc70, 0x65b2, 0x2261, 0xea14, 0xadc7, 0x6adf, 0x2d0c, 0xe579, 0xa2aa,
+        0x46dc, 0x010f, 0xc97a, 0x8ea9, 0x49b1, 0x0e62, 0xc617, 0x81c4, 0x5806, 0x1fd5, 0xd7a0, 0x9073,
+        0x576b, 0x10b8, 0xd8cd, 0x9f1e, 0xf6d0, 0xb103, 0x7976, 0x3ea5, 0xf9bd, 0xbe6e, 0x761b, 0x31c8,
+        0xe80a, 0xafd9, 0x67ac, 0x207f, 0xe767, 0xa0b4, 0x68c1, 0x2f12, 0xcb64, 0x8cb7, 0x44c2, 0x0311,
+        0xc409, 0x83da, 0x4baf, 0x0c7c, 0xd5be, 0x926d, 0x5a18, 0x1dcb, 0xdad3, 0x9d00, 0x5575, 0x12a6,
+        0x8db8, 0xca6b, 0x021e, 0x45cd, 0x82d5, 0xc506, 0x0d73, 0x4aa0, 0x9362, 0xd4b1, 0x1cc4, 0x5b17,
+        0x9c0f, 0xdbdc, 0x13a9, 0x547a, 0xb00c, 0xf7df, 0x3faa, 0x7879, 0xbf61, 0xf8b2, 0x30c7, 0x7714,
+        0xaed6, 0xe905, 0x2170, 0x66a3, 0xa1bb, 0xe668, 0x2e1d, 0x69ce, 0xfd81, 0xba52, 0x7227, 0x35f4,
+        0xf2ec, 0xb53f, 0x7d4a, 0x3a99, 0xe35b, 0xa488, 0x6cfd, 0x2b2e, 0xec36, 0xabe5, 0x6390, 0x2443,
+        0xc035, 0x87e6, 0x4f93, 0x0840, 0xcf58, 0x888b, 0x40fe, 0x072d, 0xdeef, 0x993c, 0x5149, 0x169a,
+        0xd182, 0x9651, 0x5e24, 0x19f7, 0x86e9, 0xc13a, 0x094f, 0x4e9c, 0x8984, 0xce57, 0x0622, 0x41f1,
+        0x9833, 0xdfe0, 0x1795, 0x5046, 0x975e, 0xd08d, 0x18f8, 0x5f2b, 0xbb5d, 0xfc8e, 0x34fb, 0x7328,
+        0xb430, 0xf3e3, 0x3b96, 0x7c45, 0xa587, 0xe254, 0x2a21, 0x6df2, 0xaaea, 0xed39, 0x254c, 0x629f,
+        0x0b51, 0x4c82, 0x84f7, 0xc324, 0x043c, 0x43ef, 0x8b9a, 0xcc49, 0x158b, 0x5258, 0x9a2d, 0xddfe,
+        0x1ae6, 0x5d35, 0x9540, 0xd293, 0x36e5, 0x7136, 0xb943, 0xfe90, 0x3988, 0x7e5b, 0xb62e, 0xf1fd,
+        0x283f, 0x6fec, 0xa799, 0xe04a, 0x2752, 0x6081, 0xa8f4, 0xef27, 0x7039, 0x37ea, 0xff9f, 0xb84c,
+        0x7f54, 0x3887, 0xf0f2, 0xb721, 0x6ee3, 0x2930, 0xe145, 0xa696, 0x618e, 0x265d, 0xee28, 0xa9fb,
+        0x4d8d, 0x0a5e, 0xc22b, 0x85f8, 0x42e0, 0x0533, 0xcd46, 0x8a95, 0x5357, 0x1484, 0xdcf1, 0x9b22,
+        0x5c3a, 0x1be9, 0xd39c, 0x944f,
+    },
+#endif
+};
+
+static const uint8_t crc8DvbS2Table[CRC_TABLE_SLICES][256] = {
+    {
+        0x00, 0xd5, 0x7f, 0xaa, 0xfe, 0x2b, 0x81, 0x54, 0x29, 0xfc, 0x56, 0x83, 0xd7, 0x02, 0xa8, 0x7d,
+        0x52, 0x87, 0x2d, 0xf8, 0xac, 0x79, 0xd3, 0x06, 0x7b, 0xae, 0x04, 0xd1, 0x85, 0x50, 0xfa, 0x2f,
+        0xa4, 0x71, 0xdb, 0x0e, 0x5a, 0x8f, 0x25, 0xf0, 0x8d, 0x58, 0xf2, 0x27, 0x73, 0xa6, 0x0c, 0xd9,
+        0xf6, 0x23, 0x89, 0x5c, 0x08, 0xdd, 0x77, 0xa2, 0xdf, 0x0a, 0xa0, 0x75, 0x21, 0xf4, 0x5e, 0x8b,
+        0x9d, 0x48, 0xe2, 0x37, 0x63, 0xb6, 0x1c, 0xc9, 0xb4, 0x61, 0xcb, 0x1e, 0x4a, 0x9f, 0x35, 0xe0,
+        0xcf, 0x1a, 0xb0, 0x65, 0x31, 0xe4, 0x4e, 0x9b, 0xe6, 0x33, 0x99, 0x4c, 0x18, 0xcd, 0x67, 0xb2,
+        0x39, 0xec, 0x46, 0x93, 0xc7, 0x12, 0xb8, 0x6d, 0x10, 0xc5, 0x6f, 0xba, 0xee, 0x3b, 0x91, 0x44,
+        0x6b, 0xbe, 0x14, 0xc1, 0x95, 0x40, 0xea, 0x3f, 0x42, 0x97, 0x3d, 0xe8, 0xbc, 0x69, 0xc3, 0x16,
+        0xef, 0x3a, 0x90, 0x45, 0x11, 0xc4, 0x6e, 0xbb, 0xc6, 0x13, 0xb9, 0x6c, 0x38, 0xed, 0x47, 0x92,
+        0xbd, 0x68, 0xc2, 0x17, 0x43, 0x96, 0x3c, 0xe9, 0x94, 0x41, 0xeb, 0x3e, 0x6a, 0xbf, 0x15, 0xc0,
+        0x4b, 0x9e, 0x34, 0xe1, 0xb5, 0x60, 0xca, 0x1f, 0x62, 0xb7, 0x1d, 0xc8, 0x9c, 0x49, 0xe3, 0x36,
+        0x19, 0xcc, 0x66, 0xb3, 0xe7, 0x32, 0x98, 0x4d, 0x30, 0xe5, 0x4f, 0x9a, 0xce, 0x1b, 0xb1, 0x64,
+        0x72, 0xa7, 0x0d, 0xd8, 0x8c, 0x59, 0xf3, 0x26, 0x5b, 0x8e, 0x24, 0xf1, 0xa5, 0x70, 0xda, 0x0f,
+        0x20, 0xf5, 0x5f, 0x8a, 0xde, 0x0b, 0xa1, 0x74, 0x09, 0xdc, 0x76, 0xa3, 0xf7, 0x22, 0x88, 0x5d,
+        0xd6, 0x03, 0xa9, 0x7c, 0x28, 0xfd, 0x57, 0x82, 0xff, 0x2a, 0x80, 0x55, 0x01, 0xd4, 0x7e, 0xab,
+        0x84, 0x51, 0xfb, 0x2e, 0x7a, 0xaf, 0x05, 0xd0, 0xad, 0x78, 0xd2, 0x07, 0x53, 0x86, 0x2c, 0xf9,
+    },
+#if CRC_TABLE_SLICES >= 4
+    {
+        0x00, 0x0b, 0x16, 0x1d, 0x2c, 0x27, 0x3a, 0x31, 0x58, 0x53, 0x4e, 0x45, 0x74, 0x7f, 0x62, 0x69,
+        0xb0, 0xbb, 0xa6, 0xad, 0x9c, 0x97, 0x8a, 0x81, 0xe8, 0xe3, 0xfe, 0xf5, 0xc4, 0xcf, 0xd2, 0xd9,
+        0xb5, 0xbe, 0xa3, 0xa8, 0x99, 0x92, 0x8f, 0x84, 0xed, 0xe6, 0xfb, 0xf0, 0xc1, 0xca, 0xd7, 0xdc,
+        0x05, 0x0e, 0x13, 0x18, 0x29, 0x22, 0x3f, 0x34, 0x5d, 0x56, 0x4b, 0x40, 0x71, 0x7a, 0x67, 0x6c,
+        0xbf, 0xb4, 0xa9, 0xa2, 0x93, 0x98, 0x85, 0x8e, 0xe7, 0xec, 0xf1, 0xfa, 0xcb, 0xc0, 0xdd, 0xd6,
+        0x0f, 0x04, 0x19, 0x12, 0x23, 0x28, 0x35, 0x3e, 0x57, 0x5c, 0x41, 0x4a, 0x7b, 0x70, 0x6d, 0x66,
+        0x0a, 0x01, 0x1c, 0x17, 0x26, 0x2d, 0x30, 0x3b, 0x52, 0x59, 0x44, 0x4f, 0x7e, 0x75, 0x68, 0x63,
+        0xba, 0xb1, 0xac, 0xa7, 0x96, 0x9d, 0x80, 0x8b, 0xe2, 0xe9, 0xf4, 0xff, 0xce, 0xc5, 0xd8, 0xd3,
+        0xab, 0xa0, 0xbd, 0xb6, 0x87, 0x8c, 0x91, 0x9a, 0xf3, 0xf8, 0xe5, 0xee, 0xdf, 0xd4, 0xc9, 0xc2,
+        0x1b, 0x10, 0x0d, 0x06, 0x37, 0x3c, 0x21, 0x2a, 0x43, 0x48, 0x55, 0x5e, 0x6f, 0x64, 0x79, 0x72,
+        0x1e, 0x15, 0x08, 0x03, 0x32, 0x39, 0x24, 0x2f, 0x46, 0x4d, 0x50, 0x5b, 0x6a, 0x61, 0x7c, 0x77,
+        0xae, 0xa5, 0xb8, 0xb3, 0x82, 0x89, 0x94, 0x9f, 0xf6, 0xfd, 0xe0, 0xeb, 0xda, 0xd1, 0xcc, 0xc7,
+        0x14, 0x1f, 0x02, 0x09, 0x38, 0x33, 0x2e, 0x25, 0x4c, 0x47, 0x5a, 0x51, 0x60, 0x6b, 0x76, 0x7d,
+        0xa4, 0xaf, 0xb2, 0xb9, 0x88, 0x83, 0x9e, 0x95, 0xfc, 0xf7, 0xea, 0xe1, 0xd0, 0xdb, 0xc6, 0xcd,
+        0xa1, 0xaa, 0xb7, 0xbc, 0x8d, 0x86, 0x9b, 0x90, 0xf9, 0xf2, 0xef, 0xe4, 0xd5, 0xde, 0xc3, 0xc8,
+        0x11, 0x1a, 0x07, 0x0c, 0x3d, 0x36, 0x2b, 0x20, 0x49, 0x42, 0x5f, 0x54, 0x65, 0x6e, 0x73, 0x78,
+    },
+    {
+        0x00, 0x83, 0xd3, 0x50, 0x73, 0xf0, 0xa0, 0x23, 0xe6, 0x65, 0x35, 0xb6, 0x95, 0x16, 0x46, 0xc5,
+        0x19, 0x9a, 0xca, 0x49, 0x6a, 0xe9, 0xb9, 0x3a, 0xff, 0x7c, 0x2c, 0xaf, 0x8c, 0x0f, 0x5f, 0xdc,
+        0x32, 0xb1, 0xe1, 0x62, 0x41, 0xc2, 0x92, 0x11, 0xd4, 0x57, 0x07, 0x84, 0xa7, 0x24, 0x74, 0xf7,
+        0x2b, 0xa8, 0xf8, 0x7b, 0x58, 0xdb, 0x8b, 0x08, 0xcd, 0x4e, 0x1e, 0x9d, 0xbe, 0x3d, 0x6d, 0xee,
+        0x64, 0xe7, 0xb7, 0x34, 0x17, 0x94, 0xc4, 0x47, 0x82, 0x01, 0x51, 0xd2, 0xf1, 0x72, 0x22, 0xa1,
+        0x7d, 0xfe, 0xae, 0x2d, 0x0e, 0x8d, 0xdd, 0x5e, 0x9b, 0x18, 0x48, 0xcb, 0xe8, 0x6b, 0x3b, 0xb8,
+        0x56, 0xd5, 0x85, 0x06, 0x25, 0xa6, 0xf6, 0x75, 0xb0, 0x33, 0x63, 0xe0, 0xc3, 0x40, 0x10, 0x93,
+        0x4f, 0xcc, 0x9c, 0x1f, 0x3c, 0xbf, 0xef, 0x6c, 0xa9, 0x2a, 0x7a, 0xf9, 0xda, 0x59, 0x09, 0x8a,
+        0xc8, 0x4b, 0x1b, 0x98, 0xbb, 0x38, 0x68, 0xeb, 0x2e, 0xad, 0xfd, 0x7e, 0x5d, 0xde, 0x8e, 0x0d,
+        0xd1, 0x52, 0x02, 0x81, 0xa2, 0x21, 0x71, 0xf2, 0x37, 0xb4, 0xe4, 0x67, 0x44, 0xc7, 0x97, 0x14,
+        0xfa, 0x79, 0x29, 0xaa, 0x89, 0x0a, 0x5a, 0xd9, 0x1c, 0x9f, 0xcf, 0x4c, 0x6f, 0xec, 0xbc, 0x3f,
+        0xe3, 0x60, 0x30, 0xb3, 0x90, 0x13, 0x43, 0xc0, 0x05, 0x86, 0xd6, 0x55, 0x76, 0xf5, 0xa5, 0x26,
+        0xac, 0x2f, 0x7f, 0xfc, 0xdf, 0x5c, 0x0c, 0x8f, 0x4a, 0xc9, 0x99, 0x1a, 0x39, 0xba, 0xea, 0x69,
+        0xb5, 0x36, 0x66, 0xe5, 0xc6, 0x45, 0x15, 0x96, 0x53, 0xd0, 0x80, 0x03, 0x20, 0xa3, 0xf3, 0x70,
+        0x9e, 0x1d, 0x4d, 0xce, 0xed, 0x6e, 0x3e, 0xbd, 0x78, 0xfb, 0xab, 0x28, 0x0b, 0x88, 0xd8, 0x5b,
+        0x87, 0x04, 0x54, 0xd7, 0xf4, 0x77, 0x27, 0xa4, 0x61, 0xe2, 0xb2, 0x31, 0x12, 0x91, 0xc1, 0x42,
+    },
+    {
+        0x00, 0x45, 0x8a, 0xcf, 0xc1, 0x84, 0x4b, 0x0e, 0x57, 0x12, 0xdd, 0x98, 0x96, 0xd3, 0x1c, 0x59,
+        0xae, 0xeb, 0x24, 0x61, 0x6f, 0x2a, 0xe5, 0xa0, 0xf9, 0xbc, 0x73, 0x36, 0x38, 0x7d, 0xb2, 0xf7,
+        0x89, 0xcc, 0x03, 0x46, 0x48, 0x0d, 0xc2, 0x87, 0xde, 0x9b, 0x54, 0x11, 0x1f, 0x5a, 0x95, 0xd0,
+        0x27, 0x62, 0xad, 0xe8, 0xe6, 0xa3, 0x6c, 0x29, 0x70, 0x35, 0xfa, 0xbf, 0xb1, 0xf4, 0x3b, 0x7e,
+        0xc7, 0x82, 0x4d, 0x08, 0x06, 0x43, 0x8c, 0xc9, 0x90, 0xd5, 0x1a, 0x5f, 0x51, 0x14, 0xdb, 0x9e,
+        0x69, 0x2c, 0xe3, 0xa6, 0xa8, 0xed, 0x22, 0x67, 0x3e, 0x7b, 0xb4, 0xf1, 0xff, 0xba, 0x75, 0x30,
+        0x4e, 0x0b, 0xc4, 0x81, 0x8f, 0xca, 0x05, 0x40, 0x19, 0x5c, 0x93, 0xd6, 0xd8, 0x9d, 0x52, 0x17,
+        0xe0, 0xa5, 0x6a, 0x2f, 0x21, 0x64, 0xab, 0xee, 0xb7, 0xf2, 0x3d, 0x78, 0x76, 0x33, 0xfc, 0xb9,
+        0x5b, 0x1e, 0xd1, 0x94, 0x9a, 0xdf, 0x10, 0x55, 0x0c, 0x49, 0x86, 0xc3, 0xcd, 0x88, 0x47, 0x02,
+        0xf5, 0xb0, 0x7f, 0x3a, 0x34, 0x71, 0xbe, 0xfb, 0xa2, 0xe7, 0x28, 0x6d, 0x63, 0x26, 0xe9, 0xac,
+        0xd2, 0x97, 0x58, 0x1d, 0x13, 0x56, 0x99, 0xdc, 0x85, 0xc0, 0x0f, 0x4a, 0x44, 0x01, 0xce, 0x8b,
+        0x7c, 0x39, 0xf6, 0xb3, 0xbd, 0xf8, 0x37, 0x72, 0x2b, 0x6e, 0xa1, 0xe4, 0xea, 0xaf, 0x60, 0x25,
+        0x9c, 0xd9, 0x16, 0x53, 0x5d, 0x18, 0xd7, 0x92, 0xcb, 0x8e, 0x41, 0x04, 0x0a, 0x4f, 0x80, 0xc5,
+        0x32, 0x77, 0xb8, 0xfd, 0xf3, 0xb6, 0x79, 0x3c, 0x65, 0x20, 0xef, 0xaa, 0xa4, 0xe1, 0x2e, 0x6b,
+        0x15, 0x50, 0x9f, 0xda, 0xd4, 0x91, 0x5e, 0x1b, 0x42, 0x07, 0xc8, 0x8d, 0x83, 0xc6, 0x09, 0x4c,
+        0xbb, 0xfe, 0x31, 0x74, 0x7a, 0x3f, 0xf0, 0xb5, 0xec, 0xa9, 0x66, 0x23, 0x2d, 0x68, 0xa7, 0xe2,
+    },
+#endif
+#if CRC_TABLE_SLICES >= 8
+    {
+        0x00, 0xb6, 0xb9, 0x0f, 0xa7, 0x11, 0x1e, 0xa8, 0x9b, 0x2d, 0x22, 0x94, 0x3c, 0x8a, 0x85, 0x33,
+        0xe3, 0x55, 0x5a, 0xec, 0x44, 0xf2, 0xfd, 0x4b, 0x78, 0xce, 0xc1, 0x77, 0xdf, 0x69, 0x66, 0xd0,
+        0x13, 0xa5, 0xaa, 0x1c, 0xb4, 0x02, 0x0d, 0xbb, 0x88, 0x3e, 0x31, 0x87, 0x2f, 0x99, 0x96, 0x20,
+        0xf0, 0x46, 0x49, 0xff, 0x57, 0xe1, 0xee, 0x58, 0x6b, 0xdd, 0xd2, 0x64, 0xcc, 0x7a, 0x75, 0xc3,
+        0x26, 0x90, 0x9f, 0x29, 0x81, 0x37, 0x38, 0x8e, 0xbd, 0x0b, 0x04, 0xb2, 0x1a, 0xac, 0xa3, 0x15,
+        0xc5, 0x73, 0x7c, 0xca, 0x62, 0xd4, 0xdb, 0x6d, 0x5e, 0xe8, 0xe7, 0x51, 0xf9, 0x4f, 0x40, 0xf6,
+        0x35, 0x83, 0x8c, 0x3a, 0x92, 0x24, 0x2b, 0x9d, 0xae, 0x18, 0x17, 0xa1, 0x09, 0xbf, 0xb0, 0x06,
+        0xd6, 0x60, 0x6f, 0xd9, 0x71, 0xc7, 0xc8, 0x7e, 0x4d, 0xfb, 0xf4, 0x42, 0xea, 0x5c, 0x53, 0xe5,
+        0x4c, 0xfa, 0xf5, 0x43, 0xeb, 0x5d, 0x52, 0xe4, 0xd7, 0x61, 0x6e, 0xd8, 0x70, 0xc6, 0xc9, 0x7f,
+        0xaf, 0x19, 0x16, 0xa0, 0x08, 0xbe, 0xb1, 0x07, 0x34, 0x82, 0x8d, 0x3b, 0x93, 0x25, 0x2a, 0x9c,
+        0x5f, 0xe9, 0xe6, 0x50, 0xf8, 0x4e, 0x41, 0xf7, 0xc4, 0x72, 0x7d, 0xcb, 0x63, 0xd5, 0xda, 0x6c,
+        0xbc, 0x0a, 0x05, 0xb3, 0x1b, 0xad, 0xa2, 0x14, 0x27, 0x91, 0x9e, 0x28, 0x80, 0x36, 0x39, 0x8f,
+        0x6a, 0xdc, 0xd3, 0x65, 0xcd, 0x7b, 0x74, 0xc2, 0xf1, 0x47, 0x48, 0xfe, 0x56, 0xe0, 0xef, 0x59,
+        0x89, 0x3f, 0x30, 0x86, 0x2e, 0x98, 0x97, 0x21, 0x12, 0xa4, 0xab, 0x1d, 0xb5, 0x03, 0x0c, 0xba,
+        0x79, 0xcf, 0xc0, 0x76, 0xde, 0x68, 0x67, 0xd1, 0xe2, 0x54, 0x5b, 0xed, 0x45, 0xf3, 0xfc, 0x4a,
+        0x9a, 0x2c, 0x23, 0x95, 0x3d, 0x8b, 0x84, 0x32, 0x01, 0xb7, 0xb8, 0x0e, 0xa6, 0x10, 0x1f, 0xa9,
+    },
+    {
+        0x00, 0x98, 0xe5, 0x7d, 0x1f, 0x87, 0xfa, 0x62, 0x3e, 0xa6, 0xdb, 0x43, 0x21, 0xb9, 0xc4, 0x5c,
+        0x7c, 0xe4, 0x99, 0x01, 0x63, 0xfb, 0x86, 0x1e, 0x42, 0xda, 0xa7, 0x3f, 0x5d, 0xc5, 0xb8, 0x20,
+        0xf8, 0x60, 0x1d, 0x85, 0xe7, 0x7f, 0x02, 0x9a, 0xc6, 0x5e, 0x23, 0xbb, 0xd9, 0x41, 0x3c, 0xa4,
+        0x84, 0x1c, 0x61, 0xf9, 0x9b, 0x03, 0x7e, 0xe6, 0xba, 0x22, 0x5f, 0xc7, 0xa5, 0x3d, 0x40, 0xd8,
+        0x25, 0xbd, 0xc0, 0x58, 0x3a, 0xa2, 0xdf, 0x47, 0x1b, 0x83, 0xfe, 0x66, 0x04, 0x9c, 0xe1, 0x79,
+        0x59, 0xc1, 0xbc, 0x24, 0x46, 0xde, 0xa3, 0x3b, 0x67, 0xff, 0x82, 0x1a, 0x78, 0xe0, 0x9d, 0x05,
+        0xdd, 0x45, 0x38, 0xa0, 0xc2, 0x5a, 0x27, 0xbf, 0xe3, 0x7b, 0x06, 0x9e, 0xfc, 0x64, 0x19, 0x81,
+        0xa1, 0x39, 0x44, 0xdc, 0xbe, 0x26, 0x5b, 0xc3, 0x9f, 0x07, 0x7a, 0xe2, 0x80, 0x18, 0x65, 0xfd,
+        0x4a, 0xd2, 0xaf, 0x37, 0x55, 0xcd, 0xb0, 0x28, 0x74, 0xec, 0x91, 0x09, 0x6b, 0xf3, 0x8e, 0x16,
+        0x36, 0xae, 0xd3, 0x4b, 0x29, 0xb1, 0xcc, 0x54, 0x08, 0x90, 0xed, 0x75, 0x17, 0x8f, 0xf2, 0x6a,
+        0xb2, 0x2a, 0x57, 0xcf, 0xad, 0x35, 0x48, 0xd0, 0x8c, 0x14, 0x69, 0xf1, 0x93, 0x0b, 0x76, 0xee,
+        0xce, 0x56, 0x2b, 0xb3, 0xd1, 0x49, 0x34, 0xac, 0xf0, 0x68, 0x15, 0x8d, 0xef, 0x77, 0x0a, 0x92,
+        0x6f, 0xf7, 0x8a, 0x12, 0x70, 0xe8, 0x95, 0x0d, 0x51, 0xc9, 0xb4, 0x2c, 0x4e, 0xd6, 0xab, 0x33,
+        0x13, 0x8b, 0xf6, 0x6e, 0x0c, 0x94, 0xe9, 0x71, 0x2d, 0xb5, 0xc8, 0x50, 0x32, 0xaa, 0xd7, 0x4f,
+        0x97, 0x0f, 0x72, 0xea, 0x88, 0x10, 0x6d, 0xf5, 0xa9, 0x31, 0x4c, 0xd4, 0xb6, 0x2e, 0x53, 0xcb,
+        0xeb, 0x73, 0x0e, 0x96, 0xf4, 0x6c, 0x11, 0x89, 0xd5, 0x4d, 0x30, 0xa8, 0xca, 0x52, 0x2f, 0xb7,
+    },
+    {
+        0x00, 0x94, 0xfd, 0x69, 0x2f, 0xbb, 0xd2, 0x46, 0x5e, 0xca, 0xa3, 0x37, 0x71, 0xe5, 0x8c, 0x18,
+        0xbc, 0x28, 0x41, 0xd5, 0x93, 0x07, 0x6e, 0xfa, 0xe2, 0x76, 0x1f, 0x8b, 0xcd, 0x59, 0x30, 0xa4,
+        0xad, 0x39, 0x50, 0xc4, 0x82, 0x16, 0x7f, 0xeb, 0xf3, 0x67, 0x0e, 0x9a, 0xdc, 0x48, 0x21, 0xb5,
+        0x11, 0x85, 0xec, 0x78, 0x3e, 0xaa, 0xc3, 0x57, 0x4f, 0xdb, 0xb2, 0x26, 0x60, 0xf4, 0x9d, 0x09,
+        0x8f, 0x1b, 0x72, 0xe6, 0xa0, 0x34, 0x5d, 0xc9, 0xd1, 0x45, 0x2c, 0xb8, 0xfe, 0x6a, 0x03, 0x97,
+        0x33, 0xa7, 0xce, 0x5a, 0x1c, 0x88, 0xe1, 0x75, 0x6d, 0xf9, 0x90, 0x04, 0x42, 0xd6, 0xbf, 0x2b,
+        0x22, 0xb6, 0xdf, 0x4b, 0x0d, 0x99, 0xf0, 0x64, 0x7c, 0xe8, 0x81, 0x15, 0x53, 0xc7, 0xae, 0x3a,
+        0x9e, 0x0a, 0x63, 0xf7, 0xb1, 0x25, 0x4c, 0xd8, 0xc0, 0x54, 0x3d, 0xa9, 0xef, 0x7b, 0x12, 0x86,
+        0xcb, 0x5f, 0x36, 0xa2, 0xe4, 0x70, 0x19, 0x8d, 0x95, 0x01, 0x68, 0xfc, 0xba, 0x2e, 0x47, 0xd3,
+        0x77, 0xe3, 0x8a, 0x1e, 0x58, 0xcc, 0xa5, 0x31, 0x29, 0xbd, 0xd4, 0x40, 0x06, 0x92, 0xfb, 0x6f,
+        0x66, 0xf2, 0x9b, 0x0f, 0x49, 0xdd, 0xb4, 0x20, 0x38, 0xac, 0xc5, 0x51, 0x17, 0x83, 0xea, 0x7e,
+        0xda, 0x4e, 0x27, 0xb3, 0xf5, 0x61, 0x08, 0x9c, 0x84, 0x10, 0x79, 0xed, 0xab, 0x3f, 0x56, 0xc2,
+        0x44, 0xd0, 0xb9, 0x2d, 0x6b, 0xff, 0x96, 0x02, 0x1a, 0x8e, 0xe7, 0x73, 0x35, 0xa1, 0xc8, 0x5c,
+        0xf8, 0x6c, 0x05, 0x91, 0xd7, 0x43, 0x2a, 0xbe, 0xa6, 0x32, 0x5b, 0xcf, 0x89, 0x1d, 0x74, 0xe0,
+        0xe9, 0x7d, 0x14, 0x80, 0xc6, 0x52, 0x3b, 0xaf, 0xb7, 0x23, 0x4a, 0xde, 0x98, 0x0c, 0x65, 0xf1,
+        0x55, 0xc1, 0xa8, 0x3c, 0x7a, 0xee, 0x87, 0x13, 0x0b, 0x9f, 0xf6, 0x62, 0x24, 0xb0, 0xd9, 0x4d,
+    },
+    {
+        0x00, 0x43, 0x86, 0xc5, 0xd9, 0x9a, 0x5f, 0x1c, 0x67, 0x24, 0xe1, 0xa2, 0xbe, 0xfd, 0x38, 0x7b,
+        0xce, 0x8d, 0x48, 0x0b, 0x17, 0x54, 0x91, 0xd2, 0xa9, 0xea, 0x2f, 0x6c, 0x70, 0x33, 0xf6, 0xb5,
+        0x49, 0x0a, 0xcf, 0x8c, 0x90, 0xd3, 0x16, 0x55, 0x2e, 0x6d, 0xa8, 0xeb, 0xf7, 0xb4, 0x71, 0x32,
+        0x87, 0xc4, 0x01, 0x42, 0x5e, 0x1d, 0xd8, 0x9b, 0xe0, 0xa3, 0x66, 0x25, 0x39, 0x7a, 0xbf, 0xfc,
+        0x92, 0xd1, 0x14, 0x57, 0x4b, 0x08, 0xcd, 0x8e, 0xf5, 0xb6, 0x73, 0x30, 0x2c, 0x6f, 0xaa, 0xe9,
+        0x5c, 0x1f, 0xda, 0x99, 0x85, 0xc6, 0x03, 0x40, 0x3b, 0x78, 0xbd, 0xfe, 0xe2, 0xa1, 0x64, 0x27,
+        0xdb, 0x98, 0x5d, 0x1e, 0x02, 0x41, 0x84, 0xc7, 0xbc, 0xff, 0x3a, 0x79, 0x65, 0x26, 0xe3, 0xa0,
+        0x15, 0x56, 0x93, 0xd0, 0xcc, 0x8f, 0x4a, 0x09, 0x72, 0x31, 0xf4, 0xb7, 0xab, 0xe8, 0x2d, 0x6e,
+        0xf1, 0xb2, 0x77, 0x34, 0x28, 0x6b, 0xae, 0xed, 0x96, 0xd5, 0x10, 0x53, 0x4f, 0x0c, 0xc9, 0x8a,
+        0x3f, 0x7c, 0xb9, 0xfa, 0xe6, 0xa5, 0x60, 0x23, 0x58, 0x1b, 0xde, 0x9d, 0x81, 0xc2, 0x07, 0x44,
+        0xb8, 0xfb, 0x3e, 0x7d, 0x61, 0x22, 0xe7, 0xa4, 0xdf, 0x9c, 0x59, 0x1a, 0x06, 0x45, 0x80, 0xc3,
+        0x76, 0x35, 0xf0, 0xb3, 0xaf, 0xec, 0x29, 0x6a, 0x11, 0x52, 0x97, 0xd4, 0xc8, 0x8b, 0x4e, 0x0d,
+        0x63, 0x20, 0xe5, 0xa6, 0xba, 0xf9, 0x3c, 0x7f, 0x04, 0x47, 0x82, 0xc1, 0xdd, 0x9e, 0x5b, 0x18,
+        0xad, 0xee, 0x2b, 0x68, 0x74, 0x37, 0xf2, 0xb1, 0xca, 0x89, 0x4c, 0x0f, 0x13, 0x50, 0x95, 0xd6,
+        0x2a, 0x69, 0xac, 0xef, 0xf3, 0xb0, 0x75, 0x36, 0x4d, 0x0e, 0xcb, 0x88, 0x94, 0xd7, 0x12, 0x51,
+        0xe4, 0xa7, 0x62, 0x21, 0x3d, 0x7e, 0xbb, 0xf8, 0x83, 0xc0, 0x05, 0x46, 0x5a, 0x19, 0xdc, 0x9f,
+    },
+#endif
+};
+
+static const uint8_t crc8Poly0xbaTable[CRC_TABLE_SLICES][256] = {
+    {
+        0x00, 0xba, 0xce, 0x74, 0x26, 0x9c, 0xe8, 0x52, 0x4c, 0xf6, 0x82, 0x38, 0x6a, 0xd0, 0xa4, 0x1e,
+        0x98, 0x22, 0x56, 0xec, 0xbe, 0x04, 0x70, 0xca, 0xd4, 0x6e, 0x1a, 0xa0, 0xf2, 0x48, 0x3c, 0x86,
+        0x8a, 0x30, 0x44, 0xfe, 0xac, 0x16, 0x62, 0xd8, 0xc6, 0x7c, 0x08, 0xb2, 0xe0, 0x5a, 0x2e, 0x94,
+        0x12, 0xa8, 0xdc, 0x66, 0x34, 0x8e, 0xfa, 0x40, 0x5e, 0xe4, 0x90, 0x2a, 0x78, 0xc2, 0xb6, 0x0c,
+        0xae, 0x14, 0x60, 0xda, 0x88, 0x32, 0x46, 0xfc, 0xe2, 0x58, 0x2c, 0x96, 0xc4, 0x7e, 0x0a, 0xb0,
+        0x36, 0x8c, 0xf8, 0x42, 0x10, 0xaa, 0xde, 0x64, 0x7a, 0xc0, 0xb4, 0x0e, 0x5c, 0xe6, 0x92, 0x28,
+        0x24, 0x9e, 0xea, 0x50, 0x02, 0xb8, 0xcc, 0x76, 0x68, 0xd2, 0xa6, 0x1c, 0x4e, 0xf4, 0x80, 0x3a,
+        0xbc, 0x06, 0x72, 0xc8, 0x9a, 0x20, 0x54, 0xee, 0xf0, 0x4a, 0x3e, 0x84, 0xd6, 0x6c, 0x18, 0xa2,
+        0xe6, 0x5c, 0x28, 0x92, 0xc0, 0x7a, 0x0e, 0xb4, 0xaa, 0x10, 0x64, 0xde, 0x8c, 0x36, 0x42, 0xf8,
+        0x7e, 0xc4, 0xb0, 0x0a, 0x58, 0xe2, 0x96, 0x2c, 0x32, 0x88, 0xfc, 0x46, 0x14, 0xae, 0xda, 0x60,
+        0x6c, 0xd6, 0xa2, 0x18, 0x4a, 0xf0, 0x84, 0x3e, 0x20, 0x9a, 0xee, 0x54, 0x06, 0xbc, 0xc8, 0x72,
+        0xf4, 0x4e, 0x3a, 0x80, 0xd2, 0x68, 0x1c, 0xa6, 0xb8, 0x02, 0x76, 0xcc, 0x9e, 0x24, 0x50, 0xea,
+        0x48, 0xf2, 0x86, 0x3c, 0x6e, 0xd4, 0xa0, 0x1a, 0x04, 0xbe, 0xca, 0x70, 0x22, 0x98, 0xec, 0x56,
+        0xd0, 0x6a, 0x1e, 0xa4, 0xf6, 0x4c, 0x38, 0x82, 0x9c, 0x26, 0x52, 0xe8, 0xba, 0x00, 0x74, 0xce,
+        0xc2, 0x78, 0x0c, 0xb6, 0xe4, 0x5e, 0x2a, 0x90, 0x8e, 0x34, 0x40, 0xfa, 0xa8, 0x12, 0x66, 0xdc,
+        0x5a, 0xe0, 0x94, 0x2e, 0x7c, 0xc6, 0xb2, 0x08, 0x16, 0xac, 0xd8, 0x62, 0x30, 0x8a, 0xfe, 0x44,
+    },
+#if CRC_TABLE_SLICES >= 4
+    {
+        0x00, 0x76, 0xec, 0x9a, 0x62, 0x14, 0x8e, 0xf8, 0xc4, 0xb2, 0x28, 0x5e, 0xa6, 0xd0, 0x4a, 0x3c,
+        0x32, 0x44, 0xde, 0xa8, 0x50, 0x26, 0xbc, 0xca, 0xf6, 0x80, 0x1a, 0x6c, 0x94, 0xe2, 0x78, 0x0e,
+        0x64, 0x12, 0x88, 0xfe, 0x06, 0x70, 0xea, 0x9c, 0xa0, 0xd6, 0x4c, 0x3a, 0xc2, 0xb4, 0x2e, 0x58,
+        0x56, 0x20, 0xba, 0xcc, 0x34, 0x42, 0xd8, 0xae, 0x92, 0xe4, 0x7e, 0x08, 0xf0, 0x86, 0x1c, 0x6a,
+        0xc8, 0xbe, 0x24, 0x52, 0xaa, 0xdc, 0x46, 0x30, 0x0c, 0x7a, 0xe0, 0x96, 0x6e, 0x18, 0x82, 0xf4,
+        0xfa, 0x8c, 0x16, 0x60, 0x98, 0xee, 0x74, 0x02, 0x3e, 0x48, 0xd2, 0xa4, 0x5c, 0x2a, 0xb0, 0xc6,
+        0xac, 0xda, 0x40, 0x36, 0xce, 0xb8, 0x22, 0x54, 0x68, 0x1e, 0x84, 0xf2, 0x0a, 0x7c, 0xe6, 0x90,
+        0x9e, 0xe8, 0x72, 0x04, 0xfc, 0x8a, 0x10, 0x66, 0x5a, 0x2c, 0xb6, 0xc0, 0x38, 0x4e, 0xd4, 0xa2,
+        0x2a, 0x5c, 0xc6, 0xb0, 0x48, 0x3e, 0xa4, 0xd2, 0xee, 0x98, 0x02, 0x74, 0x8c, 0xfa, 0x60, 0x16,
+        0x18, 0x6e, 0xf4, 0x82, 0x7a, 0x0c, 0x96, 0xe0, 0xdc, 0xaa, 0x30, 0x46, 0xbe, 0xc8, 0x52, 0x24,
+        0x4e, 0x38, 0xa2, 0xd4, 0x2c, 0x5a, 0xc0, 0xb6, 0x8a, 0xfc, 0x66, 0x10, 0xe8, 0x9e, 0x04, 0x72,
+        0x7c, 0x0a, 0x90, 0xe6, 0x1e, 0x68, 0xf2, 0x84, 0xb8, 0xce, 0x54, 0x22, 0xda, 0xac, 0x36, 0x40,
+        0xe2, 0x94, 0x0e, 0x78, 0x80, 0xf6, 0x6c, 0x1a, 0x26, 0x50, 0xca, 0xbc, 0x44, 0x32, 0xa8, 0xde,
+        0xd0, 0xa6, 0x3c, 0x4a, 0xb2, 0xc4, 0x5e, 0x28, 0x14, 0x62, 0xf8, 0x8e, 0x76, 0x00, 0x9a, 0xec,
+        0x86, 0xf0, 0x6a, 0x1c, 0xe4, 0x92, 0x08, 0x7e, 0x42, 0x34, 0xae, 0xd8, 0x20, 0x56, 0xcc, 0xba,
+        0xb4, 0xc2, 0x58, 0x2e, 0xd6, 0xa0, 0x3a, 0x4c, 0x70, 0x06, 0x9c, 0xea, 0x12, 0x64, 0xfe, 0x88,
+    },
+    {
+        0x00, 0x54, 0xa8, 0xfc, 0xea, 0xbe, 0x42, 0x16, 0x6e, 0x3a, 0xc6, 0x92, 0x84, 0xd0, 0x2c, 0x78,
+        0xdc, 0x88, 0x74, 0x20, 0x36, 0x62, 0x9e, 0xca, 0xb2, 0xe6, 0x1a, 0x4e, 0x58, 0x0c, 0xf0, 0xa4,
+        0x02, 0x56, 0xaa, 0xfe, 0xe8, 0xbc, 0x40, 0x14, 0x6c, 0x38, 0xc4, 0x90, 0x86, 0xd2, 0x2e, 0x7a,
+        0xde, 0x8a, 0x76, 0x22, 0x34, 0x60, 0x9c, 0xc8, 0xb0, 0xe4, 0x18, 0x4c, 0x5a, 0x0e, 0xf2, 0xa6,
+        0x04, 0x50, 0xac, 0xf8, 0xee, 0xba, 0x46, 0x12, 0x6a, 0x3e, 0xc2, 0x96, 0x80, 0xd4, 0x28, 0x7c,
+        0xd8, 0x8c, 0x70, 0x24, 0x32, 0x66, 0x9a, 0xce, 0xb6, 0xe2, 0x1e, 0x4a, 0x5c, 0x08, 0xf4, 0xa0,
+        0x06, 0x52, 0xae, 0xfa, 0xec, 0xb8, 0x44, 0x10, 0x68, 0x3c, 0xc0, 0x94, 0x82, 0xd6, 0x2a, 0x7e,
+        0xda, 0x8e, 0x72, 0x26, 0x30, 0x64, 0x98, 0xcc, 0xb4, 0xe0, 0x1c, 0x48, 0x5e, 0x0a, 0xf6, 0xa2,
+        0x08, 0x5c, 0xa0, 0xf4, 0xe2, 0xb6, 0x4a, 0x1e, 0x66, 0x32, 0xce, 0x9a, 0x8c, 0xd8, 0x24, 0x70,
+        0xd4, 0x80, 0x7c, 0x28, 0x3e, 0x6a, 0x96, 0xc2, 0xba, 0xee, 0x12, 0x46, 0x50, 0x04, 0xf8, 0xac,
+        0x0a, 0x5e, 0xa2, 0xf6, 0xe0, 0xb4, 0x48, 0x1c, 0x64, 0x30, 0xcc, 0x98, 0x8e, 0xda, 0x26, 0x72,
+        0xd6, 0x82, 0x7e, 0x2a, 0x3c, 0x68, 0x94, 0xc0, 0xb8, 0xec, 0x10, 0x44, 0x52, 0x06, 0xfa, 0xae,
+        0x0c, 0x58, 0xa4, 0xf0, 0xe6, 0xb2, 0x4e, 0x1a, 0x62, 0x36, 0xca, 0x9e, 0x88, 0xdc, 0x20, 0x74,
+        0xd0, 0x84, 0x78, 0x2c, 0x3a, 0x6e, 0x92, 0xc6, 0xbe, 0xea, 0x16, 0x42, 0x54, 0x00, 0xfc, 0xa8,
+        0x0e, 0x5a, 0xa6, 0xf2, 0xe4, 0xb0, 0x4c, 0x18, 0x60, 0x34, 0xc8, 0x9c, 0x8a, 0xde, 0x22, 0x76,
+        0xd2, 0x86, 0x7a, 0x2e, 0x38, 0x6c, 0x90, 0xc4, 0xbc, 0xe8, 0x14, 0x40, 0x56, 0x02, 0xfe, 0xaa,
+    },
+    {
+        0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80, 0x90, 0xa0, 0xb0, 0xc0, 0xd0, 0xe0, 0xf0,
+        0xba, 0xaa, 0x9a, 0x8a, 0xfa, 0xea, 0xda, 0xca, 0x3a, 0x2a, 0x1a, 0x0a, 0x7a, 0x6a, 0x5a, 0x4a,
+        0xce, 0xde, 0xee, 0xfe, 0x8e, 0x9e, 0xae, 0xbe, 0x4e, 0x5e, 0x6e, 0x7e, 0x0e, 0x1e, 0x2e, 0x3e,
+        0x74, 0x64, 0x54, 0x44, 0x34, 0x24, 0x14, 0x04, 0xf4, 0xe4, 0xd4, 0xc4, 0xb4, 0xa4, 0x94, 0x84,
+        0x26, 0x36, 0x06, 0x16, 0x66, 0x76, 0x46, 0x56, 0xa6, 0xb6, 0x86, 0x96, 0xe6, 0xf6, 0xc6, 0xd6,
+        0x9c, 0x8c, 0xbc, 0xac, 0xdc, 0xcc, 0xfc, 0xec, 0x1c, 0x0c, 0x3c, 0x2c, 0x5c, 0x4c, 0x7c, 0x6c,
+        0xe8, 0xf8, 0xc8, 0xd8, 0xa8, 0xb8, 0x88, 0x98, 0x68, 0x78, 0x48, 0x58, 0x28, 0x38, 0x08, 0x18,
+        0x52, 0x42, 0x72, 0x62, 0x12, 0x02, 0x32, 0x22, 0xd2, 0xc2, 0xf2, 0xe2, 0x92, 0x82, 0xb2, 0xa2,
+        0x4c, 0x5c, 0x6c, 0x7c, 0x0c, 0x1c, 0x2c, 0x3c, 0xcc, 0xdc, 0xec, 0xfc, 0x8c, 0x9c, 0xac, 0xbc,
+        0xf6, 0xe6, 0xd6, 0xc6, 0xb6, 0xa6, 0x96, 0x86, 0x76, 0x66, 0x56, 0x46, 0x36, 0x26, 0x16, 0x06,
+        0x82, 0x92, 0xa2, 0xb2, 0xc2, 0xd2, 0xe2, 0xf2, 0x02, 0x12, 0x22, 0x32, 0x42, 0x52, 0x62, 0x72,
+        0x38, 0x28, 0x18, 0x08, 0x78, 0x68, 0x58, 0x48, 0xb8, 0xa8, 0x98, 0x88, 0xf8, 0xe8, 0xd8, 0xc8,
+        0x6a, 0x7a, 0x4a, 0x5a, 0x2a, 0x3a, 0x0a, 0x1a, 0xea, 0xfa, 0xca, 0xda, 0xaa, 0xba, 0x8a, 0x9a,
+        0xd0, 0xc0, 0xf0, 0xe0, 0x90, 0x80, 0xb0, 0xa0, 0x50, 0x40, 0x70, 0x60, 0x10, 0x00, 0x30, 0x20,
+        0xa4, 0xb4, 0x84, 0x94, 0xe4, 0xf4, 0xc4, 0xd4, 0x24, 0x34, 0x04, 0x14, 0x64, 0x74, 0x44, 0x54,
+        0x1e, 0x0e, 0x3e, 0x2e, 0x5e, 0x4e, 0x7e, 0x6e, 0x9e, 0x8e, 0xbe, 0xae, 0xde, 0xce, 0xfe, 0xee,
+    },
+#endif
+#if CRC_TABLE_SLICES >= 8
+    {
+        0x00, 0x98, 0x8a, 0x12, 0xae, 0x36, 0x24, 0xbc, 0xe6, 0x7e, 0x6c, 0xf4, 0x48, 0xd0, 0xc2, 0x5a,
+        0x76, 0xee, 0xfc, 0x64, 0xd8, 0x40, 0x52, 0xca, 0x90, 0x08, 0x1a, 0x82, 0x3e, 0xa6, 0xb4, 0x2c,
+        0xec, 0x74, 0x66, 0xfe, 0x42, 0xda, 0xc8, 0x50, 0x0a, 0x92, 0x80, 0x18, 0xa4, 0x3c, 0x2e, 0xb6,
+        0x9a, 0x02, 0x10, 0x88, 0x34, 0xac, 0xbe, 0x26, 0x7c, 0xe4, 0xf6, 0x6e, 0xd2, 0x4a, 0x58, 0xc0,
+        0x62, 0xfa, 0xe8, 0x70, 0xcc, 0x54, 0x46, 0xde, 0x84, 0x1c, 0x0e, 0x96, 0x2a, 0xb2, 0xa0, 0x38,
+        0x14, 0x8c, 0x9e, 0x06, 0xba, 0x22, 0x30, 0xa8, 0xf2, 0x6a, 0x78, 0xe0, 0x5c, 0xc4, 0xd6, 0x4e,
+        0x8e, 0x16, 0x04, 0x9c, 0x20, 0xb8, 0xaa, 0x32, 0x68, 0xf0, 0xe2, 0x7a, 0xc6, 0x5e, 0x4c, 0xd4,
+        0xf8, 0x60, 0x72, 0xea, 0x56, 0xce, 0xdc, 0x44, 0x1e, 0x86, 0x94, 0x0c, 0xb0, 0x28, 0x3a, 0xa2,
+        0xc4, 0x5c, 0x4e, 0xd6, 0x6a, 0xf2, 0xe0, 0x78, 0x22, 0xba, 0xa8, 0x30, 0x8c, 0x14, 0x06, 0x9e,
+        0xb2, 0x2a, 0x38, 0xa0, 0x1c, 0x84, 0x96, 0x0e, 0x54, 0xcc, 0xde, 0x46, 0xfa, 0x62, 0x70, 0xe8,
+        0x28, 0xb0, 0xa2, 0x3a, 0x86, 0x1e, 0x0c, 0x94, 0xce, 0x56, 0x44, 0xdc, 0x60, 0xf8, 0xea, 0x72,
+        0x5e, 0xc6, 0xd4, 0x4c, 0xf0, 0x68, 0x7a, 0xe2, 0xb8, 0x20, 0x32, 0xaa, 0x16, 0x8e, 0x9c, 0x04,
+        0xa6, 0x3e, 0x2c, 0xb4, 0x08, 0x90, 0x82, 0x1a, 0x40, 0xd8, 0xca, 0x52, 0xee, 0x76, 0x64, 0xfc,
+        0xd0, 0x48, 0x5a, 0xc2, 0x7e, 0xe6, 0xf4, 0x6c, 0x36, 0xae, 0xbc, 0x24, 0x98, 0x00, 0x12, 0x8a,
+        0x4a, 0xd2, 0xc0, 0x58, 0xe4, 0x7c, 0x6e, 0xf6, 0xac, 0x34, 0x26, 0xbe, 0x02, 0x9a, 0x88, 0x10,
+        0x3c, 0xa4, 0xb6, 0x2e, 0x92, 0x0a, 0x18, 0x80, 0xda, 0x42, 0x50, 0xc8, 0x74, 0xec, 0xfe, 0x66,
+    },
+    {
+        0x00, 0x32, 0x64, 0x56, 0xc8, 0xfa, 0xac, 0x9e, 0x2a, 0x18, 0x4e, 0x7c, 0xe2, 0xd0, 0x86, 0xb4,
+        0x54, 0x66, 0x30, 0x02, 0x9c, 0xae, 0xf8, 0xca, 0x7e, 0x4c, 0x1a, 0x28, 0xb6, 0x84, 0xd2, 0xe0,
+        0xa8, 0x9a, 0xcc, 0xfe, 0x60, 0x52, 0x04, 0x36, 0x82, 0xb0, 0xe6, 0xd4, 0x4a, 0x78, 0x2e, 0x1c,
+        0xfc, 0xce, 0x98, 0xaa, 0x34, 0x06, 0x50, 0x62, 0xd6, 0xe4, 0xb2, 0x80, 0x1e, 0x2c, 0x7a, 0x48,
+        0xea, 0xd8, 0x8e, 0xbc, 0x22, 0x10, 0x46, 0x74, 0xc0, 0xf2, 0xa4, 0x96, 0x08, 0x3a, 0x6c, 0x5e,
+        0xbe, 0x8c, 0xda, 0xe8, 0x76, 0x44, 0x12, 0x20, 0x94, 0xa6, 0xf0, 0xc2, 0x5c, 0x6e, 0x38, 0x0a,
+        0x42, 0x70, 0x26, 0x14, 0x8a, 0xb8, 0xee, 0xdc, 0x68, 0x5a, 0x0c, 0x3e, 0xa0, 0x92, 0xc4, 0xf6,
+        0x16, 0x24, 0x72, 0x40, 0xde, 0xec, 0xba, 0x88, 0x3c, 0x0e, 0x58, 0x6a, 0xf4, 0xc6, 0x90, 0xa2,
+        0x6e, 0x5c, 0x0a, 0x38, 0xa6, 0x94, 0xc2, 0xf0, 0x44, 0x76, 0x20, 0x12, 0x8c, 0xbe, 0xe8, 0xda,
+        0x3a, 0x08, 0x5e, 0x6c, 0xf2, 0xc0, 0x96, 0xa4, 0x10, 0x22, 0x74, 0x46, 0xd8, 0xea, 0xbc, 0x8e,
+        0xc6, 0xf4, 0xa2, 0x90, 0x0e, 0x3c, 0x6a, 0x58, 0xec, 0xde, 0x88, 0xba, 0x24, 0x16, 0x40, 0x72,
+        0x92, 0xa0, 0xf6, 0xc4, 0x5a, 0x68, 0x3e, 0x0c, 0xb8, 0x8a, 0xdc, 0xee, 0x70, 0x42, 0x14, 0x26,
+        0x84, 0xb6, 0xe0, 0xd2, 0x4c, 0x7e, 0x28, 0x1a, 0xae, 0x9c, 0xca, 0xf8, 0x66, 0x54, 0x02, 0x30,
+        0xd0, 0xe2, 0xb4, 0x86, 0x18, 0x2a, 0x7c, 0x4e, 0xfa, 0xc8, 0x9e, 0xac, 0x32, 0x00, 0x56, 0x64,
+        0x2c, 0x1e, 0x48, 0x7a, 0xe4, 0xd6, 0x80, 0xb2, 0x06, 0x34, 0x62, 0x50, 0xce, 0xfc, 0xaa, 0x98,
+        0x78, 0x4a, 0x1c, 0x2e, 0xb0, 0x82, 0xd4, 0xe6, 0x52, 0x60, 0x36, 0x04, 0x9a, 0xa8, 0xfe, 0xcc,
+    },
+    {
+        0x00, 0xdc, 0x02, 0xde, 0x04, 0xd8, 0x06, 0xda, 0x08, 0xd4, 0x0a, 0xd6, 0x0c, 0xd0, 0x0e, 0xd2,
+        0x10, 0xcc, 0x12, 0xce, 0x14, 0xc8, 0x16, 0xca, 0x18, 0xc4, 0x1a, 0xc6, 0x1c, 0xc0, 0x1e, 0xc2,
+        0x20, 0xfc, 0x22, 0xfe, 0x24, 0xf8, 0x26, 0xfa, 0x28, 0xf4, 0x2a, 0xf6, 0x2c, 0xf0, 0x2e, 0xf2,
+        0x30, 0xec, 0x32, 0xee, 0x34, 0xe8, 0x36, 0xea, 0x38, 0xe4, 0x3a, 0xe6, 0x3c, 0xe0, 0x3e, 0xe2,
+        0x40, 0x9c, 0x42, 0x9e, 0x44, 0x98, 0x46, 0x9a, 0x48, 0x94, 0x4a, 0x96, 0x4c, 0x90, 0x4e, 0x92,
+        0x50, 0x8c, 0x52, 0x8e, 0x54, 0x88, 0x56, 0x8a, 0x58, 0x84, 0x5a, 0x86, 0x5c, 0x80, 0x5e, 0x82,
+        0x60, 0xbc, 0x62, 0xbe, 0x64, 0xb8, 0x66, 0xba, 0x68, 0xb4, 0x6a, 0xb6, 0x6c, 0xb0, 0x6e, 0xb2,
+        0x70, 0xac, 0x72, 0xae, 0x74, 0xa8, 0x76, 0xaa, 0x78, 0xa4, 0x7a, 0xa6, 0x7c, 0xa0, 0x7e, 0xa2,
+        0x80, 0x5c, 0x82, 0x5e, 0x84, 0x58, 0x86, 0x5a, 0x88, 0x54, 0x8a, 0x56, 0x8c, 0x50, 0x8e, 0x52,
+        0x90, 0x4c, 0x92, 0x4e, 0x94, 0x48, 0x96, 0x4a, 0x98, 0x44, 0x9a, 0x46, 0x9c, 0x40, 0x9e, 0x42,
+        0xa0, 0x7c, 0xa2, 0x7e, 0xa4, 0x78, 0xa6, 0x7a, 0xa8, 0x74, 0xaa, 0x76, 0xac, 0x70, 0xae, 0x72,
+        0xb0, 0x6c, 0xb2, 0x6e, 0xb4, 0x68, 0xb6, 0x6a, 0xb8, 0x64, 0xba, 0x66, 0xbc, 0x60, 0xbe, 0x62,
+        0xc0, 0x1c, 0xc2, 0x1e, 0xc4, 0x18, 0xc6, 0x1a, 0xc8, 0x14, 0xca, 0x16, 0xcc, 0x10, 0xce, 0x12,
+        0xd0, 0x0c, 0xd2, 0x0e, 0xd4, 0x08, 0xd6, 0x0a, 0xd8, 0x04, 0xda, 0x06, 0xdc, 0x00, 0xde, 0x02,
+        0xe0, 0x3c, 0xe2, 0x3e, 0xe4, 0x38, 0xe6, 0x3a, 0xe8, 0x34, 0xea, 0x36, 0xec, 0x30, 0xee, 0x32,
+        0xf0, 0x2c, 0xf2, 0x2e, 0xf4, 0x28, 0xf6, 0x2a, 0xf8, 0x24, 0xfa, 0x26, 0xfc, 0x20, 0xfe, 0x22,
+    },
+    {
+        0x00, 0xba, 0xce, 0x74, 0x26, 0x9c, 0xe8, 0x52, 0x4c, 0xf6, 0x82, 0x38, 0x6a, 0xd0, 0xa4, 0x1e,
+        0x98, 0x22, 0x56, 0xec, 0xbe, 0x04, 0x70, 0xca, 0xd4, 0x6e, 0x1a, 0xa0, 0xf2, 0x48, 0x3c, 0x86,
+        0x8a, 0x30, 0x44, 0xfe, 0xac, 0x16, 0x62, 0xd8, 0xc6, 0x7c, 0x08, 0xb2, 0xe0, 0x5a, 0x2e, 0x94,
+        0x12, 0xa8, 0xdc, 0x66, 0x34, 0x8e, 0xfa, 0x40, 0x5e, 0xe4, 0x90, 0x2a, 0x78, 0xc2, 0xb6, 0x0c,
+        0xae, 0x14, 0x60, 0xda, 0x88, 0x32, 0x46, 0xfc, 0xe2, 0x58, 0x2c, 0x96, 0xc4, 0x7e, 0x0a, 0xb0,
+        0x36, 0x8c, 0xf8, 0x42, 0x10, 0xaa, 0xde, 0x64, 0x7a, 0xc0, 0xb4, 0x0e, 0x5c, 0xe6, 0x92, 0x28,
+        0x24, 0x9e, 0xea, 0x50, 0x02, 0xb8, 0xcc, 0x76, 0x68, 0xd2, 0xa6, 0x1c, 0x4e, 0xf4, 0x80, 0x3a,
+        0xbc, 0x06, 0x72, 0xc8, 0x9a, 0x20, 0x54, 0xee, 0xf0, 0x4a, 0x3e, 0x84, 0xd6, 0x6c, 0x18, 0xa2,
+        0xe6, 0x5c, 0x28, 0x92, 0xc0, 0x7a, 0x0e, 0xb4, 0xaa, 0x10, 0x64, 0xde, 0x8c, 0x36, 0x42, 0xf8,
+        0x7e, 0xc4, 0xb0, 0x0a, 0x58, 0xe2, 0x96, 0x2c, 0x32, 0x88, 0xfc, 0x46, 0x14, 0xae, 0xda, 0x60,
+        0x6c, 0xd6, 0xa2, 0x18, 0x4a, 0xf0, 0x84, 0x3e, 0x20, 0x9a, 0xee, 0x54, 0x06, 0xbc, 0xc8, 0x72,
+        0xf4, 0x4e, 0x3a, 0x80, 0xd2, 0x68, 0x1c, 0xa6, 0xb8, 0x02, 0x76, 0xcc, 0x9e, 0x24, 0x50, 0xea,
+        0x48, 0xf2, 0x86, 0x3c, 0x6e, 0xd4, 0xa0, 0x1a, 0x04, 0xbe, 0xca, 0x70, 0x22, 0x98, 0xec, 0x56,
+        0xd0, 0x6a, 0x1e, 0xa4, 0xf6, 0x4c, 0x38, 0x82, 0x9c, 0x26, 0x52, 0xe8, 0xba, 0x00, 0x74, 0xce,
+        0xc2, 0x78, 0x0c, 0xb6, 0xe4, 0x5e, 0x2a, 0x90, 0x8e, 0x34, 0x40, 0xfa, 0xa8, 0x12, 0x66, 0xdc,
+        0x5a, 0xe0, 0x94, 0x2e, 0x7c, 0xc6, 0xb2, 0x08, 0x16, 0xac, 0xd8, 0x62, 0x30, 0x8a, 0xfe, 0x44,
+    },
+#endif
+};
+
+#endif // CRC_TABLE_SLICES > 0
+
 uint16_t crc16_ccitt(uint16_t crc, unsigned char a)
 {
+#if CRC_TABLE_SLICES > 0
+    return (crc << 8) ^ crc16CcittTable[0][(crc >> 8) ^ a];
+#else
     crc ^= (uint16_t)a << 8;
     for (int ii = 0; ii < 8; ++ii) {
         if (crc & 0x8000) {
@@ -37,6 +568,7 @@ uint16_t crc16_ccitt(uint16_t crc, unsigned char a)
         }
     }
     return crc;
+#endif
 }
 
 uint16_t crc16_ccitt_update(uint16_t crc, const void *data, uint32_t length)
@@ -44,6 +576,22 @@ uint16_t crc16_ccitt_update(uint16_t crc, const void *data, uint32_t length)
     const uint8_t *p = (const uint8_t *)data;
     const uint8_t *pend = p + length;
 
+#if CRC_TABLE_SLICES >= 4
+    // The CRC is folded into the first two bytes of each slice
+    for (; pend - p >= CRC_TABLE_SLICES; p += CRC_TABLE_SLICES) {
+        crc = crc16CcittTable[CRC_TABLE_SLICES - 1][(crc >> 8) ^ p[0]]
+            ^ crc16CcittTable[CRC_TABLE_SLICES - 2][(crc & 0xff) ^ p[1]]
+            ^ crc16CcittTable[CRC_TABLE_SLICES - 3][p[2]]
+            ^ crc16CcittTable[CRC_TABLE_SLICES - 4][p[3]]
+#if CRC_TABLE_SLICES == 8
+            ^ crc16CcittTable[3][p[4]]
+            ^ crc16CcittTable[2][p[5]]
+            ^ crc16CcittTable[1][p[6]]
+            ^ crc16CcittTable[0][p[7]]
+#endif
+            ;
+    }
+#endif
     for (; p != pend; p++) {
         crc = crc16_ccitt(crc, *p);
     }
@@ -52,15 +600,11 @@ uint16_t crc16_ccitt_update(uint16_t crc, const void *data, uint32_t length)
 
 void crc16_ccitt_sbuf_append(sbuf_t *dst, uint8_t *start)
 {
-    uint16_t crc = 0;
     const uint8_t * const end = sbufPtr(dst);
-    for (const uint8_t *ptr = start; ptr < end; ++ptr) {
-        crc = crc16_ccitt(crc, *ptr);
-    }
-    sbufWriteU16(dst, crc);
+    sbufWriteU16(dst, crc16_ccitt_update(0, start, end - start));
 }
 
-uint8_t crc8_calc(uint8_t crc, unsigned char a, uint8_t poly)
+static uint8_t crc8_calc_bits(uint8_t crc, unsigned char a, uint8_t poly)
 {
     crc ^= a;
     for (int ii = 0; ii < 8; ++ii) {
@@ -73,25 +617,72 @@ uint8_t crc8_calc(uint8_t crc, unsigned char a, uint8_t poly)
     return crc;
 }
 
+#if CRC_TABLE_SLICES > 0
+typedef const uint8_t crc8Table_t[CRC_TABLE_SLICES][256];
+
+static crc8Table_t *crc8Table(uint8_t poly)
+{
+    switch (poly) {
+    case 0xD5:
+        return &crc8DvbS2Table;
+    case 0xBA:
+        return &crc8Poly0xbaTable;
+    default:
+        return NULL;
+    }
+}
+#endif
+
+uint8_t crc8_calc(uint8_t crc, unsigned char a, uint8_t poly)
+{
+#if CRC_TABLE_SLICES > 0
+    crc8Table_t *table = crc8Table(poly);
+    if (table) {
+        return (*table)[0][crc ^ a];
+    }
+#endif
+    return crc8_calc_bits(crc, a, poly);
+}
+
 uint8_t crc8_update(uint8_t crc, const void *data, uint32_t length, uint8_t poly)
 {
     const uint8_t *p = (const uint8_t *)data;
     const uint8_t *pend = p + length;
 
+#if CRC_TABLE_SLICES > 0
+    crc8Table_t *table = crc8Table(poly);
+    if (table) {
+#if CRC_TABLE_SLICES >= 4
+        for (; pend - p >= CRC_TABLE_SLICES; p += CRC_TABLE_SLICES) {
+            crc = (*table)[CRC_TABLE_SLICES - 1][crc ^ p[0]]
+                ^ (*table)[CRC_TABLE_SLICES - 2][p[1]]
+                ^ (*table)[CRC_TABLE_SLICES - 3][p[2]]
+                ^ (*table)[CRC_TABLE_SLICES - 4][p[3]]
+#if CRC_TABLE_SLICES == 8
+                ^ (*table)[3][p[4]]
+                ^ (*table)[2][p[5]]
+                ^ (*table)[1][p[6]]
+                ^ (*table)[0][p[7]]
+#endif
+                ;
+        }
+#endif
+        for (; p != pend; p++) {
+            crc = (*table)[0][crc ^ *p];
+        }
+        return crc;
+    }
+#endif
     for (; p != pend; p++) {
-        crc = crc8_calc(crc, *p, poly);
+        crc = crc8_calc_bits(crc, *p, poly);
     }
     return crc;
 }
 
 void crc8_sbuf_append(sbuf_t *dst, uint8_t *start, uint8_t poly)
 {
-    uint8_t crc = 0;
     const uint8_t * const end = dst->ptr;
-    for (const uint8_t *ptr = start; ptr < end; ++ptr) {
-        crc = crc8_calc(crc, *ptr, poly);
-    }
-    sbufWriteU8(dst, crc);
+    sbufWriteU8(dst, crc8_update(0, start, end - start, poly));
 }
 
 uint8_t crc8_xor_update(uint8_t crc, const void *data, uint32_t length)
@@ -0,0 +1,180 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+
+#include "platform.h"
+
+#include "common/fft.h"
+#include "common/maths.h"
+
+#define FFT_COS_MASK (FFT_SIZE_MAX - 1)
+#define FFT_SIN_SHIFT (FFT_SIZE_MAX / 4)   // sin(x) = cos(x - pi / 2)
+
+static FAST_DATA_ZERO_INIT bool  isInitialized;
+static FAST_DATA_ZERO_INIT float cosTable[FFT_SIZE_MAX];  // cos(2 * pi * i / FFT_SIZE_MAX)
+
+void fftInit(fft_t *fft, const int size)
+{
+    if (!isInitialized) {
+        const float c = 2.0f * M_PIf / (float)FFT_SIZE_MAX;
+        for (int i = 0; i < FFT_SIZE_MAX; i++) {
+            cosTable[i] = cos_approx(c * i);
+        }
+        isInitialized = true;
+    }
+
+    fft->size = FFT_SIZE_MIN;
+    fft->log2Size = 0;
+    while (fft->size < size && fft->size < FFT_SIZE_MAX) {
+        fft->size <<= 1;
+    }
+    while ((1 << fft->log2Size) < fft->size) {
+        fft->log2Size++;
+    }
+
+    fft->state = FFT_IDLE;
+    fft->input = NULL;
+
+    for (int i = 0; i < FFT_SIZE_MAX; i++) {
+        fft->re[i] = 0.0f;
+        fft->im[i] = 0.0f;
+    }
+}
+
+// Start transforming the circular buffer input, which must hold fft->size samples.
+// Samples are copied oldest first, so new samples may be written to the buffer while loading.
+void fftStart(fft_t *fft, const float *input, const int inputIdx)
+{
+    fft->input = input;
+    fft->inputIdx = inputIdx;
+    fft->stage = 0;
+    fft->progress = 0;
+    fft->state = FFT_LOAD;
+}
+
+// Number of budget units needed for one transform, loading two samples costs one unit
+int fftOpCount(const int size)
+{
+    int log2Size = 0;
+    while ((1 << log2Size) < size) {
+        log2Size++;
+    }
+    return size / 2 + log2Size * size / 2;
+}
+
+static FAST_CODE int bitReverse(int value, const int bits)
+{
+    int result = 0;
+    for (int i = 0; i < bits; i++) {
+        result = (result << 1) | (value & 1);
+        value >>= 1;
+    }
+    return result;
+}
+
+// Windowed copy of the input into bit reversed order
+static FAST_CODE int fftLoad(fft_t *fft, int budget)
+{
+    const int mask = fft->size - 1;
+    const int windowStride = FFT_SIZE_MAX / fft->size;
+
+    int count = MIN(2 * budget, fft->size - fft->progress);
+    for (int i = 0; i < count; i++) {
+        const int n = fft->progress + i;
+        const float window = 0.5f - 0.5f * cosTable[n * windowStride];  // Hann window
+        const int dst = bitReverse(n, fft->log2Size);
+        fft->re[dst] = fft->input[(fft->inputIdx + n) & mask] * window;
+        fft->im[dst] = 0.0f;
+    }
+    fft->progress += count;
+
+    if (fft->progress == fft->size) {
+        fft->progress = 0;
+        fft->state = FFT_TRANSFORM;
+    }
+
+    return (count + 1) / 2;
+}
+
+// Decimation in time butterflies of the current stage
+static FAST_CODE int fftButterflies(fft_t *fft, int budget)
+{
+    const int stage = fft->stage;
+    const int half = 1 << stage;
+    const int twiddleStride = FFT_SIZE_MAX >> (stage + 1);
+    const int count = MIN(budget, fft->size / 2 - fft->progress);
+
+    for (int j = fft->progress; j < fft->progress + count; j++) {
+        const int k = j & (half - 1);
+        const int i1 = ((j >> stage) << (stage + 1)) + k;
+        const int i2 = i1 + half;
+
+        const int m = k * twiddleStride;
+        const float wr = cosTable[m];
+        const float wi = -cosTable[(m - FFT_SIN_SHIFT) & FFT_COS_MASK];
+
+        const float tr = wr * fft->re[i2] - wi * fft->im[i2];
+        const float ti = wr * fft->im[i2] + wi * fft->re[i2];
+
+        fft->re[i2] = fft->re[i1] - tr;
+        fft->im[i2] = fft->im[i1] - ti;
+        fft->re[i1] += tr;
+        fft->im[i1] += ti;
+    }
+    fft->progress += count;
+
+    if (fft->progress == fft->size / 2) {
+        fft->progress = 0;
+        fft->stage++;
+        if (fft->stage == fft->log2Size) {
+            fft->state = FFT_IDLE;
+        }
+    }
+
+    return count;
+}
+
+// Continue the transform using at most budget butterflies, returns true when the transform completed
+FAST_CODE bool fftStep(fft_t *fft, int budget)
+{
+    while (budget > 0 && fft->state != FFT_IDLE) {
+        if (fft->state == FFT_LOAD) {
+            budget -= fftLoad(fft, budget);
+        } else {
+            budget -= fftButterflies(fft, budget);
+        }
+    }
+
+    return fft->state == FFT_IDLE;
+}
+
+bool fftIsBusy(const fft_t *fft)
+{
+    return fft->state != FFT_IDLE;
+}
+
+// Get squared magnitude of frequency spectrum
+FAST_CODE void fftMagSq(const fft_t *fft, const int startBin, const int endBin, float *output)
+{
+    for (int i = startBin; i <= endBin; i++) {
+        output[i] = fft->re[i] * fft->re[i] + fft->im[i] * fft->im[i];
+    }
+}
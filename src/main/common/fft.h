@@ -0,0 +1,60 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ // Radix-2 FFT of a Hann windowed block of real samples.
+ // The transform is computed incrementally, so the work can be spread over several calls.
+ // Complexity for calculating frequency spectrum with N bins is O(N log N).
+
+#pragma once
+
+#include <stdbool.h>
+
+#include "common/utils.h"
+
+#define FFT_SIZE_MIN      64
+#define FFT_SIZE_MAX      256
+#define FFT_BIN_COUNT_MAX (FFT_SIZE_MAX / 2)
+
+typedef enum {
+    FFT_IDLE,
+    FFT_LOAD,
+    FFT_TRANSFORM,
+} fftState_e;
+
+typedef struct fft_s {
+    int size;
+    int log2Size;
+    fftState_e state;
+    const float *input;                // circular buffer of size samples
+    int inputIdx;                      // index of the oldest sample in the circular buffer
+    int stage;                         // current butterfly stage
+    int progress;                      // samples loaded or butterflies computed in the current stage
+    float re[FFT_SIZE_MAX];
+    float im[FFT_SIZE_MAX];
+} fft_t;
+
+STATIC_ASSERT((FFT_SIZE_MAX & (FFT_SIZE_MAX - 1)) == 0, fft_size_max_not_power_of_two);
+
+void fftInit(fft_t *fft, const int size);
+void fftStart(fft_t *fft, const float *input, const int inputIdx);
+bool fftStep(fft_t *fft, int budget);
+bool fftIsBusy(const fft_t *fft);
+int fftOpCount(const int size);
+void fftMagSq(const fft_t *fft, const int startBin, const int endBin, float *output);
@@ -273,6 +273,186 @@ FAST_CODE float biquadFilterApply(biquadFilter_t *filter, float input)
     return result;
 }
 
+// Three axis filters
+
+void pt1FilterVec3Init(pt1FilterVec3_t *filter, float k)
+{
+    memset(filter, 0, sizeof(*filter));
+    filter->k = k;
+}
+
+void pt1FilterVec3UpdateCutoff(pt1FilterVec3_t *filter, float k)
+{
+    filter->k = k;
+}
+
+FAST_CODE void pt1FilterVec3Apply(pt1FilterVec3_t *filter, float values[XYZ_AXIS_COUNT])
+{
+    const float k = filter->k;
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        filter->state[axis] = filter->state[axis] + k * (values[axis] - filter->state[axis]);
+        values[axis] = filter->state[axis];
+    }
+}
+
+void pt2FilterVec3Init(pt2FilterVec3_t *filter, float k)
+{
+    memset(filter, 0, sizeof(*filter));
+    filter->k = k;
+}
+
+void pt2FilterVec3UpdateCutoff(pt2FilterVec3_t *filter, float k)
+{
+    filter->k = k;
+}
+
+FAST_CODE void pt2FilterVec3Apply(pt2FilterVec3_t *filter, float values[XYZ_AXIS_COUNT])
+{
+    const float k = filter->k;
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        filter->state1[axis] = filter->state1[axis] + k * (values[axis] - filter->state1[axis]);
+        filter->state[axis] = filter->state[axis] + k * (filter->state1[axis] - filter->state[axis]);
+        values[axis] = filter->state[axis];
+    }
+}
+
+void pt3FilterVec3Init(pt3FilterVec3_t *filter, float k)
+{
+    memset(filter, 0, sizeof(*filter));
+    filter->k = k;
+}
+
+void pt3FilterVec3UpdateCutoff(pt3FilterVec3_t *filter, float k)
+{
+    filter->k = k;
+}
+
+FAST_CODE void pt3FilterVec3Apply(pt3FilterVec3_t *filter, float values[XYZ_AXIS_COUNT])
+{
+    const float k = filter->k;
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        filter->state1[axis] = filter->state1[axis] + k * (values[axis] - filter->state1[axis]);
+        filter->state2[axis] = filter->state2[axis] + k * (filter->state1[axis] - filter->state2[axis]);
+        filter->state[axis] = filter->state[axis] + k * (filter->state2[axis] - filter->state[axis]);
+        values[axis] = filter->state[axis];
+    }
+}
+
+void biquadFilterVec3Init(biquadFilterVec3_t *filter, float filterFreq, uint32_t refreshRate, float Q, biquadFilterType_e filterType)
+{
+    memset(filter, 0, sizeof(*filter));
+    biquadFilterVec3Update(filter, filterFreq, refreshRate, Q, filterType);
+}
+
+FAST_CODE void biquadFilterVec3Update(biquadFilterVec3_t *filter, float filterFreq, uint32_t refreshRate, float Q, biquadFilterType_e filterType)
+{
+    biquadFilter_t coeffs;
+    biquadFilterUpdate(&coeffs, filterFreq, refreshRate, Q, filterType, 1.0f);
+
+    filter->b0 = coeffs.b0;
+    filter->b1 = coeffs.b1;
+    filter->b2 = coeffs.b2;
+    filter->a1 = coeffs.a1;
+    filter->a2 = coeffs.a2;
+}
+
+void biquadFilterVec3InitLPF(biquadFilterVec3_t *filter, float filterFreq, uint32_t refreshRate)
+{
+    biquadFilterVec3Init(filter, filterFreq, refreshRate, BIQUAD_Q, FILTER_LPF);
+}
+
+FAST_CODE void biquadFilterVec3UpdateLPF(biquadFilterVec3_t *filter, float filterFreq, uint32_t refreshRate)
+{
+    biquadFilterVec3Update(filter, filterFreq, refreshRate, BIQUAD_Q, FILTER_LPF);
+}
+
+/* Same as biquadFilterApply(), x1 and x2 hold the direct form 2 transposed state */
+FAST_CODE void biquadFilterVec3Apply(biquadFilterVec3_t *filter, float values[XYZ_AXIS_COUNT])
+{
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        const float input = values[axis];
+        const float result = filter->b0 * input + filter->x1[axis];
+
+        filter->x1[axis] = filter->b1 * input - filter->a1 * result + filter->x2[axis];
+        filter->x2[axis] = filter->b2 * input - filter->a2 * result;
+
+        values[axis] = result;
+    }
+}
+
+/* Same as biquadFilterApplyDF1() */
+FAST_CODE void biquadFilterVec3ApplyDF1(biquadFilterVec3_t *filter, float values[XYZ_AXIS_COUNT])
+{
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        const float input = values[axis];
+        const float result = filter->b0 * input + filter->b1 * filter->x1[axis] + filter->b2 * filter->x2[axis] - filter->a1 * filter->y1[axis] - filter->a2 * filter->y2[axis];
+
+        filter->x2[axis] = filter->x1[axis];
+        filter->x1[axis] = input;
+        filter->y2[axis] = filter->y1[axis];
+        filter->y1[axis] = result;
+
+        values[axis] = result;
+    }
+}
+
+void filterVec3InitNone(filterVec3_t *filter)
+{
+    filter->type = FILTER_VEC3_NONE;
+}
+
+void filterVec3InitPt1(filterVec3_t *filter, float k)
+{
+    filter->type = FILTER_VEC3_PT1;
+    pt1FilterVec3Init(&filter->pt1, k);
+}
+
+void filterVec3InitPt2(filterVec3_t *filter, float k)
+{
+    filter->type = FILTER_VEC3_PT2;
+    pt2FilterVec3Init(&filter->pt2, k);
+}
+
+void filterVec3InitPt3(filterVec3_t *filter, float k)
+{
+    filter->type = FILTER_VEC3_PT3;
+    pt3FilterVec3Init(&filter->pt3, k);
+}
+
+void filterVec3InitBiquad(filterVec3_t *filter, float filterFreq, uint32_t refreshRate, float Q, biquadFilterType_e filterType, bool df1)
+{
+    filter->type = df1 ? FILTER_VEC3_BIQUAD_DF1 : FILTER_VEC3_BIQUAD;
+    biquadFilterVec3Init(&filter->biquad, filterFreq, refreshRate, Q, filterType);
+}
+
+void filterVec3InitBiquadLPF(filterVec3_t *filter, float filterFreq, uint32_t refreshRate, bool df1)
+{
+    filterVec3InitBiquad(filter, filterFreq, refreshRate, BIQUAD_Q, FILTER_LPF, df1);
+}
+
+FAST_CODE void filterVec3Apply(filterVec3_t *filter, float values[XYZ_AXIS_COUNT])
+{
+    switch (filter->type) {
+    case FILTER_VEC3_NONE:
+        break;
+    case FILTER_VEC3_PT1:
+        pt1FilterVec3Apply(&filter->pt1, values);
+        break;
+    case FILTER_VEC3_PT2:
+        pt2FilterVec3Apply(&filter->pt2, values);
+        break;
+    case FILTER_VEC3_PT3:
+        pt3FilterVec3Apply(&filter->pt3, values);
+        break;
+    case FILTER_VEC3_BIQUAD:
+        biquadFilterVec3Apply(&filter->biquad, values);
+        break;
+    case FILTER_VEC3_BIQUAD_DF1:
+        biquadFilterVec3ApplyDF1(&filter->biquad, values);
+        break;
+    }
+}
+
 // Phase Compensator (Lead-Lag-Compensator)
 
 void phaseCompInit(phaseComp_t *filter, const float centerFreqHz, const float centerPhaseDeg, const uint32_t looptimeUs)
@@ -23,6 +23,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "common/axis.h"
+
 struct filter_s;
 typedef struct filter_s filter_t;
 typedef float (*filterApplyFnPtr)(filter_t *filter, float input);
@@ -65,6 +67,51 @@ typedef struct biquadFilter_s {
     float weight;
 } biquadFilter_t;
 
+// three axis variants, the axes share one set of coefficients and keep separate state
+typedef struct pt1FilterVec3_s {
+    float state[XYZ_AXIS_COUNT];
+    float k;
+} pt1FilterVec3_t;
+
+typedef struct pt2FilterVec3_s {
+    float state[XYZ_AXIS_COUNT];
+    float state1[XYZ_AXIS_COUNT];
+    float k;
+} pt2FilterVec3_t;
+
+typedef struct pt3FilterVec3_s {
+    float state[XYZ_AXIS_COUNT];
+    float state1[XYZ_AXIS_COUNT];
+    float state2[XYZ_AXIS_COUNT];
+    float k;
+} pt3FilterVec3_t;
+
+typedef struct biquadFilterVec3_s {
+    float b0, b1, b2, a1, a2;
+    float x1[XYZ_AXIS_COUNT], x2[XYZ_AXIS_COUNT];
+    float y1[XYZ_AXIS_COUNT], y2[XYZ_AXIS_COUNT];
+} biquadFilterVec3_t;
+
+typedef enum {
+    FILTER_VEC3_NONE = 0,
+    FILTER_VEC3_PT1,
+    FILTER_VEC3_PT2,
+    FILTER_VEC3_PT3,
+    FILTER_VEC3_BIQUAD,         // direct form 2 transposed
+    FILTER_VEC3_BIQUAD_DF1,     // direct form 1, use when the coefficients are updated on the fly
+} filterVec3Type_e;
+
+// three axis filter of any type, applied with a single switch instead of an indirect call per axis
+typedef struct filterVec3_s {
+    filterVec3Type_e type;
+    union {
+        pt1FilterVec3_t pt1;
+        pt2FilterVec3_t pt2;
+        pt3FilterVec3_t pt3;
+        biquadFilterVec3_t biquad;
+    };
+} filterVec3_t;
+
 typedef struct phaseComp_s {
     float b0, b1, a1;
     float x1, y1;
@@ -125,6 +172,31 @@ float biquadFilterApplyDF1(biquadFilter_t *filter, float input);
 float biquadFilterApplyDF1Weighted(biquadFilter_t *filter, float input);
 float biquadFilterApply(biquadFilter_t *filter, float input);
 
+void pt1FilterVec3Init(pt1FilterVec3_t *filter, float k);
+void pt1FilterVec3UpdateCutoff(pt1FilterVec3_t *filter, float k);
+void pt1FilterVec3Apply(pt1FilterVec3_t *filter, float values[XYZ_AXIS_COUNT]);
+void pt2FilterVec3Init(pt2FilterVec3_t *filter, float k);
+void pt2FilterVec3UpdateCutoff(pt2FilterVec3_t *filter, float k);
+void pt2FilterVec3Apply(pt2FilterVec3_t *filter, float values[XYZ_AXIS_COUNT]);
+void pt3FilterVec3Init(pt3FilterVec3_t *filter, float k);
+void pt3FilterVec3UpdateCutoff(pt3FilterVec3_t *filter, float k);
+void pt3FilterVec3Apply(pt3FilterVec3_t *filter, float values[XYZ_AXIS_COUNT]);
+
+void biquadFilterVec3Init(biquadFilterVec3_t *filter, float filterFreq, uint32_t refreshRate, float Q, biquadFilterType_e filterType);
+void biquadFilterVec3Update(biquadFilterVec3_t *filter, float filterFreq, uint32_t refreshRate, float Q, biquadFilterType_e filterType);
+void biquadFilterVec3InitLPF(biquadFilterVec3_t *filter, float filterFreq, uint32_t refreshRate);
+void biquadFilterVec3UpdateLPF(biquadFilterVec3_t *filter, float filterFreq, uint32_t refreshRate);
+void biquadFilterVec3Apply(biquadFilterVec3_t *filter, float values[XYZ_AXIS_COUNT]);
+void biquadFilterVec3ApplyDF1(biquadFilterVec3_t *filter, float values[XYZ_AXIS_COUNT]);
+
+void filterVec3InitNone(filterVec3_t *filter);
+void filterVec3InitPt1(filterVec3_t *filter, float k);
+void filterVec3InitPt2(filterVec3_t *filter, float k);
+void filterVec3InitPt3(filterVec3_t *filter, float k);
+void filterVec3InitBiquad(filterVec3_t *filter, float filterFreq, uint32_t refreshRate, float Q, biquadFilterType_e filterType, bool df1);
+void filterVec3InitBiquadLPF(filterVec3_t *filter, float filterFreq, uint32_t refreshRate, bool df1);
+void filterVec3Apply(filterVec3_t *filter, float values[XYZ_AXIS_COUNT]);
+
 void phaseCompInit(phaseComp_t *filter, const float centerFreq, const float centerPhase, const uint32_t looptimeUs);
 void phaseCompUpdate(phaseComp_t *filter, const float centerFreq, const float centerPhase, const uint32_t looptimeUs);
 float phaseCompApply(phaseComp_t *filter, const float input);
@@ -0,0 +1,101 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+
+#include "platform.h"
+
+#include "common/goertzel.h"
+#include "common/maths.h"
+
+// Bins do not need to be integers, so the bank can be spread evenly over any frequency range
+void goertzelInit(goertzel_t *goertzel, const float startBin, const float binStep, const int binCount, const int blockSize, const int numBatches)
+{
+    goertzel->blockSize = MAX(blockSize, 2);
+    goertzel->sampleIdx = 0;
+    goertzel->binCount = constrain(binCount, 1, GOERTZEL_BIN_COUNT_MAX);
+    goertzel->numBatches = constrain(numBatches, 1, goertzel->binCount);
+    goertzel->batchSize = goertzel->binCount / goertzel->numBatches;
+    goertzel->ready = false;
+    goertzel->input = 0.0f;
+
+    const float c = 2.0f * M_PIf / (float)goertzel->blockSize;
+    for (int i = 0; i < GOERTZEL_BIN_COUNT_MAX; i++) {
+        goertzel->coeff[i] = 2.0f * cos_approx(c * (startBin + i * binStep));
+        goertzel->s1[i] = 0.0f;
+        goertzel->s2[i] = 0.0f;
+        goertzel->power[i] = 0.0f;
+    }
+}
+
+// Add new sample to the bins of one batch, the last batch completes the sample
+FAST_CODE void goertzelPushBatch(goertzel_t *goertzel, const float sample, const int batchIdx)
+{
+    if (batchIdx >= goertzel->numBatches) {
+        return;
+    }
+
+    if (batchIdx == 0) {
+        // Hann window
+        const float phi = 2.0f * M_PIf * goertzel->sampleIdx / (float)goertzel->blockSize;
+        goertzel->input = sample * (0.5f - 0.5f * cos_approx(phi));
+    }
+
+    const int batchStart = goertzel->batchSize * batchIdx;
+    const bool lastBatch = batchIdx == goertzel->numBatches - 1;
+    const int batchEnd = lastBatch ? goertzel->binCount : batchStart + goertzel->batchSize;
+    const bool lastSample = goertzel->sampleIdx == goertzel->blockSize - 1;
+
+    for (int i = batchStart; i < batchEnd; i++) {
+        const float s0 = goertzel->input + goertzel->coeff[i] * goertzel->s1[i] - goertzel->s2[i];
+        goertzel->s2[i] = goertzel->s1[i];
+        goertzel->s1[i] = s0;
+
+        if (lastSample) {
+            const float s1 = goertzel->s1[i];
+            const float s2 = goertzel->s2[i];
+            goertzel->power[i] = s1 * s1 + s2 * s2 - goertzel->coeff[i] * s1 * s2;
+            goertzel->s1[i] = 0.0f;
+            goertzel->s2[i] = 0.0f;
+        }
+    }
+
+    if (lastBatch) {
+        goertzel->sampleIdx++;
+        if (goertzel->sampleIdx == goertzel->blockSize) {
+            goertzel->sampleIdx = 0;
+            goertzel->ready = true;
+        }
+    }
+}
+
+bool goertzelIsReady(const goertzel_t *goertzel)
+{
+    return goertzel->ready;
+}
+
+// Get squared magnitude of the last completed block
+FAST_CODE void goertzelMagSq(goertzel_t *goertzel, float *output)
+{
+    for (int i = 0; i < goertzel->binCount; i++) {
+        output[i] = goertzel->power[i];
+    }
+    goertzel->ready = false;
+}
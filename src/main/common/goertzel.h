@@ -0,0 +1,47 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ // Bank of Goertzel filters evaluating a sparse set of frequency bins over Hann windowed blocks of samples.
+ // Complexity per sample is O(number of bins), a new power spectrum is available after every block.
+
+#pragma once
+
+#include <stdbool.h>
+
+#define GOERTZEL_BIN_COUNT_MAX 64
+
+typedef struct goertzel_s {
+    int blockSize;
+    int sampleIdx;                           // position of the current sample in the block
+    int binCount;
+    int batchSize;
+    int numBatches;
+    bool ready;                              // set when a block completed, cleared by goertzelMagSq()
+    float input;                             // windowed current sample
+    float coeff[GOERTZEL_BIN_COUNT_MAX];     // 2 * cos(2 * pi * bin / blockSize)
+    float s1[GOERTZEL_BIN_COUNT_MAX];
+    float s2[GOERTZEL_BIN_COUNT_MAX];
+    float power[GOERTZEL_BIN_COUNT_MAX];     // squared magnitude of the last completed block
+} goertzel_t;
+
+void goertzelInit(goertzel_t *goertzel, const float startBin, const float binStep, const int binCount, const int blockSize, const int numBatches);
+void goertzelPushBatch(goertzel_t *goertzel, const float sample, const int batchIdx);
+bool goertzelIsReady(const goertzel_t *goertzel);
+void goertzelMagSq(goertzel_t *goertzel, float *output);
@@ -0,0 +1,230 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#ifdef USE_LZ
+
+#include "common/maths.h"
+
+#include "lz.h"
+
+#define LZ_WINDOW_MASK      (LZ_WINDOW_SIZE - 1)
+#define LZ_NIBBLE_MAX       15U
+
+void lzInit(lzState_t *state, uint8_t *outBuf, uint16_t outBufLen)
+{
+    state->outByte = outBuf;
+    state->bytesWritten = 0;
+    state->outBufLen = outBufLen;
+    state->inputCount = 0;
+    state->encodedCount = 0;
+    state->position = 0;
+    state->literalStart = 0;
+    state->matchLength = 0;
+    state->matchOffset = 0;
+    memset(state->hashTable, 0, sizeof(state->hashTable));
+}
+
+static uint32_t lzHash(const lzState_t *state, uint32_t position)
+{
+    const uint32_t sequence = state->window[position & LZ_WINDOW_MASK]
+        | (state->window[(position + 1) & LZ_WINDOW_MASK] << 8)
+        | (state->window[(position + 2) & LZ_WINDOW_MASK] << 16)
+        | ((uint32_t)state->window[(position + 3) & LZ_WINDOW_MASK] << 24);
+    return (sequence * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+static unsigned lzLengthBytes(uint32_t length)
+{
+    return length >= LZ_NIBBLE_MAX ? (length - LZ_NIBBLE_MAX) / 255 + 1 : 0;
+}
+
+static uint8_t *lzWriteLength(uint8_t *p, uint32_t length)
+{
+    if (length >= LZ_NIBBLE_MAX) {
+        length -= LZ_NIBBLE_MAX;
+        for (; length >= 255; length -= 255) {
+            *p++ = 255;
+        }
+        *p++ = length;
+    }
+    return p;
+}
+
+// Writes the literals from literalStart followed by a match, or as many of the literals as fit in the
+// output buffer if the whole sequence doesn't
+static bool lzWriteSequence(lzState_t *state, uint32_t literalCount, uint32_t matchLength, uint32_t matchOffset)
+{
+    const uint32_t available = state->outBufLen - state->bytesWritten;
+    const uint32_t matchCode = matchLength ? matchLength - LZ_MIN_MATCH + 1 : 0;
+    const uint32_t size = 1 + lzLengthBytes(literalCount) + literalCount + (matchLength ? sizeof(uint16_t) + lzLengthBytes(matchCode) : 0);
+
+    bool complete = true;
+    if (size > available) {
+        complete = false;
+        matchLength = 0;
+        literalCount = MIN(literalCount, available > 1 ? available - 1 : 0);
+        while (literalCount && 1 + lzLengthBytes(literalCount) + literalCount > available) {
+            literalCount--;
+        }
+        if (!literalCount) {
+            return false;
+        }
+    }
+
+    uint8_t *p = state->outByte;
+    *p++ = (MIN(literalCount, LZ_NIBBLE_MAX) << 4) | (matchLength ? MIN(matchCode, LZ_NIBBLE_MAX) : 0);
+    p = lzWriteLength(p, literalCount);
+    for (uint32_t i = 0; i < literalCount; i++) {
+        *p++ = state->window[(state->literalStart + i) & LZ_WINDOW_MASK];
+    }
+    if (matchLength) {
+        *p++ = matchOffset & 0xff;
+        *p++ = matchOffset >> 8;
+        p = lzWriteLength(p, matchCode);
+    }
+
+    state->bytesWritten += p - state->outByte;
+    state->outByte = p;
+    state->literalStart += literalCount + matchLength;
+    state->encodedCount = state->literalStart;
+    return complete;
+}
+
+static bool lzWritePendingMatch(lzState_t *state)
+{
+    const uint32_t matchStart = state->position - state->matchLength;
+    const bool complete = lzWriteSequence(state, matchStart - state->literalStart, state->matchLength, state->matchOffset);
+    state->matchLength = 0;
+    return complete;
+}
+
+// Writes everything pending, including input too short to look for a match at
+int lzFlush(lzState_t *state)
+{
+    if (state->matchLength && !lzWritePendingMatch(state)) {
+        return -1;
+    }
+    if (state->literalStart < state->inputCount && !lzWriteSequence(state, state->inputCount - state->literalStart, 0, 0)) {
+        return -1;
+    }
+    state->position = state->inputCount;
+    return 0;
+}
+
+// Compresses inBuf, with matches against the preceding input in the window. Sequences that may still
+// grow with further input are held back until the next call or lzFlush(). Returns -1, with encodedCount
+// covering the input written so far, once the output buffer is full.
+int lzEncodeBufStreaming(lzState_t *state, const uint8_t *inBuf, int inLen)
+{
+    if (inLen > LZ_WINDOW_SIZE / 2) {
+        // Keep at least half the window for matches into earlier input
+        const int status = lzEncodeBufStreaming(state, inBuf, LZ_WINDOW_SIZE / 2);
+        if (status != 0) {
+            return status;
+        }
+        return lzEncodeBufStreaming(state, inBuf + LZ_WINDOW_SIZE / 2, inLen - LZ_WINDOW_SIZE / 2);
+    }
+
+    const uint32_t end = state->inputCount + inLen;
+
+    // Pending literals and the source of a pending match must survive the new input
+    const uint32_t literalEnd = state->matchLength ? state->position - state->matchLength : state->inputCount;
+    if (literalEnd > state->literalStart && end - state->literalStart > LZ_WINDOW_SIZE) {
+        // A long match can stay pending, its literals are written on their own
+        if (!lzWriteSequence(state, literalEnd - state->literalStart, 0, 0)) {
+            return -1;
+        }
+        state->position = MAX(state->position, state->literalStart);
+    }
+    if (state->matchLength && state->matchOffset + inLen > LZ_WINDOW_SIZE && !lzWritePendingMatch(state)) {
+        return -1;
+    }
+
+    for (uint32_t i = state->inputCount; i < end; i++) {
+        state->window[i & LZ_WINDOW_MASK] = inBuf[i - state->inputCount];
+    }
+    state->inputCount = end;
+
+    uint32_t position = state->position;
+    if (state->matchLength) {
+        while (position < end && state->window[(position - state->matchOffset) & LZ_WINDOW_MASK] == state->window[position & LZ_WINDOW_MASK]) {
+            position++;
+            state->matchLength++;
+        }
+        state->position = position;
+        if (position == end) {
+            return 0;
+        }
+        if (!lzWritePendingMatch(state)) {
+            return -1;
+        }
+    }
+
+    while (position + LZ_MIN_MATCH <= end) {
+        const uint32_t hash = lzHash(state, position);
+        // Recover the full position from its lower 16 bits, the window check below limits the distance
+        const uint32_t candidate = position - (uint16_t)(position - state->hashTable[hash]);
+        state->hashTable[hash] = position;
+
+        // The candidate must be earlier input that wasn't overwritten since
+        if (candidate >= position || end - candidate > LZ_WINDOW_SIZE) {
+            position++;
+            continue;
+        }
+
+        uint32_t length = 0;
+        while (position + length < end && state->window[(candidate + length) & LZ_WINDOW_MASK] == state->window[(position + length) & LZ_WINDOW_MASK]) {
+            length++;
+        }
+        if (length < LZ_MIN_MATCH) {
+            position++;
+            continue;
+        }
+
+        // Positions within the match are candidates for later matches too
+        const uint32_t matchEnd = position + length;
+        for (position++; position < matchEnd && position + LZ_MIN_MATCH <= end; position++) {
+            state->hashTable[lzHash(state, position)] = position;
+        }
+        position = matchEnd;
+
+        state->position = position;
+        state->matchLength = length;
+        state->matchOffset = position - length - candidate;
+        if (position == end) {
+            // The match may continue in the next input
+            return 0;
+        }
+        if (!lzWritePendingMatch(state)) {
+            return -1;
+        }
+    }
+    state->position = position;
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Streaming LZ77 compression in the style of LZ4 sequences.
+//
+// The compressed stream is a series of sequences, each:
+//   token           high nibble literal count, low nibble match code (0 = no match)
+//   [length bytes]  when the literal count nibble is 15, further bytes are added until one is below 255
+//   literals
+//   offset          only if there is a match, uint16 little endian, distance back from the current output
+//   [length bytes]  when the match code nibble is 15, as for literals
+// The match length is the match code + LZ_MIN_MATCH - 1, and the match may overlap the bytes it produces.
+// Matches never reach further back than LZ_WINDOW_SIZE, or before the start of the stream.
+
+#define LZ_WINDOW_SIZE      1024    // must be a power of 2
+#define LZ_HASH_BITS        8
+#define LZ_HASH_SIZE        (1 << LZ_HASH_BITS)
+#define LZ_MIN_MATCH        4
+
+typedef struct lzState_s {
+    uint8_t     *outByte;
+    uint16_t    bytesWritten;
+    uint16_t    outBufLen;
+    uint32_t    inputCount;         // input bytes passed to the encoder
+    uint32_t    encodedCount;       // input bytes represented by the output
+    uint32_t    position;           // next input position to look for a match at
+    uint32_t    literalStart;       // first input position not yet in the output or a pending match
+    uint32_t    matchLength;        // match at literalStart + pending literals, extended by further input
+    uint32_t    matchOffset;
+    uint16_t    hashTable[LZ_HASH_SIZE];    // lower 16 bits of the last input position of each hash
+    uint8_t     window[LZ_WINDOW_SIZE];
+} lzState_t;
+
+struct lzInfo_s {
+    uint16_t uncompressedByteCount;
+};
+
+#define LZ_INFO_SIZE sizeof(struct lzInfo_s)
+
+void lzInit(lzState_t *state, uint8_t *outBuf, uint16_t outBufLen);
+int lzEncodeBufStreaming(lzState_t *state, const uint8_t *inBuf, int inLen);
+int lzFlush(lzState_t *state);
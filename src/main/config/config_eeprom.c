@@ -80,6 +80,25 @@ typedef struct {
 } PG_PACKED configFooter_t;
 // checksum is appended just after footer. It is not included in footer to make checksum calculation consistent
 
+#ifdef USE_CONFIG_INCREMENTAL_SAVE
+#define CONFIG_APPEND_MAGIC     0xA5C3
+#define CONFIG_APPEND_ALIGN(offset) (((offset) + CONFIG_STREAMER_BUFFER_SIZE - 1) & ~(CONFIG_STREAMER_BUFFER_SIZE - 1))
+
+// Written after the CRC by a full write. Groups that change are then appended after it as records, each padded to the
+// write size and followed by a CRC. The CRC chains on from the previous record, seeded by this header, so records
+// left over from an earlier image are never taken as valid.
+typedef struct {
+    uint16_t magic;
+    uint16_t generation;
+} PG_PACKED configAppendHeader_t;
+
+static uint32_t configAppendStart;      // offset of the first appended record, 0 if the image has no append header
+static uint32_t configAppendEnd;        // offset just past the last valid appended record
+static uint16_t configAppendGeneration;
+static uint16_t configAppendSeed;
+static uint16_t configAppendCrc;        // chain CRC of the last valid appended record
+#endif
+
 // Used to check the compiler packing at build time.
 typedef struct {
     uint8_t byte;
@@ -329,6 +348,70 @@ bool isEEPROMVersionValid(void)
     return true;
 }
 
+#ifdef USE_CONFIG_INCREMENTAL_SAVE
+static uint32_t configRegionSize(void)
+{
+    return (const uint8_t*)&__config_end - (const uint8_t*)&__config_start;
+}
+
+// Returns the appended record at offset, or NULL where the chain ends. On success crc is moved on to the record's CRC.
+static const configRecord_t *appendedRecordAt(uint32_t offset, uint16_t *crc)
+{
+    if (offset + sizeof(configRecord_t) + sizeof(uint16_t) > configRegionSize()) {
+        return NULL;
+    }
+
+    const uint8_t *p = (const uint8_t*)&__config_start + offset;
+    const configRecord_t *record = (const configRecord_t *)p;
+    if (record->size < sizeof(*record) || offset + record->size + sizeof(uint16_t) > configRegionSize()) {
+        // Erased, or not a record
+        return NULL;
+    }
+
+    uint16_t storedCrc;
+    memcpy(&storedCrc, p + record->size, sizeof(storedCrc));
+    const uint16_t recordCrc = crc16_ccitt_update(*crc, p, record->size);
+    if (recordCrc != storedCrc) {
+        return NULL;
+    }
+
+    *crc = recordCrc;
+    return record;
+}
+
+static uint32_t nextAppendedRecordOffset(uint32_t offset, const configRecord_t *record)
+{
+    return CONFIG_APPEND_ALIGN(offset + record->size + sizeof(uint16_t));
+}
+
+// p points just past the CRC of a valid image
+static void scanAppendedRecords(const uint8_t *p, uint16_t storedCrc)
+{
+    configAppendStart = 0;
+
+    const configAppendHeader_t *header = (const configAppendHeader_t *)p;
+    if (p + sizeof(*header) > (const uint8_t*)&__config_end || header->magic != CONFIG_APPEND_MAGIC) {
+        // Written without an append header, the next save is a full write
+        return;
+    }
+
+    configAppendGeneration = header->generation;
+    configAppendSeed = crc16_ccitt_update(storedCrc, header, sizeof(*header));
+    configAppendStart = CONFIG_APPEND_ALIGN(p + sizeof(*header) - (const uint8_t*)&__config_start);
+
+    uint32_t offset = configAppendStart;
+    uint16_t crc = configAppendSeed;
+    const configRecord_t *record;
+    while ((record = appendedRecordAt(offset, &crc))) {
+        offset = nextAppendedRecordOffset(offset, record);
+    }
+
+    configAppendEnd = offset;
+    configAppendCrc = crc;
+    eepromConfigSize = offset;
+}
+#endif
+
 // Scan the EEPROM config. Returns true if the config is valid.
 bool isEEPROMStructureValid(void)
 {
@@ -368,12 +451,20 @@ bool isEEPROMStructureValid(void)
     // include stored CRC in the CRC calculation
     const uint16_t *storedCrc = (const uint16_t *)p;
     crc = crc16_ccitt_update(crc, storedCrc, sizeof(*storedCrc));
-    p += sizeof(storedCrc);
+    p += sizeof(*storedCrc);
 
     eepromConfigSize = p - (const uint8_t*)&__config_start;
 
     // CRC has the property that if the CRC itself is included in the calculation the resulting CRC will have constant value
-    return crc == CRC_CHECK_VALUE;
+    if (crc != CRC_CHECK_VALUE) {
+        return false;
+    }
+
+#ifdef USE_CONFIG_INCREMENTAL_SAVE
+    scanAppendedRecords(p, *storedCrc);
+#endif
+
+    return true;
 }
 
 uint16_t getEEPROMConfigSize(void)
@@ -395,45 +486,120 @@ size_t getEEPROMStorageSize(void)
 #endif
 }
 
+typedef struct {
+    const uint8_t *p;       // next record of the image, NULL once past its last record
+#ifdef USE_CONFIG_INCREMENTAL_SAVE
+    uint32_t offset;        // next appended record, 0 once past the last one
+    uint16_t crc;
+#endif
+} configRecordIterator_t;
+
+static void configRecordIteratorInit(configRecordIterator_t *it)
+{
+    it->p = (const uint8_t*)&__config_start + sizeof(configHeader_t);   // skip header
+#ifdef USE_CONFIG_INCREMENTAL_SAVE
+    it->offset = configAppendStart;
+    it->crc = configAppendSeed;
+#endif
+}
+
+// Returns the stored records in the order they were written, NULL after the last one
+// this function assumes that EEPROM content is valid
+static const configRecord_t *nextConfigRecord(configRecordIterator_t *it)
+{
+    if (it->p) {
+        const configRecord_t *record = (const configRecord_t *)it->p;
+        if (record->size != 0
+            && it->p + record->size < (const uint8_t*)&__config_end
+            && record->size >= sizeof(*record)) {
+            it->p += record->size;
+            return record;
+        }
+        it->p = NULL;
+    }
+
+#ifdef USE_CONFIG_INCREMENTAL_SAVE
+    if (it->offset) {
+        const configRecord_t *record = appendedRecordAt(it->offset, &it->crc);
+        if (record) {
+            it->offset = nextAppendedRecordOffset(it->offset, record);
+            return record;
+        }
+        it->offset = 0;
+    }
+#endif
+
+    return NULL;
+}
+
 // find config record for reg + classification (profile info) in EEPROM
 // return NULL when record is not found
-// this function assumes that EEPROM content is valid
+// a group may have been appended after the image, possibly more than once, the last record is the current one
 static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFlags_e classification)
 {
-    const uint8_t *p = (const uint8_t*)&__config_start;
-    p += sizeof(configHeader_t);             // skip header
-    while (true) {
-        const configRecord_t *record = (const configRecord_t *)p;
-        if (record->size == 0
-            || p + record->size >= (const uint8_t*)&__config_end
-            || record->size < sizeof(*record))
-            break;
+    const configRecord_t *found = NULL;
+    configRecordIterator_t it;
+    configRecordIteratorInit(&it);
+    const configRecord_t *record;
+    while ((record = nextConfigRecord(&it))) {
         if (pgN(reg) == record->pgn
-            && (record->flags & CR_CLASSIFICATION_MASK) == classification)
-            return record;
-        p += record->size;
+            && (record->flags & CR_CLASSIFICATION_MASK) == classification) {
+            found = record;
+        }
     }
-    // record not found
-    return NULL;
+    return found;
 }
 
+#define PG_BITMAP_WORDS ((PG_REGISTRY_MAX_COUNT + 31) / 32)
+
 // Initialize all PG records from EEPROM.
-// This functions processes all PGs sequentially, scanning EEPROM for each one. This is suboptimal,
-//   but each PG is loaded/initialized exactly once and in defined order.
+// The stored records are visited once, each looked up with pgFind(). Groups are loaded in the order they were stored,
+//   which for the image is registry order, a group that was also appended is loaded again from the later record.
+//   Groups without a record are reset to defaults after that.
 bool loadEEPROM(void)
 {
     bool success = true;
 
+    uint32_t found[PG_BITMAP_WORDS] = { 0 };
+    uint32_t loaded[PG_BITMAP_WORDS] = { 0 };
+
+    configRecordIterator_t it;
+    configRecordIteratorInit(&it);
+    const configRecord_t *rec;
+    while ((rec = nextConfigRecord(&it))) {
+        const pgRegistry_t *reg = pgFind(rec->pgn);
+        if (!reg || (rec->flags & CR_CLASSIFICATION_MASK) != CR_CLASSICATION_SYSTEM) {
+            continue;
+        }
+        const unsigned index = reg - __pg_registry_start;
+        if (index >= PG_REGISTRY_MAX_COUNT) {
+            continue;
+        }
+        found[index / 32] |= 1U << (index % 32);
+        // config from EEPROM is available, use it to initialize PG. pgLoad will handle version mismatch
+        if (pgLoad(reg, rec->pg, rec->size - offsetof(configRecord_t, pg), rec->version)) {
+            loaded[index / 32] |= 1U << (index % 32);
+        } else {
+            loaded[index / 32] &= ~(1U << (index % 32));
+        }
+    }
+
     PG_FOREACH(reg) {
-        const configRecord_t *rec = findEEPROM(reg, CR_CLASSICATION_SYSTEM);
-        if (rec) {
-            // config from EEPROM is available, use it to initialize PG. pgLoad will handle version mismatch
-            if (!pgLoad(reg, rec->pg, rec->size - offsetof(configRecord_t, pg), rec->version)) {
+        const unsigned index = reg - __pg_registry_start;
+        if (index >= PG_REGISTRY_MAX_COUNT) {
+            // beyond the bitmaps, look it up the slow way
+            rec = findEEPROM(reg, CR_CLASSICATION_SYSTEM);
+            if (!rec || !pgLoad(reg, rec->pg, rec->size - offsetof(configRecord_t, pg), rec->version)) {
+                if (!rec) {
+                    pgReset(reg);
+                }
                 success = false;
             }
-        } else {
+        } else if (!(found[index / 32] & (1U << (index % 32)))) {
             pgReset(reg);
 
+            success = false;
+        } else if (!(loaded[index / 32] & (1U << (index % 32)))) {
             success = false;
         }
         *reg->fnv_hash = fnv_update(FNV_OFFSET_BASIS, reg->address, pgSize(reg));
@@ -442,9 +608,72 @@ bool loadEEPROM(void)
     return success;
 }
 
-static bool writeSettingsToEEPROM(void)
+static bool isPgDirty(const pgRegistry_t *reg)
+{
+    return *reg->fnv_hash != fnv_update(FNV_OFFSET_BASIS, reg->address, pgSize(reg));
+}
+
+#ifdef USE_CONFIG_INCREMENTAL_SAVE
+static uint32_t appendedRecordSize(const pgRegistry_t *reg)
+{
+    return CONFIG_APPEND_ALIGN(sizeof(configRecord_t) + pgSize(reg) + sizeof(uint16_t));
+}
+
+// Appends a record for each changed group after the records already in the store, without touching the rest of it.
+// Returns false when they don't fit, the caller then compacts the store with a full write.
+static bool appendSettingsToEEPROM(void)
+{
+    uint32_t offset = configAppendEnd;
+    PG_FOREACH(reg) {
+        if (isPgDirty(reg)) {
+            offset += appendedRecordSize(reg);
+        }
+    }
+    if (offset > configRegionSize()) {
+        return false;
+    }
+    const uint32_t expectedEnd = offset;
+
+    config_streamer_t streamer;
+    config_streamer_init(&streamer);
+
+    config_streamer_start(&streamer, (uintptr_t)&__config_start + configAppendEnd, configRegionSize() - configAppendEnd);
+
+    uint16_t crc = configAppendCrc;
+    PG_FOREACH(reg) {
+        if (!isPgDirty(reg)) {
+            continue;
+        }
+        const uint16_t regSize = pgSize(reg);
+        configRecord_t record = {
+            .size = sizeof(configRecord_t) + regSize,
+            .pgn = pgN(reg),
+            .version = pgVersion(reg),
+            .flags = CR_CLASSICATION_SYSTEM,
+        };
+
+        config_streamer_write(&streamer, (uint8_t *)&record, sizeof(record));
+        crc = crc16_ccitt_update(crc, (uint8_t *)&record, sizeof(record));
+        config_streamer_write(&streamer, reg->address, regSize);
+        crc = crc16_ccitt_update(crc, reg->address, regSize);
+        config_streamer_write(&streamer, (uint8_t *)&crc, sizeof(crc));
+        // the next record starts on a fresh word, so no word is ever programmed twice
+        config_streamer_flush(&streamer);
+    }
+
+    if (config_streamer_finish(&streamer) != 0) {
+        return false;
+    }
+
+    // everything appended must now be part of the chain
+    return isEEPROMStructureValid() && configAppendEnd == expectedEnd;
+}
+#endif
+
+static bool writeSettingsToEEPROM(bool allowAppend)
 {
-    bool dirtyConfig = !isEEPROMVersionValid() || !isEEPROMStructureValid();
+    const bool validStore = isEEPROMVersionValid() && isEEPROMStructureValid();
+    bool dirtyConfig = !validStore;
 
     configHeader_t header = {
         .eepromConfigVersion =  EEPROM_CONF_VERSION,
@@ -452,54 +681,70 @@ static bool writeSettingsToEEPROM(void)
     };
 
     PG_FOREACH(reg) {
-        if (*reg->fnv_hash != fnv_update(FNV_OFFSET_BASIS, reg->address, pgSize(reg))) {
+        if (isPgDirty(reg)) {
             dirtyConfig = true;
         }
     }
 
     // Only write the config if it has changed
-    if (dirtyConfig) {
-        config_streamer_t streamer;
-        config_streamer_init(&streamer);
+    if (!dirtyConfig) {
+        return true;
+    }
 
-        config_streamer_start(&streamer, (uintptr_t)&__config_start, (const uint8_t*)&__config_end - (const uint8_t*)&__config_start);
+#ifdef USE_CONFIG_INCREMENTAL_SAVE
+    if (allowAppend && validStore && configAppendStart && appendSettingsToEEPROM()) {
+        return true;
+    }
+#else
+    UNUSED(allowAppend);
+#endif
 
-        config_streamer_write(&streamer, (uint8_t *)&header, sizeof(header));
-        uint16_t crc = CRC_START_VALUE;
-        crc = crc16_ccitt_update(crc, (uint8_t *)&header, sizeof(header));
-        PG_FOREACH(reg) {
-            const uint16_t regSize = pgSize(reg);
-            configRecord_t record = {
-                .size = sizeof(configRecord_t) + regSize,
-                .pgn = pgN(reg),
-                .version = pgVersion(reg),
-                .flags = 0,
-            };
-
-            record.flags |= CR_CLASSICATION_SYSTEM;
-            config_streamer_write(&streamer, (uint8_t *)&record, sizeof(record));
-            crc = crc16_ccitt_update(crc, (uint8_t *)&record, sizeof(record));
-            config_streamer_write(&streamer, reg->address, regSize);
-            crc = crc16_ccitt_update(crc, reg->address, regSize);
-        }
+    config_streamer_t streamer;
+    config_streamer_init(&streamer);
 
-        configFooter_t footer = {
-            .terminator = 0,
+    config_streamer_start(&streamer, (uintptr_t)&__config_start, (const uint8_t*)&__config_end - (const uint8_t*)&__config_start);
+
+    config_streamer_write(&streamer, (uint8_t *)&header, sizeof(header));
+    uint16_t crc = CRC_START_VALUE;
+    crc = crc16_ccitt_update(crc, (uint8_t *)&header, sizeof(header));
+    PG_FOREACH(reg) {
+        const uint16_t regSize = pgSize(reg);
+        configRecord_t record = {
+            .size = sizeof(configRecord_t) + regSize,
+            .pgn = pgN(reg),
+            .version = pgVersion(reg),
+            .flags = 0,
         };
 
-        config_streamer_write(&streamer, (uint8_t *)&footer, sizeof(footer));
-        crc = crc16_ccitt_update(crc, (uint8_t *)&footer, sizeof(footer));
+        record.flags |= CR_CLASSICATION_SYSTEM;
+        config_streamer_write(&streamer, (uint8_t *)&record, sizeof(record));
+        crc = crc16_ccitt_update(crc, (uint8_t *)&record, sizeof(record));
+        config_streamer_write(&streamer, reg->address, regSize);
+        crc = crc16_ccitt_update(crc, reg->address, regSize);
+    }
 
-        // include inverted CRC in big endian format in the CRC
-        const uint16_t invertedBigEndianCrc = ~(((crc & 0xFF) << 8) | (crc >> 8));
-        config_streamer_write(&streamer, (uint8_t *)&invertedBigEndianCrc, sizeof(crc));
+    configFooter_t footer = {
+        .terminator = 0,
+    };
 
-        config_streamer_flush(&streamer);
+    config_streamer_write(&streamer, (uint8_t *)&footer, sizeof(footer));
+    crc = crc16_ccitt_update(crc, (uint8_t *)&footer, sizeof(footer));
 
-        return (config_streamer_finish(&streamer) == 0);
-    } else {
-        return true;
-    }
+    // include inverted CRC in big endian format in the CRC
+    const uint16_t invertedBigEndianCrc = ~(((crc & 0xFF) << 8) | (crc >> 8));
+    config_streamer_write(&streamer, (uint8_t *)&invertedBigEndianCrc, sizeof(crc));
+
+#ifdef USE_CONFIG_INCREMENTAL_SAVE
+    configAppendHeader_t appendHeader = {
+        .magic = CONFIG_APPEND_MAGIC,
+        .generation = validStore && configAppendStart ? configAppendGeneration + 1 : 0,
+    };
+    config_streamer_write(&streamer, (uint8_t *)&appendHeader, sizeof(appendHeader));
+#endif
+
+    config_streamer_flush(&streamer);
+
+    return (config_streamer_finish(&streamer) == 0);
 }
 
 void writeConfigToEEPROM(void)
@@ -507,7 +752,8 @@ void writeConfigToEEPROM(void)
     bool success = false;
     // write it
     for (int attempt = 0; attempt < 3 && !success; attempt++) {
-        if (writeSettingsToEEPROM() && isEEPROMVersionValid() && isEEPROMStructureValid()) {
+        // a failed append is retried as a full write
+        if (writeSettingsToEEPROM(attempt == 0) && isEEPROMVersionValid() && isEEPROMStructureValid()) {
             success = true;
 
 #if defined(CONFIG_IN_EXTERNAL_FLASH) || defined(CONFIG_IN_MEMORY_MAPPED_FLASH)
@@ -522,6 +768,10 @@ void writeConfigToEEPROM(void)
     }
 
     if (success) {
+        // the stored config now matches, so only groups changed after this are written by the next save
+        PG_FOREACH(reg) {
+            *reg->fnv_hash = fnv_update(FNV_OFFSET_BASIS, reg->address, pgSize(reg));
+        }
         return;
     }
 
@@ -49,6 +49,14 @@ uint16_t bbBuffer[134];
 #define BITBAND_SRAM_BASE  0x22000000
 #define BITBAND_SRAM(a,b) ((BITBAND_SRAM_BASE + (((a)-BITBAND_SRAM_REF)<<5) + ((b)<<2)))  // Convert SRAM address
 
+#ifdef UNIT_TEST
+// The alias region only exists on the MCU, tests provide an emulated one
+uint32_t *bitBandAlias(uint16_t buffer[], uint32_t bit);
+#define BITBAND_ALIAS(a,b) bitBandAlias(a, b)
+#else
+#define BITBAND_ALIAS(a,b) BITBAND_SRAM((uint32_t)(a), b)
+#endif
+
 // Period at which to check preamble length
 #define MARGIN_CHECK_INTERVAL_US 500000
 
@@ -70,7 +78,7 @@ uint32_t sequence[MAX_GCR_EDGES];
 int sequenceIndex = 0;
 #endif
 
-static uint32_t decode_bb_value(uint32_t value, uint16_t buffer[], uint32_t count, uint32_t bit)
+static uint32_t decode_bb_value(uint32_t value, const uint16_t buffer[], uint32_t count, uint32_t bit)
 {
 #ifndef DEBUG_BBDECODE
     UNUSED(buffer);
@@ -108,6 +116,26 @@ static uint32_t decode_bb_value(uint32_t value, uint16_t buffer[], uint32_t coun
     return value;
 }
 
+static void updatePreambleSkip(timeUs_t now)
+{
+    if (cmpTimeUs(now, nextMarginCheckUs) >= 0) {
+        nextMarginCheckUs += MARGIN_CHECK_INTERVAL_US;
+
+        // Handle a skipped check
+        if (nextMarginCheckUs < now) {
+            nextMarginCheckUs = now + DSHOT_TELEMETRY_START_MARGIN;
+        }
+
+        if (minMargin > DSHOT_TELEMETRY_START_MARGIN) {
+            preambleSkip = minMargin - DSHOT_TELEMETRY_START_MARGIN;
+        } else {
+            preambleSkip = 0;
+        }
+
+        minMargin = UINT32_MAX;
+    }
+}
+
 #ifdef USE_DSHOT_BITBAND
 uint32_t decode_bb_bitband( uint16_t buffer[], uint32_t count, uint32_t bit)
 {
@@ -118,7 +146,7 @@ uint32_t decode_bb_bitband( uint16_t buffer[], uint32_t count, uint32_t bit)
 #endif
     uint32_t value = 0;
 
-    bitBandWord_t* p = (bitBandWord_t*)BITBAND_SRAM((uint32_t)buffer, bit);
+    bitBandWord_t* p = (bitBandWord_t*)BITBAND_ALIAS(buffer, bit);
     bitBandWord_t* b = p;
     bitBandWord_t* endP = p + (count - MIN_VALID_BBSAMPLES);
 
@@ -228,23 +256,7 @@ uint32_t decode_bb_bitband( uint16_t buffer[], uint32_t count, uint32_t bit)
     if (startMargin < minMargin) {
         minMargin = startMargin;
     }
-
-    if (cmpTimeUs(now, nextMarginCheckUs) >= 0) {
-        nextMarginCheckUs += MARGIN_CHECK_INTERVAL_US;
-
-        // Handle a skipped check
-        if (nextMarginCheckUs < now) {
-            nextMarginCheckUs = now + DSHOT_TELEMETRY_START_MARGIN;
-        }
-
-        if (minMargin > DSHOT_TELEMETRY_START_MARGIN) {
-            preambleSkip = minMargin - DSHOT_TELEMETRY_START_MARGIN;
-        } else {
-            preambleSkip = 0;
-        }
-
-        minMargin = UINT32_MAX;
-    }
+    updatePreambleSkip(now);
 
 #ifdef DEBUG_BBDECODE
     sequence[sequenceIndex] = sequence[sequenceIndex] + (nlen) * 3;
@@ -359,23 +371,7 @@ FAST_CODE uint32_t decode_bb( uint16_t buffer[], uint32_t count, uint32_t bit)
     if (startMargin < minMargin) {
         minMargin = startMargin;
     }
-
-    if (cmpTimeUs(now, nextMarginCheckUs) >= 0) {
-        nextMarginCheckUs += MARGIN_CHECK_INTERVAL_US;
-
-        // Handle a skipped check
-        if (nextMarginCheckUs < now) {
-            nextMarginCheckUs = now + DSHOT_TELEMETRY_START_MARGIN;
-        }
-
-        if (minMargin > DSHOT_TELEMETRY_START_MARGIN) {
-            preambleSkip = minMargin - DSHOT_TELEMETRY_START_MARGIN;
-        } else {
-            preambleSkip = 0;
-        }
-
-        minMargin = UINT32_MAX;
-    }
+    updatePreambleSkip(now);
 
 #ifdef DEBUG_BBDECODE
     sequence[sequenceIndex] = sequence[sequenceIndex] + (nlen) * 3;
@@ -392,4 +388,134 @@ FAST_CODE uint32_t decode_bb( uint16_t buffer[], uint32_t count, uint32_t bit)
 }
 #endif // USE_DSHOT_BITBAND
 
+// Bit-band targets decode each motor through its alias, the port decoder is only built to be checked against it
+#if !defined(USE_DSHOT_BITBAND) || defined(UNIT_TEST)
+
+// State of one pin while decode_bb_port() walks the port input buffer
+typedef struct bbDecodePin_s {
+    uint32_t value;
+    uint32_t bits;
+    uint32_t startMargin;
+    uint32_t lastEdge;          // sample index of the last transition
+    uint32_t endEdge;           // last sample index at which a transition belongs to this frame
+} bbDecodePin_t;
+
+// Adds the transitions at sample index of every pin in edges
+static inline void decode_bb_port_edges(bbDecodePin_t pins[], uint32_t edges, uint32_t index)
+{
+    while (edges) {
+        bbDecodePin_t *state = &pins[__builtin_ctz(edges)];
+        edges &= edges - 1;
+        if (index <= state->endEdge) {
+            // A level of length n gets decoded to a sequence of bits of
+            // the form 1000 with a length of (n+1) / 3 to account for 3x
+            // oversampling.
+            const int len = MAX((int)(index - state->lastEdge + 1) / 3, 1);
+            state->bits += len;
+            state->value <<= len;
+            state->value |= 1 << (len - 1);
+            state->lastEdge = index;
+        }
+    }
+}
+
+// Decodes the telemetry of every pin in pinMask in a single walk of the port input buffer. Transitions of
+// all pins are found at once from the XOR of consecutive samples. values[] is indexed by pin, results are
+// as returned by decode_bb().
+FAST_CODE void decode_bb_port(const uint16_t buffer[], uint32_t count, uint32_t pinMask, uint32_t values[DSHOT_BB_DECODE_PIN_COUNT])
+{
+    timeUs_t now = micros();
+    bbDecodePin_t pins[DSHOT_BB_DECODE_PIN_COUNT];
+
+    pinMask &= (1 << DSHOT_BB_DECODE_PIN_COUNT) - 1;
+
+    // The start bit must leave room for a minimal frame
+    const uint32_t startEnd = count > MIN_VALID_BBSAMPLES + 1 ? count - MIN_VALID_BBSAMPLES - 1 : 0;
+
+    uint32_t waiting = pinMask;         // pins still looking for the leading edge of their start bit
+    uint32_t started = 0;
+    uint32_t lastEnd = 0;
+    uint32_t previous = 0;
+
+    DEBUG_SET(DEBUG_DSHOT_TELEMETRY_COUNTS, 3, preambleSkip);
+
+    // Jump forward in the buffer to just before where we anticipate the first zero, then look for the
+    // first zero of each pin
+    uint32_t i = preambleSkip;
+    for (; waiting && i < startEnd; i++) {
+        const uint32_t sample = buffer[i];
+
+        decode_bb_port_edges(pins, (sample ^ previous) & started, i);
+        previous = sample;
+
+        uint32_t low = ~sample & waiting;
+        waiting &= ~low;
+        started |= low;
+        while (low) {
+            bbDecodePin_t *state = &pins[__builtin_ctz(low)];
+            low &= low - 1;
+            state->value = 0;
+            state->bits = 0;
+            state->startMargin = i + 1;
+            state->lastEdge = i;
+            state->endEdge = i + MIN(count - (i + 1), (unsigned int)MAX_VALID_BBSAMPLES) - 1;
+            lastEnd = state->endEdge;
+        }
+    }
+
+    // All frames have started, pins that didn't start have no telemetry
+    for (; i <= lastEnd && started; i++) {
+        const uint32_t sample = buffer[i];
+        const uint32_t edges = (sample ^ previous) & started;
+        previous = sample;
+        if (edges) {
+            decode_bb_port_edges(pins, edges, i);
+        }
+    }
+
+    bool valid = false;
+    for (uint32_t remaining = pinMask; remaining; remaining &= remaining - 1) {
+        const unsigned pin = __builtin_ctz(remaining);
+        const bbDecodePin_t *state = &pins[pin];
+
+        values[pin] = DSHOT_TELEMETRY_NOEDGE;
+
+        if (!(started & (1 << pin))) {
+            // not returning telemetry is ok if the esc cpu is overburdened
+            if (preambleSkip > 0) {
+                // Increase the start margin
+                preambleSkip--;
+            }
+            continue;
+        }
+
+        // length of last sequence has to be inferred since the last bit with inverted dshot is high
+        const int nlen = 21 - (int)state->bits;
+        if (state->bits < 18 || nlen < 0) {
+            continue;
+        }
+
+        // Data appears valid
+        if (state->startMargin < minMargin) {
+            minMargin = state->startMargin;
+        }
+        valid = true;
+
+        uint32_t value = state->value;
+        // The anticipated edges were observed
+        if (nlen > 0) {
+            value <<= nlen;
+            value |= 1 << (nlen - 1);
+        }
+
+        values[pin] = decode_bb_value(value, buffer, count, pin);
+    }
+
+    if (valid) {
+        updatePreambleSkip(now);
+    }
+}
+
+#endif // !USE_DSHOT_BITBAND || UNIT_TEST
+
 #endif
@@ -22,10 +22,15 @@
 
 #if defined(USE_DSHOT) && defined(USE_DSHOT_TELEMETRY)
 
+#define DSHOT_BB_DECODE_PIN_COUNT 16    // pins of one GPIO port
+
 #ifdef USE_DSHOT_BITBAND
 uint32_t decode_bb_bitband( uint16_t buffer[], uint32_t count, uint32_t bit);
 #else
 uint32_t decode_bb(uint16_t buffer[], uint32_t count, uint32_t mask);
 #endif
+#if !defined(USE_DSHOT_BITBAND) || defined(UNIT_TEST)
+void decode_bb_port(const uint16_t buffer[], uint32_t count, uint32_t pinMask, uint32_t values[DSHOT_BB_DECODE_PIN_COUNT]);
+#endif
 
 #endif
@@ -34,6 +34,7 @@
 #include "drivers/flash/flash_w25n.h"
 #include "drivers/flash/flash_w25q128fv.h"
 #include "drivers/flash/flash_w25m.h"
+#include "drivers/flash/flash_virtual.h"
 #include "drivers/bus_spi.h"
 #include "drivers/bus_quadspi.h"
 #include "drivers/bus_octospi.h"
@@ -390,6 +391,12 @@ static bool flashDeviceInit(const flashConfig_t *flashConfig)
     }
 #endif
 
+#ifdef USE_FLASH_VIRTUAL
+    if (!haveFlash) {
+        haveFlash = virtualFlash_identify(&flashDevice);
+    }
+#endif
+
     if (haveFlash && flashDevice.vTable->configure) {
         uint32_t configurationFlags = 0;
 
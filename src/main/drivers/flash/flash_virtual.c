@@ -0,0 +1,506 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "platform.h"
+
+#ifdef USE_FLASH_VIRTUAL
+
+#include "common/maths.h"
+#include "common/time.h"
+
+#include "drivers/flash/flash.h"
+#include "drivers/flash/flash_impl.h"
+#include "drivers/system.h"
+#include "drivers/time.h"
+
+#include "drivers/flash/flash_virtual.h"
+
+/*
+ * Simulated SPI flash chip backed by a memory mapped file, so its content survives a restart like a real chip.
+ *
+ * Programming can only clear bits, erasing sets a whole sector to 0xFF. Program and erase operations leave the
+ * device busy for a modelled time, measured with the cycle counter so that busy-waits also terminate in lockstep
+ * mode where polling the cycle counter advances virtual time. As with the real drivers every operation first waits
+ * for the previous one to complete.
+ *
+ * NOR devices program the bytes given straight away, taking a time proportional to their count.
+ * NAND devices collect the data in the page buffer of the chip and program the page once it is complete or on
+ * flush(), taking the full page program time, like the W25N01G.
+ */
+
+// Defaults are a Winbond W25Q128 16MB NOR flash
+#define VIRTUAL_FLASH_NOR_JEDEC_ID          0xEF4018
+#define VIRTUAL_FLASH_NOR_PAGE_SIZE         256
+#define VIRTUAL_FLASH_NOR_PAGES_PER_SECTOR  256
+#define VIRTUAL_FLASH_NOR_SECTORS           256
+#define VIRTUAL_FLASH_NOR_PROGRAM_US        700     // tPP typ for a whole page
+#define VIRTUAL_FLASH_NOR_ERASE_US          150000  // tBE2 typ for a 64kB block
+
+// Winbond W25N01G 128MB NAND flash
+#define VIRTUAL_FLASH_NAND_JEDEC_ID         0xEFAA21
+#define VIRTUAL_FLASH_NAND_PAGE_SIZE        2048
+#define VIRTUAL_FLASH_NAND_PAGES_PER_SECTOR 64
+#define VIRTUAL_FLASH_NAND_SECTORS          1024
+#define VIRTUAL_FLASH_NAND_PROGRAM_US       250     // tPP typ
+#define VIRTUAL_FLASH_NAND_ERASE_US         2000    // tBE typ
+
+#define VIRTUAL_FLASH_MIN_PAGE_SIZE         16
+#define VIRTUAL_FLASH_MAX_SIZE              (1024U * 1024 * 1024)
+#define VIRTUAL_FLASH_MAX_BUSY_US           (1000U * 1000 * 1000)
+#define VIRTUAL_FLASH_STATUS_POLL_US        1
+
+const flashVTable_t virtualFlash_vTable;
+
+// There is no chip until a file or geometry is given, so a plain SITL start doesn't create a flash image
+static const char *virtualFlashFilename;
+static flashType_e virtualFlashType = FLASH_TYPE_NOR;
+static uint16_t virtualFlashPageSize = VIRTUAL_FLASH_NOR_PAGE_SIZE;
+static uint16_t virtualFlashPagesPerSector = VIRTUAL_FLASH_NOR_PAGES_PER_SECTOR;
+static flashSector_t virtualFlashSectors = VIRTUAL_FLASH_NOR_SECTORS;
+// 0 selects the default of the flash type
+static uint32_t virtualFlashProgramUs;
+static uint32_t virtualFlashEraseUs;
+
+static int virtualFlashFd = -1;
+static uint8_t *virtualFlashArray;
+static uint32_t virtualFlashBusyUntil;      // cycle counter
+
+// Page buffer of a NAND device
+static uint8_t virtualFlashPageBuffer[FLASH_MAX_PAGE_SIZE];
+static uint32_t virtualFlashPageBufferAddress;
+static bool virtualFlashPageBufferDirty;
+
+static virtualFlashStats_t virtualFlashStats;
+
+// NULL removes the chip
+void virtualFlashSetFile(const char *filename)
+{
+    virtualFlashFilename = filename;
+}
+
+/*
+ * Set the geometry from "nor", "nand" or "<page size>,<pages per sector>,<sectors>[,nand]".
+ * Adds the chip, backed by VIRTUAL_FLASH_FILENAME unless a file was given. Must be called before the flash is initialised.
+ */
+bool virtualFlashSetGeometry(const char *spec)
+{
+    unsigned pageSize;
+    unsigned pagesPerSector;
+    unsigned sectors;
+    char type[8] = "nor";
+
+    if (strcmp(spec, "nor") == 0) {
+        pageSize = VIRTUAL_FLASH_NOR_PAGE_SIZE;
+        pagesPerSector = VIRTUAL_FLASH_NOR_PAGES_PER_SECTOR;
+        sectors = VIRTUAL_FLASH_NOR_SECTORS;
+    } else if (strcmp(spec, "nand") == 0) {
+        pageSize = VIRTUAL_FLASH_NAND_PAGE_SIZE;
+        pagesPerSector = VIRTUAL_FLASH_NAND_PAGES_PER_SECTOR;
+        sectors = VIRTUAL_FLASH_NAND_SECTORS;
+        strcpy(type, "nand");
+    } else if (sscanf(spec, "%u,%u,%u,%7s", &pageSize, &pagesPerSector, &sectors, type) < 3) {
+        return false;
+    }
+
+    const bool isNand = (strcmp(type, "nand") == 0);
+    if ((!isNand && strcmp(type, "nor") != 0)
+        || pageSize < VIRTUAL_FLASH_MIN_PAGE_SIZE || pageSize > FLASH_MAX_PAGE_SIZE || (pageSize & (pageSize - 1))
+        || pagesPerSector == 0 || pagesPerSector > UINT16_MAX
+        || sectors == 0 || sectors > UINT16_MAX
+        || (uint64_t)pageSize * pagesPerSector * sectors > VIRTUAL_FLASH_MAX_SIZE) {
+        return false;
+    }
+
+    virtualFlashType = isNand ? FLASH_TYPE_NAND : FLASH_TYPE_NOR;
+    virtualFlashPageSize = pageSize;
+    virtualFlashPagesPerSector = pagesPerSector;
+    virtualFlashSectors = sectors;
+
+    if (!virtualFlashFilename) {
+        virtualFlashFilename = VIRTUAL_FLASH_FILENAME;
+    }
+
+    return true;
+}
+
+/*
+ * Set the page program and sector erase time from "<program us>,<erase us>".
+ */
+bool virtualFlashSetTiming(const char *spec)
+{
+    unsigned programUs;
+    unsigned eraseUs;
+
+    if (sscanf(spec, "%u,%u", &programUs, &eraseUs) != 2
+        || programUs > VIRTUAL_FLASH_MAX_BUSY_US || eraseUs > VIRTUAL_FLASH_MAX_BUSY_US) {
+        return false;
+    }
+
+    // Zero would select the default, a device without any latency is modelled with 1us
+    virtualFlashProgramUs = MAX(programUs, 1U);
+    virtualFlashEraseUs = MAX(eraseUs, 1U);
+
+    return true;
+}
+
+static void virtualFlashSetBusy(flashDevice_t *fdevice, uint32_t busyUs)
+{
+    busyUs = MIN(busyUs, VIRTUAL_FLASH_MAX_BUSY_US);
+
+    virtualFlashBusyUntil = getCycleCounter() + clockMicrosToCycles(busyUs);
+    fdevice->couldBeBusy = true;
+
+    virtualFlashStats.busyUs += busyUs;
+}
+
+static bool virtualFlash_isReady(flashDevice_t *fdevice)
+{
+    if (!fdevice->couldBeBusy) {
+        return true;
+    }
+
+    if (cmpTimeCycles(getCycleCounter(), virtualFlashBusyUntil) < 0) {
+        // Reading the status register takes time, so that callers polling a busy device make progress
+        delayMicroseconds(VIRTUAL_FLASH_STATUS_POLL_US);
+        virtualFlashStats.busyPolls++;
+        return false;
+    }
+
+    fdevice->couldBeBusy = false;
+
+    return true;
+}
+
+static bool virtualFlash_waitForReady(flashDevice_t *fdevice)
+{
+    while (!virtualFlash_isReady(fdevice));
+
+    return true;
+}
+
+// Programming can only clear bits
+static void virtualFlashProgramArray(uint32_t address, const uint8_t *data, uint32_t length)
+{
+    uint8_t *dest = virtualFlashArray + address;
+
+    for (uint32_t i = 0; i < length; i++) {
+        dest[i] &= data[i];
+    }
+}
+
+static void virtualFlashProgramExecute(flashDevice_t *fdevice)
+{
+    virtualFlash_waitForReady(fdevice);
+
+    virtualFlashProgramArray(virtualFlashPageBufferAddress, virtualFlashPageBuffer, fdevice->geometry.pageSize);
+    virtualFlashPageBufferDirty = false;
+
+    virtualFlashSetBusy(fdevice, virtualFlashProgramUs);
+    virtualFlashStats.programCount++;
+}
+
+// Load data, which must not cross a page boundary, into the page buffer of a NAND device
+static void virtualFlashProgramDataLoad(flashDevice_t *fdevice, uint32_t address, const uint8_t *data, uint32_t length)
+{
+    const uint32_t pageSize = fdevice->geometry.pageSize;
+    const uint32_t pageAddress = address & ~(pageSize - 1);
+
+    if (virtualFlashPageBufferDirty && pageAddress != virtualFlashPageBufferAddress) {
+        // The previous page was left incomplete
+        virtualFlashProgramExecute(fdevice);
+    }
+
+    if (!virtualFlashPageBufferDirty) {
+        memset(virtualFlashPageBuffer, 0xff, pageSize);
+        virtualFlashPageBufferAddress = pageAddress;
+        virtualFlashPageBufferDirty = true;
+    }
+
+    memcpy(&virtualFlashPageBuffer[address - pageAddress], data, length);
+
+    if (address + length == pageAddress + pageSize) {
+        virtualFlashProgramExecute(fdevice);
+    }
+}
+
+// Program data which may span several pages, a NOR device is programmed once all the data of a command is sent
+static void virtualFlashProgram(flashDevice_t *fdevice, uint32_t address, const uint8_t *data, uint32_t length)
+{
+    const uint32_t pageSize = fdevice->geometry.pageSize;
+
+    virtualFlashStats.bytesProgrammed += length;
+
+    if (fdevice->geometry.flashType == FLASH_TYPE_NOR) {
+        virtualFlashProgramArray(address, data, length);
+    } else {
+        while (length) {
+            const uint32_t chunk = MIN(length, pageSize - (address & (pageSize - 1)));
+
+            virtualFlashProgramDataLoad(fdevice, address, data, chunk);
+
+            address += chunk;
+            data += chunk;
+            length -= chunk;
+        }
+    }
+}
+
+static void virtualFlash_eraseSector(flashDevice_t *fdevice, uint32_t address)
+{
+    const uint32_t sectorSize = fdevice->geometry.sectorSize;
+
+    virtualFlash_waitForReady(fdevice);
+
+    address -= address % sectorSize;
+    if (address < fdevice->geometry.totalSize) {
+        memset(virtualFlashArray + address, 0xff, sectorSize);
+    }
+
+    virtualFlashSetBusy(fdevice, virtualFlashEraseUs);
+    virtualFlashStats.eraseCount++;
+}
+
+static void virtualFlash_eraseCompletely(flashDevice_t *fdevice)
+{
+    virtualFlash_waitForReady(fdevice);
+
+    memset(virtualFlashArray, 0xff, fdevice->geometry.totalSize);
+    virtualFlashPageBufferDirty = false;
+
+    virtualFlashSetBusy(fdevice, MIN((uint64_t)virtualFlashEraseUs * fdevice->geometry.sectors, VIRTUAL_FLASH_MAX_BUSY_US));
+    virtualFlashStats.eraseCount++;
+}
+
+static void virtualFlash_pageProgramBegin(flashDevice_t *fdevice, uint32_t address, void (*callback)(uint32_t length))
+{
+    fdevice->callback = callback;
+    fdevice->currentWriteAddress = address;
+}
+
+// There is no transfer to wait for, so the callback is called before returning
+static uint32_t virtualFlash_pageProgramContinue(flashDevice_t *fdevice, uint8_t const **buffers, const uint32_t *bufferSizes, uint32_t bufferCount)
+{
+    const bool isNor = fdevice->geometry.flashType == FLASH_TYPE_NOR;
+    uint32_t bytesWritten = 0;
+
+    if (isNor) {
+        virtualFlash_waitForReady(fdevice);
+    }
+
+    for (uint32_t i = 0; i < bufferCount; i++) {
+        const uint32_t address = fdevice->currentWriteAddress + bytesWritten;
+        if (address >= fdevice->geometry.totalSize) {
+            break;
+        }
+        const uint32_t length = MIN(bufferSizes[i], fdevice->geometry.totalSize - address);
+
+        virtualFlashProgram(fdevice, address, buffers[i], length);
+        bytesWritten += length;
+    }
+
+    if (isNor && bytesWritten) {
+        const uint32_t pageSize = fdevice->geometry.pageSize;
+
+        virtualFlashSetBusy(fdevice, (virtualFlashProgramUs * bytesWritten + pageSize - 1) / pageSize);
+        virtualFlashStats.programCount++;
+    }
+
+    fdevice->currentWriteAddress += bytesWritten;
+    fdevice->callbackArg = bytesWritten;
+
+    if (fdevice->callback) {
+        fdevice->callback(bytesWritten);
+    }
+
+    return bytesWritten;
+}
+
+static void virtualFlash_pageProgramFinish(flashDevice_t *fdevice)
+{
+    UNUSED(fdevice);
+}
+
+static void virtualFlash_pageProgram(flashDevice_t *fdevice, uint32_t address, const uint8_t *data, uint32_t length, void (*callback)(uint32_t length))
+{
+    virtualFlash_pageProgramBegin(fdevice, address, callback);
+
+    virtualFlash_pageProgramContinue(fdevice, &data, &length, 1);
+
+    virtualFlash_pageProgramFinish(fdevice);
+}
+
+// Program an incomplete page of a NAND device
+static void virtualFlash_flush(flashDevice_t *fdevice)
+{
+    if (virtualFlashPageBufferDirty) {
+        virtualFlashProgramExecute(fdevice);
+    }
+}
+
+// As on a real NAND device data still in the page buffer isn't read back
+static int virtualFlash_readBytes(flashDevice_t *fdevice, uint32_t address, uint8_t *buffer, uint32_t length)
+{
+    virtualFlash_waitForReady(fdevice);
+
+    if (address >= fdevice->geometry.totalSize) {
+        return 0;
+    }
+    length = MIN(length, fdevice->geometry.totalSize - address);
+
+    memcpy(buffer, virtualFlashArray + address, length);
+
+    return length;
+}
+
+static const flashGeometry_t *virtualFlash_getGeometry(flashDevice_t *fdevice)
+{
+    return &fdevice->geometry;
+}
+
+bool virtualFlash_identify(flashDevice_t *fdevice)
+{
+    flashGeometry_t *geometry = &fdevice->geometry;
+
+    const uint32_t totalSize = (uint32_t)virtualFlashPageSize * virtualFlashPagesPerSector * virtualFlashSectors;
+
+    virtualFlashClose();
+
+    if (!virtualFlashFilename) {
+        return false;
+    }
+
+    virtualFlashFd = open(virtualFlashFilename, O_RDWR | O_CREAT, 0644);
+    if (virtualFlashFd < 0) {
+        perror("[flash] open");
+        return false;
+    }
+
+    struct stat st;
+    off_t fileSize = 0;
+    if (fstat(virtualFlashFd, &st) == 0) {
+        fileSize = st.st_size;
+    }
+    if (fileSize < totalSize && ftruncate(virtualFlashFd, totalSize) != 0) {
+        perror("[flash] ftruncate");
+        close(virtualFlashFd);
+        virtualFlashFd = -1;
+        return false;
+    }
+
+    void *array = mmap(NULL, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, virtualFlashFd, 0);
+    if (array == MAP_FAILED) {
+        perror("[flash] mmap");
+        close(virtualFlashFd);
+        virtualFlashFd = -1;
+        return false;
+    }
+    virtualFlashArray = array;
+
+    // A new or extended file starts erased
+    if (fileSize < totalSize) {
+        memset(virtualFlashArray + fileSize, 0xff, totalSize - fileSize);
+    }
+
+    const bool isNand = (virtualFlashType == FLASH_TYPE_NAND);
+    if (!virtualFlashProgramUs) {
+        virtualFlashProgramUs = isNand ? VIRTUAL_FLASH_NAND_PROGRAM_US : VIRTUAL_FLASH_NOR_PROGRAM_US;
+    }
+    if (!virtualFlashEraseUs) {
+        virtualFlashEraseUs = isNand ? VIRTUAL_FLASH_NAND_ERASE_US : VIRTUAL_FLASH_NOR_ERASE_US;
+    }
+
+    geometry->flashType = virtualFlashType;
+    geometry->jedecId = isNand ? VIRTUAL_FLASH_NAND_JEDEC_ID : VIRTUAL_FLASH_NOR_JEDEC_ID;
+    geometry->pageSize = virtualFlashPageSize;
+    geometry->pagesPerSector = virtualFlashPagesPerSector;
+    geometry->sectors = virtualFlashSectors;
+    geometry->sectorSize = geometry->pagesPerSector * geometry->pageSize;
+    geometry->totalSize = totalSize;
+
+    fdevice->couldBeBusy = false;
+    fdevice->vTable = &virtualFlash_vTable;
+
+    virtualFlashPageBufferDirty = false;
+
+    printf("[flash] %s flash '%s', %u sectors of %u pages of %u bytes, program %uus erase %uus\n",
+           isNand ? "NAND" : "NOR", virtualFlashFilename, geometry->sectors, geometry->pagesPerSector,
+           geometry->pageSize, virtualFlashProgramUs, virtualFlashEraseUs);
+
+    return true;
+}
+
+// Unmap the file, data in the page buffer of a NAND device is lost as on power down
+void virtualFlashClose(void)
+{
+    if (virtualFlashFd < 0) {
+        return;
+    }
+
+    if (virtualFlashStats.programCount || virtualFlashStats.eraseCount) {
+        printf("[flash] %llu bytes in %u programs, %u erases, busy for %llums, %u busy polls\n",
+               (unsigned long long)virtualFlashStats.bytesProgrammed, virtualFlashStats.programCount,
+               virtualFlashStats.eraseCount, (unsigned long long)virtualFlashStats.busyUs / 1000,
+               virtualFlashStats.busyPolls);
+    }
+
+    const uint32_t totalSize = (uint32_t)virtualFlashPageSize * virtualFlashPagesPerSector * virtualFlashSectors;
+    msync(virtualFlashArray, totalSize, MS_SYNC);
+    munmap(virtualFlashArray, totalSize);
+    virtualFlashArray = NULL;
+
+    close(virtualFlashFd);
+    virtualFlashFd = -1;
+}
+
+const virtualFlashStats_t *virtualFlashGetStats(void)
+{
+    return &virtualFlashStats;
+}
+
+void virtualFlashResetStats(void)
+{
+    memset(&virtualFlashStats, 0, sizeof(virtualFlashStats));
+}
+
+const flashVTable_t virtualFlash_vTable = {
+    .isReady = virtualFlash_isReady,
+    .waitForReady = virtualFlash_waitForReady,
+    .eraseSector = virtualFlash_eraseSector,
+    .eraseCompletely = virtualFlash_eraseCompletely,
+    .pageProgramBegin = virtualFlash_pageProgramBegin,
+    .pageProgramContinue = virtualFlash_pageProgramContinue,
+    .pageProgramFinish = virtualFlash_pageProgramFinish,
+    .pageProgram = virtualFlash_pageProgram,
+    .flush = virtualFlash_flush,
+    .readBytes = virtualFlash_readBytes,
+    .getGeometry = virtualFlash_getGeometry,
+};
+
+#endif // USE_FLASH_VIRTUAL
@@ -0,0 +1,48 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "flash_impl.h"
+
+#if defined(USE_FLASH_VIRTUAL) && !defined(SIMULATOR_BUILD) && !defined(UNIT_TEST)
+#error "USE_FLASH_VIRTUAL valid for SITL build only"
+#endif
+
+#define VIRTUAL_FLASH_FILENAME "flash.bin"
+
+typedef struct virtualFlashStats_s {
+    uint32_t programCount;      // page programs started
+    uint64_t bytesProgrammed;
+    uint32_t eraseCount;        // sector erases, a chip erase counts as one
+    uint64_t busyUs;            // total program and erase time
+    uint32_t busyPolls;         // isReady() calls that found the device busy
+} virtualFlashStats_t;
+
+void virtualFlashSetFile(const char *filename);
+bool virtualFlashSetGeometry(const char *spec);
+bool virtualFlashSetTiming(const char *spec);
+
+bool virtualFlash_identify(flashDevice_t *fdevice);
+void virtualFlashClose(void);
+
+const virtualFlashStats_t *virtualFlashGetStats(void);
+void virtualFlashResetStats(void);
@@ -20,9 +20,12 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
+#include "common/maths.h"
+
 #include "io/serial.h"
 #include "serial.h"
 
@@ -122,6 +125,69 @@ void serialEndWrite(serialPort_t *instance)
         instance->vTable->endWrite(instance);
 }
 
+/*
+ * Returns a span of received bytes, to be released with serialSkipRx() once they have been processed.
+ * Ports with zero-copy receive return everything contiguous in their receive buffer. Other ports
+ * return one byte, already read into *byte, so a caller must always consume the first byte of a span.
+ */
+uint32_t serialPeekRx(serialPort_t *instance, const uint8_t **data, uint8_t *byte)
+{
+    if (instance->vTable->peekRx) {
+        return instance->vTable->peekRx(instance, data);
+    }
+
+    if (!serialRxBytesWaiting(instance)) {
+        return 0;
+    }
+    *byte = serialRead(instance);
+    *data = byte;
+    return 1;
+}
+
+void serialSkipRx(serialPort_t *instance, uint32_t count)
+{
+    if (instance->vTable->skipRx) {
+        instance->vTable->skipRx(instance, count);
+    }
+}
+
+// Reads up to count bytes, returns the number read
+uint32_t serialReadBuf(serialPort_t *instance, uint8_t *data, uint32_t count)
+{
+    uint32_t total = 0;
+    while (total < count) {
+        const uint8_t *span;
+        uint8_t byte;
+        const uint32_t available = MIN(serialPeekRx(instance, &span, &byte), count - total);
+        if (!available) {
+            break;
+        }
+        memcpy(data + total, span, available);
+        serialSkipRx(instance, available);
+        total += available;
+    }
+    return total;
+}
+
+uint32_t serialRingPeekRx(serialPort_t *instance, const uint8_t **data)
+{
+    const uint32_t head = instance->rxBufferHead;
+    const uint32_t tail = instance->rxBufferTail;
+
+    *data = (const uint8_t *)&instance->rxBuffer[tail];
+    // up to the end of the buffer when the data wraps, the rest is returned by the next call
+    return head >= tail ? head - tail : instance->rxBufferSize - tail;
+}
+
+void serialRingSkipRx(serialPort_t *instance, uint32_t count)
+{
+    uint32_t tail = instance->rxBufferTail + count;
+    if (tail >= instance->rxBufferSize) {
+        tail -= instance->rxBufferSize;
+    }
+    instance->rxBufferTail = tail;
+}
+
 void serialWriteBuf(serialPort_t *instance, const uint8_t *data, int count)
 {
     serialBeginWrite(instance);
@@ -132,6 +132,11 @@ struct serialPortVTable {
     // Optional functions used to buffer large writes.
     void (*beginWrite)(serialPort_t *instance);
     void (*endWrite)(serialPort_t *instance);
+
+    // Optional zero-copy receive, returns the number of contiguous bytes waiting at *data.
+    // They stay in the receive buffer until released with skipRx.
+    uint32_t (*peekRx)(serialPort_t *instance, const uint8_t **data);
+    void (*skipRx)(serialPort_t *instance, uint32_t count);
 };
 
 void serialWrite(serialPort_t *instance, uint8_t ch);
@@ -153,3 +158,11 @@ void serialWriteBufShim(void *instance, const uint8_t *data, int count);
 void serialWriteBufBlockingShim(void *instance, const uint8_t *data, int count);
 void serialBeginWrite(serialPort_t *instance);
 void serialEndWrite(serialPort_t *instance);
+
+uint32_t serialPeekRx(serialPort_t *instance, const uint8_t **data, uint8_t *byte);
+void serialSkipRx(serialPort_t *instance, uint32_t count);
+uint32_t serialReadBuf(serialPort_t *instance, uint8_t *data, uint32_t count);
+
+// Zero-copy receive for drivers using the rxBuffer ring of serialPort_t
+uint32_t serialRingPeekRx(serialPort_t *instance, const uint8_t **data);
+void serialRingSkipRx(serialPort_t *instance, uint32_t count);
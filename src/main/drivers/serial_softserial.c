@@ -574,6 +574,15 @@ uint8_t softSerialReadByte(serialPort_t *instance)
     return ch;
 }
 
+static uint32_t softSerialPeekRx(serialPort_t *instance, const uint8_t **data)
+{
+    if ((instance->mode & MODE_RX) == 0) {
+        return 0;
+    }
+
+    return serialRingPeekRx(instance, data);
+}
+
 void softSerialWriteByte(serialPort_t *s, uint8_t ch)
 {
     if ((s->mode & MODE_TX) == 0) {
@@ -615,7 +624,9 @@ static const struct serialPortVTable softSerialVTable = {
     .setBaudRateCb = NULL,
     .writeBuf = NULL,
     .beginWrite = NULL,
-    .endWrite = NULL
+    .endWrite = NULL,
+    .peekRx = softSerialPeekRx,
+    .skipRx = serialRingSkipRx,
 };
 
 #endif
@@ -216,6 +216,24 @@ static uint8_t tcpRead(serialPort_t *instance)
     return ch;
 }
 
+static uint32_t tcpPeekRx(serialPort_t *instance, const uint8_t **data)
+{
+    tcpPort_t *s = (tcpPort_t *)instance;
+    pthread_mutex_lock(&s->rxLock);
+    const uint32_t count = serialRingPeekRx(instance, data);
+    pthread_mutex_unlock(&s->rxLock);
+
+    return count;
+}
+
+static void tcpSkipRx(serialPort_t *instance, uint32_t count)
+{
+    tcpPort_t *s = (tcpPort_t *)instance;
+    pthread_mutex_lock(&s->rxLock);
+    serialRingSkipRx(instance, count);
+    pthread_mutex_unlock(&s->rxLock);
+}
+
 static void tcpWrite(serialPort_t *instance, uint8_t ch)
 {
     tcpPort_t *s = (tcpPort_t *)instance;
@@ -283,4 +301,6 @@ static const struct serialPortVTable tcpVTable = {
         .writeBuf = NULL,
         .beginWrite = NULL,
         .endWrite = NULL,
+        .peekRx = tcpPeekRx,
+        .skipRx = tcpSkipRx,
 };
@@ -232,18 +232,25 @@ static void uartSetMode(serialPort_t *instance, portMode_e mode)
     uartReconfigure(uartPort);
 }
 
+#ifdef USE_DMA
+static uint32_t uartRxDMAHead(const uartPort_t *uartPort)
+{
+    // XXX Could be consolidated
+#ifdef USE_HAL_DRIVER
+    return __HAL_DMA_GET_COUNTER(uartPort->Handle.hdmarx);
+#else
+    return xDMA_GetCurrDataCounter(uartPort->rxDMAResource);
+#endif
+}
+#endif
+
 static uint32_t uartTotalRxBytesWaiting(const serialPort_t *instance)
 {
     const uartPort_t *uartPort = (const uartPort_t*)instance;
 
 #ifdef USE_DMA
     if (uartPort->rxDMAResource) {
-        // XXX Could be consolidated
-#ifdef USE_HAL_DRIVER
-        uint32_t rxDMAHead = __HAL_DMA_GET_COUNTER(uartPort->Handle.hdmarx);
-#else
-        uint32_t rxDMAHead = xDMA_GetCurrDataCounter(uartPort->rxDMAResource);
-#endif
+        const uint32_t rxDMAHead = uartRxDMAHead(uartPort);
 
         // uartPort->rxDMAPos and rxDMAHead represent distances from the end
         // of the buffer.  They count DOWN as they advance.
@@ -340,6 +347,41 @@ static uint8_t uartRead(serialPort_t *instance)
     return ch;
 }
 
+static uint32_t uartPeekRx(serialPort_t *instance, const uint8_t **data)
+{
+    uartPort_t *uartPort = (uartPort_t *)instance;
+
+#ifdef USE_DMA
+    if (uartPort->rxDMAResource) {
+        // distances from the end of the buffer, counting down as they advance
+        const uint32_t rxDMAHead = uartRxDMAHead(uartPort);
+
+        *data = (const uint8_t *)&uartPort->port.rxBuffer[uartPort->port.rxBufferSize - uartPort->rxDMAPos];
+        return uartPort->rxDMAPos >= rxDMAHead ? uartPort->rxDMAPos - rxDMAHead : uartPort->rxDMAPos;
+    }
+#endif
+
+    return serialRingPeekRx(instance, data);
+}
+
+static void uartSkipRx(serialPort_t *instance, uint32_t count)
+{
+    uartPort_t *uartPort = (uartPort_t *)instance;
+
+#ifdef USE_DMA
+    if (uartPort->rxDMAResource) {
+        if (uartPort->rxDMAPos > count) {
+            uartPort->rxDMAPos -= count;
+        } else {
+            uartPort->rxDMAPos += uartPort->port.rxBufferSize - count;
+        }
+        return;
+    }
+#endif
+
+    serialRingSkipRx(instance, count);
+}
+
 static void uartWrite(serialPort_t *instance, uint8_t ch)
 {
     uartPort_t *uartPort = (uartPort_t *)instance;
@@ -441,6 +483,8 @@ const struct serialPortVTable uartVTable[] = {
         .writeBuf = uartWriteBuf,
         .beginWrite = uartBeginWrite,
         .endWrite = uartEndWrite,
+        .peekRx = uartPeekRx,
+        .skipRx = uartSkipRx,
     }
 };
 
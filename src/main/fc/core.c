@@ -97,6 +97,7 @@
 #include "rx/rx.h"
 
 #include "scheduler/scheduler.h"
+#include "scheduler/scheduler_trace.h"
 
 #include "sensors/acceleration.h"
 #include "sensors/barometer.h"
@@ -1373,10 +1374,18 @@ FAST_CODE void taskMainPidLoop(timeUs_t currentTimeUs)
     // 3 - subTaskPidSubprocesses()
     DEBUG_SET(DEBUG_PIDLOOP, 0, micros() - currentTimeUs);
 
+    SCHED_TRACE(SCHED_TRACE_STAGE_BEGIN, SCHED_TRACE_STAGE_RC_COMMAND, 0);
     subTaskRcCommand(currentTimeUs);
+    SCHED_TRACE(SCHED_TRACE_STAGE_END, SCHED_TRACE_STAGE_RC_COMMAND, 0);
+    SCHED_TRACE(SCHED_TRACE_STAGE_BEGIN, SCHED_TRACE_STAGE_PID_CONTROLLER, 0);
     subTaskPidController(currentTimeUs);
+    SCHED_TRACE(SCHED_TRACE_STAGE_END, SCHED_TRACE_STAGE_PID_CONTROLLER, 0);
+    SCHED_TRACE(SCHED_TRACE_STAGE_BEGIN, SCHED_TRACE_STAGE_MOTOR_UPDATE, 0);
     subTaskMotorUpdate(currentTimeUs);
+    SCHED_TRACE(SCHED_TRACE_STAGE_END, SCHED_TRACE_STAGE_MOTOR_UPDATE, 0);
+    SCHED_TRACE(SCHED_TRACE_STAGE_BEGIN, SCHED_TRACE_STAGE_PID_SUBPROCESSES, 0);
     subTaskPidSubprocesses(currentTimeUs);
+    SCHED_TRACE(SCHED_TRACE_STAGE_END, SCHED_TRACE_STAGE_PID_SUBPROCESSES, 0);
 
     DEBUG_SET(DEBUG_CYCLETIME, 0, getTaskDeltaTimeUs(TASK_SELF));
     DEBUG_SET(DEBUG_CYCLETIME, 1, getAverageSystemLoadPercent());
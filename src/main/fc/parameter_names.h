@@ -30,6 +30,9 @@
 #define PARAM_NAME_DYN_NOTCH_COUNT "dyn_notch_count"
 #define PARAM_NAME_DYN_NOTCH_Q "dyn_notch_q"
 #define PARAM_NAME_DYN_NOTCH_MIN_HZ "dyn_notch_min_hz"
+#define PARAM_NAME_DYN_NOTCH_ESTIMATOR "dyn_notch_estimator"
+#define PARAM_NAME_DYN_NOTCH_FFT_SIZE "dyn_notch_fft_size"
+#define PARAM_NAME_DYN_NOTCH_BUDGET "dyn_notch_budget"
 #define PARAM_NAME_ACC_HARDWARE "acc_hardware"
 #define PARAM_NAME_ACC_LPF_HZ "acc_lpf_hz"
 #define PARAM_NAME_MAG_HARDWARE "mag_hardware"
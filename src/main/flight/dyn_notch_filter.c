@@ -30,6 +30,7 @@
 
 #include <math.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -37,7 +38,9 @@
 #include "build/debug.h"
 
 #include "common/axis.h"
+#include "common/fft.h"
 #include "common/filter.h"
+#include "common/goertzel.h"
 #include "common/maths.h"
 #include "common/sdft.h"
 #include "common/utils.h"
@@ -83,6 +86,16 @@
 // Each SDFT output bin has width sdftSampleRateHz/72, ie 18.5Hz per bin at 1333Hz.
 // Usable bandwidth is half this, ie 666Hz if sdftSampleRateHz is 1333Hz, i.e. bin 1 is 18.5Hz, bin 2 is 37.0Hz etc.
 
+// Instead of the SDFT, dyn_notch_estimator can select a block FFT or a Goertzel bank working on
+// dyn_notch_fft_size (64, 128 or 256) downsampled values, for finer resolution at low frequencies.
+// At 8k with 600Hz max, a 256 sample block gives 5.2Hz per bin.
+// FFT: the Hann windowed block of one axis is transformed while the peaks of the previous axis are processed.
+// The transform is spread over as many loops as needed to do at most dyn_notch_budget butterflies per loop.
+// Goertzel: a bank of bins spread evenly over dyn_notch_min_hz..dyn_notch_max_hz is updated with every downsampled value.
+// The number of bins is limited so that at most dyn_notch_budget bins (all axes) are updated per loop.
+// A new spectrum is available after every block, i.e. every 256 * 0.75ms = 192ms at 8k, 600Hz max and a 256 sample block.
+// The FFT and Goertzel estimators are only built with USE_DYN_NOTCH_FFT and USE_DYN_NOTCH_GOERTZEL, the SDFT is used otherwise.
+
 #define DYN_NOTCH_SMOOTH_HZ        4
 #define DYN_NOTCH_CALC_TICKS       (XYZ_AXIS_COUNT * STEP_COUNT) // 3 axes and 4 steps per axis
 #define DYN_NOTCH_OSD_MIN_THROTTLE 20
@@ -141,17 +154,52 @@ static FAST_DATA_ZERO_INIT float sampleAccumulator[XYZ_AXIS_COUNT];
 // downsampled data for frequency analysis
 static FAST_DATA_ZERO_INIT float sampleAvg[XYZ_AXIS_COUNT];
 
+// spectrum estimators built in, only the configured one is in use
+typedef union estimator_u {
+
+    sdft_t sdft[XYZ_AXIS_COUNT];
+
+#ifdef USE_DYN_NOTCH_FFT
+    struct {
+        fft_t fft;                                      // transform of one axis at a time
+        float samples[XYZ_AXIS_COUNT][FFT_SIZE_MAX];    // circular buffers of downsampled data
+        int sampleIdx;
+    } block;
+#endif
+
+#ifdef USE_DYN_NOTCH_GOERTZEL
+    goertzel_t goertzel[XYZ_AXIS_COUNT];
+#endif
+
+} estimator_t;
+
+#if defined(USE_DYN_NOTCH_FFT)
+#define SPECTRUM_BIN_COUNT_MAX FFT_BIN_COUNT_MAX
+#elif defined(USE_DYN_NOTCH_GOERTZEL)
+#define SPECTRUM_BIN_COUNT_MAX GOERTZEL_BIN_COUNT_MAX
+#else
+#define SPECTRUM_BIN_COUNT_MAX SDFT_BIN_COUNT
+#endif
+
+STATIC_ASSERT(SDFT_BIN_COUNT <= SPECTRUM_BIN_COUNT_MAX, spectrum_too_small_for_sdft);
+#ifdef USE_DYN_NOTCH_GOERTZEL
+STATIC_ASSERT(GOERTZEL_BIN_COUNT_MAX <= SPECTRUM_BIN_COUNT_MAX, spectrum_too_small_for_goertzel);
+#endif
+
 // parameters for peak detection and frequency analysis
-static FAST_DATA_ZERO_INIT state_t state;
-static FAST_DATA_ZERO_INIT sdft_t  sdft[XYZ_AXIS_COUNT];
-static FAST_DATA_ZERO_INIT peak_t  peaks[DYN_NOTCH_COUNT_MAX];
-static FAST_DATA_ZERO_INIT float   sdftData[SDFT_BIN_COUNT];
-static FAST_DATA_ZERO_INIT float   sdftSampleRateHz;
-static FAST_DATA_ZERO_INIT float   sdftResolutionHz;
-static FAST_DATA_ZERO_INIT int     sdftStartBin;
-static FAST_DATA_ZERO_INIT int     sdftEndBin;
-static FAST_DATA_ZERO_INIT float   sdftNoiseThreshold;
-static FAST_DATA_ZERO_INIT float   pt1LooptimeS;
+static FAST_DATA_ZERO_INIT state_t     state;
+static FAST_DATA_ZERO_INIT estimator_t estimator;
+static FAST_DATA_ZERO_INIT int         estimatorType;
+static FAST_DATA_ZERO_INIT int         estimatorBudget;
+static FAST_DATA_ZERO_INIT peak_t      peaks[DYN_NOTCH_COUNT_MAX];
+static FAST_DATA_ZERO_INIT float       spectrumData[SPECTRUM_BIN_COUNT_MAX];
+static FAST_DATA_ZERO_INIT float       sdftSampleRateHz;   // downsampled rate, used by all estimators
+static FAST_DATA_ZERO_INIT float       spectrumBinHz;      // frequency step between bins
+static FAST_DATA_ZERO_INIT float       spectrumOffsetHz;   // frequency of bin 0
+static FAST_DATA_ZERO_INIT int         spectrumStartBin;
+static FAST_DATA_ZERO_INIT int         spectrumEndBin;
+static FAST_DATA_ZERO_INIT float       spectrumNoiseThreshold;
+static FAST_DATA_ZERO_INIT float       pt1LooptimeS;
 
 void dynNotchInit(const dynNotchConfig_t *config, const timeUs_t targetLooptimeUs)
 {
@@ -185,13 +233,75 @@ void dynNotchInit(const dynNotchConfig_t *config, const timeUs_t targetLooptimeU
     // eg 1k, user max 600hz, int(500/500)  = 1 (1.0)    sdftSampleRateHz = 1000hz, range 500Hz
     // The upper limit of DN is always going to be the Nyquist frequency (= sampleRate / 2)
 
-    sdftResolutionHz = sdftSampleRateHz / SDFT_SAMPLE_SIZE; // 18.5hz per bin at 8k and 600Hz maxHz
-    sdftStartBin = MAX(1, lrintf(dynNotch.minHz / sdftResolutionHz)); // can't use bin 0 because it is DC.
-    sdftEndBin = MIN(SDFT_BIN_COUNT - 1, lrintf(dynNotch.maxHz / sdftResolutionHz)); // can't use more than SDFT_BIN_COUNT bins.
-    pt1LooptimeS = DYN_NOTCH_CALC_TICKS / looprateHz;
+    // restart peak detection on the first axis, the estimators rely on it
+    state.tick = 0;
+    state.step = STEP_WINDOW;
+    state.axis = 0;
+
+    estimatorType = config->dyn_notch_estimator;
+    estimatorBudget = MAX(config->dyn_notch_budget, 1);
+#if defined(USE_DYN_NOTCH_FFT) || defined(USE_DYN_NOTCH_GOERTZEL)
+    const int blockSize = FFT_SIZE_MIN << config->dyn_notch_fft_size;
+#endif
+
+    switch (estimatorType) {
+#ifdef USE_DYN_NOTCH_FFT
+    case DYN_NOTCH_ESTIMATOR_FFT:
+    {
+        spectrumBinHz = sdftSampleRateHz / blockSize; // 5.2hz per bin at 8k, 600Hz maxHz and 256 samples
+        spectrumOffsetHz = 0.0f;
+        spectrumStartBin = MAX(1, lrintf(dynNotch.minHz / spectrumBinHz)); // can't use bin 0 because it is DC.
+        spectrumEndBin = MIN(blockSize / 2 - 1, lrintf(dynNotch.maxHz / spectrumBinHz));
+
+        // each axis takes the loops needed for the FFT plus STEP_COUNT loops, axes are updated one after another
+        const int loopsPerAxis = (fftOpCount(blockSize) + estimatorBudget - 1) / estimatorBudget + STEP_COUNT;
+        pt1LooptimeS = XYZ_AXIS_COUNT * loopsPerAxis / looprateHz;
+
+        fftInit(&estimator.block.fft, blockSize);
+        memset(estimator.block.samples, 0, sizeof(estimator.block.samples));
+        estimator.block.sampleIdx = 0;
+        fftStart(&estimator.block.fft, estimator.block.samples[state.axis], estimator.block.sampleIdx);
+        break;
+    }
+#endif
+#ifdef USE_DYN_NOTCH_GOERTZEL
+    case DYN_NOTCH_ESTIMATOR_GOERTZEL:
+    {
+        const float blockResolutionHz = sdftSampleRateHz / blockSize;
+        const float startBin = MAX(1.0f, dynNotch.minHz / blockResolutionHz);
+        const float endBin = MAX(startBin, MIN(blockSize / 2 - 1.0f, dynNotch.maxHz / blockResolutionHz));
+
+        // bins are limited by the range, the bank size and the per loop budget shared by all axes
+        int binCount = MIN((int)(endBin - startBin) + 1, GOERTZEL_BIN_COUNT_MAX);
+        binCount = MIN(binCount, estimatorBudget * sampleCount / XYZ_AXIS_COUNT);
+        binCount = MAX(binCount, 3); // peak detection needs a bin on either side
+        const float binStep = (endBin - startBin) / (binCount - 1);
+
+        spectrumBinHz = binStep * blockResolutionHz;
+        spectrumOffsetHz = startBin * blockResolutionHz;
+        spectrumStartBin = 0;
+        spectrumEndBin = binCount - 1;
+        pt1LooptimeS = blockSize * sampleCount / looprateHz; // one update per block
 
-    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-        sdftInit(&sdft[axis], sdftStartBin, sdftEndBin, sampleCount);
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            goertzelInit(&estimator.goertzel[axis], startBin, binStep, binCount, blockSize, sampleCount);
+        }
+        break;
+    }
+#endif
+    default:
+        // also used when the configured estimator isn't built in
+        estimatorType = DYN_NOTCH_ESTIMATOR_SDFT;
+        spectrumBinHz = sdftSampleRateHz / SDFT_SAMPLE_SIZE; // 18.5hz per bin at 8k and 600Hz maxHz
+        spectrumOffsetHz = 0.0f;
+        spectrumStartBin = MAX(1, lrintf(dynNotch.minHz / spectrumBinHz)); // can't use bin 0 because it is DC.
+        spectrumEndBin = MIN(SDFT_BIN_COUNT - 1, lrintf(dynNotch.maxHz / spectrumBinHz)); // can't use more than SDFT_BIN_COUNT bins.
+        pt1LooptimeS = DYN_NOTCH_CALC_TICKS / looprateHz;
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            sdftInit(&estimator.sdft[axis], spectrumStartBin, spectrumEndBin, sampleCount);
+        }
+        break;
     }
 
     for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
@@ -228,17 +338,51 @@ FAST_CODE void dynNotchUpdate(void)
             }
         }
 
-        // We need DYN_NOTCH_CALC_TICKS ticks to update all axes with newly sampled value
-        // recalculation of filters takes 4 calls per axis => each filter gets updated every DYN_NOTCH_CALC_TICKS calls
-        // at 8kHz PID loop rate this means 8kHz / 4 / 3 = 666Hz => update every 1.5ms
-        // at 4kHz PID loop rate this means 4kHz / 4 / 3 = 333Hz => update every 3ms
-        state.tick = DYN_NOTCH_CALC_TICKS;
+        if (estimatorType == DYN_NOTCH_ESTIMATOR_SDFT) {
+            // We need DYN_NOTCH_CALC_TICKS ticks to update all axes with newly sampled value
+            // recalculation of filters takes 4 calls per axis => each filter gets updated every DYN_NOTCH_CALC_TICKS calls
+            // at 8kHz PID loop rate this means 8kHz / 4 / 3 = 666Hz => update every 1.5ms
+            // at 4kHz PID loop rate this means 4kHz / 4 / 3 = 333Hz => update every 3ms
+            state.tick = DYN_NOTCH_CALC_TICKS;
+        }
+#ifdef USE_DYN_NOTCH_FFT
+        else if (estimatorType == DYN_NOTCH_ESTIMATOR_FFT) {
+            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+                estimator.block.samples[axis][estimator.block.sampleIdx] = sampleAvg[axis];
+            }
+            estimator.block.sampleIdx = (estimator.block.sampleIdx + 1) & (estimator.block.fft.size - 1);
+        }
+#endif
     }
 
-    // 2us @ F722
-    // SDFT processing in batches to synchronize with incoming downsampled data
-    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-        sdftPushBatch(&sdft[axis], sampleAvg[axis], sampleIndex);
+    switch (estimatorType) {
+#ifdef USE_DYN_NOTCH_FFT
+    case DYN_NOTCH_ESTIMATOR_FFT:
+        // FFT of the current axis, spread over several loops to stay within the budget
+        if (fftIsBusy(&estimator.block.fft) && fftStep(&estimator.block.fft, estimatorBudget)) {
+            state.tick = STEP_COUNT;
+        }
+        break;
+#endif
+#ifdef USE_DYN_NOTCH_GOERTZEL
+    case DYN_NOTCH_ESTIMATOR_GOERTZEL:
+        // Goertzel processing in batches to synchronize with incoming downsampled data
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            goertzelPushBatch(&estimator.goertzel[axis], sampleAvg[axis], sampleIndex);
+        }
+        // all axes complete their block at the same time
+        if (state.tick == 0 && goertzelIsReady(&estimator.goertzel[0])) {
+            state.tick = DYN_NOTCH_CALC_TICKS;
+        }
+        break;
+#endif
+    default:
+        // 2us @ F722
+        // SDFT processing in batches to synchronize with incoming downsampled data
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            sdftPushBatch(&estimator.sdft[axis], sampleAvg[axis], sampleIndex);
+        }
+        break;
     }
     sampleIndex++;
 
@@ -263,12 +407,31 @@ static FAST_CODE_NOINLINE void dynNotchProcess(void)
 
         case STEP_WINDOW: // 4.1us (3-6us) @ F722
         {
-            sdftWinSq(&sdft[state.axis], sdftData);
+            switch (estimatorType) {
+#ifdef USE_DYN_NOTCH_FFT
+            case DYN_NOTCH_ESTIMATOR_FFT:
+            {
+                fftMagSq(&estimator.block.fft, spectrumStartBin, spectrumEndBin, spectrumData);
+                // transform the next axis while the peaks of this axis are processed
+                const int nextAxis = (state.axis + 1) % XYZ_AXIS_COUNT;
+                fftStart(&estimator.block.fft, estimator.block.samples[nextAxis], estimator.block.sampleIdx);
+                break;
+            }
+#endif
+#ifdef USE_DYN_NOTCH_GOERTZEL
+            case DYN_NOTCH_ESTIMATOR_GOERTZEL:
+                goertzelMagSq(&estimator.goertzel[state.axis], spectrumData);
+                break;
+#endif
+            default:
+                sdftWinSq(&estimator.sdft[state.axis], spectrumData);
+                break;
+            }
 
             // Get total vibrational power in dyn notch range for noise floor estimate in STEP_CALC_FREQUENCIES
-            sdftNoiseThreshold = 0.0f;
-            for (int bin = sdftStartBin; bin <= sdftEndBin; bin++) {
-                sdftNoiseThreshold += sdftData[bin];  // sdftData contains power spectral density
+            spectrumNoiseThreshold = 0.0f;
+            for (int bin = spectrumStartBin; bin <= spectrumEndBin; bin++) {
+                spectrumNoiseThreshold += spectrumData[bin];  // spectrumData contains power spectral density
             }
 
             DEBUG_SET(DEBUG_FFT_TIME, 1, micros() - startTime);
@@ -284,18 +447,18 @@ static FAST_CODE_NOINLINE void dynNotchProcess(void)
             }
 
             // Search for N biggest peaks in frequency spectrum
-            for (int bin = (sdftStartBin + 1); bin < sdftEndBin; bin++) {
+            for (int bin = (spectrumStartBin + 1); bin < spectrumEndBin; bin++) {
                 // Check if bin is peak
-                if ((sdftData[bin] > sdftData[bin - 1]) && (sdftData[bin] > sdftData[bin + 1])) {
+                if ((spectrumData[bin] > spectrumData[bin - 1]) && (spectrumData[bin] > spectrumData[bin + 1])) {
                     // Check if peak is big enough to be one of N biggest peaks.
                     // If so, insert peak and sort peaks in descending height order
                     for (int p = 0; p < dynNotch.count; p++) {
-                        if (sdftData[bin] > peaks[p].value) {
+                        if (spectrumData[bin] > peaks[p].value) {
                             for (int k = dynNotch.count - 1; k > p; k--) {
                                 peaks[k] = peaks[k - 1];
                             }
                             peaks[p].bin = bin;
-                            peaks[p].value = sdftData[bin];
+                            peaks[p].value = spectrumData[bin];
                             break;
                         }
                     }
@@ -326,28 +489,28 @@ static FAST_CODE_NOINLINE void dynNotchProcess(void)
             int peakCount = 0;
             for (int p = 0; p < dynNotch.count; p++) {
                 if (peaks[p].bin != 0) {
-                    sdftNoiseThreshold -= 0.75f * sdftData[peaks[p].bin - 1];
-                    sdftNoiseThreshold -= sdftData[peaks[p].bin];
-                    sdftNoiseThreshold -= 0.75f * sdftData[peaks[p].bin + 1];
+                    spectrumNoiseThreshold -= 0.75f * spectrumData[peaks[p].bin - 1];
+                    spectrumNoiseThreshold -= spectrumData[peaks[p].bin];
+                    spectrumNoiseThreshold -= 0.75f * spectrumData[peaks[p].bin + 1];
                     peakCount++;
                 }
             }
-            sdftNoiseThreshold /= sdftEndBin - sdftStartBin - peakCount + 1;
+            spectrumNoiseThreshold /= spectrumEndBin - spectrumStartBin - peakCount + 1;
 
             // A noise threshold 2 times the noise floor prevents peak tracking being too sensitive to noise
-            sdftNoiseThreshold *= 2.0f;
+            spectrumNoiseThreshold *= 2.0f;
 
             for (int p = 0; p < dynNotch.count; p++) {
 
                 // Only update dynNotch.centerFreq if there is a peak (ignore void peaks) and if peak is above noise floor
-                if (peaks[p].bin != 0 && peaks[p].value > sdftNoiseThreshold) {
+                if (peaks[p].bin != 0 && peaks[p].value > spectrumNoiseThreshold) {
 
                     float meanBin = peaks[p].bin;
 
                     // Height of peak bin (y1) and shoulder bins (y0, y2)
-                    const float y0 = sdftData[peaks[p].bin - 1];
-                    const float y1 = sdftData[peaks[p].bin];
-                    const float y2 = sdftData[peaks[p].bin + 1];
+                    const float y0 = spectrumData[peaks[p].bin - 1];
+                    const float y1 = spectrumData[peaks[p].bin];
+                    const float y2 = spectrumData[peaks[p].bin + 1];
 
                     // Estimate true peak position aka. meanBin (fit parabola y(x) over y0, y1 and y2, solve dy/dx=0 for x)
                     const float denom = 2.0f * (y0 - 2 * y1 + y2);
@@ -355,11 +518,11 @@ static FAST_CODE_NOINLINE void dynNotchProcess(void)
                         meanBin += (y0 - y2) / denom;
                     }
 
-                    // Convert bin to frequency: freq = bin * binResoultion (bin 0 is 0Hz)
-                    const float centerFreq = constrainf(meanBin * sdftResolutionHz, dynNotch.minHz, dynNotch.maxHz);
+                    // Convert bin to frequency: freq = bin * binResoultion (bin 0 is 0Hz for SDFT and FFT)
+                    const float centerFreq = constrainf(spectrumOffsetHz + meanBin * spectrumBinHz, dynNotch.minHz, dynNotch.maxHz);
 
                     // PT1 style smoothing moves notch center freqs rapidly towards big peaks and slowly away, up to 10x faster
-                    const float cutoffMult = constrainf(peaks[p].value / sdftNoiseThreshold, 1.0f, 10.0f);
+                    const float cutoffMult = constrainf(peaks[p].value / spectrumNoiseThreshold, 1.0f, 10.0f);
                     const float gain = pt1FilterGain(DYN_NOTCH_SMOOTH_HZ * cutoffMult, pt1LooptimeS); // dynamic PT1 k value
 
                     // Finally update notch center frequency p on current axis
@@ -389,7 +552,7 @@ static FAST_CODE_NOINLINE void dynNotchProcess(void)
         {
             for (int p = 0; p < dynNotch.count; p++) {
                 // Only update notch filter coefficients if the corresponding peak got its center frequency updated in the previous step
-                if (peaks[p].bin != 0 && peaks[p].value > sdftNoiseThreshold) {
+                if (peaks[p].bin != 0 && peaks[p].value > spectrumNoiseThreshold) {
                     biquadFilterUpdate(&dynNotch.notch[state.axis][p], dynNotch.centerFreq[state.axis][p], dynNotch.looptimeUs, dynNotch.q, FILTER_NOTCH, 1.0f);
                 }
             }
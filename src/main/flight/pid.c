@@ -1191,12 +1191,12 @@ void FAST_CODE pidController(const pidProfile_t *pidProfile, timeUs_t currentTim
             previousRawGyroRateDterm[axis] = gyroRateDterm[axis];
             DEBUG_SET(DEBUG_D_LPF, axis, lrintf(delta)); // debug d_lpf 2 and 3 used for pre-TPA D
         }
-
-        gyroRateDterm[axis] = pidRuntime.dtermNotchApplyFn((filter_t *) &pidRuntime.dtermNotch[axis], gyroRateDterm[axis]);
-        gyroRateDterm[axis] = pidRuntime.dtermLowpassApplyFn((filter_t *) &pidRuntime.dtermLowpass[axis], gyroRateDterm[axis]);
-        gyroRateDterm[axis] = pidRuntime.dtermLowpass2ApplyFn((filter_t *) &pidRuntime.dtermLowpass2[axis], gyroRateDterm[axis]);
     }
 
+    filterVec3Apply(&pidRuntime.dtermNotch, gyroRateDterm);
+    filterVec3Apply(&pidRuntime.dtermLowpass, gyroRateDterm);
+    filterVec3Apply(&pidRuntime.dtermLowpass2, gyroRateDterm);
+
     rotateItermAndAxisError();
 
 #ifdef USE_RPM_FILTER
@@ -1596,24 +1596,16 @@ void dynLpfDTermUpdate(float throttle)
 
         switch (pidRuntime.dynLpfFilter) {
         case DYN_LPF_PT1:
-            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-                pt1FilterUpdateCutoff(&pidRuntime.dtermLowpass[axis].pt1Filter, pt1FilterGain(cutoffFreq, pidRuntime.dT));
-            }
+            pt1FilterVec3UpdateCutoff(&pidRuntime.dtermLowpass.pt1, pt1FilterGain(cutoffFreq, pidRuntime.dT));
             break;
         case DYN_LPF_BIQUAD:
-            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-                biquadFilterUpdateLPF(&pidRuntime.dtermLowpass[axis].biquadFilter, cutoffFreq, targetPidLooptime);
-            }
+            biquadFilterVec3UpdateLPF(&pidRuntime.dtermLowpass.biquad, cutoffFreq, targetPidLooptime);
             break;
         case DYN_LPF_PT2:
-            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-                pt2FilterUpdateCutoff(&pidRuntime.dtermLowpass[axis].pt2Filter, pt2FilterGain(cutoffFreq, pidRuntime.dT));
-            }
+            pt2FilterVec3UpdateCutoff(&pidRuntime.dtermLowpass.pt2, pt2FilterGain(cutoffFreq, pidRuntime.dT));
             break;
         case DYN_LPF_PT3:
-            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-                pt3FilterUpdateCutoff(&pidRuntime.dtermLowpass[axis].pt3Filter, pt3FilterGain(cutoffFreq, pidRuntime.dT));
-            }
+            pt3FilterVec3UpdateCutoff(&pidRuntime.dtermLowpass.pt3, pt3FilterGain(cutoffFreq, pidRuntime.dT));
             break;
         }
     }
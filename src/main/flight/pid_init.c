@@ -134,9 +134,9 @@ void pidInitFilters(const pidProfile_t *pidProfile)
 
     if (targetPidLooptime == 0) {
         // no looptime set, so set all the filters to null
-        pidRuntime.dtermNotchApplyFn = nullFilterApply;
-        pidRuntime.dtermLowpassApplyFn = nullFilterApply;
-        pidRuntime.dtermLowpass2ApplyFn = nullFilterApply;
+        filterVec3InitNone(&pidRuntime.dtermNotch);
+        filterVec3InitNone(&pidRuntime.dtermLowpass);
+        filterVec3InitNone(&pidRuntime.dtermLowpass2);
         pidRuntime.ptermYawLowpassApplyFn = nullFilterApply;
         return;
     }
@@ -155,13 +155,10 @@ void pidInitFilters(const pidProfile_t *pidProfile)
     }
 
     if (dTermNotchHz != 0 && pidProfile->dterm_notch_cutoff != 0) {
-        pidRuntime.dtermNotchApplyFn = (filterApplyFnPtr)biquadFilterApply;
         const float notchQ = filterGetNotchQ(dTermNotchHz, pidProfile->dterm_notch_cutoff);
-        for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
-            biquadFilterInit(&pidRuntime.dtermNotch[axis], dTermNotchHz, targetPidLooptime, notchQ, FILTER_NOTCH, 1.0f);
-        }
+        filterVec3InitBiquad(&pidRuntime.dtermNotch, dTermNotchHz, targetPidLooptime, notchQ, FILTER_NOTCH, false);
     } else {
-        pidRuntime.dtermNotchApplyFn = nullFilterApply;
+        filterVec3InitNone(&pidRuntime.dtermNotch);
     }
 
     //1st Dterm Lowpass Filter
@@ -176,82 +173,58 @@ void pidInitFilters(const pidProfile_t *pidProfile)
     if (dterm_lpf1_init_hz > 0) {
         switch (pidProfile->dterm_lpf1_type) {
         case FILTER_PT1:
-            pidRuntime.dtermLowpassApplyFn = (filterApplyFnPtr)pt1FilterApply;
-            for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
-                pt1FilterInit(&pidRuntime.dtermLowpass[axis].pt1Filter, pt1FilterGain(dterm_lpf1_init_hz, pidRuntime.dT));
-            }
+            filterVec3InitPt1(&pidRuntime.dtermLowpass, pt1FilterGain(dterm_lpf1_init_hz, pidRuntime.dT));
             break;
         case FILTER_BIQUAD:
             if (pidProfile->dterm_lpf1_static_hz < pidFrequencyNyquist) {
 #ifdef USE_DYN_LPF
-                pidRuntime.dtermLowpassApplyFn = (filterApplyFnPtr)biquadFilterApplyDF1;
+                filterVec3InitBiquadLPF(&pidRuntime.dtermLowpass, dterm_lpf1_init_hz, targetPidLooptime, true);
 #else
-                pidRuntime.dtermLowpassApplyFn = (filterApplyFnPtr)biquadFilterApply;
+                filterVec3InitBiquadLPF(&pidRuntime.dtermLowpass, dterm_lpf1_init_hz, targetPidLooptime, false);
 #endif
-                for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
-                    biquadFilterInitLPF(&pidRuntime.dtermLowpass[axis].biquadFilter, dterm_lpf1_init_hz, targetPidLooptime);
-                }
             } else {
-                pidRuntime.dtermLowpassApplyFn = nullFilterApply;
+                filterVec3InitNone(&pidRuntime.dtermLowpass);
             }
             break;
         case FILTER_PT2:
-            pidRuntime.dtermLowpassApplyFn = (filterApplyFnPtr)pt2FilterApply;
-            for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
-                pt2FilterInit(&pidRuntime.dtermLowpass[axis].pt2Filter, pt2FilterGain(dterm_lpf1_init_hz, pidRuntime.dT));
-            }
+            filterVec3InitPt2(&pidRuntime.dtermLowpass, pt2FilterGain(dterm_lpf1_init_hz, pidRuntime.dT));
             break;
         case FILTER_PT3:
-            pidRuntime.dtermLowpassApplyFn = (filterApplyFnPtr)pt3FilterApply;
-            for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
-                pt3FilterInit(&pidRuntime.dtermLowpass[axis].pt3Filter, pt3FilterGain(dterm_lpf1_init_hz, pidRuntime.dT));
-            }
+            filterVec3InitPt3(&pidRuntime.dtermLowpass, pt3FilterGain(dterm_lpf1_init_hz, pidRuntime.dT));
             break;
         default:
-            pidRuntime.dtermLowpassApplyFn = nullFilterApply;
+            filterVec3InitNone(&pidRuntime.dtermLowpass);
             break;
         }
     } else {
-        pidRuntime.dtermLowpassApplyFn = nullFilterApply;
+        filterVec3InitNone(&pidRuntime.dtermLowpass);
     }
 
     //2nd Dterm Lowpass Filter
     if (pidProfile->dterm_lpf2_static_hz > 0) {
         switch (pidProfile->dterm_lpf2_type) {
         case FILTER_PT1:
-            pidRuntime.dtermLowpass2ApplyFn = (filterApplyFnPtr)pt1FilterApply;
-            for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
-                pt1FilterInit(&pidRuntime.dtermLowpass2[axis].pt1Filter, pt1FilterGain(pidProfile->dterm_lpf2_static_hz, pidRuntime.dT));
-            }
+            filterVec3InitPt1(&pidRuntime.dtermLowpass2, pt1FilterGain(pidProfile->dterm_lpf2_static_hz, pidRuntime.dT));
             break;
         case FILTER_BIQUAD:
             if (pidProfile->dterm_lpf2_static_hz < pidFrequencyNyquist) {
-                pidRuntime.dtermLowpass2ApplyFn = (filterApplyFnPtr)biquadFilterApply;
-                for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
-                    biquadFilterInitLPF(&pidRuntime.dtermLowpass2[axis].biquadFilter, pidProfile->dterm_lpf2_static_hz, targetPidLooptime);
-                }
+                filterVec3InitBiquadLPF(&pidRuntime.dtermLowpass2, pidProfile->dterm_lpf2_static_hz, targetPidLooptime, false);
             } else {
-                pidRuntime.dtermLowpassApplyFn = nullFilterApply;
+                filterVec3InitNone(&pidRuntime.dtermLowpass2);
             }
             break;
         case FILTER_PT2:
-            pidRuntime.dtermLowpass2ApplyFn = (filterApplyFnPtr)pt2FilterApply;
-            for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
-                pt2FilterInit(&pidRuntime.dtermLowpass2[axis].pt2Filter, pt2FilterGain(pidProfile->dterm_lpf2_static_hz, pidRuntime.dT));
-            }
+            filterVec3InitPt2(&pidRuntime.dtermLowpass2, pt2FilterGain(pidProfile->dterm_lpf2_static_hz, pidRuntime.dT));
             break;
         case FILTER_PT3:
-            pidRuntime.dtermLowpass2ApplyFn = (filterApplyFnPtr)pt3FilterApply;
-            for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
-                pt3FilterInit(&pidRuntime.dtermLowpass2[axis].pt3Filter, pt3FilterGain(pidProfile->dterm_lpf2_static_hz, pidRuntime.dT));
-            }
+            filterVec3InitPt3(&pidRuntime.dtermLowpass2, pt3FilterGain(pidProfile->dterm_lpf2_static_hz, pidRuntime.dT));
             break;
         default:
-            pidRuntime.dtermLowpass2ApplyFn = nullFilterApply;
+            filterVec3InitNone(&pidRuntime.dtermLowpass2);
             break;
         }
     } else {
-        pidRuntime.dtermLowpass2ApplyFn = nullFilterApply;
+        filterVec3InitNone(&pidRuntime.dtermLowpass2);
     }
 
     if (pidProfile->yaw_lowpass_hz == 0) {
@@ -19,6 +19,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -44,6 +45,34 @@
 
 #define RPM_FILTER_DURATION_S    0.001f  // Maximum duration allowed to update all RPM notches once
 
+#if defined(__SSE__) || defined(__ARM_NEON)
+#define USE_RPM_FILTER_SIMD
+// one lane per axis, the fourth lane is padding
+typedef float rpmAxisVector_t __attribute__((vector_size(4 * sizeof(float))));
+#endif
+
+// notch coefficients are the same on all axes, so they are stored once per motor and harmonic
+typedef struct rpmNotchCoeffs_s {
+    float b0, b1, b2, a1, a2;
+    float weight;
+} rpmNotchCoeffs_t;
+
+// DF1 state of one notch with the axes interleaved, so all axes are filtered in one pass
+typedef struct rpmNotchState_s {
+#ifdef USE_RPM_FILTER_SIMD
+    rpmAxisVector_t x1, x2, y1, y2;
+#else
+    float x1[XYZ_AXIS_COUNT], x2[XYZ_AXIS_COUNT];
+    float y1[XYZ_AXIS_COUNT], y2[XYZ_AXIS_COUNT];
+#endif
+} rpmNotchState_t;
+
+// notches are indexed [harmonic][motor] to match the order they are applied in
+typedef struct rpmNotchBank_s {
+    rpmNotchCoeffs_t coeffs[RPM_FILTER_HARMONICS_MAX][MAX_SUPPORTED_MOTORS];
+    rpmNotchState_t state[RPM_FILTER_HARMONICS_MAX][MAX_SUPPORTED_MOTORS];
+} rpmNotchBank_t;
+
 typedef struct rpmFilter_s {
 
     int numHarmonics;
@@ -54,7 +83,7 @@ typedef struct rpmFilter_s {
     float q;
 
     timeUs_t looptimeUs;
-    biquadFilter_t notch[XYZ_AXIS_COUNT][MAX_SUPPORTED_MOTORS][RPM_FILTER_HARMONICS_MAX];
+    rpmNotchBank_t notches;
 
 } rpmFilter_t;
 
@@ -66,6 +95,16 @@ FAST_DATA_ZERO_INIT static int notchUpdatesPerIteration;
 FAST_DATA_ZERO_INIT static int motorIndex;
 FAST_DATA_ZERO_INIT static int harmonicIndex;
 
+static void rpmNotchSetCoeffs(rpmNotchCoeffs_t *coeffs, const biquadFilter_t *notch)
+{
+    coeffs->b0 = notch->b0;
+    coeffs->b1 = notch->b1;
+    coeffs->b2 = notch->b2;
+    coeffs->a1 = notch->a1;
+    coeffs->a2 = notch->a2;
+    coeffs->weight = notch->weight;
+}
+
 void rpmFilterInit(const rpmFilterConfig_t *config, const timeUs_t looptimeUs)
 {
     motorIndex = 0;
@@ -94,11 +133,12 @@ void rpmFilterInit(const rpmFilterConfig_t *config, const timeUs_t looptimeUs)
         rpmFilter.weights[n] = constrainf(config->rpm_filter_weights[n] / 100.0f, 0.0f, 1.0f);
     }
 
-    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+    memset(&rpmFilter.notches.state, 0, sizeof(rpmFilter.notches.state));
+    for (int i = 0; i < rpmFilter.numHarmonics; i++) {
         for (int motor = 0; motor < getMotorCount(); motor++) {
-            for (int i = 0; i < rpmFilter.numHarmonics; i++) {
-                biquadFilterInit(&rpmFilter.notch[axis][motor][i], rpmFilter.minHz * i, rpmFilter.looptimeUs, rpmFilter.q, FILTER_NOTCH, 0.0f);
-            }
+            biquadFilter_t notch;
+            biquadFilterInit(&notch, rpmFilter.minHz * i, rpmFilter.looptimeUs, rpmFilter.q, FILTER_NOTCH, 0.0f);
+            rpmNotchSetCoeffs(&rpmFilter.notches.coeffs[i][motor], &notch);
         }
     }
 
@@ -130,9 +170,6 @@ FAST_CODE_NOINLINE void rpmFilterUpdate(void)
         // Only bother updating notches which have an effect on filtered output
         if (rpmFilter.weights[harmonicIndex] > 0.0f) {
 
-            // select current notch on ROLL
-            biquadFilter_t *template = &rpmFilter.notch[0][motorIndex][harmonicIndex];
-
             const float frequencyHz = constrainf((harmonicIndex + 1) * getMotorFrequencyHz(motorIndex), rpmFilter.minHz, rpmFilter.maxHz);
             const float marginHz = frequencyHz - rpmFilter.minHz;
             float weight = 1.0f;
@@ -145,22 +182,13 @@ FAST_CODE_NOINLINE void rpmFilterUpdate(void)
             // attenuate notches per harmonics group
             weight *= rpmFilter.weights[harmonicIndex];
 
-            // update notch
-            biquadFilterUpdate(template, frequencyHz, correctedLooptime, rpmFilter.q, FILTER_NOTCH, weight);
-
-            // copy notch properties to corresponding notches on PITCH and YAW
-            for (int axis = 1; axis < XYZ_AXIS_COUNT; axis++) {
-                biquadFilter_t *dest = &rpmFilter.notch[axis][motorIndex][harmonicIndex];
-                dest->b0 = template->b0;
-                dest->b1 = template->b1;
-                dest->b2 = template->b2;
-                dest->a1 = template->a1;
-                dest->a2 = template->a2;
-                dest->weight = template->weight;
-            }
+            // update notch, the coefficients are shared by all axes
+            biquadFilter_t notch;
+            biquadFilterUpdate(&notch, frequencyHz, correctedLooptime, rpmFilter.q, FILTER_NOTCH, weight);
+            rpmNotchSetCoeffs(&rpmFilter.notches.coeffs[harmonicIndex][motorIndex], &notch);
         }
 
-        // cycle through all notches on ROLL (takes RPM_FILTER_DURATION_S at max.)
+        // cycle through all notches (takes RPM_FILTER_DURATION_S at max.)
         harmonicIndex = (harmonicIndex + 1) % rpmFilter.numHarmonics;
         if (harmonicIndex == 0) {
             motorIndex = (motorIndex + 1) % getMotorCount();
@@ -168,9 +196,13 @@ FAST_CODE_NOINLINE void rpmFilterUpdate(void)
     }
 }
 
-FAST_CODE float rpmFilterApply(const int axis, float value)
+FAST_CODE void rpmFilterApply(float values[XYZ_AXIS_COUNT])
 {
-    // Iterate over all notches on axis and apply each one to value.
+#ifdef USE_RPM_FILTER_SIMD
+    rpmAxisVector_t value = { values[X], values[Y], values[Z], 0.0f };
+#endif
+
+    // Iterate over all notches and apply each one to the values of all axes.
     // Order of application doesn't matter because biquads are linear time-invariant filters.
     for (int i = 0; i < rpmFilter.numHarmonics; i++) {
 
@@ -179,11 +211,40 @@ FAST_CODE float rpmFilterApply(const int axis, float value)
         }
 
         for (int motor = 0; motor < getMotorCount(); motor++) {
-            value = biquadFilterApplyDF1Weighted(&rpmFilter.notch[axis][motor][i], value);
+            const rpmNotchCoeffs_t *c = &rpmFilter.notches.coeffs[i][motor];
+            rpmNotchState_t *s = &rpmFilter.notches.state[i][motor];
+
+            // same computation as biquadFilterApplyDF1Weighted()
+#ifdef USE_RPM_FILTER_SIMD
+            const rpmAxisVector_t result = c->b0 * value + c->b1 * s->x1 + c->b2 * s->x2 - c->a1 * s->y1 - c->a2 * s->y2;
+
+            s->x2 = s->x1;
+            s->x1 = value;
+            s->y2 = s->y1;
+            s->y1 = result;
+
+            value = c->weight * result + (1 - c->weight) * value;
+#else
+            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+                const float input = values[axis];
+                const float result = c->b0 * input + c->b1 * s->x1[axis] + c->b2 * s->x2[axis] - c->a1 * s->y1[axis] - c->a2 * s->y2[axis];
+
+                s->x2[axis] = s->x1[axis];
+                s->x1[axis] = input;
+                s->y2[axis] = s->y1[axis];
+                s->y1[axis] = result;
+
+                values[axis] = c->weight * result + (1 - c->weight) * input;
+            }
+#endif
         }
     }
 
-    return value;
+#ifdef USE_RPM_FILTER_SIMD
+    values[X] = value[X];
+    values[Y] = value[Y];
+    values[Z] = value[Z];
+#endif
 }
 
 bool isRpmFilterEnabled(void)
@@ -22,11 +22,12 @@
 
 #include <stdbool.h>
 
+#include "common/axis.h"
 #include "common/time.h"
 
 #include "pg/rpm_filter.h"
 
 void rpmFilterInit(const rpmFilterConfig_t *config, const timeUs_t looptimeUs);
 void rpmFilterUpdate(void);
-float rpmFilterApply(const int axis, float value);
+void rpmFilterApply(float values[XYZ_AXIS_COUNT]);
 bool isRpmFilterEnabled(void);
@@ -47,6 +47,29 @@
 static displayPort_t mspDisplayPort;
 static serialPortIdentifier_e displayPortSerial;
 
+#define MSP_OSD_MAX_STRING_LENGTH 30 // FIXME move this
+
+// What has been drawn and what the display was last sent, as character and MSP attribute byte. Writes only
+// update the screen buffer, committing sends the runs of cells that changed since, so text redrawn unchanged
+// every OSD refresh isn't sent again. Canvases too large for the buffers are sent as drawn.
+#define MSP_DISPLAYPORT_MAX_CELLS   (OSD_HD_ROWS * OSD_HD_COLS)
+// Unchanged cells between two changes are sent along rather than starting a new packet below this,
+// a WRITE_STRING packet costs 6 bytes of MSP framing and 4 of displayport header.
+#define MSP_DISPLAYPORT_RUN_GAP     10
+
+typedef struct mspDisplayCell_s {
+    uint8_t ch;
+    uint8_t attr;
+} mspDisplayCell_t;
+
+static const mspDisplayCell_t blankCell = { .ch = ' ', .attr = 0 };
+
+static mspDisplayCell_t screen[MSP_DISPLAYPORT_MAX_CELLS];
+static mspDisplayCell_t sentScreen[MSP_DISPLAYPORT_MAX_CELLS];
+static bool useShadowScreen;
+static bool sentScreenValid;    // false when the display content is unknown, it's cleared before the next update
+static uint8_t refreshRow;      // row resent in full on each update, for displays that connect late
+
 static int output(displayPort_t *displayPort, uint8_t cmd, uint8_t *buf, int len)
 {
     UNUSED(displayPort);
@@ -75,6 +98,9 @@ static int release(displayPort_t *displayPort)
 {
     uint8_t subcmd[] = { MSP_DP_RELEASE };
 
+    // the display is free to show something else until grabbed again
+    sentScreenValid = false;
+
     return output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
 }
 
@@ -82,19 +108,115 @@ static int clearScreen(displayPort_t *displayPort, displayClearOption_e options)
 {
     UNUSED(options);
 
+    if (useShadowScreen) {
+        const int cells = displayPort->rows * displayPort->cols;
+        for (int i = 0; i < cells; i++) {
+            screen[i] = blankCell;
+        }
+        return 0;
+    }
+
     uint8_t subcmd[] = { MSP_DP_CLEAR_SCREEN };
 
     return output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
 }
 
+static bool isCellChanged(int index, bool refresh)
+{
+    return screen[index].ch != sentScreen[index].ch || screen[index].attr != sentScreen[index].attr
+        || (refresh && screen[index].ch != ' ');
+}
+
+static bool writeRun(displayPort_t *displayPort, uint8_t row, uint8_t col, int len)
+{
+    uint8_t buf[MSP_OSD_MAX_STRING_LENGTH + 4];
+    const int index = row * displayPort->cols + col;
+
+    buf[0] = MSP_DP_WRITE_STRING;
+    buf[1] = row;
+    buf[2] = col;
+    buf[3] = screen[index].attr;
+    for (int i = 0; i < len; i++) {
+        buf[4 + i] = screen[index + i].ch;
+    }
+
+    // a frame that didn't fit in the transmit buffer is dropped, the cells are sent again on the next update
+    if (!output(displayPort, MSP_DISPLAYPORT, buf, len + 4)) {
+        return false;
+    }
+    memcpy(&sentScreen[index], &screen[index], len * sizeof(mspDisplayCell_t));
+
+    return true;
+}
+
+// Sends the runs of changed cells, up to MSP_OSD_MAX_STRING_LENGTH cells of the same attribute each
+static void sendChangedCells(displayPort_t *displayPort)
+{
+    if (!useShadowScreen) {
+        return;
+    }
+
+    if (!sentScreenValid) {
+        uint8_t subcmd[] = { MSP_DP_CLEAR_SCREEN };
+        if (!output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd))) {
+            return;
+        }
+        const int cells = displayPort->rows * displayPort->cols;
+        for (int i = 0; i < cells; i++) {
+            sentScreen[i] = blankCell;
+        }
+        sentScreenValid = true;
+    }
+
+    for (int row = 0; row < displayPort->rows; row++) {
+        const int rowStart = row * displayPort->cols;
+        const bool refresh = row == refreshRow;
+
+        int col = 0;
+        while (col < displayPort->cols) {
+            if (!isCellChanged(rowStart + col, refresh)) {
+                col++;
+                continue;
+            }
+
+            const uint8_t attr = screen[rowStart + col].attr;
+            int end = col + 1;
+            for (int next = col + 1; next < displayPort->cols && next - col < MSP_OSD_MAX_STRING_LENGTH; next++) {
+                if (screen[rowStart + next].attr != attr || next - end >= MSP_DISPLAYPORT_RUN_GAP) {
+                    break;
+                }
+                if (isCellChanged(rowStart + next, refresh)) {
+                    end = next + 1;
+                }
+            }
+
+            if (!writeRun(displayPort, row, col, end - col)) {
+                return;
+            }
+            col = end;
+        }
+    }
+
+    if (++refreshRow >= displayPort->rows) {
+        refreshRow = 0;
+    }
+}
+
 static bool drawScreen(displayPort_t *displayPort)
 {
+    sendChangedCells(displayPort);
+
     uint8_t subcmd[] = { MSP_DP_DRAW_SCREEN };
     output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
 
     return 0;
 }
 
+static void commitTransaction(displayPort_t *displayPort)
+{
+    sendChangedCells(displayPort);
+}
+
 static int screenSize(const displayPort_t *displayPort)
 {
     return displayPort->rows * displayPort->cols;
@@ -102,9 +224,25 @@ static int screenSize(const displayPort_t *displayPort)
 
 static int writeString(displayPort_t *displayPort, uint8_t col, uint8_t row, uint8_t attr, const char *string)
 {
-#define MSP_OSD_MAX_STRING_LENGTH 30 // FIXME move this
     uint8_t buf[MSP_OSD_MAX_STRING_LENGTH + 4];
 
+    uint8_t mspAttr = displayPortProfileMsp()->fontSelection[attr & (DISPLAYPORT_SEVERITY_COUNT - 1)] & DISPLAYPORT_MSP_ATTR_FONT;
+
+    if (attr & DISPLAYPORT_BLINK) {
+        mspAttr |= DISPLAYPORT_MSP_ATTR_BLINK;
+    }
+
+    if (useShadowScreen) {
+        if (row < displayPort->rows && col < displayPort->cols) {
+            mspDisplayCell_t *cell = &screen[row * displayPort->cols + col];
+            for (; *string && col < displayPort->cols; string++, col++, cell++) {
+                cell->ch = *string;
+                cell->attr = mspAttr;
+            }
+        }
+        return 0;
+    }
+
     int len = strlen(string);
     if (len >= MSP_OSD_MAX_STRING_LENGTH) {
         len = MSP_OSD_MAX_STRING_LENGTH;
@@ -113,11 +251,7 @@ static int writeString(displayPort_t *displayPort, uint8_t col, uint8_t row, uin
     buf[0] = MSP_DP_WRITE_STRING;
     buf[1] = row;
     buf[2] = col;
-    buf[3] = displayPortProfileMsp()->fontSelection[attr & (DISPLAYPORT_SEVERITY_COUNT - 1)] & DISPLAYPORT_MSP_ATTR_FONT;
-
-    if (attr & DISPLAYPORT_BLINK) {
-        buf[3] |= DISPLAYPORT_MSP_ATTR_BLINK;
-    }
+    buf[3] = mspAttr;
 
     memcpy(&buf[4], string, len);
 
@@ -159,6 +293,8 @@ static bool isSynced(const displayPort_t *displayPort)
 
 static void redraw(displayPort_t *displayPort)
 {
+    // resend everything
+    sentScreenValid = false;
     drawScreen(displayPort);
 }
 
@@ -185,6 +321,7 @@ static const displayPortVTable_t mspDisplayPortVTable = {
     .layerSupported = NULL,
     .layerSelect = NULL,
     .layerCopy = NULL,
+    .commitTransaction = commitTransaction,
 };
 
 displayPort_t *displayPortMspInit(void)
@@ -215,6 +352,11 @@ displayPort_t *displayPortMspInit(void)
         mspDisplayPort.cols = OSD_SD_COLS + displayPortProfileMsp()->colAdjust;
     }
 
+    useShadowScreen = mspDisplayPort.rows * mspDisplayPort.cols <= MSP_DISPLAYPORT_MAX_CELLS;
+    if (useShadowScreen) {
+        clearScreen(&mspDisplayPort, DISPLAY_CLEAR_NONE);
+    }
+
     redraw(&mspDisplayPort);
 
     return &mspDisplayPort;
@@ -43,6 +43,7 @@
 #include "build/debug.h"
 #include "common/maths.h"
 #include "common/printf.h"
+#include "common/utils.h"
 #include "drivers/flash/flash.h"
 #include "drivers/light_led.h"
 
@@ -59,6 +60,10 @@ static uint32_t flashfsSize = 0;
 static flashfsState_e flashfsState = FLASHFS_IDLE;
 static flashSector_t eraseSectorCurrent = 0;
 
+STATIC_ASSERT((FLASHFS_WRITE_BUFFER_SIZE & (FLASHFS_WRITE_BUFFER_SIZE - 1)) == 0, flashfs_write_buffer_size_not_power_of_2);
+
+#define FLASHFS_WRITE_BUFFER_MASK (FLASHFS_WRITE_BUFFER_SIZE - 1)
+
 static DMA_DATA_ZERO_INIT uint8_t flashWriteBuffer[FLASHFS_WRITE_BUFFER_SIZE];
 
 /* The position of our head and tail in the circular flash write buffer.
@@ -71,8 +76,8 @@ static DMA_DATA_ZERO_INIT uint8_t flashWriteBuffer[FLASHFS_WRITE_BUFFER_SIZE];
  * The tail is advanced once a write is complete up to the location behind head. The tail is advanced
  * by a callback from the FLASH write routine. This prevents data being overwritten whilst a write is in progress.
  */
-static uint8_t bufferHead = 0;
-static volatile uint8_t bufferTail = 0;
+static uint32_t bufferHead = 0;
+static volatile uint32_t bufferTail = 0;
 
 /* Track if there is new data to write. Until the contents of the buffer have been completely
  * written flashfsFlushAsync() will be repeatedly called. The tail pointer is only updated
@@ -228,10 +233,7 @@ uint32_t flashfsGetSize(void)
 
 static uint32_t flashfsTransmitBufferUsed(void)
 {
-    if (bufferHead >= bufferTail)
-        return bufferHead - bufferTail;
-
-    return FLASHFS_WRITE_BUFFER_SIZE - bufferTail + bufferHead;
+    return (bufferHead - bufferTail) & FLASHFS_WRITE_BUFFER_MASK;
 }
 
 /**
@@ -255,12 +257,8 @@ uint32_t flashfsGetWriteBufferFreeSpace(void)
  */
 static void flashfsAdvanceTailInBuffer(uint32_t delta)
 {
-    bufferTail += delta;
-
     // Wrap tail around the end of the buffer
-    if (bufferTail >= FLASHFS_WRITE_BUFFER_SIZE) {
-        bufferTail -= FLASHFS_WRITE_BUFFER_SIZE;
-    }
+    bufferTail = (bufferTail + delta) & FLASHFS_WRITE_BUFFER_MASK;
 }
 
 /**
@@ -336,15 +334,17 @@ static uint32_t flashfsWriteBuffers(uint8_t const **buffers, uint32_t *bufferSiz
  */
 static int flashfsGetDirtyDataBuffers(uint8_t const *buffers[], uint32_t bufferSizes[])
 {
-    buffers[0] = flashWriteBuffer + bufferTail;
+    const uint32_t tail = bufferTail;
+
+    buffers[0] = flashWriteBuffer + tail;
     buffers[1] = flashWriteBuffer + 0;
 
-    if (bufferHead > bufferTail) {
-        bufferSizes[0] = bufferHead - bufferTail;
+    if (bufferHead > tail) {
+        bufferSizes[0] = bufferHead - tail;
         bufferSizes[1] = 0;
         return 1;
-    } else if (bufferHead < bufferTail) {
-        bufferSizes[0] = FLASHFS_WRITE_BUFFER_SIZE - bufferTail;
+    } else if (bufferHead < tail) {
+        bufferSizes[0] = FLASHFS_WRITE_BUFFER_SIZE - tail;
         bufferSizes[1] = bufferHead;
         if (bufferSizes[1] == 0) {
             return 1;
@@ -380,7 +380,21 @@ uint32_t flashfsGetOffset(void)
 }
 
 /**
- * If the flash is ready to accept writes, flush the buffer to it.
+ * Get the number of buffered bytes at which an unforced flush writes to the device. Programs are started at the
+ * tail address and never cross a page boundary, so waiting for the rest of the current page keeps every program
+ * after the first one page-aligned. They are a whole page long if the page is no larger than
+ * FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN, so on the 2 kB ring NAND pages take two programs.
+ */
+static uint32_t flashfsFlushThreshold(void)
+{
+    const uint32_t pageRemaining = flashGeometry->pageSize - (tailAddress % flashGeometry->pageSize);
+
+    return MIN(pageRemaining, (uint32_t)FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN);
+}
+
+/**
+ * If the flash is ready to accept writes, flush the buffer to it. Page programs are issued back to back for as
+ * long as the device completes them and there is enough buffered data.
  *
  * Returns true if all data in the buffer has been flushed to the device, or false if
  * there is still data to be written (call flush again later).
@@ -389,46 +403,45 @@ bool flashfsFlushAsync(bool force)
 {
     uint8_t const * buffers[2];
     uint32_t bufferSizes[2];
-    int bufCount;
 
-    if (flashfsBufferIsEmpty()) {
-        return true; // Nothing to flush
-    }
-
-    if (!flashfsNewData()) {
-        // The previous write has yet to complete
-        return false;
-    }
+    // Wait for the previous write to complete before starting the next one
+    while (!flashfsBufferIsEmpty() && flashfsNewData()) {
+        const int bufCount = flashfsGetDirtyDataBuffers(buffers, bufferSizes);
+        const uint32_t bufferedBytes = bufferSizes[0] + bufferSizes[1];
 
-    bufCount = flashfsGetDirtyDataBuffers(buffers, bufferSizes);
-    uint32_t bufferedBytes = bufferSizes[0] + bufferSizes[1];
+        if (!force && bufferedBytes < flashfsFlushThreshold()) {
+            break;
+        }
 
-    if (bufCount && (force || (bufferedBytes >= FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN))) {
-        flashfsWriteBuffers(buffers, bufferSizes, bufCount, false);
+        if (flashfsWriteBuffers(buffers, bufferSizes, bufCount, false) == 0) {
+            // The device is busy or full
+            break;
+        }
     }
 
     return flashfsBufferIsEmpty();
 }
 
 /**
- * Wait for the flash to become ready and begin flushing any buffered data to flash.
+ * Wait for the flash to become ready and write all buffered data to flash.
  *
- * The flash will still be busy some time after this sync completes, but space will
- * be freed up to accept more writes in the write buffer.
+ * The flash will still be busy some time after this sync completes, but the write
+ * buffer will be empty.
  */
 void flashfsFlushSync(void)
 {
     uint8_t const * buffers[2];
     uint32_t bufferSizes[2];
-    int bufCount;
 
-    if (flashfsBufferIsEmpty()) {
-        return; // Nothing to flush
-    }
+    while (!flashfsBufferIsEmpty()) {
+        // Wait for the previous write to complete so that its bytes are not written again
+        while (!flashfsNewData());
 
-    bufCount = flashfsGetDirtyDataBuffers(buffers, bufferSizes);
-    if (bufCount) {
-        flashfsWriteBuffers(buffers, bufferSizes, bufCount, true);
+        const int bufCount = flashfsGetDirtyDataBuffers(buffers, bufferSizes);
+        if (flashfsWriteBuffers(buffers, bufferSizes, bufCount, true) == 0) {
+            // Out of space
+            break;
+        }
     }
 
     while (!flashIsReady());
@@ -464,24 +477,42 @@ void flashfsSeekAbs(uint32_t offset)
 }
 
 /**
- * Write the given byte asynchronously to the flash. If the buffer overflows, data is silently discarded.
+ * Copy the given bytes to the head of the write buffer, which must have room for them.
  */
-void flashfsWriteByte(uint8_t byte)
+static void flashfsBufferAppend(const uint8_t *data, uint32_t len)
 {
+    const uint32_t head = bufferHead;
+    const uint32_t firstLen = MIN(len, FLASHFS_WRITE_BUFFER_SIZE - head);
+
+    // The data may wrap around the end of the buffer
+    memcpy(flashWriteBuffer + head, data, firstLen);
+    memcpy(flashWriteBuffer, data + firstLen, len - firstLen);
+
 #ifdef USE_FLASH_TEST_PRBS
     if (checkFlashActive) {
-        byte = checkFlashNextByte();
-        checkFlashLen++;
+        for (uint32_t i = 0; i < len; i++) {
+            flashWriteBuffer[(head + i) & FLASHFS_WRITE_BUFFER_MASK] = checkFlashNextByte();
+        }
+        checkFlashLen += len;
     }
 #endif
 
-    flashWriteBuffer[bufferHead++] = byte;
+    bufferHead = (head + len) & FLASHFS_WRITE_BUFFER_MASK;
+}
 
-    if (bufferHead >= FLASHFS_WRITE_BUFFER_SIZE) {
-        bufferHead = 0;
+/**
+ * Write the given byte asynchronously to the flash. If the buffer overflows, data is silently discarded.
+ */
+void flashfsWriteByte(uint8_t byte)
+{
+    if (flashfsGetWriteBufferFreeSpace() == 0) {
+        return;
     }
 
-    if (flashfsTransmitBufferUsed() >= FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN) {
+    flashfsBufferAppend(&byte, 1);
+
+    // Only try to flush when this byte reaches the threshold, data left behind by a busy device goes with the periodic flush
+    if (flashfsTransmitBufferUsed() == flashfsFlushThreshold()) {
         flashfsFlushAsync(false);
     }
 }
@@ -489,32 +520,35 @@ void flashfsWriteByte(uint8_t byte)
 /**
  * Write the given buffer to the flash either synchronously or asynchronously depending on the 'sync' parameter.
  *
- * If writing asynchronously, data will be silently discarded if the buffer overflows.
+ * If writing asynchronously, the whole buffer is silently discarded if it doesn't fit in the write buffer, so
+ * that a blackbox frame is either logged complete or not at all.
  * If writing synchronously, the routine will block waiting for the flash to become ready so will never drop data.
  */
 void flashfsWrite(const uint8_t *data, unsigned int len, bool sync)
 {
-    uint8_t const * buffers[2];
-    uint32_t bufferSizes[2];
-    int bufCount;
-    uint32_t totalBufSize;
+    if (sync) {
+        while (len > flashfsGetWriteBufferFreeSpace()) {
+            const uint32_t chunkLen = flashfsGetWriteBufferFreeSpace();
 
-    // Buffer up the data the user supplied instead of writing it right away
-    for (unsigned int i = 0; i < len; i++) {
-        flashfsWriteByte(data[i]);
-    }
+            flashfsBufferAppend(data, chunkLen);
+            data += chunkLen;
+            len -= chunkLen;
 
-    // There could be two dirty buffers to write out already:
-    bufCount = flashfsGetDirtyDataBuffers(buffers, bufferSizes);
-    totalBufSize = bufferSizes[0] + bufferSizes[1];
+            flashfsFlushSync();
 
-    /*
-     * Would writing this data to our buffer cause our buffer to reach the flush threshold? If so try to write through
-     * to the flash now
-     */
-    if (bufCount && (totalBufSize >= FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN)) {
-        flashfsWriteBuffers(buffers, bufferSizes, bufCount, sync);
+            if (flashfsIsEOF()) {
+                // Nowhere left to write the rest
+                return;
+            }
+        }
+    } else if (len > flashfsGetWriteBufferFreeSpace()) {
+        return;
     }
+
+    flashfsBufferAppend(data, len);
+
+    // Write through to the flash if a page worth of data is now buffered
+    flashfsFlushAsync(false);
 }
 
 /**
@@ -20,11 +20,21 @@
 
 #pragma once
 
-#define FLASHFS_WRITE_BUFFER_SIZE 128
+// The write buffer is a ring at least two NOR flash pages deep, so that logging continues while a page is programmed.
+// The 4 kB ring also holds two pages of the 2 kB page NAND chips, the 2 kB ring used on small MCUs only one.
+// Targets may override its size, which must be a power of 2.
+#ifndef FLASHFS_WRITE_BUFFER_SIZE
+#if defined(TARGET_FLASH_SIZE) && TARGET_FLASH_SIZE <= 512
+#define FLASHFS_WRITE_BUFFER_SIZE 2048
+#else
+#define FLASHFS_WRITE_BUFFER_SIZE 4096
+#endif
+#endif
 #define FLASHFS_WRITE_BUFFER_USABLE (FLASHFS_WRITE_BUFFER_SIZE - 1)
 
-// Automatically trigger a flush when this much data is in the buffer
-#define FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN 64
+// Automatically trigger a flush when this much data is in the buffer, or when it completes a flash page.
+// Pages larger than this are programmed in page-aligned pieces of this length.
+#define FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN (FLASHFS_WRITE_BUFFER_SIZE / 2)
 
 void flashfsEraseCompletely(void);
 void flashfsEraseRange(uint32_t start, uint32_t end);
@@ -373,11 +373,13 @@ static void logErrorToPacketLog(void)
 #endif  // USE_DASHBOARD
 
 static void gpsNewData(uint16_t c);
+static uint32_t gpsNewDataSpan(const uint8_t *data, uint32_t count);
 #ifdef USE_GPS_NMEA
 static bool gpsNewFrameNMEA(char c);
 #endif
 #ifdef USE_GPS_UBLOX
 static bool gpsNewFrameUBLOX(uint8_t data);
+static uint32_t gpsNewSpanUBLOX(const uint8_t *data, uint32_t count, bool *newPositionDataReceived);
 #endif
 
 static void gpsSetState(gpsState_e state)
@@ -1391,17 +1393,24 @@ void gpsUpdate(timeUs_t currentTimeUs)
         DEBUG_SET(DEBUG_GPS_CONNECTION, 7, serialRxBytesWaiting(gpsPort));
         static uint8_t wait = 0;
         static bool isFast = false;
-        while (serialRxBytesWaiting(gpsPort)) {
+        const uint8_t *data;
+        uint8_t byte;
+        uint32_t count;
+        while ((count = serialPeekRx(gpsPort, &data, &byte))) {
             wait = 0;
             if (!isFast) {
                 rescheduleTask(TASK_SELF, TASK_PERIOD_HZ(TASK_GPS_RATE_FAST));
                 isFast = true;
             }
-            if (cmpTimeUs(micros(), currentTimeUs) > GPS_RECV_TIME_MAX) {
+            // Parse the received data in place, when enough bytes are received, convert data to values
+            uint32_t consumed = 0;
+            do {
+                consumed += gpsNewDataSpan(data + consumed, count - consumed);
+            } while (consumed < count && cmpTimeUs(micros(), currentTimeUs) <= GPS_RECV_TIME_MAX);
+            serialSkipRx(gpsPort, consumed);
+            if (consumed < count) {
                 break;
             }
-            // Add every byte to _buffer, when enough bytes are received, convert data to values
-            gpsNewData(serialRead(gpsPort));
         }
         if (wait < 1) {
             wait++;
@@ -1523,13 +1532,8 @@ void gpsUpdate(timeUs_t currentTimeUs)
 //    DEBUG_SET(DEBUG_GPS_CONNECTION, 6, (gpsStateDurationFractionUs[gpsCurrentState] >> GPS_TASK_DECAY_SHIFT));
 }
 
-static void gpsNewData(uint16_t c)
+static void gpsHandleNewNavData(void)
 {
-    DEBUG_SET(DEBUG_GPS_CONNECTION, 1, gpsSol.navIntervalMs);
-    if (!gpsNewFrame(c)) {
-        // no new nav solution data
-        return;
-    }
     if (gpsData.state == GPS_STATE_RECEIVING_DATA) {
         DEBUG_SET(DEBUG_GPS_CONNECTION, 3, gpsData.now - gpsData.lastNavMessage); // interval since last Nav data was received
         gpsData.lastNavMessage = gpsData.now;
@@ -1540,6 +1544,39 @@ static void gpsNewData(uint16_t c)
     onGpsNewData();
 }
 
+static void gpsNewData(uint16_t c)
+{
+    DEBUG_SET(DEBUG_GPS_CONNECTION, 1, gpsSol.navIntervalMs);
+    if (!gpsNewFrame(c)) {
+        // no new nav solution data
+        return;
+    }
+    gpsHandleNewNavData();
+}
+
+// Returns the number of bytes consumed, at least one
+static uint32_t gpsNewDataSpan(const uint8_t *data, uint32_t count)
+{
+#ifdef USE_GPS_UBLOX
+    if (gpsConfig()->provider == GPS_UBLOX) {
+        // Whole frames are parsed from the buffer, anything else goes through the byte parser
+        bool newPositionDataReceived = false;
+        const uint32_t consumed = gpsNewSpanUBLOX(data, count, &newPositionDataReceived);
+        if (consumed) {
+            DEBUG_SET(DEBUG_GPS_CONNECTION, 1, gpsSol.navIntervalMs);
+            if (newPositionDataReceived) {
+                gpsHandleNewNavData();
+            }
+            return consumed;
+        }
+    }
+#endif
+
+    gpsNewData(*data);
+
+    return 1;
+}
+
 #ifdef USE_GPS_UBLOX
 static ubloxVersion_e ubloxParseVersion(const uint32_t version)
 {
@@ -1990,6 +2027,7 @@ typedef struct ubxNavSol_s {
     uint32_t res2;
 } ubxNavSol_t;
 
+// NAV-PVT and NAV-SAT are decoded in place from the serial receive buffer, so have no alignment
 typedef struct ubxNavPvt_s {
     uint32_t time;
     uint16_t year;
@@ -2024,7 +2062,9 @@ typedef struct ubxNavPvt_s {
     int32_t headVeh;
     int16_t magDec;
     uint16_t magAcc;
-} ubxNavPvt_t;
+} __attribute__((packed)) ubxNavPvt_t;
+
+STATIC_ASSERT(sizeof(ubxNavPvt_t) == 92, ubxNavPvt_t_size_mismatch);
 
 typedef struct ubxNavVelned_s {
     uint32_t time;              // GPS msToW
@@ -2057,7 +2097,7 @@ typedef struct ubxNavSatSv_s {
     int16_t azim;               // Azimuth in integer degrees
     int16_t prRes;              // Pseudo range residual in decimetres
     uint32_t flags;             // Bitmask
-} ubxNavSatSv_t;
+} __attribute__((packed)) ubxNavSatSv_t;
 
 typedef struct ubxNavSvinfo_s {
     uint32_t time;              // GPS Millisecond time of week
@@ -2073,7 +2113,9 @@ typedef struct ubxNavSat_s {
     uint8_t numSvs;
     uint8_t reserved0[2];
     ubxNavSatSv_t svs[GPS_SV_MAXSATS_M8N];
-} ubxNavSat_t;
+} __attribute__((packed)) ubxNavSat_t;
+
+STATIC_ASSERT(sizeof(ubxNavSat_t) == 8 + 12 * GPS_SV_MAXSATS_M8N, ubxNavSat_t_size_mismatch);
 
 typedef struct ubxAck_s {
     uint8_t clsId;               // Class ID of the acknowledged message
@@ -2167,6 +2209,88 @@ static uint16_t ubxFrameParsePayloadCounter;
 // Combines message class & ID for a single value to switch on.
 #define CLSMSG(cls, msg) (((cls) << 8) | (msg))
 
+static bool ubloxHaveNewNavData(void)
+{
+    // we only return true when we get new position and speed data
+    // this ensures we don't use stale data
+    if (ubxHaveNewPosition && ubxHaveNewSpeed) {
+        ubxHaveNewSpeed = ubxHaveNewPosition = false;
+        return true;
+    }
+    return false;
+}
+
+static void ubloxParseNavPvt(const ubxNavPvt_t *pvt)
+{
+#ifdef USE_DASHBOARD
+    *dashboardGpsPacketLogCurrentChar = DASHBOARD_LOG_UBLOX_SOL;
+#endif
+    ubxHaveNewValidFix = (pvt->flags & NAV_STATUS_FIX_VALID) && (pvt->fixType == FIX_3D);
+    gpsSol.time = pvt->time;
+    calculateNavInterval();
+    gpsSol.llh.lon = pvt->lon;
+    gpsSol.llh.lat = pvt->lat;
+    gpsSol.llh.altCm = pvt->hMSL / 10;  //alt in cm
+    gpsSetFixState(ubxHaveNewValidFix);
+    ubxHaveNewPosition = true;
+    gpsSol.numSat = pvt->numSV;
+    gpsSol.acc.hAcc = pvt->hAcc;
+    gpsSol.acc.vAcc = pvt->vAcc;
+    gpsSol.acc.sAcc = pvt->sAcc;
+    gpsSol.speed3d = (uint16_t) sqrtf(powf(pvt->gSpeed / 10, 2.0f) + powf(pvt->velD / 10, 2.0f));
+    gpsSol.groundSpeed = pvt->gSpeed / 10;    // cm/s
+    gpsSol.groundCourse = (uint16_t) (pvt->headMot / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
+    gpsSol.dop.pdop = pvt->pDOP;
+    ubxHaveNewSpeed = true;
+#ifdef USE_RTC_TIME
+    //set clock, when gps time is available
+    if (!rtcHasTime() && (pvt->valid & NAV_VALID_DATE) && (pvt->valid & NAV_VALID_TIME)) {
+        dateTime_t dt;
+        dt.year = pvt->year;
+        dt.month = pvt->month;
+        dt.day = pvt->day;
+        dt.hours = pvt->hour;
+        dt.minutes = pvt->min;
+        dt.seconds = pvt->sec;
+        dt.millis = (pvt->nano > 0) ? pvt->nano / 1000000 : 0; // up to 5ms of error
+        rtcSetDateTime(&dt);
+    }
+#endif
+}
+
+static void ubloxParseNavSat(const ubxNavSat_t *sat)
+{
+#ifdef USE_DASHBOARD
+    *dashboardGpsPacketLogCurrentChar = DASHBOARD_LOG_UBLOX_SVINFO; // The display log only shows SVINFO for both SVINFO and SAT.
+#endif
+    GPS_numCh = MIN(sat->numSvs, GPS_SV_MAXSATS_M8N);
+    // If we're receiving UBX-NAV-SAT messages, we detected a module M8 or newer.
+    // We can receive far more sats than we can handle for Configurator, which is the primary consumer for sat info.
+    // We're using the max for M8 (32) for our sizing, since Configurator only supports a max of 32 sats and we
+    // want to limit the payload buffer space used.
+    // We simply ignore any sats above that max, the down side is we may not see sats used for the solution, but
+    // the intent in Configurator is to see if sats are being acquired and their strength, so this is not an issue.
+    for (unsigned i = 0; i < ARRAYLEN(GPS_svinfo); i++) {
+        if (i < GPS_numCh) {
+            GPS_svinfo[i].chn = sat->svs[i].gnssId;
+            GPS_svinfo[i].svid = sat->svs[i].svId;
+            GPS_svinfo[i].cno = sat->svs[i].cno;
+            GPS_svinfo[i].quality = sat->svs[i].flags;
+        } else {
+            GPS_svinfo[i] = (GPS_svinfo_t){ .chn = 255 };
+        }
+    }
+
+    // Setting the number of channels higher than GPS_SV_MAXSATS_LEGACY is the only way to tell BF Configurator we're sending the
+    // enhanced sat list info without changing the MSP protocol. Also, we're sending the complete list each time even if it's empty, so
+    // BF Conf can erase old entries shown on screen when channels are removed from the list.
+    // TODO: GPS_numCh = MAX(GPS_numCh, GPS_SV_MAXSATS_LEGACY + 1);
+    GPS_numCh = GPS_SV_MAXSATS_M8N;
+#ifdef USE_DASHBOARD
+    dashboardGpsNavSvInfoRcvCount++;
+#endif
+}
+
 static bool UBLOX_parse_gps(void)
 {
 //    lastUbxRcvMsgClass = ubxRcvMsgClass;
@@ -2242,40 +2366,7 @@ static bool UBLOX_parse_gps(void)
         ubxHaveNewSpeed = true;
         break;
     case CLSMSG(CLASS_NAV, MSG_NAV_PVT):
-#ifdef USE_DASHBOARD
-        *dashboardGpsPacketLogCurrentChar = DASHBOARD_LOG_UBLOX_SOL;
-#endif
-        ubxHaveNewValidFix = (ubxRcvMsgPayload.ubxNavPvt.flags & NAV_STATUS_FIX_VALID) && (ubxRcvMsgPayload.ubxNavPvt.fixType == FIX_3D);
-        gpsSol.time = ubxRcvMsgPayload.ubxNavPvt.time;
-        calculateNavInterval();
-        gpsSol.llh.lon = ubxRcvMsgPayload.ubxNavPvt.lon;
-        gpsSol.llh.lat = ubxRcvMsgPayload.ubxNavPvt.lat;
-        gpsSol.llh.altCm = ubxRcvMsgPayload.ubxNavPvt.hMSL / 10;  //alt in cm
-        gpsSetFixState(ubxHaveNewValidFix);
-        ubxHaveNewPosition = true;
-        gpsSol.numSat = ubxRcvMsgPayload.ubxNavPvt.numSV;
-        gpsSol.acc.hAcc = ubxRcvMsgPayload.ubxNavPvt.hAcc;
-        gpsSol.acc.vAcc = ubxRcvMsgPayload.ubxNavPvt.vAcc;
-        gpsSol.acc.sAcc = ubxRcvMsgPayload.ubxNavPvt.sAcc;
-        gpsSol.speed3d = (uint16_t) sqrtf(powf(ubxRcvMsgPayload.ubxNavPvt.gSpeed / 10, 2.0f) + powf(ubxRcvMsgPayload.ubxNavPvt.velD / 10, 2.0f));
-        gpsSol.groundSpeed = ubxRcvMsgPayload.ubxNavPvt.gSpeed / 10;    // cm/s
-        gpsSol.groundCourse = (uint16_t) (ubxRcvMsgPayload.ubxNavPvt.headMot / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
-        gpsSol.dop.pdop = ubxRcvMsgPayload.ubxNavPvt.pDOP;
-        ubxHaveNewSpeed = true;
-#ifdef USE_RTC_TIME
-        //set clock, when gps time is available
-        if (!rtcHasTime() && (ubxRcvMsgPayload.ubxNavPvt.valid & NAV_VALID_DATE) && (ubxRcvMsgPayload.ubxNavPvt.valid & NAV_VALID_TIME)) {
-            dateTime_t dt;
-            dt.year = ubxRcvMsgPayload.ubxNavPvt.year;
-            dt.month = ubxRcvMsgPayload.ubxNavPvt.month;
-            dt.day = ubxRcvMsgPayload.ubxNavPvt.day;
-            dt.hours = ubxRcvMsgPayload.ubxNavPvt.hour;
-            dt.minutes = ubxRcvMsgPayload.ubxNavPvt.min;
-            dt.seconds = ubxRcvMsgPayload.ubxNavPvt.sec;
-            dt.millis = (ubxRcvMsgPayload.ubxNavPvt.nano > 0) ? ubxRcvMsgPayload.ubxNavPvt.nano / 1000000 : 0; // up to 5ms of error
-            rtcSetDateTime(&dt);
-        }
-#endif
+        ubloxParseNavPvt(&ubxRcvMsgPayload.ubxNavPvt);
         break;
     case CLSMSG(CLASS_NAV, MSG_NAV_SVINFO):
 #ifdef USE_DASHBOARD
@@ -2303,35 +2394,7 @@ static bool UBLOX_parse_gps(void)
 #endif
         break;
     case CLSMSG(CLASS_NAV, MSG_NAV_SAT):
-#ifdef USE_DASHBOARD
-        *dashboardGpsPacketLogCurrentChar = DASHBOARD_LOG_UBLOX_SVINFO; // The display log only shows SVINFO for both SVINFO and SAT.
-#endif
-        GPS_numCh = MIN(ubxRcvMsgPayload.ubxNavSat.numSvs, GPS_SV_MAXSATS_M8N);
-        // If we're receiving UBX-NAV-SAT messages, we detected a module M8 or newer.
-        // We can receive far more sats than we can handle for Configurator, which is the primary consumer for sat info.
-        // We're using the max for M8 (32) for our sizing, since Configurator only supports a max of 32 sats and we
-        // want to limit the payload buffer space used.
-        // We simply ignore any sats above that max, the down side is we may not see sats used for the solution, but
-        // the intent in Configurator is to see if sats are being acquired and their strength, so this is not an issue.
-        for (unsigned i = 0; i < ARRAYLEN(GPS_svinfo); i++) {
-            if (i < GPS_numCh) {
-                GPS_svinfo[i].chn = ubxRcvMsgPayload.ubxNavSat.svs[i].gnssId;
-                GPS_svinfo[i].svid = ubxRcvMsgPayload.ubxNavSat.svs[i].svId;
-                GPS_svinfo[i].cno = ubxRcvMsgPayload.ubxNavSat.svs[i].cno;
-                GPS_svinfo[i].quality = ubxRcvMsgPayload.ubxNavSat.svs[i].flags;
-            } else {
-                GPS_svinfo[i] = (GPS_svinfo_t){ .chn = 255 };
-            }
-        }
-
-        // Setting the number of channels higher than GPS_SV_MAXSATS_LEGACY is the only way to tell BF Configurator we're sending the
-        // enhanced sat list info without changing the MSP protocol. Also, we're sending the complete list each time even if it's empty, so
-        // BF Conf can erase old entries shown on screen when channels are removed from the list.
-        // TODO: GPS_numCh = MAX(GPS_numCh, GPS_SV_MAXSATS_LEGACY + 1);
-        GPS_numCh = GPS_SV_MAXSATS_M8N;
-#ifdef USE_DASHBOARD
-        dashboardGpsNavSvInfoRcvCount++;
-#endif
+        ubloxParseNavSat(&ubxRcvMsgPayload.ubxNavSat);
         break;
     case CLSMSG(CLASS_CFG, MSG_CFG_GNSS):
         {
@@ -2375,15 +2438,8 @@ static bool UBLOX_parse_gps(void)
     default:
         return false;
     }
-#undef CLSMSG
 
-    // we only return true when we get new position and speed data
-    // this ensures we don't use stale data
-    if (ubxHaveNewPosition && ubxHaveNewSpeed) {
-        ubxHaveNewSpeed = ubxHaveNewPosition = false;
-        return true;
-    }
-    return false;
+    return ubloxHaveNewNavData();
 }
 
 static bool gpsNewFrameUBLOX(uint8_t data)
@@ -2512,6 +2568,85 @@ static bool gpsNewFrameUBLOX(uint8_t data)
     // Note this function returns if UBLOX_parse_gps() found new position data, NOT whether this function successfully parsed the frame or not.
     return newPositionDataReceived;
 }
+
+// Handles a frame received in one piece with a valid checksum, the payload is only valid during the call
+static bool ubloxParseFrame(const uint8_t *payload)
+{
+    switch (CLSMSG(ubxRcvMsgClass, ubxRcvMsgID)) {
+    case CLSMSG(CLASS_NAV, MSG_NAV_PVT):
+        if (ubxRcvMsgPayloadLength >= sizeof(ubxNavPvt_t)) {
+            ubloxParseNavPvt((const ubxNavPvt_t *)payload);
+            return ubloxHaveNewNavData();
+        }
+        break;
+    case CLSMSG(CLASS_NAV, MSG_NAV_SAT):
+        {
+            const ubxNavSat_t *sat = (const ubxNavSat_t *)payload;
+            if (ubxRcvMsgPayloadLength >= offsetof(ubxNavSat_t, svs)
+                && ubxRcvMsgPayloadLength >= offsetof(ubxNavSat_t, svs) + MIN(sat->numSvs, GPS_SV_MAXSATS_M8N) * sizeof(ubxNavSatSv_t)) {
+                ubloxParseNavSat(sat);
+                return ubloxHaveNewNavData();
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    // Other messages are decoded from a copy, the same as when received byte by byte
+    memcpy(ubxRcvMsgPayload.rawBytes, payload, MIN(ubxRcvMsgPayloadLength, UBLOX_PAYLOAD_SIZE));
+
+    return UBLOX_parse_gps();
+}
+#undef CLSMSG
+
+// Parses the frames starting at data while between frames, so that a frame received in one piece is checked
+// and decoded in a single pass. Returns the number of bytes consumed, 0 when the byte parser must take the next
+// byte: when a frame is incomplete, split at the end of the receive buffer or has a bad checksum.
+static uint32_t gpsNewSpanUBLOX(const uint8_t *data, uint32_t count, bool *newPositionDataReceived)
+{
+    if (ubxFrameParseState != UBX_PARSE_PREAMBLE_SYNC_1) {
+        return 0;
+    }
+
+    // The byte parser would stay looking for the preamble on the bytes before it
+    const uint8_t *frame = memchr(data, PREAMBLE1, count);
+    if (!frame) {
+        return count;
+    }
+    const uint32_t skipped = frame - data;
+    count -= skipped;
+
+    // preamble, class, ID and length, payload, checksum A and B
+    if (count < 8 || frame[1] != PREAMBLE2) {
+        return skipped;
+    }
+    const uint16_t payloadLength = frame[4] | frame[5] << 8;
+    if (payloadLength > UBLOX_MAX_PAYLOAD_SANITY_SIZE || count < payloadLength + 8U) {
+        return skipped;
+    }
+
+    uint8_t checksumA = 0;
+    uint8_t checksumB = 0;
+    for (unsigned i = 2; i < payloadLength + 6U; i++) {
+        checksumB += (checksumA += frame[i]);
+    }
+    if (checksumA != frame[payloadLength + 6] || checksumB != frame[payloadLength + 7]) {
+        return skipped;
+    }
+
+#ifdef USE_DASHBOARD
+    dashboardGpsPacketCount++;
+    shiftPacketLog();
+    *dashboardGpsPacketLogCurrentChar = DASHBOARD_LOG_IGNORED;
+#endif
+    ubxRcvMsgClass = frame[2];
+    ubxRcvMsgID = frame[3];
+    ubxRcvMsgPayloadLength = payloadLength;
+    *newPositionDataReceived = ubloxParseFrame(&frame[6]);
+
+    return skipped + payloadLength + 8;
+}
 #endif // USE_GPS_UBLOX
 
 static void gpsHandlePassthrough(uint8_t data)
@@ -47,6 +47,9 @@ int main(int argc, char * argv[])
 void FAST_CODE run(void)
 {
     while (true) {
+#if defined(SIMULATOR_BUILD)
+        simulatorLoopWait();
+#endif
         scheduler();
 #if defined(RUN_LOOP_DELAY_US) && RUN_LOOP_DELAY_US > 0
         delayMicroseconds_real(RUN_LOOP_DELAY_US);
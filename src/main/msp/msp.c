@@ -41,6 +41,7 @@
 #include "common/bitarray.h"
 #include "common/color.h"
 #include "common/huffman.h"
+#include "common/lz.h"
 #include "common/maths.h"
 #include "common/streambuf.h"
 #include "common/utils.h"
@@ -523,10 +524,102 @@ static void serializeDataflashSummaryReply(sbuf_t *dst)
 #ifdef USE_FLASHFS
 enum compressionType_e {
     NO_COMPRESSION,
-    HUFFMAN
+    HUFFMAN,
+    LZ
 };
 
-static void serializeDataflashReadReply(sbuf_t *dst, uint32_t address, const uint16_t size, bool useLegacyFormat, bool allowCompression)
+#ifdef USE_LZ
+static lzState_t lzState;
+
+// A host that asks for LZ also decodes Huffman. Each LZ reply counts the Huffman bits of its input as well, and
+// when Huffman would have been smaller the next replies that continue where it stopped are sent in Huffman.
+// The choice is made again after a seek or DATAFLASH_HUFFMAN_REPLIES_MAX Huffman replies, so flash is read once.
+#define DATAFLASH_HUFFMAN_REPLIES_MAX 8
+
+static uint32_t dataflashNextAddress;
+static uint8_t dataflashHuffmanReplies;
+#endif
+
+static uint8_t dataflashCompressionMethod(uint8_t requested)
+{
+    switch (requested) {
+    case NO_COMPRESSION:
+        return NO_COMPRESSION;
+#ifdef USE_LZ
+    case LZ:
+        return LZ;
+#endif
+    default:
+        // older hosts ask for compression with any non zero value, LZ falls back to Huffman when not built
+#ifdef USE_HUFFMAN
+        return HUFFMAN;
+#else
+        return NO_COMPRESSION;
+#endif
+    }
+}
+
+#ifdef USE_LZ
+static bool dataflashHuffmanChosen(uint32_t address)
+{
+    if (address == dataflashNextAddress && dataflashHuffmanReplies > 0) {
+        dataflashHuffmanReplies--;
+        return true;
+    }
+    return false;
+}
+
+static void serializeDataflashLzReply(sbuf_t *dst, uint32_t address, uint16_t readLen)
+{
+    const uint32_t flashfsSize = flashfsGetSize();
+    // compress in 256-byte chunks
+    const uint16_t READ_BUFFER_SIZE = 256;
+    // This may be DMAable, so make it cache aligned
+    __attribute__ ((aligned(32))) uint8_t readBuffer[READ_BUFFER_SIZE];
+
+    lzInit(&lzState, sbufPtr(dst) + sizeof(uint16_t) + sizeof(uint8_t) + LZ_INFO_SIZE, readLen);
+#ifdef USE_HUFFMAN
+    uint32_t huffmanBits = 0;
+#endif
+
+    // read until output buffer overflows, flash is exhausted or the uncompressed count is at its limit
+    int status = 0;
+    while (status == 0 && address + lzState.inputCount < flashfsSize && lzState.inputCount < UINT16_MAX) {
+        const int bytesRead = flashfsReadAbs(address + lzState.inputCount, readBuffer,
+            MIN(MIN(sizeof(readBuffer), flashfsSize - address - lzState.inputCount), UINT16_MAX - lzState.inputCount));
+        if (bytesRead <= 0) {
+            break;
+        }
+#ifdef USE_HUFFMAN
+        for (int i = 0; i < bytesRead; i++) {
+            huffmanBits += huffmanTable[readBuffer[i]].codeLen;
+        }
+#endif
+        status = lzEncodeBufStreaming(&lzState, readBuffer, bytesRead);
+    }
+    if (status == 0) {
+        lzFlush(&lzState);
+    }
+    // on overflow only the input that was encoded is reported, the host reads on from there
+    dataflashNextAddress = address + lzState.encodedCount;
+
+#ifdef USE_HUFFMAN
+    // compare output bits per input byte, LZ may not have encoded all of the input it was given
+    if ((uint64_t)huffmanBits * lzState.encodedCount < (uint64_t)lzState.bytesWritten * 8 * lzState.inputCount) {
+        dataflashHuffmanReplies = DATAFLASH_HUFFMAN_REPLIES_MAX;
+    }
+#endif
+
+    // header
+    sbufWriteU16(dst, LZ_INFO_SIZE + lzState.bytesWritten);
+    sbufWriteU8(dst, LZ);
+    // payload
+    sbufWriteU16(dst, lzState.encodedCount);
+    sbufAdvance(dst, lzState.bytesWritten);
+}
+#endif
+
+static void serializeDataflashReadReply(sbuf_t *dst, uint32_t address, const uint16_t size, bool useLegacyFormat, uint8_t requestedCompression)
 {
     STATIC_ASSERT(MSP_PORT_DATAFLASH_INFO_SIZE >= 16, MSP_PORT_DATAFLASH_INFO_SIZE_invalid);
 
@@ -544,11 +637,17 @@ static void serializeDataflashReadReply(sbuf_t *dst, uint32_t address, const uin
     sbufWriteU32(dst, address);
 
     // legacy format does not support compression
-#ifdef USE_HUFFMAN
-    const uint8_t compressionMethod = (!allowCompression || useLegacyFormat) ? NO_COMPRESSION : HUFFMAN;
-#else
-    const uint8_t compressionMethod = NO_COMPRESSION;
-    UNUSED(allowCompression);
+    uint8_t compressionMethod = useLegacyFormat ? NO_COMPRESSION : dataflashCompressionMethod(requestedCompression);
+
+#ifdef USE_LZ
+    if (compressionMethod == LZ) {
+        if (!dataflashHuffmanChosen(address)) {
+            serializeDataflashLzReply(dst, address, readLen);
+            return;
+        }
+        // Huffman codes this part of the log in fewer bytes
+        compressionMethod = HUFFMAN;
+    }
 #endif
 
     if (compressionMethod == NO_COMPRESSION) {
@@ -575,8 +674,8 @@ static void serializeDataflashReadReply(sbuf_t *dst, uint32_t address, const uin
                 sbufWriteU8(dst, 0);
             }
         }
-    } else {
 #ifdef USE_HUFFMAN
+    } else if (compressionMethod == HUFFMAN) {
         // compress in 256-byte chunks
         const uint16_t READ_BUFFER_SIZE = 256;
         // This may be DMAable, so make it cache aligned
@@ -615,6 +714,9 @@ static void serializeDataflashReadReply(sbuf_t *dst, uint32_t address, const uin
         // payload
         sbufWriteU16(dst, bytesReadTotal);
         sbufAdvance(dst, state.bytesWritten);
+#ifdef USE_LZ
+        dataflashNextAddress = address + bytesReadTotal;
+#endif
 #endif
     }
 }
@@ -2319,6 +2421,76 @@ static void writePidfs(pidProfile_t* pidProfile, sbuf_t *dst)
 }
 #endif // USE_SIMPLIFIED_TUNING
 
+// Sub-command replies of MSP2_MULTIPLE_MSP are built here, then copied to the reply if they fit
+static uint8_t mspMultipleReplyBuf[MSP_PORT_OUTBUF_SIZE_MIN];
+static bool mspMultipleActive;
+
+/*
+ * MSP2_MULTIPLE_MSP request: { uint16 command, uint8 argument size, argument }, repeated
+ * Reply: { uint16 command, int8 result, uint16 reply size, reply }, repeated for the commands in order,
+ * ending early with the first reply that doesn't fit.
+ */
+static mspResult_e mspFcProcessMultipleCommand(mspDescriptor_t srcDesc, sbuf_t *src, sbuf_t *dst)
+{
+    // no nesting, there is only the one sub-command reply buffer
+    if (mspMultipleActive) {
+        return MSP_RESULT_ERROR;
+    }
+    mspMultipleActive = true;
+
+    while (sbufBytesRemaining(src) >= 3) {
+        mspPacket_t packetIn = { .direction = MSP_DIRECTION_REQUEST };
+        mspPacket_t packetOut = {
+            .buf = { .ptr = mspMultipleReplyBuf, .end = ARRAYEND(mspMultipleReplyBuf), },
+            .direction = MSP_DIRECTION_REPLY,
+        };
+
+        packetIn.cmd = sbufReadU16(src);
+        const int argSize = MIN(sbufReadU8(src), sbufBytesRemaining(src));
+        sbufInit(&packetIn.buf, sbufPtr(src), sbufPtr(src) + argSize);
+        sbufAdvance(src, argSize);
+
+        const mspResult_e result = mspFcProcessCommand(srcDesc, &packetIn, &packetOut, NULL);
+        const int replySize = sbufPtr(&packetOut.buf) - mspMultipleReplyBuf;
+        if (sbufBytesRemaining(dst) < 2 + 1 + 2 + replySize) {
+            break;
+        }
+        sbufWriteU16(dst, packetIn.cmd);
+        sbufWriteU8(dst, result);
+        sbufWriteU16(dst, replySize);
+        sbufWriteData(dst, mspMultipleReplyBuf, replySize);
+    }
+
+    mspMultipleActive = false;
+    return MSP_RESULT_ACK;
+}
+
+/*
+ * A subscription is replayed every interval, also while armed, so it may only list queries: commands without
+ * arguments handled by the out processors. These have no side effects, so running one tells whether it is a query.
+ */
+static bool mspFcIsQueryRequest(mspDescriptor_t srcDesc, sbuf_t *src)
+{
+    if (mspMultipleActive) {
+        return false;
+    }
+
+    while (sbufBytesRemaining(src)) {
+        if (sbufBytesRemaining(src) < 3) {
+            return false;
+        }
+        const int16_t cmdMSP = sbufReadU16(src);
+        if (sbufReadU8(src) != 0) {
+            return false;
+        }
+        sbuf_t dst = { .ptr = mspMultipleReplyBuf, .end = ARRAYEND(mspMultipleReplyBuf), };
+        if (!mspCommonProcessOutCommand(cmdMSP, &dst, NULL) && !mspProcessOutCommand(srcDesc, cmdMSP, &dst)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static mspResult_e mspFcProcessOutCommandWithArg(mspDescriptor_t srcDesc, int16_t cmdMSP, sbuf_t *src, sbuf_t *dst, mspPostProcessFnPtr *mspPostProcessFn)
 {
 
@@ -2408,6 +2580,24 @@ static mspResult_e mspFcProcessOutCommandWithArg(mspDescriptor_t srcDesc, int16_
         }
         break;
 
+    case MSP2_MULTIPLE_MSP:
+        return mspFcProcessMultipleCommand(srcDesc, src, dst);
+
+    case MSP2_SUBSCRIBE:
+        {
+            // { uint16 interval in ms, MSP2_MULTIPLE_MSP request }, an interval of 0 ends the subscription
+            if (sbufBytesRemaining(src) < 2) {
+                return MSP_RESULT_ERROR;
+            }
+            const uint16_t intervalMs = sbufReadU16(src);
+            sbuf_t request = *src;
+            if (!mspFcIsQueryRequest(srcDesc, &request) ||
+                !mspSerialSubscribe(srcDesc, intervalMs, sbufPtr(src), sbufBytesRemaining(src))) {
+                return MSP_RESULT_ERROR;
+            }
+        }
+        break;
+
 #ifdef USE_VTX_TABLE
     case MSP_VTXTABLE_BAND:
         {
@@ -2623,12 +2813,12 @@ static void mspFcDataFlashReadCommand(sbuf_t *dst, sbuf_t *src)
     const unsigned int dataSize = sbufBytesRemaining(src);
     const uint32_t readAddress = sbufReadU32(src);
     uint16_t readLength;
-    bool allowCompression = false;
+    uint8_t compressionMethod = NO_COMPRESSION;
     bool useLegacyFormat;
     if (dataSize >= sizeof(uint32_t) + sizeof(uint16_t)) {
         readLength = sbufReadU16(src);
         if (sbufBytesRemaining(src)) {
-            allowCompression = sbufReadU8(src);
+            compressionMethod = sbufReadU8(src);
         }
         useLegacyFormat = false;
     } else {
@@ -2636,7 +2826,7 @@ static void mspFcDataFlashReadCommand(sbuf_t *dst, sbuf_t *src)
         useLegacyFormat = true;
     }
 
-    serializeDataflashReadReply(dst, readAddress, readLength, useLegacyFormat, allowCompression);
+    serializeDataflashReadReply(dst, readAddress, readLength, useLegacyFormat, compressionMethod);
 }
 #endif
 
@@ -4436,6 +4626,61 @@ static mspResult_e mspCommonProcessInCommand(mspDescriptor_t srcDesc, int16_t cm
     return MSP_RESULT_ACK;
 }
 
+/*
+ * The command processors are tried in turn until one handles the command. Which one handled a command is
+ * remembered, so the next request for it starts there instead of falling through the switch statements of
+ * the processors before. A command is only ever handled by one processor, but a processor may pass on a
+ * command it can't serve at the time, so a request still falls through to the processors after.
+ */
+typedef enum {
+    MSP_PROCESSOR_COMMON_OUT = 0,
+    MSP_PROCESSOR_OUT,
+    MSP_PROCESSOR_OUT_WITH_ARG,
+    MSP_PROCESSOR_IN,
+} mspProcessor_e;
+
+#define MSP_PROCESSOR_BITS 2
+#define MSP_PROCESSORS_PER_BYTE (8 / MSP_PROCESSOR_BITS)
+
+// MSP v1 commands, followed by the MSP2 common and MSP2 Betaflight commands
+#define MSP_PROCESSOR_CACHE_COUNT (3 * 0x100)
+
+static uint8_t mspProcessorCache[MSP_PROCESSOR_CACHE_COUNT / MSP_PROCESSORS_PER_BYTE];
+
+static int mspProcessorCacheIndex(int16_t cmdMSP)
+{
+    if (cmdMSP >= 0 && cmdMSP < 0x100) {
+        return cmdMSP;
+    } else if (cmdMSP >= 0x1000 && cmdMSP < 0x1100) {
+        return 0x100 + cmdMSP - 0x1000;
+    } else if (cmdMSP >= 0x3000 && cmdMSP < 0x3100) {
+        return 0x200 + cmdMSP - 0x3000;
+    }
+    return -1;
+}
+
+static mspProcessor_e mspProcessorCacheGet(int cacheIndex)
+{
+    const unsigned shift = (cacheIndex % MSP_PROCESSORS_PER_BYTE) * MSP_PROCESSOR_BITS;
+    return (mspProcessorCache[cacheIndex / MSP_PROCESSORS_PER_BYTE] >> shift) & ((1 << MSP_PROCESSOR_BITS) - 1);
+}
+
+static void mspProcessorCacheSet(int cacheIndex, mspProcessor_e processor)
+{
+    const unsigned shift = (cacheIndex % MSP_PROCESSORS_PER_BYTE) * MSP_PROCESSOR_BITS;
+    uint8_t *entry = &mspProcessorCache[cacheIndex / MSP_PROCESSORS_PER_BYTE];
+    *entry = (*entry & ~(((1 << MSP_PROCESSOR_BITS) - 1) << shift)) | (processor << shift);
+}
+
+#ifdef UNIT_TEST
+// Returns the processor a command starts at, or -1 for commands which aren't cached
+int mspProcessorCached(int16_t cmdMSP)
+{
+    const int cacheIndex = mspProcessorCacheIndex(cmdMSP);
+    return cacheIndex >= 0 ? (int)mspProcessorCacheGet(cacheIndex) : -1;
+}
+#endif
+
 /*
  * Returns MSP_RESULT_ACK, MSP_RESULT_ERROR or MSP_RESULT_NO_REPLY
  */
@@ -4448,23 +4693,53 @@ mspResult_e mspFcProcessCommand(mspDescriptor_t srcDesc, mspPacket_t *cmd, mspPa
     // initialize reply by default
     reply->cmd = cmd->cmd;
 
-    if (mspCommonProcessOutCommand(cmdMSP, dst, mspPostProcessFn)) {
-        ret = MSP_RESULT_ACK;
-    } else if (mspProcessOutCommand(srcDesc, cmdMSP, dst)) {
-        ret = MSP_RESULT_ACK;
-    } else if ((ret = mspFcProcessOutCommandWithArg(srcDesc, cmdMSP, src, dst, mspPostProcessFn)) != MSP_RESULT_CMD_UNKNOWN) {
-        /* ret */;
-    } else if (cmdMSP == MSP_SET_PASSTHROUGH) {
-        mspFcSetPassthroughCommand(dst, src, mspPostProcessFn);
-        ret = MSP_RESULT_ACK;
+    const int cacheIndex = mspProcessorCacheIndex(cmdMSP);
+    mspProcessor_e processor = MSP_PROCESSOR_COMMON_OUT;
+    if (cacheIndex >= 0) {
+        processor = mspProcessorCacheGet(cacheIndex);
+    }
+
+    switch (processor) {
+    case MSP_PROCESSOR_COMMON_OUT:
+        if (mspCommonProcessOutCommand(cmdMSP, dst, mspPostProcessFn)) {
+            ret = MSP_RESULT_ACK;
+            break;
+        }
+        processor = MSP_PROCESSOR_OUT;
+        FALLTHROUGH;
+    case MSP_PROCESSOR_OUT:
+        if (mspProcessOutCommand(srcDesc, cmdMSP, dst)) {
+            ret = MSP_RESULT_ACK;
+            break;
+        }
+        processor = MSP_PROCESSOR_OUT_WITH_ARG;
+        FALLTHROUGH;
+    case MSP_PROCESSOR_OUT_WITH_ARG:
+        if ((ret = mspFcProcessOutCommandWithArg(srcDesc, cmdMSP, src, dst, mspPostProcessFn)) != MSP_RESULT_CMD_UNKNOWN) {
+            break;
+        }
+        processor = MSP_PROCESSOR_IN;
+        FALLTHROUGH;
+    case MSP_PROCESSOR_IN:
+        if (cmdMSP == MSP_SET_PASSTHROUGH) {
+            mspFcSetPassthroughCommand(dst, src, mspPostProcessFn);
+            ret = MSP_RESULT_ACK;
 #ifdef USE_FLASHFS
-    } else if (cmdMSP == MSP_DATAFLASH_READ) {
-        mspFcDataFlashReadCommand(dst, src);
-        ret = MSP_RESULT_ACK;
+        } else if (cmdMSP == MSP_DATAFLASH_READ) {
+            mspFcDataFlashReadCommand(dst, src);
+            ret = MSP_RESULT_ACK;
 #endif
-    } else {
-        ret = mspCommonProcessInCommand(srcDesc, cmdMSP, src, mspPostProcessFn);
+        } else {
+            ret = mspCommonProcessInCommand(srcDesc, cmdMSP, src, mspPostProcessFn);
+        }
+        break;
     }
+
+    // unknown commands end with an error, as may a command passed on by its processor, so only successes are remembered
+    if (cacheIndex >= 0 && ret != MSP_RESULT_ERROR) {
+        mspProcessorCacheSet(cacheIndex, processor);
+    }
+
     reply->result = ret;
     return ret;
 }
@@ -31,6 +31,8 @@
 #define MSP2_SENSOR_CONFIG_ACTIVE           0x300A
 #define MSP2_SENSOR_OPTICALFLOW             0x300B
 #define MSP2_MCU_INFO                       0x300C
+#define MSP2_MULTIPLE_MSP                   0x300D  // runs a list of commands, returns all replies in one frame
+#define MSP2_SUBSCRIBE                      0x300E  // streams the MSP2_MULTIPLE_MSP reply for a list of commands at a fixed interval
 
 // MSP2_SET_TEXT and MSP2_GET_TEXT variable types
 #define MSP2TEXT_PILOT_NAME                      1
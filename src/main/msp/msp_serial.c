@@ -37,6 +37,7 @@
 #include "io/displayport_msp.h"
 
 #include "msp/msp.h"
+#include "msp/msp_protocol_v2_betaflight.h"
 
 #include "msp_serial.h"
 
@@ -405,10 +406,10 @@ static int mspSerialEncode(mspPort_t *msp, mspPacket_t *packet, mspVersion_e msp
     return mspSerialSendFrame(msp, hdrBuf, hdrLen, sbufPtr(&packet->buf), dataLen, crcBuf, crcLen);
 }
 
+static uint8_t mspSerialOutBuf[MSP_PORT_OUTBUF_SIZE];
+
 static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
 {
-    static uint8_t mspSerialOutBuf[MSP_PORT_OUTBUF_SIZE];
-
     mspPacket_t reply = {
         .buf = { .ptr = mspSerialOutBuf, .end = ARRAYEND(mspSerialOutBuf), },
         .cmd = -1,
@@ -437,6 +438,56 @@ static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspPr
     return mspPostProcessFn;
 }
 
+bool mspSerialSubscribe(mspDescriptor_t descriptor, uint16_t intervalMs, const uint8_t *request, int requestSize)
+{
+    for (mspPort_t *mspPort = mspPorts; mspPort < ARRAYEND(mspPorts); mspPort++) {
+        if (mspPort->port && mspPort->descriptor == descriptor) {
+            if (requestSize > MSP_PORT_SUBSCRIPTION_SIZE) {
+                return false;
+            }
+            memcpy(mspPort->subscription, request, requestSize);
+            mspPort->subscriptionSize = requestSize;
+            mspPort->subscriptionIntervalMs = requestSize ? intervalMs : 0;
+            mspPort->subscriptionLastMs = millis();
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sends the reply to the subscribed commands as an unsolicited MSP2_MULTIPLE_MSP reply once the interval is up
+static void mspSerialProcessSubscription(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
+{
+    const timeMs_t now = millis();
+    if (!msp->subscriptionIntervalMs || cmp32(now, msp->subscriptionLastMs) < msp->subscriptionIntervalMs) {
+        return;
+    }
+    msp->subscriptionLastMs = now;
+
+    mspPacket_t reply = {
+        .buf = { .ptr = mspSerialOutBuf, .end = ARRAYEND(mspSerialOutBuf), },
+        .cmd = -1,
+        .flags = 0,
+        .result = 0,
+        .direction = MSP_DIRECTION_REPLY,
+    };
+    uint8_t *outBufHead = reply.buf.ptr;
+
+    mspPacket_t command = {
+        .buf = { .ptr = msp->subscription, .end = msp->subscription + msp->subscriptionSize, },
+        .cmd = MSP2_MULTIPLE_MSP,
+        .flags = 0,
+        .result = 0,
+        .direction = MSP_DIRECTION_REQUEST,
+    };
+
+    if (mspProcessCommandFn(msp->descriptor, &command, &reply, NULL) != MSP_RESULT_NO_REPLY) {
+        sbufSwitchToReader(&reply.buf, outBufHead);
+        // the frame is dropped when it doesn't fit in the transmit buffer, the next one follows an interval later
+        mspSerialEncode(msp, &reply, MSP_V2_NATIVE);
+    }
+}
+
 static void mspProcessPendingRequest(mspPort_t * mspPort)
 {
     // If no request is pending or 100ms guard time has not elapsed - do nothing
@@ -487,26 +538,32 @@ static void mspProcessPacket(mspPort_t *mspPort, mspProcessCommandFnPtr mspProce
 {
     mspPostProcessFnPtr mspPostProcessFn = NULL;
 
-    while (serialRxBytesWaiting(mspPort->port)) {
-        const uint8_t c = serialRead(mspPort->port);
-
-        mspSerialProcessReceivedPacketData(mspPort, c);
+    // parse the received data in place, only what has been parsed is released from the receive buffer
+    const uint8_t *data;
+    uint8_t byte;
+    uint32_t count;
+    while (mspPort->portState == PORT_MSP_PACKET && (count = serialPeekRx(mspPort->port, &data, &byte))) {
+        uint32_t consumed = 0;
+        while (consumed < count) {
+            mspSerialProcessReceivedPacketData(mspPort, data[consumed++]);
+
+            if (mspPort->packetState == MSP_COMMAND_RECEIVED) {
+                if (mspPort->packetType == MSP_PACKET_COMMAND) {
+                    mspPostProcessFn = mspSerialProcessReceivedCommand(mspPort, mspProcessCommandFn);
+                } else if (mspPort->packetType == MSP_PACKET_REPLY) {
+                    mspSerialProcessReceivedReply(mspPort, mspProcessReplyFn);
+                }
 
-        if (mspPort->packetState == MSP_COMMAND_RECEIVED) {
-            if (mspPort->packetType == MSP_PACKET_COMMAND) {
-                mspPostProcessFn = mspSerialProcessReceivedCommand(mspPort, mspProcessCommandFn);
-            } else if (mspPort->packetType == MSP_PACKET_REPLY) {
-                mspSerialProcessReceivedReply(mspPort, mspProcessReplyFn);
+                // process one command at a time so as not to block
+                mspPort->packetState = MSP_IDLE;
             }
 
-            // process one command at a time so as not to block
-            mspPort->packetState = MSP_IDLE;
-        }
-
-        if (mspPort->packetState == MSP_IDLE) {
-            mspPort->portState = PORT_IDLE;
-            break;
+            if (mspPort->packetState == MSP_IDLE) {
+                mspPort->portState = PORT_IDLE;
+                break;
+            }
         }
+        serialSkipRx(mspPort->port, consumed);
     }
 
     if (mspPostProcessFn) {
@@ -528,39 +585,48 @@ void mspSerialProcess(mspEvaluateNonMspData_e evaluateNonMspData, mspProcessComm
         }
 
         // whilst port is idle, poll incoming until portState changes or no more bytes
-        while (mspPort->portState == PORT_IDLE && serialRxBytesWaiting(mspPort->port)) {
+        const uint8_t *data;
+        uint8_t byte;
+        uint32_t count;
+        while (mspPort->portState == PORT_IDLE && (count = serialPeekRx(mspPort->port, &data, &byte))) {
 
             // There are bytes incoming - abort pending request
             mspPort->lastActivityMs = millis();
-            mspPort->pendingRequest = MSP_PENDING_NONE;
 
-            const uint8_t c = serialRead(mspPort->port);
-            if (c == '$') {
-                mspPort->portState = PORT_MSP_PACKET;
-                mspPort->packetState = MSP_HEADER_START;
-            } else if ((evaluateNonMspData == MSP_EVALUATE_NON_MSP_DATA)
+            uint32_t consumed = 0;
+            while (mspPort->portState == PORT_IDLE && consumed < count) {
+                mspPort->pendingRequest = MSP_PENDING_NONE;
+
+                const uint8_t c = data[consumed++];
+                if (c == '$') {
+                    mspPort->portState = PORT_MSP_PACKET;
+                    mspPort->packetState = MSP_HEADER_START;
+                } else if ((evaluateNonMspData == MSP_EVALUATE_NON_MSP_DATA)
 #ifdef USE_MSP_DISPLAYPORT
-                       // Don't evaluate non-MSP commands on VTX MSP port
-                       && (mspPort->port->identifier != displayPortMspGetSerial())
+                           // Don't evaluate non-MSP commands on VTX MSP port
+                           && (mspPort->port->identifier != displayPortMspGetSerial())
 #endif
-                       ) {
-                // evaluate the non-MSP data
-                if (c == serialConfig()->reboot_character) {
-                    mspPort->pendingRequest = MSP_PENDING_BOOTLOADER_ROM;
+                           ) {
+                    // evaluate the non-MSP data
+                    if (c == serialConfig()->reboot_character) {
+                        mspPort->pendingRequest = MSP_PENDING_BOOTLOADER_ROM;
 #ifdef USE_CLI
-                } else if (c == '#') {
-                    mspPort->pendingRequest = MSP_PENDING_CLI;
-                } else if (c == 0x2) {
-                    mspPort->portState = PORT_CLI_CMD;
-                    cliEnter(mspPort->port, false);
+                    } else if (c == '#') {
+                        mspPort->pendingRequest = MSP_PENDING_CLI;
+                    } else if (c == 0x2) {
+                        mspPort->portState = PORT_CLI_CMD;
+                        cliEnter(mspPort->port, false);
 #endif
+                    }
                 }
             }
+            serialSkipRx(mspPort->port, consumed);
         }
 
         switch (mspPort->portState) {
         case PORT_IDLE:
             mspProcessPendingRequest(mspPort);
+            mspSerialProcessSubscription(mspPort, mspProcessCommandFn);
             break;
         case PORT_MSP_PACKET:
             mspProcessPacket(mspPort, mspProcessCommandFn, mspProcessReplyFn);
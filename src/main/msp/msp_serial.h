@@ -104,6 +104,8 @@ typedef struct __attribute__((packed)) {
 
 #define MSP_MAX_HEADER_SIZE     9
 
+#define MSP_PORT_SUBSCRIPTION_SIZE 48   // MSP2_SUBSCRIBE command list, 3 bytes per command without arguments
+
 struct serialPort_s;
 typedef struct mspPort_s {
     struct serialPort_s *port; // null when port unused.
@@ -122,6 +124,11 @@ typedef struct mspPort_s {
     uint8_t checksum2;
     bool sharedWithTelemetry;
     mspDescriptor_t descriptor;
+    // MSP2_MULTIPLE_MSP request sent on behalf of the client every subscriptionIntervalMs
+    uint8_t subscription[MSP_PORT_SUBSCRIPTION_SIZE];
+    uint8_t subscriptionSize;
+    uint16_t subscriptionIntervalMs;
+    timeMs_t subscriptionLastMs;
 } mspPort_t;
 
 void mspSerialInit(void);
@@ -133,3 +140,4 @@ void mspSerialReleaseSharedTelemetryPorts(void);
 mspDescriptor_t getMspSerialPortDescriptor(const serialPortIdentifier_e portIdentifier);
 int mspSerialPush(serialPortIdentifier_e port, uint8_t cmd, uint8_t *data, int datalen, mspDirection_e direction, mspVersion_e mspVersion);
 uint32_t mspSerialTxBytesFree(void);
+bool mspSerialSubscribe(mspDescriptor_t descriptor, uint16_t intervalMs, const uint8_t *request, int requestSize);
@@ -50,7 +50,18 @@
 
     Add the mapping for the element ID to the background drawing function to the
     osdElementBackgroundFunction array.
-    
+
+    Create the function to return the element's value key (optional).
+    ------------------------------------------------------------------
+    If the element draws a single string from a few source values then create a function
+    returning those values, quantized to what is displayed, packed into a key. It should be
+    named like "osdKeySomething()". While the key is unchanged the element's previous text
+    is written again without calling the drawing function. The key must include everything
+    the text and attribute depend on, including configuration and alarm state.
+
+    Add the mapping for the element ID to the key function to the osdElementValueKeyFunction
+    array.
+
     You should also add a corresponding entry to the file: cms_menu_osd.c
 
     Accelerometer reqirement:
@@ -249,6 +260,20 @@ static bool displayPendingForeground;
 static bool displayPendingBackground;
 static char elementBuff[OSD_ELEMENT_BUFFER_LENGTH];
 
+// Text last drawn by the active elements having a value key, redrawn unchanged while the key is the same
+#define OSD_ELEMENT_CACHE_COUNT 12
+
+typedef struct osdElementCache_s {
+    uint64_t key;
+    bool valid;
+    uint8_t attr;
+    char buff[OSD_ELEMENT_BUFFER_LENGTH];
+} osdElementCache_t;
+
+static osdElementCache_t elementCache[OSD_ELEMENT_CACHE_COUNT];
+static unsigned elementCacheCount;
+static uint8_t elementCacheIndex[OSD_ITEM_COUNT];   // cache entry + 1, 0 if the element isn't cached
+
 // Return whether element is a SYS element and needs special handling
 #define IS_SYS_OSD_ELEMENT(item) (item >= OSD_SYS_GOGGLE_VOLTAGE) && (item <= OSD_SYS_FAN_SPEED)
 
@@ -1599,18 +1624,20 @@ static void osdElementRemainingTimeEstimate(osdElementParms_t *element)
     }
 }
 
-static void osdElementRssi(osdElementParms_t *element)
+static uint16_t osdGetRssiValue(void)
 {
-    uint16_t osdRssi = getRssi() * 100 / 1024; // change range
-    if (osdRssi >= 100) {
-        osdRssi = 99;
-    }
+    const uint16_t osdRssi = getRssi() * 100 / 1024; // change range
+
+    return MIN(osdRssi, 99);
+}
 
+static void osdElementRssi(osdElementParms_t *element)
+{
     if (getRssiPercent() < osdConfig()->rssi_alarm) {
         element->attr = DISPLAYPORT_SEVERITY_CRITICAL;
     }
 
-    tfp_sprintf(element->buff, "%c%2d", SYM_RSSI, osdRssi);
+    tfp_sprintf(element->buff, "%c%2d", SYM_RSSI, osdGetRssiValue());
 }
 
 #ifdef USE_RTC_TIME
@@ -1712,17 +1739,26 @@ static void osdElementThrottlePosition(osdElementParms_t *element)
     tfp_sprintf(element->buff, "%c%3d", SYM_THR, calculateThrottlePercent());
 }
 
-static void osdElementTimer(osdElementParms_t *element)
+static bool osdIsTimerAlarmActive(void)
 {
     for (int i = 0; i < OSD_TIMER_COUNT; i++) {
         const uint16_t timer = osdConfig()->timers[i];
         const timeUs_t time = osdGetTimerValue(OSD_TIMER_SRC(timer));
         const timeUs_t alarmTime = OSD_TIMER_ALARM(timer) * 60000000; // convert from minutes to us
         if (alarmTime != 0 && time >= alarmTime) {
-            element->attr = DISPLAYPORT_SEVERITY_CRITICAL;
+            return true;
         }
     }
 
+    return false;
+}
+
+static void osdElementTimer(osdElementParms_t *element)
+{
+    if (osdIsTimerAlarmActive()) {
+        element->attr = DISPLAYPORT_SEVERITY_CRITICAL;
+    }
+
     osdFormatTimer(element->buff, true, true, element->item - OSD_ITEM_TIMER_1);
 }
 
@@ -2102,10 +2138,107 @@ const osdElementDrawFn osdElementBackgroundFunction[OSD_ITEM_COUNT] = {
     [OSD_PILOT_NAME]              = osdBackgroundPilotName,
 };
 
+// Value keys, see osdElementValueKeyFunction below
+
+static uint64_t osdKeyAverageCellVoltage(const osdElementParms_t *element)
+{
+    UNUSED(element);
+
+    const uint16_t cellV = getBatteryAverageCellVoltage();
+
+    return cellV | (uint64_t)(uint8_t)osdGetBatterySymbol(cellV) << 16 | (uint64_t)getBatteryState() << 24;
+}
+
+static uint64_t osdKeyMahDrawn(const osdElementParms_t *element)
+{
+    UNUSED(element);
+
+    const int mAhDrawn = getMAhDrawn();
+
+    return (uint32_t)mAhDrawn | (uint64_t)(mAhDrawn >= osdConfig()->cap_alarm) << 32;
+}
+
+static uint64_t osdKeyMainBatteryVoltage(const osdElementParms_t *element)
+{
+    UNUSED(element);
+
+    const uint8_t symbol = osdGetBatterySymbol(getBatteryAverageCellVoltage());
+
+    return getBatteryVoltage() | (uint64_t)symbol << 16 | (uint64_t)getBatteryState() << 24;
+}
+
+static uint64_t osdKeyPidRateProfile(const osdElementParms_t *element)
+{
+    UNUSED(element);
+
+    return getCurrentPidProfileIndex() | getCurrentControlRateProfileIndex() << 8;
+}
+
+static uint64_t osdKeyPids(const osdElementParms_t *element)
+{
+    const uint8_t axis = element->item == OSD_ROLL_PIDS ? PID_ROLL : element->item == OSD_PITCH_PIDS ? PID_PITCH : PID_YAW;
+    const pidf_t *pid = &currentPidProfile->pid[axis];
+
+    return pid->P | pid->I << 8 | pid->D << 16 | (uint64_t)currentPidProfile->d_max[axis] << 24 | (uint64_t)pid->F << 32;
+}
+
+static uint64_t osdKeyRssi(const osdElementParms_t *element)
+{
+    UNUSED(element);
+
+    return osdGetRssiValue() | (getRssiPercent() < osdConfig()->rssi_alarm) << 8;
+}
+
+static uint64_t osdKeyThrottlePosition(const osdElementParms_t *element)
+{
+    UNUSED(element);
+
+    return (uint8_t)calculateThrottlePercent();
+}
+
+static uint64_t osdKeyTimer(const osdElementParms_t *element)
+{
+    static const uint32_t resolutionUs[OSD_TIMER_PREC_COUNT] = {
+        [OSD_TIMER_PREC_SECOND]     = 1000000,
+        [OSD_TIMER_PREC_HUNDREDTHS] = 10000,
+        [OSD_TIMER_PREC_TENTHS]     = 100000,
+    };
+    const uint16_t timer = osdConfig()->timers[element->item - OSD_ITEM_TIMER_1];
+    const osd_timer_source_e src = OSD_TIMER_SRC(timer);
+    const uint8_t precision = OSD_TIMER_PRECISION(timer);
+    // osdFormatTime() shows seconds for an unknown precision
+    const uint32_t resolution = precision < OSD_TIMER_PREC_COUNT ? resolutionUs[precision] : resolutionUs[OSD_TIMER_PREC_SECOND];
+
+    return osdGetTimerValue(src) / resolution | (uint64_t)timer << 32
+        | (uint64_t)(uint8_t)osdGetTimerSymbol(src) << 48 | (uint64_t)osdIsTimerAlarmActive() << 56;
+}
+
+// Define the mapping between the OSD element id and the function returning its value key
+// Only elements drawing a single string at their position without an offset can have a key
+
+const osdElementKeyFn osdElementValueKeyFunction[OSD_ITEM_COUNT] = {
+    [OSD_RSSI_VALUE]              = osdKeyRssi,
+    [OSD_MAIN_BATT_VOLTAGE]       = osdKeyMainBatteryVoltage,
+    [OSD_ITEM_TIMER_1]            = osdKeyTimer,
+    [OSD_ITEM_TIMER_2]            = osdKeyTimer,
+    [OSD_THROTTLE_POS]            = osdKeyThrottlePosition,
+    [OSD_MAH_DRAWN]               = osdKeyMahDrawn,
+    [OSD_ROLL_PIDS]               = osdKeyPids,
+    [OSD_PITCH_PIDS]              = osdKeyPids,
+    [OSD_YAW_PIDS]                = osdKeyPids,
+    [OSD_PIDRATE_PROFILE]         = osdKeyPidRateProfile,
+    [OSD_AVG_CELL_VOLTAGE]        = osdKeyAverageCellVoltage,
+};
+
 static void osdAddActiveElement(osd_items_e element)
 {
     if (VISIBLE(osdElementConfig()->item_pos[element])) {
         activeOsdElementArray[activeOsdElementCount++] = element;
+
+        if (osdElementValueKeyFunction[element] && elementCacheCount < OSD_ELEMENT_CACHE_COUNT) {
+            elementCache[elementCacheCount].valid = false;
+            elementCacheIndex[element] = ++elementCacheCount;
+        }
     }
 }
 
@@ -2115,6 +2248,8 @@ static void osdAddActiveElement(osd_items_e element)
 void osdAddActiveElements(void)
 {
     activeOsdElementCount = 0;
+    elementCacheCount = 0;
+    memset(elementCacheIndex, 0, sizeof(elementCacheIndex));
 
 #ifdef USE_ACC
     if (sensors(SENSOR_ACC)) {
@@ -2189,6 +2324,22 @@ static bool osdDrawSingleElement(displayPort_t *osdDisplayPort, uint8_t item)
     activeElement.drawElement = true;
     activeElement.attr = DISPLAYPORT_SEVERITY_NORMAL;
 
+    osdElementCache_t *cache = NULL;
+    if (elementCacheIndex[item]) {
+        cache = &elementCache[elementCacheIndex[item] - 1];
+
+        const uint64_t key = osdElementValueKeyFunction[item](&activeElement);
+        if (cache->valid && cache->key == key) {
+            // Nothing displayed has changed, so skip formatting and write the text straight away
+            osdDisplayWrite(&activeElement, elemPosX, elemPosY, cache->attr, cache->buff);
+
+            return true;
+        }
+
+        cache->key = key;
+        cache->valid = false;
+    }
+
     // Call the element drawing function
     if (IS_SYS_OSD_ELEMENT(item)) {
         displaySys(osdDisplayPort, elemPosX, elemPosY, (displayPortSystemElement_e)(item - OSD_SYS_GOGGLE_VOLTAGE + DISPLAYPORT_SYS_GOGGLE_VOLTAGE));
@@ -2196,6 +2347,12 @@ static bool osdDrawSingleElement(displayPort_t *osdDisplayPort, uint8_t item)
         osdElementDrawFunction[item](&activeElement);
         if (activeElement.drawElement) {
             displayPendingForeground = true;
+
+            if (cache) {
+                strcpy(cache->buff, activeElement.buff);
+                cache->attr = activeElement.attr;
+                cache->valid = true;
+            }
         }
     }
 
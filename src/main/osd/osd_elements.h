@@ -46,6 +46,7 @@ typedef struct osdElementParms_s {
 } osdElementParms_t;
 
 typedef void (*osdElementDrawFn)(osdElementParms_t *element);
+typedef uint64_t (*osdElementKeyFn)(const osdElementParms_t *element);
 
 int osdConvertTemperatureToSelectedUnit(int tempInDegreesCelcius);
 void osdFormatDistanceString(char *result, int distance, char leadingSymbol);
@@ -33,7 +33,10 @@ PG_RESET_TEMPLATE(dynNotchConfig_t, dynNotchConfig,
     .dyn_notch_min_hz = 100,
     .dyn_notch_max_hz = 600,
     .dyn_notch_q = 300,
-    .dyn_notch_count = 3
+    .dyn_notch_count = 3,
+    .dyn_notch_estimator = DYN_NOTCH_ESTIMATOR_SDFT,
+    .dyn_notch_fft_size = DYN_NOTCH_FFT_SIZE_128,
+    .dyn_notch_budget = 64,
 );
 
 #endif // USE_DYN_NOTCH_FILTER
@@ -24,12 +24,27 @@
 
 #include "pg/pg.h"
 
+typedef enum {
+    DYN_NOTCH_ESTIMATOR_SDFT = 0,
+    DYN_NOTCH_ESTIMATOR_FFT,
+    DYN_NOTCH_ESTIMATOR_GOERTZEL,
+} dynNotchEstimator_e;
+
+typedef enum {
+    DYN_NOTCH_FFT_SIZE_64 = 0,
+    DYN_NOTCH_FFT_SIZE_128,
+    DYN_NOTCH_FFT_SIZE_256,
+} dynNotchFftSize_e;
+
 typedef struct dynNotchConfig_s
 {
     uint16_t dyn_notch_min_hz;
     uint16_t dyn_notch_max_hz;
     uint16_t dyn_notch_q;
     uint8_t  dyn_notch_count;
+    uint8_t  dyn_notch_estimator;   // spectrum estimator, see dynNotchEstimator_e
+    uint8_t  dyn_notch_fft_size;    // block size of the FFT and Goertzel estimators, see dynNotchFftSize_e
+    uint8_t  dyn_notch_budget;      // FFT butterflies or Goertzel bin updates per PID loop
 
 } dynNotchConfig_t;
 
@@ -29,9 +29,48 @@
 
 #include "pg.h"
 
+// Registry indices ordered by PGN. The registry itself is in link order, so this is built on first use.
+static uint8_t pgSortedIndex[PG_REGISTRY_MAX_COUNT];
+static int pgSortedCount = -1;
+
+static void pgBuildSortedIndex(void)
+{
+    pgSortedCount = MIN(PG_REGISTRY_SIZE, PG_REGISTRY_MAX_COUNT);
+
+    // insertion sort, the registry is small and this runs once
+    for (int i = 0; i < pgSortedCount; i++) {
+        const pgn_t pgn = pgN(&__pg_registry_start[i]);
+        int j = i;
+        while (j > 0 && pgN(&__pg_registry_start[pgSortedIndex[j - 1]]) > pgn) {
+            pgSortedIndex[j] = pgSortedIndex[j - 1];
+            j--;
+        }
+        pgSortedIndex[j] = i;
+    }
+}
+
 const pgRegistry_t* pgFind(pgn_t pgn)
 {
-    PG_FOREACH(reg) {
+    if (pgSortedCount < 0) {
+        pgBuildSortedIndex();
+    }
+
+    int low = 0;
+    int high = pgSortedCount;
+    while (low < high) {
+        const int mid = (low + high) / 2;
+        const pgRegistry_t *reg = &__pg_registry_start[pgSortedIndex[mid]];
+        if (pgN(reg) == pgn) {
+            return reg;
+        } else if (pgN(reg) < pgn) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    // only if the registry outgrew the index
+    for (const pgRegistry_t *reg = __pg_registry_start + pgSortedCount; reg < __pg_registry_end; reg++) {
         if (pgN(reg) == pgn) {
             return reg;
         }
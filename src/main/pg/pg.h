@@ -83,6 +83,7 @@ extern const uint8_t __pg_resetdata_end[];
 #endif
 
 #define PG_REGISTRY_SIZE (__pg_registry_end - __pg_registry_start)
+#define PG_REGISTRY_MAX_COUNT 256   // groups pgFind() keeps a sorted index for, there are far fewer PG ids
 
 // Helper to iterate over the PG register.  Cheaper than a visitor style callback.
 #define PG_FOREACH(_name) \
@@ -48,6 +48,7 @@
 #include "flight/failsafe.h"
 
 #include "scheduler.h"
+#include "scheduler_trace.h"
 
 #include "sensors/gyro_init.h"
 
@@ -136,11 +137,128 @@ static timeMs_t lastFailsafeCheckMs = 0;
 #endif
 STATIC_UNIT_TESTED FAST_DATA_ZERO_INIT task_t* taskQueueArray[TASK_COUNT + 1 + TASK_QUEUE_RESERVE]; // extra item for NULL pointer at end of queue (+ overflow check in UNTT_TEST)
 
+#if defined(USE_SCHEDULER_HEAP)
+// Time driven tasks are also kept in a binary min-heap keyed on the time they are next due, so that
+// a scheduler pass only visits the tasks which are due. Event driven tasks have to be polled through
+// their check function on every pass anyway and are kept in a separate list, in queue order.
+// Realtime tasks are run directly by the scheduler and are in neither.
+STATIC_UNIT_TESTED FAST_DATA_ZERO_INIT task_t *taskHeap[TASK_COUNT];
+STATIC_UNIT_TESTED FAST_DATA_ZERO_INIT int taskHeapSize = 0;
+STATIC_UNIT_TESTED FAST_DATA_ZERO_INIT task_t *eventTaskArray[TASK_COUNT];
+STATIC_UNIT_TESTED FAST_DATA_ZERO_INIT int eventTaskCount = 0;
+
+static FAST_CODE bool heapBefore(const task_t *a, const task_t *b)
+{
+    return cmpTimeUs(a->nextDueAtUs, b->nextDueAtUs) < 0;
+}
+
+static FAST_CODE void heapSet(int index, task_t *task)
+{
+    taskHeap[index] = task;
+    task->heapIndex = index;
+}
+
+static FAST_CODE void heapSiftUp(int index)
+{
+    task_t *task = taskHeap[index];
+    while (index > 0) {
+        const int parent = (index - 1) / 2;
+        if (!heapBefore(task, taskHeap[parent])) {
+            break;
+        }
+        heapSet(index, taskHeap[parent]);
+        index = parent;
+    }
+    heapSet(index, task);
+}
+
+static FAST_CODE void heapSiftDown(int index)
+{
+    task_t *task = taskHeap[index];
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= taskHeapSize) {
+            break;
+        }
+        if (child + 1 < taskHeapSize && heapBefore(taskHeap[child + 1], taskHeap[child])) {
+            child++;
+        }
+        if (!heapBefore(taskHeap[child], task)) {
+            break;
+        }
+        heapSet(index, taskHeap[child]);
+        index = child;
+    }
+    heapSet(index, task);
+}
+
+static bool heapContains(const task_t *task)
+{
+    return task->heapIndex < taskHeapSize && taskHeap[task->heapIndex] == task;
+}
+
+// Re-key a task after its last execution time or period has changed
+static FAST_CODE void heapUpdate(task_t *task)
+{
+    if (heapContains(task)) {
+        task->nextDueAtUs = task->lastExecutedAtUs + task->attribute->desiredPeriodUs;
+        heapSiftUp(task->heapIndex);
+        heapSiftDown(task->heapIndex);
+    }
+}
+
+static void heapAdd(task_t *task)
+{
+    if (task->attribute->staticPriority == TASK_PRIORITY_REALTIME) {
+        return;
+    }
+    if (task->attribute->checkFunc) {
+        // Keep the queue order, so ties in dynamic priority go to the higher static priority as with the queue
+        int ii = eventTaskCount;
+        while (ii > 0 && eventTaskArray[ii - 1]->attribute->staticPriority < task->attribute->staticPriority) {
+            eventTaskArray[ii] = eventTaskArray[ii - 1];
+            --ii;
+        }
+        eventTaskArray[ii] = task;
+        ++eventTaskCount;
+    } else {
+        task->nextDueAtUs = task->lastExecutedAtUs + task->attribute->desiredPeriodUs;
+        heapSet(taskHeapSize++, task);
+        heapSiftUp(task->heapIndex);
+    }
+}
+
+static void heapRemove(task_t *task)
+{
+    if (heapContains(task)) {
+        const int index = task->heapIndex;
+        task_t *last = taskHeap[--taskHeapSize];
+        if (last != task) {
+            heapSet(index, last);
+            heapSiftUp(index);
+            heapSiftDown(last->heapIndex);
+        }
+        return;
+    }
+    for (int ii = 0; ii < eventTaskCount; ++ii) {
+        if (eventTaskArray[ii] == task) {
+            memmove(&eventTaskArray[ii], &eventTaskArray[ii + 1], sizeof(task) * (eventTaskCount - ii - 1));
+            --eventTaskCount;
+            return;
+        }
+    }
+}
+#endif
+
 STATIC_UNIT_TESTED void queueClear(void)
 {
     memset(taskQueueArray, 0, sizeof(taskQueueArray));
     taskQueuePos = 0;
     taskQueueSize = 0;
+#if defined(USE_SCHEDULER_HEAP)
+    taskHeapSize = 0;
+    eventTaskCount = 0;
+#endif
 }
 
 static bool queueContains(const task_t *task)
@@ -153,6 +271,16 @@ static bool queueContains(const task_t *task)
     return false;
 }
 
+#if defined(USE_SCHEDULER_HEAP)
+// Record the queue position of each task from index onwards, used to break ties in dynamic priority
+static void queueRenumber(int index)
+{
+    for (int ii = index; ii < taskQueueSize; ++ii) {
+        taskQueueArray[ii]->queueIndex = ii;
+    }
+}
+#endif
+
 STATIC_UNIT_TESTED bool queueAdd(task_t *task)
 {
     if ((taskQueueSize >= TASK_COUNT) || queueContains(task)) {
@@ -163,6 +291,10 @@ STATIC_UNIT_TESTED bool queueAdd(task_t *task)
             memmove(&taskQueueArray[ii+1], &taskQueueArray[ii], sizeof(task) * (taskQueueSize - ii));
             taskQueueArray[ii] = task;
             ++taskQueueSize;
+#if defined(USE_SCHEDULER_HEAP)
+            queueRenumber(ii);
+            heapAdd(task);
+#endif
             return true;
         }
     }
@@ -175,12 +307,17 @@ STATIC_UNIT_TESTED bool queueRemove(task_t *task)
         if (taskQueueArray[ii] == task) {
             memmove(&taskQueueArray[ii], &taskQueueArray[ii+1], sizeof(task) * (taskQueueSize - ii));
             --taskQueueSize;
+#if defined(USE_SCHEDULER_HEAP)
+            queueRenumber(ii);
+            heapRemove(task);
+#endif
             return true;
         }
     }
     return false;
 }
 
+#if !defined(USE_SCHEDULER_HEAP) || defined(UNIT_TEST)
 /*
  * Returns first item queue or NULL if queue empty
  */
@@ -197,6 +334,7 @@ STATIC_UNIT_TESTED FAST_CODE task_t *queueNext(void)
 {
     return taskQueueArray[++taskQueuePos]; // guaranteed to be NULL at end of queue
 }
+#endif
 
 static timeUs_t taskTotalExecutionTime = 0;
 
@@ -278,6 +416,10 @@ void rescheduleTask(taskId_e taskId, timeDelta_t newPeriodUs)
     if (taskId == TASK_GYRO) {
         desiredPeriodCycles = (int32_t)clockMicrosToCycles((uint32_t)getTask(TASK_GYRO)->attribute->desiredPeriodUs);
     }
+
+#if defined(USE_SCHEDULER_HEAP)
+    heapUpdate(task);
+#endif
 }
 
 void setTaskEnabled(taskId_e taskId, bool enabled)
@@ -416,14 +558,19 @@ FAST_CODE timeUs_t schedulerExecuteTask(task_t *selectedTask, timeUs_t currentTi
         selectedTask->lastExecutedAtUs = currentTimeUs;
         selectedTask->lastDesiredAt += selectedTask->attribute->desiredPeriodUs;
         selectedTask->dynamicPriority = 0;
+#if defined(USE_SCHEDULER_HEAP)
+        heapUpdate(selectedTask);
+#endif
 
         // Execute task
         const timeUs_t currentTimeBeforeTaskCallUs = micros();
 #if defined(USE_LATE_TASK_STATISTICS)
         const timeUs_t estimatedExecutionUs = selectedTask->execTime;
 #endif
+        SCHED_TRACE_AT(currentTimeBeforeTaskCallUs, SCHED_TRACE_TASK_BEGIN, selectedTask - tasks, 0);
         selectedTask->attribute->taskFunc(currentTimeBeforeTaskCallUs);
         taskExecutionTimeUs = micros() - currentTimeBeforeTaskCallUs;
+        SCHED_TRACE_AT(currentTimeBeforeTaskCallUs + taskExecutionTimeUs, SCHED_TRACE_TASK_END, selectedTask - tasks, 0);
         taskTotalExecutionTime += taskExecutionTimeUs;
         selectedTask->movingSumExecutionTime10thUs += (taskExecutionTimeUs * 10) - selectedTask->movingSumExecutionTime10thUs / TASK_STATS_MOVING_SUM_COUNT;
         if (!ignoreCurrentTaskExecRate) {
@@ -483,6 +630,60 @@ static void readSchedulerLocals(task_t *selectedTask, uint8_t selectedTaskDynami
 }
 #endif
 
+static FAST_CODE void updateEventTaskPriority(task_t *task, timeUs_t currentTimeUs)
+{
+    // Increase priority for event driven tasks
+    if (task->dynamicPriority > 0) {
+        task->taskAgePeriods = 1 + (cmpTimeUs(currentTimeUs, task->lastSignaledAtUs) / task->attribute->desiredPeriodUs);
+        task->dynamicPriority = 1 + task->attribute->staticPriority * task->taskAgePeriods;
+    } else if (task->attribute->checkFunc(currentTimeUs, cmpTimeUs(currentTimeUs, task->lastExecutedAtUs))) {
+        const uint32_t checkFuncExecutionTimeUs = cmpTimeUs(micros(), currentTimeUs);
+        checkFuncMovingSumExecutionTimeUs += checkFuncExecutionTimeUs - checkFuncMovingSumExecutionTimeUs / TASK_STATS_MOVING_SUM_COUNT;
+        checkFuncMovingSumDeltaTimeUs += task->taskLatestDeltaTimeUs - checkFuncMovingSumDeltaTimeUs / TASK_STATS_MOVING_SUM_COUNT;
+        checkFuncTotalExecutionTimeUs += checkFuncExecutionTimeUs;   // time consumed by scheduler + task
+        checkFuncMaxExecutionTimeUs = MAX(checkFuncMaxExecutionTimeUs, checkFuncExecutionTimeUs);
+        task->lastSignaledAtUs = currentTimeUs;
+        task->taskAgePeriods = 1;
+        task->dynamicPriority = 1 + task->attribute->staticPriority;
+    } else {
+        task->taskAgePeriods = 0;
+    }
+}
+
+static FAST_CODE void updateTimeTaskPriority(task_t *task, timeUs_t currentTimeUs)
+{
+    // Task is time-driven, dynamicPriority is last execution age (measured in desiredPeriods)
+    // Task age is calculated from last execution
+    task->taskAgePeriods = (cmpTimeUs(currentTimeUs, task->lastExecutedAtUs) / task->attribute->desiredPeriodUs);
+    if (task->taskAgePeriods > 0) {
+        task->dynamicPriority = 1 + task->attribute->staticPriority * task->taskAgePeriods;
+    }
+}
+
+#if defined(USE_SCHEDULER_HEAP)
+// The heap visits tasks in due time order, so on equal dynamic priority pick the task earlier in the queue,
+// i.e. higher static priority first, then the order of enabling, as the queue scan does
+static FAST_CODE bool taskSelectionPrecedes(const task_t *task, const task_t *selectedTask, uint16_t selectedTaskDynamicPriority)
+{
+    return task->dynamicPriority > selectedTaskDynamicPriority ||
+        (selectedTask && task->dynamicPriority == selectedTaskDynamicPriority && task->queueIndex < selectedTask->queueIndex);
+}
+#endif
+
+static FAST_CODE bool taskFitsSchedule(const task_t *task, int32_t schedLoopRemainingCycles, uint32_t checkCycles, uint32_t scheduleCount)
+{
+    timeDelta_t taskRequiredTimeUs = task->anticipatedExecutionTime >> TASK_EXEC_TIME_SHIFT;
+    int32_t taskRequiredTimeCycles = (int32_t)clockMicrosToCycles((uint32_t)taskRequiredTimeUs);
+    // Allow a little extra time
+    taskRequiredTimeCycles += checkCycles + taskGuardCycles;
+
+    // If there's no time to run the task, discount it from prioritisation unless aged sufficiently
+    // Don't block the SERIAL task.
+    return (taskRequiredTimeCycles < schedLoopRemainingCycles) ||
+        ((scheduleCount & SCHED_TASK_DEFER_MASK) == 0) ||
+        ((task - tasks) == TASK_SERIAL);
+}
+
 FAST_CODE void scheduler(void)
 {
     static uint32_t checkCycles = 0;
@@ -544,6 +745,12 @@ FAST_CODE void scheduler(void)
             if (schedLoopStartCycles > schedLoopStartMinCycles) {
                 schedLoopStartCycles -= schedLoopStartDeltaDownCycles;
             }
+#if defined(SIMULATOR_BUILD)
+            // Time doesn't pass while polling in lockstep mode, so catch the boundary on a later pass
+            if (simulatorLockstepEnabled() && schedLoopRemainingCycles > 0) {
+                return;
+            }
+#endif
 #if !defined(UNIT_TEST)
             while (schedLoopRemainingCycles > 0) {
                 nowCycles = getCycleCounter();
@@ -551,6 +758,7 @@ FAST_CODE void scheduler(void)
             }
 #endif
             currentTimeUs = micros();
+            SCHED_TRACE_AT(currentTimeUs, SCHED_TRACE_STAGE_BEGIN, SCHED_TRACE_STAGE_REALTIME, 0);
             taskExecutionTimeUs += schedulerExecuteTask(gyroTask, currentTimeUs);
 
             if (gyroFilterReady()) {
@@ -559,6 +767,7 @@ FAST_CODE void scheduler(void)
             if (pidLoopReady()) {
                 taskExecutionTimeUs += schedulerExecuteTask(getTask(TASK_PID), currentTimeUs);
             }
+            SCHED_TRACE(SCHED_TRACE_STAGE_END, SCHED_TRACE_STAGE_REALTIME, 0);
 
             // Check for incoming RX data. Don't do this in the checker as that is called repeatedly within
             // a given gyro loop, and ELRS takes a long time to process this and so can only be safely processed
@@ -704,59 +913,65 @@ FAST_CODE void scheduler(void)
         currentTimeUs = micros();
 
         // Update task dynamic priorities
+#if defined(USE_SCHEDULER_HEAP)
+        for (int ii = 0; ii < eventTaskCount; ++ii) {
+            task_t *task = eventTaskArray[ii];
+            updateEventTaskPriority(task, currentTimeUs);
+            if (taskSelectionPrecedes(task, selectedTask, selectedTaskDynamicPriority) && taskFitsSchedule(task, schedLoopRemainingCycles, checkCycles, scheduleCount)) {
+                selectedTaskDynamicPriority = task->dynamicPriority;
+                selectedTask = task;
+            }
+        }
+
+        // Walk the heap of time driven tasks, skipping the subtree below any task that isn't due yet
+        uint8_t heapStack[TASK_COUNT];
+        int heapStackSize = 0;
+        if (taskHeapSize) {
+            heapStack[heapStackSize++] = 0;
+        }
+        while (heapStackSize) {
+            const int index = heapStack[--heapStackSize];
+            task_t *task = taskHeap[index];
+            if (cmpTimeUs(currentTimeUs, task->nextDueAtUs) < 0) {
+                continue;
+            }
+            updateTimeTaskPriority(task, currentTimeUs);
+            if (taskSelectionPrecedes(task, selectedTask, selectedTaskDynamicPriority) && taskFitsSchedule(task, schedLoopRemainingCycles, checkCycles, scheduleCount)) {
+                selectedTaskDynamicPriority = task->dynamicPriority;
+                selectedTask = task;
+            }
+            for (int child = 2 * index + 1; child <= 2 * index + 2 && child < taskHeapSize; child++) {
+                heapStack[heapStackSize++] = child;
+            }
+        }
+#else
         for (task_t *task = queueFirst(); task != NULL; task = queueNext()) {
             if (task->attribute->staticPriority != TASK_PRIORITY_REALTIME) {
                 // Task has checkFunc - event driven
                 if (task->attribute->checkFunc) {
-                    // Increase priority for event driven tasks
-                    if (task->dynamicPriority > 0) {
-                        task->taskAgePeriods = 1 + (cmpTimeUs(currentTimeUs, task->lastSignaledAtUs) / task->attribute->desiredPeriodUs);
-                        task->dynamicPriority = 1 + task->attribute->staticPriority * task->taskAgePeriods;
-                    } else if (task->attribute->checkFunc(currentTimeUs, cmpTimeUs(currentTimeUs, task->lastExecutedAtUs))) {
-                        const uint32_t checkFuncExecutionTimeUs = cmpTimeUs(micros(), currentTimeUs);
-                        checkFuncMovingSumExecutionTimeUs += checkFuncExecutionTimeUs - checkFuncMovingSumExecutionTimeUs / TASK_STATS_MOVING_SUM_COUNT;
-                        checkFuncMovingSumDeltaTimeUs += task->taskLatestDeltaTimeUs - checkFuncMovingSumDeltaTimeUs / TASK_STATS_MOVING_SUM_COUNT;
-                        checkFuncTotalExecutionTimeUs += checkFuncExecutionTimeUs;   // time consumed by scheduler + task
-                        checkFuncMaxExecutionTimeUs = MAX(checkFuncMaxExecutionTimeUs, checkFuncExecutionTimeUs);
-                        task->lastSignaledAtUs = currentTimeUs;
-                        task->taskAgePeriods = 1;
-                        task->dynamicPriority = 1 + task->attribute->staticPriority;
-                    } else {
-                        task->taskAgePeriods = 0;
-                    }
+                    updateEventTaskPriority(task, currentTimeUs);
                 } else {
-                    // Task is time-driven, dynamicPriority is last execution age (measured in desiredPeriods)
-                    // Task age is calculated from last execution
-                    task->taskAgePeriods = (cmpTimeUs(currentTimeUs, task->lastExecutedAtUs) / task->attribute->desiredPeriodUs);
-                    if (task->taskAgePeriods > 0) {
-                        task->dynamicPriority = 1 + task->attribute->staticPriority * task->taskAgePeriods;
-                    }
+                    updateTimeTaskPriority(task, currentTimeUs);
                 }
 
-                if (task->dynamicPriority > selectedTaskDynamicPriority) {
-                    timeDelta_t taskRequiredTimeUs = task->anticipatedExecutionTime >> TASK_EXEC_TIME_SHIFT;
-                    int32_t taskRequiredTimeCycles = (int32_t)clockMicrosToCycles((uint32_t)taskRequiredTimeUs);
-                    // Allow a little extra time
-                    taskRequiredTimeCycles += checkCycles + taskGuardCycles;
-
-                    // If there's no time to run the task, discount it from prioritisation unless aged sufficiently
-                    // Don't block the SERIAL task.
-                    if ((taskRequiredTimeCycles < schedLoopRemainingCycles) ||
-                        ((scheduleCount & SCHED_TASK_DEFER_MASK) == 0) ||
-                        ((task - tasks) == TASK_SERIAL)) {
-                        selectedTaskDynamicPriority = task->dynamicPriority;
-                        selectedTask = task;
-                    }
+                if (task->dynamicPriority > selectedTaskDynamicPriority && taskFitsSchedule(task, schedLoopRemainingCycles, checkCycles, scheduleCount)) {
+                    selectedTaskDynamicPriority = task->dynamicPriority;
+                    selectedTask = task;
                 }
             }
 
         }
+#endif
 
         // The number of cycles taken to run the checkers is quite consistent with some higher spikes, but
         // that doesn't defeat its use
         checkCycles = cmpTimeCycles(getCycleCounter(), nowCycles);
 
         if (selectedTask) {
+            // Idle passes aren't traced, they would fill the trace in no time
+            SCHED_TRACE_AT(currentTimeUs, SCHED_TRACE_STAGE_BEGIN, SCHED_TRACE_STAGE_CHECK, 0);
+            SCHED_TRACE(SCHED_TRACE_STAGE_END, SCHED_TRACE_STAGE_CHECK, 0);
+
             // Recheck the available time as checkCycles is only approximate
             timeDelta_t taskRequiredTimeUs = selectedTask->anticipatedExecutionTime >> TASK_EXEC_TIME_SHIFT;
 #if defined(USE_LATE_TASK_STATISTICS)
@@ -772,10 +987,15 @@ FAST_CODE void scheduler(void)
 
             if (!gyroEnabled || firstSchedulingOpportunity || (taskRequiredTimeCycles < schedLoopRemainingCycles)) {
                 uint32_t antipatedEndCycles = nowCycles + taskRequiredTimeCycles;
+                SCHED_TRACE(SCHED_TRACE_SELECT, selectedTask - tasks, selectedTaskDynamicPriority);
                 taskExecutionTimeUs += schedulerExecuteTask(selectedTask, currentTimeUs);
                 nowCycles = getCycleCounter();
                 int32_t cyclesOverdue = cmpTimeCycles(nowCycles, antipatedEndCycles);
 
+                if (cyclesOverdue > 0) {
+                    SCHED_TRACE(SCHED_TRACE_LATE, currentTask - tasks, clockCyclesToMicros(cyclesOverdue));
+                }
+
 #if defined(USE_LATE_TASK_STATISTICS)
                 if (cyclesOverdue > 0) {
                     if ((currentTask - tasks) != TASK_SERIAL) {
@@ -807,14 +1027,18 @@ FAST_CODE void scheduler(void)
 #if defined(USE_LATE_TASK_STATISTICS)
                 taskCount++;
 #endif  // USE_LATE_TASK_STATISTICS
-            } else if ((selectedTask->taskAgePeriods > TASK_AGE_EXPEDITE_COUNT) ||
+            } else {
+                SCHED_TRACE(SCHED_TRACE_DEFER, selectedTask - tasks, selectedTaskDynamicPriority);
+
+                if ((selectedTask->taskAgePeriods > TASK_AGE_EXPEDITE_COUNT) ||
 #ifdef USE_OSD
-                       (((selectedTask - tasks) == TASK_OSD) && (TASK_AGE_EXPEDITE_OSD != 0) && (++skippedOSDAttempts > TASK_AGE_EXPEDITE_OSD)) ||
+                    (((selectedTask - tasks) == TASK_OSD) && (TASK_AGE_EXPEDITE_OSD != 0) && (++skippedOSDAttempts > TASK_AGE_EXPEDITE_OSD)) ||
 #endif
-                       (((selectedTask - tasks) == TASK_RX) && (TASK_AGE_EXPEDITE_RX != 0) && (++skippedRxAttempts > TASK_AGE_EXPEDITE_RX))) {
-                // If a task has been unable to run, then reduce it's recorded estimated run time to ensure
-                // it's ultimate scheduling
-                selectedTask->anticipatedExecutionTime *= TASK_AGE_EXPEDITE_SCALE;
+                    (((selectedTask - tasks) == TASK_RX) && (TASK_AGE_EXPEDITE_RX != 0) && (++skippedRxAttempts > TASK_AGE_EXPEDITE_RX))) {
+                    // If a task has been unable to run, then reduce it's recorded estimated run time to ensure
+                    // it's ultimate scheduling
+                    selectedTask->anticipatedExecutionTime *= TASK_AGE_EXPEDITE_SCALE;
+                }
             }
         }
     }
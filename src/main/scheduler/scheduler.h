@@ -191,6 +191,9 @@ typedef enum {
 #ifdef USE_GIMBAL
     TASK_GIMBAL,
 #endif
+#ifdef USE_BLACKBOX_TASK
+    TASK_BLACKBOX,
+#endif
 
     /* Count of real tasks */
     TASK_COUNT,
@@ -221,6 +224,11 @@ typedef struct {
     timeUs_t lastExecutedAtUs;          // last time of invocation
     timeUs_t lastSignaledAtUs;          // time of invocation event for event-driven tasks
     timeUs_t lastDesiredAt;             // time of last desired execution
+#if defined(USE_SCHEDULER_HEAP)
+    timeUs_t nextDueAtUs;               // heap key of time driven tasks, lastExecutedAtUs + desiredPeriodUs
+    uint8_t heapIndex;                  // position in the heap of time driven tasks
+    uint8_t queueIndex;                 // position in the task queue, breaks ties in dynamic priority
+#endif
 
     // Statistics
     float    movingAverageCycleTimeUs;
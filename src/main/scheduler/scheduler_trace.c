@@ -0,0 +1,165 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "platform.h"
+
+#ifdef USE_SCHEDULER_TRACE
+
+#include "common/maths.h"
+#include "common/printf.h"
+#include "common/utils.h"
+
+#include "fc/tasks.h"
+
+#include "scheduler/scheduler.h"
+
+#include "scheduler_trace.h"
+
+#define SCHED_TRACE_BUFFER_MASK (SCHED_TRACE_BUFFER_SIZE - 1)
+
+STATIC_ASSERT((SCHED_TRACE_BUFFER_SIZE & SCHED_TRACE_BUFFER_MASK) == 0, sched_trace_buffer_size_not_power_of_2);
+
+bool schedTraceActive;
+
+static schedTraceEvent_t schedTraceBuffer[SCHED_TRACE_BUFFER_SIZE];
+// head is only written by the producer and tail only by the consumer, both are free running
+static uint32_t schedTraceHead;
+static uint32_t schedTraceTail;
+static uint32_t schedTraceDropCount;
+static bool schedTraceStreaming;
+
+static const char * const schedTraceStageNames[SCHED_TRACE_STAGE_COUNT] = {
+    [SCHED_TRACE_STAGE_REALTIME] = "REALTIME",
+    [SCHED_TRACE_STAGE_CHECK] = "CHECK",
+    [SCHED_TRACE_STAGE_RC_COMMAND] = "RC_COMMAND",
+    [SCHED_TRACE_STAGE_PID_CONTROLLER] = "PID_CONTROLLER",
+    [SCHED_TRACE_STAGE_MOTOR_UPDATE] = "MOTOR_UPDATE",
+    [SCHED_TRACE_STAGE_PID_SUBPROCESSES] = "PID_SUBPROCESSES",
+};
+
+FAST_CODE void schedTraceRecord(timeUs_t timeUs, schedTraceEventType_e type, unsigned id, unsigned arg)
+{
+    const uint32_t head = schedTraceHead;
+
+    if (head - __atomic_load_n(&schedTraceTail, __ATOMIC_ACQUIRE) >= SCHED_TRACE_BUFFER_SIZE) {
+        schedTraceDropCount++;
+        return;
+    }
+
+    schedTraceEvent_t *event = &schedTraceBuffer[head & SCHED_TRACE_BUFFER_MASK];
+    event->timeUs = timeUs;
+    event->type = type;
+    event->id = id;
+    event->arg = MIN(arg, (unsigned)UINT16_MAX);
+
+    __atomic_store_n(&schedTraceHead, head + 1, __ATOMIC_RELEASE);
+}
+
+void schedTraceStart(void)
+{
+    schedTraceDropCount = 0;
+    schedTraceActive = true;
+}
+
+void schedTraceStop(void)
+{
+    schedTraceActive = false;
+}
+
+bool schedTraceIsActive(void)
+{
+    return schedTraceActive;
+}
+
+uint32_t schedTraceDropped(void)
+{
+    return schedTraceDropCount;
+}
+
+void schedTraceSetStreaming(bool streaming)
+{
+    schedTraceStreaming = streaming;
+}
+
+bool schedTraceIsStreaming(void)
+{
+    return schedTraceStreaming;
+}
+
+uint32_t schedTracePending(void)
+{
+    return __atomic_load_n(&schedTraceHead, __ATOMIC_ACQUIRE) - __atomic_load_n(&schedTraceTail, __ATOMIC_ACQUIRE);
+}
+
+uint32_t schedTraceRead(schedTraceEvent_t *events, uint32_t maxEvents)
+{
+    uint32_t tail = schedTraceTail;
+    const uint32_t count = MIN(__atomic_load_n(&schedTraceHead, __ATOMIC_ACQUIRE) - tail, maxEvents);
+
+    for (uint32_t i = 0; i < count; i++) {
+        events[i] = schedTraceBuffer[tail++ & SCHED_TRACE_BUFFER_MASK];
+    }
+
+    __atomic_store_n(&schedTraceTail, tail, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+void schedTraceClear(void)
+{
+    __atomic_store_n(&schedTraceTail, __atomic_load_n(&schedTraceHead, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+}
+
+static const char *schedTraceTaskName(unsigned taskId)
+{
+    return taskId < TASK_COUNT ? getTask(taskId)->attribute->taskName : "?";
+}
+
+// Formats an event as a Chrome trace event object, buf must hold SCHED_TRACE_JSON_MAX characters
+int schedTraceFormatEvent(const schedTraceEvent_t *event, char *buf)
+{
+    switch (event->type) {
+    case SCHED_TRACE_TASK_BEGIN:
+    case SCHED_TRACE_TASK_END:
+        return tfp_sprintf(buf, "{\"name\":\"%s\",\"cat\":\"task\",\"ph\":\"%c\",\"ts\":%u,\"pid\":1,\"tid\":1}",
+            schedTraceTaskName(event->id), event->type == SCHED_TRACE_TASK_BEGIN ? 'B' : 'E', event->timeUs);
+    case SCHED_TRACE_STAGE_BEGIN:
+    case SCHED_TRACE_STAGE_END:
+        return tfp_sprintf(buf, "{\"name\":\"%s\",\"cat\":\"stage\",\"ph\":\"%c\",\"ts\":%u,\"pid\":1,\"tid\":1}",
+            event->id < SCHED_TRACE_STAGE_COUNT ? schedTraceStageNames[event->id] : "?",
+            event->type == SCHED_TRACE_STAGE_BEGIN ? 'B' : 'E', event->timeUs);
+    case SCHED_TRACE_SELECT:
+    case SCHED_TRACE_DEFER:
+        return tfp_sprintf(buf, "{\"name\":\"%s %s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u,\"pid\":1,\"tid\":1,\"args\":{\"priority\":%u}}",
+            event->type == SCHED_TRACE_SELECT ? "select" : "defer", schedTraceTaskName(event->id), event->timeUs, event->arg);
+    case SCHED_TRACE_LATE:
+        return tfp_sprintf(buf, "{\"name\":\"late %s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u,\"pid\":1,\"tid\":1,\"args\":{\"us\":%u}}",
+            schedTraceTaskName(event->id), event->timeUs, event->arg);
+    default:
+        buf[0] = '\0';
+        return 0;
+    }
+}
+
+#endif // USE_SCHEDULER_TRACE
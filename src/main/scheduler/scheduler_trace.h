@@ -0,0 +1,98 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common/time.h"
+
+#include "drivers/time.h"
+
+// Scheduler trace recorder
+// Every task execution, the realtime gyro/filter/PID stages and the scheduler's task selection
+// are recorded with a timestamp into a single producer/single consumer ring. The producer is the
+// scheduler, the consumer is the CLI or, in SITL, a thread writing a Chrome trace JSON file.
+// Events are dropped, and counted, while the ring is full, so without a consumer a trace is a
+// one shot capture starting at schedTraceStart().
+
+#ifndef SCHED_TRACE_BUFFER_SIZE
+#define SCHED_TRACE_BUFFER_SIZE     2048    // events, must be a power of 2
+#endif
+
+#define SCHED_TRACE_JSON_MAX        160     // longest string produced by schedTraceFormatEvent()
+
+typedef enum {
+    SCHED_TRACE_TASK_BEGIN = 0,     // id = taskId_e
+    SCHED_TRACE_TASK_END,           // id = taskId_e
+    SCHED_TRACE_STAGE_BEGIN,        // id = schedTraceStage_e
+    SCHED_TRACE_STAGE_END,          // id = schedTraceStage_e
+    SCHED_TRACE_SELECT,             // id = taskId_e, arg = dynamic priority
+    SCHED_TRACE_DEFER,              // id = taskId_e, arg = dynamic priority, selected but no time to run
+    SCHED_TRACE_LATE,               // id = taskId_e, arg = us beyond the anticipated end
+    SCHED_TRACE_EVENT_COUNT
+} schedTraceEventType_e;
+
+typedef enum {
+    SCHED_TRACE_STAGE_REALTIME = 0, // gyro, filter and PID tasks of one gyro slot
+    SCHED_TRACE_STAGE_CHECK,        // dynamic priority update and check functions, only when a task was selected
+    SCHED_TRACE_STAGE_RC_COMMAND,
+    SCHED_TRACE_STAGE_PID_CONTROLLER,
+    SCHED_TRACE_STAGE_MOTOR_UPDATE,
+    SCHED_TRACE_STAGE_PID_SUBPROCESSES,
+    SCHED_TRACE_STAGE_COUNT
+} schedTraceStage_e;
+
+typedef struct schedTraceEvent_s {
+    uint32_t timeUs;
+    uint8_t type;                   // schedTraceEventType_e
+    uint8_t id;
+    uint16_t arg;
+} schedTraceEvent_t;
+
+#ifdef USE_SCHEDULER_TRACE
+extern bool schedTraceActive;
+
+#define SCHED_TRACE_AT(timeUs, type, id, arg) do { if (schedTraceActive) { schedTraceRecord((timeUs), (type), (id), (arg)); } } while (0)
+#define SCHED_TRACE(type, id, arg) do { if (schedTraceActive) { schedTraceRecord(micros(), (type), (id), (arg)); } } while (0)
+#else
+#define SCHED_TRACE_AT(timeUs, type, id, arg) do {} while (0)
+#define SCHED_TRACE(type, id, arg) do {} while (0)
+#endif
+
+void schedTraceRecord(timeUs_t timeUs, schedTraceEventType_e type, unsigned id, unsigned arg);
+
+void schedTraceStart(void);
+void schedTraceStop(void);
+bool schedTraceIsActive(void);
+uint32_t schedTraceDropped(void);
+
+// A consumer other than the CLI, like the SITL trace file writer, drains the ring
+void schedTraceSetStreaming(bool streaming);
+bool schedTraceIsStreaming(void);
+
+// Consumer side, must only be called from one context at a time
+uint32_t schedTracePending(void);
+uint32_t schedTraceRead(schedTraceEvent_t *events, uint32_t maxEvents);
+void schedTraceClear(void);
+int schedTraceFormatEvent(const schedTraceEvent_t *event, char *buf);
@@ -618,6 +618,11 @@
 #undef USE_CMS_GPS_RESCUE_MENU
 #endif
 
+#if defined(CONFIG_IN_EXTERNAL_FLASH) || defined(CONFIG_IN_SDCARD) || defined(CONFIG_IN_MEMORY_MAPPED_FLASH)
+// these stores write back the whole image, or only program whole pages, so there is nothing to gain from appending
+#undef USE_CONFIG_INCREMENTAL_SAVE
+#endif
+
 #if defined(CONFIG_IN_RAM) || defined(CONFIG_IN_FILE) || defined(CONFIG_IN_EXTERNAL_FLASH) || defined(CONFIG_IN_SDCARD) || defined(CONFIG_IN_MEMORY_MAPPED_FLASH)
 #ifndef EEPROM_SIZE
 #define EEPROM_SIZE     4096
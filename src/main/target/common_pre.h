@@ -310,6 +310,7 @@
 #endif
 
 #define USE_CLI_BATCH
+#define USE_CONFIG_INCREMENTAL_SAVE
 #define USE_RESOURCE_MGMT
 
 #define USE_RUNAWAY_TAKEOFF     // Runaway Takeoff Prevention (anti-taz)
@@ -494,12 +494,38 @@ static bool bbDecodeTelemetry(void)
             SCB_InvalidateDCache_by_Addr((uint32_t *)bbPort->portInputBuffer, DSHOT_BB_PORT_IP_BUF_CACHE_ALIGN_BYTES);
         }
 #endif
-        for (int motorIndex = 0; motorIndex < MAX_SUPPORTED_MOTORS && motorIndex < dshotMotorCount; motorIndex++) {
+#ifndef USE_DSHOT_BITBAND
+        // Each port input buffer is walked once for all of its motors
+        uint32_t rawValues[MAX_SUPPORTED_MOTORS];
+        for (int i = 0; i < usedMotorPorts; i++) {
+            bbPort_t *bbPort = &bbPorts[i];
+            uint32_t pinMask = 0;
+            for (int motorIndex = 0; motorIndex < MAX_SUPPORTED_MOTORS && motorIndex < dshotMotorCount; motorIndex++) {
+                if (bbMotors[motorIndex].bbPort == bbPort) {
+                    pinMask |= 1 << bbMotors[motorIndex].pinIndex;
+                }
+            }
+
+            uint32_t pinValues[DSHOT_BB_DECODE_PIN_COUNT];
+            decode_bb_port(bbPort->portInputBuffer, bbPort->portInputCount, pinMask, pinValues);
+
+            for (int motorIndex = 0; motorIndex < MAX_SUPPORTED_MOTORS && motorIndex < dshotMotorCount; motorIndex++) {
+                if (bbMotors[motorIndex].bbPort == bbPort) {
+                    rawValues[motorIndex] = pinValues[bbMotors[motorIndex].pinIndex];
+                }
+            }
+        }
+#endif
 
+        for (int motorIndex = 0; motorIndex < MAX_SUPPORTED_MOTORS && motorIndex < dshotMotorCount; motorIndex++) {
+#ifdef USE_DSHOT_BITBAND
             uint32_t rawValue = decode_bb_bitband(
                 bbMotors[motorIndex].bbPort->portInputBuffer,
                 bbMotors[motorIndex].bbPort->portInputCount,
                 bbMotors[motorIndex].pinIndex);
+#else
+            uint32_t rawValue = rawValues[motorIndex];
+#endif
 
             if (rawValue == DSHOT_TELEMETRY_NOEDGE) {
                 DEBUG_SET(DEBUG_DSHOT_TELEMETRY_COUNTS, 1, debug[1] + 1);
@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include <errno.h>
+#include <unistd.h>
 #include <time.h>
 
 #include "common/maths.h"
@@ -57,6 +58,9 @@
 #include "config/config_eeprom_impl.h"
 
 #include "scheduler/scheduler.h"
+#include "scheduler/scheduler_trace.h"
+
+#include "sensors/gyro.h"
 
 #include "pg/rx.h"
 #include "pg/motor.h"
@@ -67,6 +71,11 @@
 #include "io/gps.h"
 #include "io/gps_virtual.h"
 
+#include "blackbox/blackbox_virtual.h"
+
+#include "drivers/flash/flash.h"
+#include "drivers/flash/flash_virtual.h"
+
 #include "dyad.h"
 #include "udplink.h"
 
@@ -82,13 +91,64 @@ static bool fdm_received = false;
 
 static struct timespec start_time;
 static double simRate = 1.0;
-static pthread_t tcpWorker, udpWorker, udpWorkerRC;
+static pthread_t tcpWorker, udpWorker, udpWorkerRC, replayWorker, schedTraceWorker;
 static bool workerRunning = true;
 static udpLink_t stateLink, pwmLink, pwmRawLink, rcLink;
 static pthread_mutex_t updateLock;
 static pthread_mutex_t mainLoopLock;
 static char simulator_ip[32] = "127.0.0.1";
 
+// Lockstep mode
+// Virtual time is only advanced by received FDM packets and explicit delays, never by the wall clock.
+// Each FDM packet releases a fixed number of steps, after which the motor outputs are sent back,
+// so runs are deterministic and go as fast as the CPU allows. Within a step scheduler() is called
+// until the virtual time reaches the start of the next step, each call taking LOCKSTEP_PASS_NS.
+// Reading the time never advances it, busy-waits must use an explicit delay.
+#define LOCKSTEP_PASS_NS 1000
+static bool lockstepEnabled = false;
+static uint32_t lockstepIterations = 0;     // steps per FDM packet, 0 = one per gyro loop
+static uint64_t lockstepTimeNs = 0;         // virtual time, only written by the main loop, use lockstepTime()
+static uint64_t lockstepSlotNs = 0;         // virtual time at which the current step started
+static uint64_t lockstepStepNs = 0;         // virtual time advanced per step
+static uint32_t lockstepPending = 0;        // steps left to run for the current FDM packet
+static bool lockstepRunning = false;        // main loop is working on an FDM packet
+static bool lockstepLoopReady = false;      // init is complete and the main loop is waiting for steps
+static bool lockstepStarted = false;
+static double lockstepLastTimestamp = 0;    // in seconds
+static bool lockstepRcPending = false;
+static rc_packet lockstepRcPkt;
+static pthread_mutex_t lockstepLock;
+static pthread_cond_t lockstepCond;
+
+// Other threads read the virtual time too, e.g. when applying RC or replay input
+static uint64_t lockstepTime(void)
+{
+    return __atomic_load_n(&lockstepTimeNs, __ATOMIC_RELAXED);
+}
+
+static void lockstepSetTime(uint64_t timeNs)
+{
+    __atomic_store_n(&lockstepTimeNs, timeNs, __ATOMIC_RELAXED);
+}
+
+// Replay mode
+// Sensor and RC input is read from a trace file instead of the UDP links, in lockstep,
+// and the motor outputs of every step are written to a file.
+static const char *replayFilename = NULL;
+static const char *replayOutFilename = "replay_out.bin";
+static FILE *replayFd = NULL;
+static FILE *replayOutFd = NULL;
+
+#ifdef USE_SCHEDULER_TRACE
+// Scheduler trace
+// The scheduler trace ring is drained by a separate thread into a Chrome trace JSON file,
+// which can be opened with chrome://tracing or https://ui.perfetto.dev
+static const char *schedTraceFilename = NULL;
+static FILE *schedTraceFd = NULL;
+static bool schedTraceWorkerRunning = false;
+static bool schedTraceFirstEvent = true;
+#endif
+
 #define PORT_PWM_RAW    9001    // Out
 #define PORT_PWM        9002    // Out
 #define PORT_STATE      9003    // In
@@ -96,13 +156,60 @@ static char simulator_ip[32] = "127.0.0.1";
 
 int targetParseArgs(int argc, char * argv[])
 {
-    //The first argument should be target IP.
-    if (argc > 1) {
-        strcpy(simulator_ip, argv[1]);
+    // Options start with "--", the first other argument is the target IP.
+    bool ipSet = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--lockstep") == 0) {
+            lockstepEnabled = true;
+        } else if (strncmp(argv[i], "--lockstep=", 11) == 0) {
+            lockstepEnabled = true;
+            lockstepIterations = strtoul(argv[i] + 11, NULL, 10);
+        } else if (strncmp(argv[i], "--replay=", 9) == 0) {
+            lockstepEnabled = true;
+            replayFilename = argv[i] + 9;
+        } else if (strncmp(argv[i], "--replay-out=", 13) == 0) {
+            replayOutFilename = argv[i] + 13;
+#ifdef USE_SCHEDULER_TRACE
+        } else if (strncmp(argv[i], "--sched-trace=", 14) == 0) {
+            schedTraceFilename = argv[i] + 14;
+#endif
+#ifdef USE_FLASH_VIRTUAL
+        } else if (strncmp(argv[i], "--flash=", 8) == 0) {
+            virtualFlashSetFile(argv[i] + 8);
+        } else if (strncmp(argv[i], "--flash-geometry=", 17) == 0) {
+            if (!virtualFlashSetGeometry(argv[i] + 17)) {
+                printf("[SITL] invalid flash geometry '%s'\n", argv[i] + 17);
+                exit(1);
+            }
+        } else if (strncmp(argv[i], "--flash-timing=", 15) == 0) {
+            if (!virtualFlashSetTiming(argv[i] + 15)) {
+                printf("[SITL] invalid flash timing '%s'\n", argv[i] + 15);
+                exit(1);
+            }
+#endif
+        } else if (!ipSet) {
+            strncpy(simulator_ip, argv[i], sizeof(simulator_ip) - 1);
+            ipSet = true;
+        }
     }
 
     printf("[SITL] The SITL will output to IP %s:%d (Gazebo) and %s:%d (RealFlightBridge)\n",
            simulator_ip, PORT_PWM, simulator_ip, PORT_PWM_RAW);
+    if (replayFilename) {
+        printf("[SITL] replaying '%s', motor output to '%s'\n", replayFilename, replayOutFilename);
+    }
+#ifdef USE_SCHEDULER_TRACE
+    if (schedTraceFilename) {
+        printf("[SITL] writing scheduler trace to '%s'\n", schedTraceFilename);
+    }
+#endif
+    if (lockstepEnabled) {
+        if (lockstepIterations) {
+            printf("[SITL] lockstep mode, %u steps per FDM packet\n", lockstepIterations);
+        } else {
+            printf("[SITL] lockstep mode, one step per gyro loop\n");
+        }
+    }
     return 0;
 }
 
@@ -117,33 +224,43 @@ int lockMainPID(void)
 #define ACC_SCALE (256 / 9.80665)
 #define GYRO_SCALE (16.4)
 
+static float readRCSITL(const rxRuntimeState_t *rxRuntimeState, uint8_t channel)
+{
+    UNUSED(rxRuntimeState);
+    return rcPkt.channels[channel];
+}
+
+static uint8_t rxRCFrameStatus(rxRuntimeState_t *rxRuntimeState)
+{
+    UNUSED(rxRuntimeState);
+    return RX_FRAME_COMPLETE;
+}
+
 static void sendMotorUpdate(void)
 {
     udpSend(&pwmLink, &pwmPkt, sizeof(servo_packet));
 }
 
-static void updateState(const fdm_packet* pkt)
+static void applyRcPacket(const rc_packet *pkt)
 {
-    static double last_timestamp = 0; // in seconds
-    static uint64_t last_realtime = 0; // in uS
-    static struct timespec last_ts; // last packet
+    rcPkt = *pkt;
 
-    struct timespec now_ts;
-    clock_gettime(CLOCK_MONOTONIC, &now_ts);
+    if (!rc_received) {
+        printf("[SITL] new rc t:%f AETR: %d %d %d %d AUX1-4: %d %d %d %d\n", rcPkt.timestamp,
+            rcPkt.channels[0], rcPkt.channels[1],rcPkt.channels[2],rcPkt.channels[3],
+            rcPkt.channels[4], rcPkt.channels[5],rcPkt.channels[6],rcPkt.channels[7]);
 
-    const uint64_t realtime_now = micros64_real();
-    if (realtime_now > last_realtime + 500*1e3) { // 500ms timeout
-        last_timestamp = pkt->timestamp;
-        last_realtime = realtime_now;
-        sendMotorUpdate();
-        return;
-    }
+        rxRuntimeState.channelCount = SIMULATOR_MAX_RC_CHANNELS;
+        rxRuntimeState.rcReadRawFn = readRCSITL;
+        rxRuntimeState.rcFrameStatusFn = rxRCFrameStatus;
 
-    const double deltaSim = pkt->timestamp - last_timestamp;  // in seconds
-    if (deltaSim < 0) { // don't use old packet
-        return;
+        rxRuntimeState.rxProvider = RX_PROVIDER_UDP;
+        rc_received = true;
     }
+}
 
+static void setSensorState(const fdm_packet* pkt)
+{
     int16_t x,y,z;
     x = constrain(-pkt->imu_linear_acceleration_xyz[0] * ACC_SCALE, -32767, 32767);
     y = constrain(-pkt->imu_linear_acceleration_xyz[1] * ACC_SCALE, -32767, 32767);
@@ -202,6 +319,99 @@ static void updateState(const fdm_packet* pkt)
     }
     setVirtualGPS(latitude, longitude, altitude, speed, speed3D, course);
 #endif
+}
+
+// Waits for the main loop to finish the previous step, sensor state must not change under it.
+// Returns with lockstepLock held, unless the timestamp is older than the last one.
+static bool lockstepAcquire(double timestamp)
+{
+    pthread_mutex_lock(&lockstepLock);
+
+    while ((!lockstepLoopReady || lockstepRunning || lockstepPending) && workerRunning) {
+        pthread_cond_wait(&lockstepCond, &lockstepLock);
+    }
+
+    if (lockstepStarted && timestamp < lockstepLastTimestamp) { // don't use old packet
+        pthread_mutex_unlock(&lockstepLock);
+        return false;
+    }
+
+    if (lockstepRcPending) {
+        applyRcPacket(&lockstepRcPkt);
+        lockstepRcPending = false;
+    }
+
+    return true;
+}
+
+// Releases the main loop for the virtual time since the last timestamp and drops lockstepLock.
+// Returns false for the first timestamp, which only establishes the time base.
+static bool lockstepRelease(double timestamp)
+{
+    const bool started = lockstepStarted;
+
+    if (started) {
+        const uint64_t deltaNs = llrint((timestamp - lockstepLastTimestamp) * 1e9);
+        uint32_t iterations = lockstepIterations;
+        if (iterations == 0) {
+            const uint64_t gyroLoopNs = MAX(gyro.targetLooptime, 1U) * 1000ULL;
+            iterations = MAX((deltaNs + gyroLoopNs / 2) / gyroLoopNs, 1ULL);
+        }
+
+        lockstepStepNs = deltaNs / iterations;
+        lockstepPending = iterations;
+        pthread_cond_broadcast(&lockstepCond);
+    }
+
+    lockstepStarted = true;
+    lockstepLastTimestamp = timestamp;
+
+    pthread_mutex_unlock(&lockstepLock);
+
+    return started;
+}
+
+static void updateStateLockstep(const fdm_packet* pkt)
+{
+    if (!lockstepAcquire(pkt->timestamp)) {
+        return;
+    }
+
+    setSensorState(pkt);
+
+    if (!lockstepRelease(pkt->timestamp)) {
+        sendMotorUpdate();
+    }
+}
+
+static void updateState(const fdm_packet* pkt)
+{
+    static double last_timestamp = 0; // in seconds
+    static uint64_t last_realtime = 0; // in uS
+    static struct timespec last_ts; // last packet
+
+    if (lockstepEnabled) {
+        updateStateLockstep(pkt);
+        return;
+    }
+
+    struct timespec now_ts;
+    clock_gettime(CLOCK_MONOTONIC, &now_ts);
+
+    const uint64_t realtime_now = micros64_real();
+    if (realtime_now > last_realtime + 500*1e3) { // 500ms timeout
+        last_timestamp = pkt->timestamp;
+        last_realtime = realtime_now;
+        sendMotorUpdate();
+        return;
+    }
+
+    const double deltaSim = pkt->timestamp - last_timestamp;  // in seconds
+    if (deltaSim < 0) { // don't use old packet
+        return;
+    }
+
+    setSensorState(pkt);
 
 #if defined(SIMULATOR_IMU_SYNC)
     imuSetHasNewData(deltaSim*1e6);
@@ -249,42 +459,156 @@ static void* udpThread(void* data)
     return NULL;
 }
 
-static float readRCSITL(const rxRuntimeState_t *rxRuntimeState, uint8_t channel)
+static void *udpRCThread(void *data)
 {
-    UNUSED(rxRuntimeState);
-    return rcPkt.channels[channel];
+    UNUSED(data);
+    int n = 0;
+    rc_packet pkt;
+
+    while (workerRunning) {
+        n = udpRecv(&rcLink, &pkt, sizeof(rc_packet), 100);
+        if (n == sizeof(rc_packet)) {
+            if (lockstepEnabled) {
+                // Applied together with the next FDM packet to keep lockstep runs deterministic
+                pthread_mutex_lock(&lockstepLock);
+                lockstepRcPkt = pkt;
+                lockstepRcPending = true;
+                pthread_mutex_unlock(&lockstepLock);
+            } else {
+                applyRcPacket(&pkt);
+            }
+        }
+    }
+
+    printf("udpRCThread end!!\n");
+    return NULL;
 }
 
-static uint8_t rxRCFrameStatus(rxRuntimeState_t *rxRuntimeState)
+static void applyReplayRecord(const replay_record *rec)
 {
-    UNUSED(rxRuntimeState);
-    return RX_FRAME_COMPLETE;
+    if (rec->flags & REPLAY_ACC) {
+        virtualAccSet(virtualAccDev, rec->acc[0], rec->acc[1], rec->acc[2]);
+    }
+    if (rec->flags & REPLAY_GYRO) {
+        virtualGyroSet(virtualGyroDev, rec->gyro[0], rec->gyro[1], rec->gyro[2]);
+    }
+    if (rec->flags & REPLAY_BARO) {
+        virtualBaroSet(rec->pressure, rec->temperature);
+    }
+#if !defined(USE_IMU_CALC)
+    if (rec->flags & REPLAY_ATTITUDE) {
+        imuSetAttitudeQuat(rec->orientation_quat[0], rec->orientation_quat[1], rec->orientation_quat[2], rec->orientation_quat[3]);
+    }
+#endif
+#if defined(USE_VIRTUAL_GPS)
+    if (rec->flags & REPLAY_GPS) {
+        setVirtualGPS(rec->latitude, rec->longitude, rec->altitude, rec->speed, rec->speed3D, rec->course);
+    }
+#endif
+    if (rec->flags & REPLAY_RC) {
+        rc_packet pkt = { .timestamp = rec->timestamp };
+        memcpy(pkt.channels, rec->channels, sizeof(pkt.channels));
+        applyRcPacket(&pkt);
+    }
 }
 
-static void *udpRCThread(void *data)
+#ifdef USE_SCHEDULER_TRACE
+static uint32_t schedTraceDrain(void)
+{
+    schedTraceEvent_t events[256];
+    char buf[SCHED_TRACE_JSON_MAX];
+    uint32_t count;
+    uint32_t total = 0;
+
+    while ((count = schedTraceRead(events, ARRAYLEN(events)))) {
+        for (uint32_t i = 0; i < count; i++) {
+            schedTraceFormatEvent(&events[i], buf);
+            fprintf(schedTraceFd, "%s%s\n", schedTraceFirstEvent ? "" : ",", buf);
+            schedTraceFirstEvent = false;
+        }
+        total += count;
+    }
+
+    return total;
+}
+
+static void *schedTraceThread(void *data)
 {
     UNUSED(data);
-    int n = 0;
 
-    while (workerRunning) {
-        n = udpRecv(&rcLink, &rcPkt, sizeof(rc_packet), 100);
-        if (n == sizeof(rc_packet)) {
-            if (!rc_received) {
-                printf("[SITL] new rc %d: t:%f AETR: %d %d %d %d AUX1-4: %d %d %d %d\n", n, rcPkt.timestamp,
-                    rcPkt.channels[0], rcPkt.channels[1],rcPkt.channels[2],rcPkt.channels[3],
-                    rcPkt.channels[4], rcPkt.channels[5],rcPkt.channels[6],rcPkt.channels[7]);
+    while (schedTraceWorkerRunning) {
+        // Only back off once the ring is empty, lockstep runs produce events much faster than real time
+        if (schedTraceDrain() == 0) {
+            fflush(schedTraceFd);
+            usleep(1000);
+        }
+    }
 
-                rxRuntimeState.channelCount = SIMULATOR_MAX_RC_CHANNELS;
-                rxRuntimeState.rcReadRawFn = readRCSITL;
-                rxRuntimeState.rcFrameStatusFn = rxRCFrameStatus;
+    return NULL;
+}
 
-                rxRuntimeState.rxProvider = RX_PROVIDER_UDP;
-                rc_received = true;
-            }
+static void schedTraceClose(void)
+{
+    if (!schedTraceFd) {
+        return;
+    }
+
+    schedTraceStop();
+    schedTraceWorkerRunning = false;
+    pthread_join(schedTraceWorker, NULL);
+    schedTraceDrain();
+    schedTraceSetStreaming(false);
+    fprintf(schedTraceFd, "]\n");
+    fclose(schedTraceFd);
+    schedTraceFd = NULL;
+
+    if (schedTraceDropped()) {
+        printf("[SITL] scheduler trace dropped %u events\n", schedTraceDropped());
+    }
+}
+#endif
+
+static void replayFinish(uint32_t recordCount)
+{
+    // Wait for the last step, the main loop stays blocked afterwards
+    pthread_mutex_lock(&lockstepLock);
+    while ((lockstepRunning || lockstepPending) && workerRunning) {
+        pthread_cond_wait(&lockstepCond, &lockstepLock);
+    }
+
+#ifdef USE_BLACKBOX_VIRTUAL
+    blackboxVirtualClose();
+#endif
+#ifdef USE_FLASH_VIRTUAL
+    virtualFlashClose();
+#endif
+    fclose(replayOutFd);
+    fclose(replayFd);
+#ifdef USE_SCHEDULER_TRACE
+    schedTraceClose();
+#endif
+
+    printf("[SITL] replay finished, %u records, %.3f s simulated in %.3f s\n",
+        recordCount, lockstepLastTimestamp, micros64_real() * 1e-6);
+    exit(0);
+}
+
+static void *replayThread(void *data)
+{
+    UNUSED(data);
+    replay_record rec;
+    uint32_t recordCount = 0;
+
+    while (workerRunning && fread(&rec, sizeof(rec), 1, replayFd) == 1) {
+        if (!lockstepAcquire(rec.timestamp)) {
+            continue;
         }
+        applyReplayRecord(&rec);
+        lockstepRelease(rec.timestamp);
+        recordCount++;
     }
 
-    printf("udpRCThread end!!\n");
+    replayFinish(recordCount);
     return NULL;
 }
 
@@ -325,12 +649,58 @@ void systemInit(void)
         exit(1);
     }
 
+    if (pthread_mutex_init(&lockstepLock, NULL) != 0 || pthread_cond_init(&lockstepCond, NULL) != 0) {
+        printf("Create lockstepLock error!\n");
+        exit(1);
+    }
+
     ret = pthread_create(&tcpWorker, NULL, tcpThread, NULL);
     if (ret != 0) {
         printf("Create tcpWorker error!\n");
         exit(1);
     }
 
+#ifdef USE_SCHEDULER_TRACE
+    if (schedTraceFilename) {
+        schedTraceFd = fopen(schedTraceFilename, "w");
+        if (schedTraceFd == NULL) {
+            fprintf(stderr, "[SITL] failed to create '%s': %s\n", schedTraceFilename, strerror(errno));
+            exit(1);
+        }
+        fprintf(schedTraceFd, "[\n");
+
+        schedTraceSetStreaming(true);
+        schedTraceWorkerRunning = true;
+        ret = pthread_create(&schedTraceWorker, NULL, schedTraceThread, NULL);
+        if (ret != 0) {
+            printf("Create schedTraceWorker error!\n");
+            exit(1);
+        }
+        schedTraceStart();
+    }
+#endif
+
+    if (replayFilename) {
+        replayFd = fopen(replayFilename, "rb");
+        if (replayFd == NULL) {
+            fprintf(stderr, "[SITL] failed to open replay '%s': %s\n", replayFilename, strerror(errno));
+            exit(1);
+        }
+        replayOutFd = fopen(replayOutFilename, "wb");
+        if (replayOutFd == NULL) {
+            fprintf(stderr, "[SITL] failed to create '%s': %s\n", replayOutFilename, strerror(errno));
+            exit(1);
+        }
+
+        // No UDP peer, sensor and RC input only comes from the trace
+        ret = pthread_create(&replayWorker, NULL, replayThread, NULL);
+        if (ret != 0) {
+            printf("Create replayWorker error!\n");
+            exit(1);
+        }
+        return;
+    }
+
     ret = udpInit(&pwmLink, simulator_ip, PORT_PWM, false);
     printf("[SITL] init PwmOut UDP link to gazebo %s:%d...%d\n", simulator_ip, PORT_PWM, ret);
 
@@ -360,8 +730,22 @@ void systemReset(void)
 {
     printf("[system]Reset!\n");
     workerRunning = false;
+    pthread_cond_broadcast(&lockstepCond);
     pthread_join(tcpWorker, NULL);
-    pthread_join(udpWorker, NULL);
+    if (replayFilename) {
+        pthread_join(replayWorker, NULL);
+    } else {
+        pthread_join(udpWorker, NULL);
+    }
+#ifdef USE_BLACKBOX_VIRTUAL
+    blackboxVirtualClose();
+#endif
+#ifdef USE_FLASH_VIRTUAL
+    virtualFlashClose();
+#endif
+#ifdef USE_SCHEDULER_TRACE
+    schedTraceClose();
+#endif
     exit(0);
 }
 void systemResetToBootloader(bootloaderRequestType_e requestType)
@@ -370,8 +754,22 @@ void systemResetToBootloader(bootloaderRequestType_e requestType)
 
     printf("[system]ResetToBootloader!\n");
     workerRunning = false;
+    pthread_cond_broadcast(&lockstepCond);
     pthread_join(tcpWorker, NULL);
-    pthread_join(udpWorker, NULL);
+    if (replayFilename) {
+        pthread_join(replayWorker, NULL);
+    } else {
+        pthread_join(udpWorker, NULL);
+    }
+#ifdef USE_BLACKBOX_VIRTUAL
+    blackboxVirtualClose();
+#endif
+#ifdef USE_FLASH_VIRTUAL
+    virtualFlashClose();
+#endif
+#ifdef USE_SCHEDULER_TRACE
+    schedTraceClose();
+#endif
     exit(0);
 }
 
@@ -417,6 +815,10 @@ uint64_t millis64_real(void)
 
 uint64_t micros64(void)
 {
+    if (lockstepEnabled) {
+        return lockstepTime() / 1000;
+    }
+
     static uint64_t last = 0;
     static uint64_t out = 0;
     uint64_t now = nanos64_real();
@@ -429,6 +831,10 @@ uint64_t micros64(void)
 
 uint64_t millis64(void)
 {
+    if (lockstepEnabled) {
+        return lockstepTime() / (1000 * 1000);
+    }
+
     static uint64_t last = 0;
     static uint64_t out = 0;
     uint64_t now = nanos64_real();
@@ -484,16 +890,31 @@ static void microsleep(uint32_t usec)
 
 void delayMicroseconds(uint32_t us)
 {
+    if (lockstepEnabled) {
+        lockstepSetTime(lockstepTime() + us * 1000ULL);
+        return;
+    }
+
     microsleep(us / simRate);
 }
 
 void delayMicroseconds_real(uint32_t us)
 {
+    if (lockstepEnabled) {
+        // No wall clock to pace against, the main loop is paced by simulatorLoopWait()
+        return;
+    }
+
     microsleep(us);
 }
 
 void delay(uint32_t ms)
 {
+    if (lockstepEnabled) {
+        lockstepSetTime(lockstepTime() + ms * 1000000ULL);
+        return;
+    }
+
     uint64_t start = millis64();
 
     while ((millis64() - start) < ms) {
@@ -501,6 +922,76 @@ void delay(uint32_t ms)
     }
 }
 
+// Used by the scheduler, which can't busy-poll for the gyro boundary while virtual time stands still
+bool simulatorLockstepEnabled(void)
+{
+    return lockstepEnabled;
+}
+
+// Called by the main loop before every scheduler() iteration
+void simulatorLoopWait(void)
+{
+    if (!lockstepEnabled) {
+        return;
+    }
+
+    if (lockstepRunning) {
+        // Keep running the scheduler until virtual time reaches the next step, so the non realtime
+        // tasks get the rest of the gyro slot
+        const uint64_t passEndNs = lockstepTime() + LOCKSTEP_PASS_NS;
+        if (passEndNs < lockstepSlotNs + lockstepStepNs) {
+            lockstepSetTime(passEndNs);
+            return;
+        }
+    }
+
+#ifdef USE_SCHEDULER_TRACE
+    // Virtual time stands still, so let the trace writer catch up rather than drop events
+    while (schedTraceFd && schedTracePending() > SCHED_TRACE_BUFFER_SIZE / 2) {
+        microsleep(100);
+    }
+#endif
+
+    pthread_mutex_lock(&lockstepLock);
+
+    if (!lockstepLoopReady) {
+        lockstepLoopReady = true;
+        pthread_cond_broadcast(&lockstepCond);
+    }
+
+    if (lockstepRunning && lockstepPending == 0) {
+        // All steps for the last FDM packet have run, reply with exactly one motor update
+        lockstepRunning = false;
+        if (replayOutFd) {
+            const replay_output_record rec = { .timestamp = lockstepLastTimestamp, .output = pwmRawPkt };
+            fwrite(&rec, sizeof(rec), 1, replayOutFd);
+        } else {
+            sendMotorUpdate();
+            udpSend(&pwmRawLink, &pwmRawPkt, sizeof(servo_packet_raw));
+        }
+        pthread_cond_broadcast(&lockstepCond);
+    }
+
+    while (lockstepPending == 0 && workerRunning) {
+        pthread_cond_wait(&lockstepCond, &lockstepLock);
+    }
+
+    if (lockstepPending) {
+        static bool synced = false;
+        if (!synced) {
+            // Start stepping from the virtual time reached during init
+            lockstepSlotNs = lockstepTime();
+            synced = true;
+        }
+        lockstepPending--;
+        lockstepRunning = true;
+        lockstepSlotNs += lockstepStepNs;
+        lockstepSetTime(MAX(lockstepTime(), lockstepSlotNs));
+    }
+
+    pthread_mutex_unlock(&lockstepLock);
+}
+
 // Subtract the ‘struct timespec’ values X and Y,  storing the result in RESULT.
 // Return 1 if the difference is negative, otherwise 0.
 // result = x - y
@@ -563,6 +1054,17 @@ static void pwmDisableMotors(void)
 
 static void pwmWriteMotor(uint8_t index, float value)
 {
+    if (lockstepEnabled) {
+        // updateLock is not used, outputs are sent by simulatorLoopWait() once per FDM packet
+        if (index < MAX_SUPPORTED_MOTORS) {
+            motorsPwm[index] = value - idlePulse;
+        }
+        if (index < pwmRawPkt.motorCount) {
+            pwmRawPkt.pwm_output_raw[index] = value;
+        }
+        return;
+    }
+
     if (pthread_mutex_trylock(&updateLock) != 0) return;
 
     if (index < MAX_SUPPORTED_MOTORS) {
@@ -601,6 +1103,10 @@ static void pwmCompleteMotorUpdate(void)
     pwmPkt.motor_speed[1] = motorsPwm[2] / outScale;
     pwmPkt.motor_speed[2] = motorsPwm[3] / outScale;
 
+    if (lockstepEnabled) {
+        return;
+    }
+
     // get one "fdm_packet" can only send one "servo_packet"!!
     if (pthread_mutex_trylock(&updateLock) != 0) return;
     udpSend(&pwmLink, &pwmPkt, sizeof(servo_packet));
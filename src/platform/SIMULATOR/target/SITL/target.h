@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 
@@ -107,6 +108,18 @@
 
 #define USE_BLACKBOX
 #define USE_BLACKBOX_VIRTUAL
+#define USE_BLACKBOX_TASK
+#define BLACKBOX_RING_SIZE 64
+
+#define USE_FLASH_CHIP
+#define USE_FLASH_VIRTUAL
+#define USE_FLASHFS
+#define USE_FLASH_TOOLS
+#define USE_LZ
+
+#define USE_SCHEDULER_HEAP
+#define USE_SCHEDULER_TRACE
+#define SCHED_TRACE_BUFFER_SIZE (1 << 16)
 
 #undef USE_STACK_CHECK // I think SITL don't need this
 #undef USE_DASHBOARD
@@ -267,6 +280,40 @@ typedef struct {
     float pwm_output_raw[SIMULATOR_MAX_PWM_CHANNELS];   // Raw PWM from 1100 to 1900
 } servo_packet_raw;
 
+// Replay trace, a sequence of replay_record with no header, see README.md
+typedef enum {
+    REPLAY_GYRO     = (1 << 0),
+    REPLAY_ACC      = (1 << 1),
+    REPLAY_BARO     = (1 << 2),
+    REPLAY_GPS      = (1 << 3),
+    REPLAY_RC       = (1 << 4),
+    REPLAY_ATTITUDE = (1 << 5),
+} replayRecordFlags_e;
+
+typedef struct {
+    double timestamp;                   // in seconds
+    double orientation_quat[4];         // w, x, y, z
+    double latitude;                    // degrees
+    double longitude;                   // degrees
+    double altitude;                    // meters
+    double speed;                       // m/s, ground speed
+    double speed3D;                     // m/s
+    double course;                      // degrees
+    int32_t pressure;                   // Pa
+    int32_t temperature;                // 0.01 C
+    int16_t gyro[3];                    // raw gyro, 16.4 per deg/s
+    int16_t acc[3];                     // raw acc, 1G = 256
+    uint16_t channels[SIMULATOR_MAX_RC_CHANNELS];   // RC channels
+    uint16_t flags;                     // replayRecordFlags_e, fields present in this record
+    uint16_t reserved;
+} replay_record;
+
+// Motor output written for every replayed step
+typedef struct {
+    double timestamp;                   // in seconds
+    servo_packet_raw output;
+} replay_output_record;
+
 uint64_t nanos64_real(void);
 uint64_t micros64_real(void);
 uint64_t millis64_real(void);
@@ -275,5 +322,7 @@ uint64_t micros64(void);
 uint64_t millis64(void);
 
 int lockMainPID(void);
+void simulatorLoopWait(void);
+bool simulatorLockstepEnabled(void);
 
 int targetParseArgs(int argc, char * argv[]);
@@ -6,7 +6,10 @@ TARGET_SRC = \
             drivers/accgyro/accgyro_virtual.c \
             drivers/barometer/barometer_virtual.c \
             drivers/compass/compass_virtual.c \
+            drivers/flash/flash.c \
+            drivers/flash/flash_virtual.c \
             drivers/serial_tcp.c \
+            io/flashfs.c \
             io/gps_virtual.c \
             blackbox/blackbox_virtual.c
 
@@ -157,6 +157,7 @@
 #define USE_DMA_SPEC
 #define USE_PERSISTENT_OBJECTS
 #define USE_LATE_TASK_STATISTICS
+#define USE_LZ
 #endif // STM32F7
 
 #ifdef STM32H7
@@ -170,6 +171,8 @@
 #define USE_RPM_FILTER
 #define USE_DYN_IDLE
 #define USE_DYN_NOTCH_FILTER
+#define USE_DYN_NOTCH_FFT
+#define USE_DYN_NOTCH_GOERTZEL
 #define USE_ADC_INTERNAL
 #define USE_USB_CDC_HID
 #define USE_DMA_SPEC
@@ -179,6 +182,7 @@
 #define USE_RTC_TIME
 #define USE_PERSISTENT_MSC_RTC
 #define USE_LATE_TASK_STATISTICS
+#define USE_LZ
 #endif
 
 #ifdef STM32G4
@@ -121,6 +121,22 @@ static uint8_t usbVcpRead(serialPort_t *instance)
     }
 }
 
+#if defined(STM32F4) || defined(STM32F7) || defined(STM32H7) || defined(STM32G4)
+static uint32_t usbVcpPeekRx(serialPort_t *instance, const uint8_t **data)
+{
+    UNUSED(instance);
+
+    return CDC_Receive_Peek(data);
+}
+
+static void usbVcpSkipRx(serialPort_t *instance, uint32_t count)
+{
+    UNUSED(instance);
+
+    CDC_Receive_Skip(count);
+}
+#endif
+
 static void usbVcpWriteBuf(serialPort_t *instance, const void *data, int count)
 {
     UNUSED(instance);
@@ -211,7 +227,11 @@ static const struct serialPortVTable usbVTable[] = {
         .setBaudRateCb = usbVcpSetBaudRateCb,
         .writeBuf = usbVcpWriteBuf,
         .beginWrite = usbVcpBeginWrite,
-        .endWrite = usbVcpEndWrite
+        .endWrite = usbVcpEndWrite,
+#if defined(STM32F4) || defined(STM32F7) || defined(STM32H7) || defined(STM32G4)
+        .peekRx = usbVcpPeekRx,
+        .skipRx = usbVcpSkipRx,
+#endif
     }
 };
 
@@ -406,6 +406,25 @@ uint32_t CDC_Receive_BytesAvailable(void)
     return rxAvailable;
 }
 
+// Returns the rest of the received packet, release it with CDC_Receive_Skip()
+uint32_t CDC_Receive_Peek(const uint8_t **data)
+{
+    *data = rxBuffPtr;
+    return rxBuffPtr ? rxAvailable : 0;
+}
+
+void CDC_Receive_Skip(uint32_t count)
+{
+    if (!count) {
+        return;
+    }
+    rxBuffPtr += count;
+    rxAvailable -= count;
+    if (rxAvailable < 1) {
+        USBD_CDC_ReceivePacket(&USBD_Device);
+    }
+}
+
 uint32_t CDC_Send_FreeBytes(void)
 {
     /*
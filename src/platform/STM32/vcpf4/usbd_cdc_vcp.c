@@ -238,6 +238,21 @@ uint32_t CDC_Receive_DATA(uint8_t* recvBuf, uint32_t len)
     return count;
 }
 
+/* Returns the received data contiguous in the circular buffer, release it with CDC_Receive_Skip() */
+uint32_t CDC_Receive_Peek(const uint8_t **data)
+{
+    const uint32_t in = APP_Tx_ptr_in;
+    const uint32_t out = APP_Tx_ptr_out;
+
+    *data = &APP_Tx_Buffer[out];
+    return in >= out ? in - out : APP_TX_DATA_SIZE - out;
+}
+
+void CDC_Receive_Skip(uint32_t count)
+{
+    APP_Tx_ptr_out = (APP_Tx_ptr_out + count) % APP_TX_DATA_SIZE;
+}
+
 uint32_t CDC_Receive_BytesAvailable(void)
 {
     /* return the bytes available in the receive circular buffer */
@@ -0,0 +1,206 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Minimal micro-benchmark harness with a Google Benchmark style interface.
+ *
+ *   static void BM_something(benchmark::State &state)
+ *   {
+ *       setup();
+ *       for (auto _ : state) {
+ *           benchmark::DoNotOptimize(something());
+ *       }
+ *       state.SetItemsPerIteration(XYZ_AXIS_COUNT);
+ *   }
+ *   BENCHMARK(BM_something);
+ *
+ * Every benchmark is run with a growing number of iterations until it takes at least
+ * --benchmark_min_time seconds (default 0.5), the result is reported per iteration and per item.
+ * Cycles are read from the time stamp counter on x86, elsewhere they are not reported.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCHMARK_HAS_CYCLES 1
+#else
+#define BENCHMARK_HAS_CYCLES 0
+#endif
+
+namespace benchmark {
+
+static inline uint64_t nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static inline uint64_t nowCycles(void)
+{
+#if BENCHMARK_HAS_CYCLES
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+template <typename T>
+static inline void DoNotOptimize(T const &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+static inline void ClobberMemory(void)
+{
+    asm volatile("" : : : "memory");
+}
+
+class State {
+public:
+    explicit State(uint64_t iterations) : iterations(iterations), itemsPerIteration(1) {}
+
+    // Unused attribute avoids warnings for the loop variable in "for (auto _ : state)"
+    struct __attribute__((unused)) Value {};
+
+    struct Iterator {
+        State *state;
+        uint64_t remaining;
+
+        bool operator!=(const Iterator &) const
+        {
+            if (remaining != 0) {
+                return true;
+            }
+            state->stop();
+            return false;
+        }
+        Iterator &operator++() { remaining--; return *this; }
+        Value operator*() const { return Value(); }
+    };
+
+    Iterator begin()
+    {
+        startNs = nowNs();
+        startCycles = nowCycles();
+        return Iterator { this, iterations };
+    }
+    Iterator end() { return Iterator { this, 0 }; }
+
+    void SetItemsPerIteration(int items) { itemsPerIteration = items; }
+
+    uint64_t iterations;
+    int itemsPerIteration;
+    uint64_t elapsedNs = 0;
+    uint64_t elapsedCycles = 0;
+
+private:
+    void stop()
+    {
+        elapsedCycles = nowCycles() - startCycles;
+        elapsedNs = nowNs() - startNs;
+    }
+
+    uint64_t startNs = 0;
+    uint64_t startCycles = 0;
+};
+
+typedef void (*benchmarkFn_t)(State &state);
+
+struct Benchmark {
+    const char *name;
+    benchmarkFn_t fn;
+};
+
+static inline std::vector<Benchmark> &registry(void)
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct Registrar {
+    Registrar(const char *name, benchmarkFn_t fn) { registry().push_back(Benchmark { name, fn }); }
+};
+
+static inline int RunAll(int argc, char *argv[])
+{
+    const char *filter = NULL;
+    double minTimeS = 0.5;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--benchmark_filter=", 19) == 0) {
+            filter = argv[i] + 19;
+        } else if (strncmp(argv[i], "--benchmark_min_time=", 21) == 0) {
+            minTimeS = atof(argv[i] + 21);
+        }
+    }
+
+    printf("%-40s %12s %12s %12s %12s\n", "Benchmark", "Iterations", "ns/iter", "cycles/iter", "cycles/item");
+    for (const Benchmark &benchmark : registry()) {
+        if (filter && !strstr(benchmark.name, filter)) {
+            continue;
+        }
+
+        uint64_t iterations = 1;
+        while (true) {
+            State state(iterations);
+            benchmark.fn(state);
+
+            const double elapsedS = state.elapsedNs * 1e-9;
+            if (elapsedS >= minTimeS || iterations >= (1ULL << 40)) {
+                const double nsPerIteration = (double)state.elapsedNs / iterations;
+                const double cyclesPerIteration = (double)state.elapsedCycles / iterations;
+                printf("%-40s %12llu %12.1f", benchmark.name, (unsigned long long)iterations, nsPerIteration);
+                if (BENCHMARK_HAS_CYCLES) {
+                    printf(" %12.1f %12.1f\n", cyclesPerIteration, cyclesPerIteration / state.itemsPerIteration);
+                } else {
+                    printf(" %12s %12s\n", "-", "-");
+                }
+                break;
+            }
+
+            // Aim for the minimum time with some margin, growing at most 10x per round
+            const double scale = elapsedS > 0 ? 1.4 * minTimeS / elapsedS : 10.0;
+            iterations = (uint64_t)(iterations * (scale < 10.0 ? (scale > 1.1 ? scale : 1.1) : 10.0)) + 1;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace benchmark
+
+#define BENCHMARK(fn) static benchmark::Registrar benchmarkRegistrar_##fn(#fn, fn)
+
+#define BENCHMARK_MAIN() \
+    int main(int argc, char *argv[]) \
+    { \
+        return benchmark::RunAll(argc, argv); \
+    }
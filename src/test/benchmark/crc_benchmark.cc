@@ -0,0 +1,141 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// CRC engines over a CRSF sized frame and an EEPROM sized block, against the bit serial engine.
+// Items are bytes. Build with CRC_TABLE_SLICES in crc_benchmark_DEFINES to compare table sizes.
+
+#include <stdint.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/crc.h"
+}
+
+#include "benchmark.h"
+
+#define BENCHMARK_FRAME_SIZE    64
+#define BENCHMARK_BLOCK_SIZE    1024
+
+static uint8_t data[BENCHMARK_BLOCK_SIZE];
+
+static void fillData(void)
+{
+    uint32_t state = 0x12345678;
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        state = state * 1664525 + 1013904223;
+        data[i] = state >> 24;
+    }
+}
+
+static uint16_t crc16CcittBits(uint16_t crc, const uint8_t *p, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)p[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint8_t crc8DvbS2Bits(uint8_t crc, const uint8_t *p, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= p[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0xD5 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static void BM_crc16CcittBits(benchmark::State &state)
+{
+    fillData();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crc16CcittBits(0, data, BENCHMARK_BLOCK_SIZE));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsPerIteration(BENCHMARK_BLOCK_SIZE);
+}
+BENCHMARK(BM_crc16CcittBits);
+
+static void BM_crc16CcittUpdate(benchmark::State &state)
+{
+    fillData();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crc16_ccitt_update(0, data, BENCHMARK_BLOCK_SIZE));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsPerIteration(BENCHMARK_BLOCK_SIZE);
+}
+BENCHMARK(BM_crc16CcittUpdate);
+
+static void BM_crc16CcittUpdateFrame(benchmark::State &state)
+{
+    fillData();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crc16_ccitt_update(0, data, BENCHMARK_FRAME_SIZE));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsPerIteration(BENCHMARK_FRAME_SIZE);
+}
+BENCHMARK(BM_crc16CcittUpdateFrame);
+
+static void BM_crc8DvbS2Bits(benchmark::State &state)
+{
+    fillData();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crc8DvbS2Bits(0, data, BENCHMARK_FRAME_SIZE));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsPerIteration(BENCHMARK_FRAME_SIZE);
+}
+BENCHMARK(BM_crc8DvbS2Bits);
+
+static void BM_crc8DvbS2Update(benchmark::State &state)
+{
+    fillData();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crc8_dvb_s2_update(0, data, BENCHMARK_FRAME_SIZE));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsPerIteration(BENCHMARK_FRAME_SIZE);
+}
+BENCHMARK(BM_crc8DvbS2Update);
+
+// Byte at a time, as the CRSF and MSP parsers do while receiving
+static void BM_crc8DvbS2Calc(benchmark::State &state)
+{
+    fillData();
+    for (auto _ : state) {
+        uint8_t crc = 0;
+        for (int i = 0; i < BENCHMARK_FRAME_SIZE; i++) {
+            crc = crc8_dvb_s2(crc, data[i]);
+        }
+        benchmark::DoNotOptimize(crc);
+    }
+    state.SetItemsPerIteration(BENCHMARK_FRAME_SIZE);
+}
+BENCHMARK(BM_crc8DvbS2Calc);
+
+BENCHMARK_MAIN();
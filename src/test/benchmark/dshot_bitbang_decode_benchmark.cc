@@ -0,0 +1,117 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Bidirectional DShot telemetry of four motors on one GPIO port, decoded per motor and in one pass.
+// Items are motors.
+
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "build/debug.h"
+    #include "drivers/dshot.h"
+    #include "drivers/dshot_bitbang_decode.h"
+
+    uint8_t debugMode;
+    int16_t debug[DEBUG16_VALUE_COUNT];
+}
+
+#include "benchmark.h"
+
+#define BENCHMARK_BUFFER_LENGTH 140
+#define BENCHMARK_MOTOR_COUNT   4
+
+static uint16_t portBuffer[BENCHMARK_BUFFER_LENGTH];
+static const unsigned motorPins[BENCHMARK_MOTOR_COUNT] = { 0, 1, 6, 7 };
+
+// Writes a valid telemetry frame for each motor, each starting a little later than the one before
+static void setupBuffer(void)
+{
+    static const uint8_t gcr[16] = {
+        0x19, 0x1b, 0x12, 0x13, 0x1d, 0x15, 0x16, 0x17, 0x1a, 0x09, 0x0a, 0x0b, 0x1e, 0x0d, 0x0e, 0x0f };
+
+    memset(portBuffer, 0, sizeof(portBuffer));
+    for (unsigned motor = 0; motor < BENCHMARK_MOTOR_COUNT; motor++) {
+        const uint16_t value = 0x300 + 0x111 * motor;
+        const uint16_t word = (value << 4) | ((~(value ^ (value >> 4) ^ (value >> 8))) & 0xf);
+        uint32_t code = 1;
+        for (int nibble = 3; nibble >= 0; nibble--) {
+            code = (code << 5) | gcr[(word >> (4 * nibble)) & 0xf];
+        }
+
+        const uint16_t mask = 1 << motorPins[motor];
+        unsigned index = 0;
+        for (; index < 20 + 2 * motor; index++) {
+            portBuffer[index] |= mask;
+        }
+        bool level = true;
+        for (int bit = 20; bit >= 0; bit--) {
+            level ^= (code >> bit) & 1;
+            for (int i = 0; i < 3; i++, index++) {
+                portBuffer[index] |= level ? mask : 0;
+            }
+        }
+        for (; index < BENCHMARK_BUFFER_LENGTH; index++) {
+            portBuffer[index] |= mask;
+        }
+    }
+}
+
+static void BM_decodeBbPerMotor(benchmark::State &state)
+{
+    setupBuffer();
+    for (auto _ : state) {
+        for (unsigned motor = 0; motor < BENCHMARK_MOTOR_COUNT; motor++) {
+            benchmark::DoNotOptimize(decode_bb(portBuffer, BENCHMARK_BUFFER_LENGTH, motorPins[motor]));
+        }
+    }
+    state.SetItemsPerIteration(BENCHMARK_MOTOR_COUNT);
+}
+BENCHMARK(BM_decodeBbPerMotor);
+
+static void BM_decodeBbPort(benchmark::State &state)
+{
+    setupBuffer();
+    uint32_t pinMask = 0;
+    for (unsigned motor = 0; motor < BENCHMARK_MOTOR_COUNT; motor++) {
+        pinMask |= 1 << motorPins[motor];
+    }
+
+    uint32_t values[DSHOT_BB_DECODE_PIN_COUNT];
+    for (auto _ : state) {
+        decode_bb_port(portBuffer, BENCHMARK_BUFFER_LENGTH, pinMask, values);
+        benchmark::DoNotOptimize(values);
+    }
+    state.SetItemsPerIteration(BENCHMARK_MOTOR_COUNT);
+}
+BENCHMARK(BM_decodeBbPort);
+
+BENCHMARK_MAIN();
+
+// STUBS
+
+extern "C" {
+
+uint32_t micros(void) { return 0; }
+
+}
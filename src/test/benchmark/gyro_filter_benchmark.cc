@@ -0,0 +1,210 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Gyro filter chain at 8kHz with 4 motors, 3 RPM harmonics and 5 dynamic notches
+
+#include <stdint.h>
+#include <math.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "build/debug.h"
+    #include "common/axis.h"
+    #include "common/filter.h"
+    #include "common/maths.h"
+    #include "drivers/dshot.h"
+    #include "flight/dyn_notch_filter.h"
+    #include "flight/rpm_filter.h"
+    #include "io/beeper.h"
+    #include "pg/pg.h"
+    #include "scheduler/scheduler.h"
+    #include "sensors/gyro.h"
+    #include "sensors/gyro_init.h"
+    #include "sensors/sensors.h"
+
+    uint8_t debugMode;
+    int16_t debug[DEBUG16_VALUE_COUNT];
+}
+
+#include "benchmark.h"
+
+#define BENCHMARK_LOOPTIME_US   125     // 8kHz
+#define BENCHMARK_MOTOR_COUNT   4
+
+static float motorFrequencyHz[BENCHMARK_MOTOR_COUNT];
+static uint32_t sampleIndex;
+
+// Gyro noise from four motors with slightly different speeds and their harmonics
+static float noiseSample(int axis)
+{
+    const float t = sampleIndex * BENCHMARK_LOOPTIME_US * 1e-6f;
+    float value = 10.0f * (axis + 1);
+    for (int motor = 0; motor < BENCHMARK_MOTOR_COUNT; motor++) {
+        value += 20.0f * sin_approx(2.0f * M_PIf * motorFrequencyHz[motor] * t + axis);
+    }
+    return value;
+}
+
+static void setupFilters(void)
+{
+    pgResetAll();
+
+    rpmFilterConfigMutable()->rpm_filter_harmonics = 3;
+    dynNotchConfigMutable()->dyn_notch_count = 5;
+
+    gyroInit();
+    gyro.sampleRateHz = 1000000 / BENCHMARK_LOOPTIME_US;
+    gyroSetTargetLooptime(1);
+    gyroInitFilters();
+
+    for (int motor = 0; motor < BENCHMARK_MOTOR_COUNT; motor++) {
+        motorFrequencyHz[motor] = 200.0f + 7.0f * motor;
+    }
+    rpmFilterInit(rpmFilterConfig(), gyro.targetLooptime);
+    // Update every notch once so the whole bank is active
+    for (int i = 0; i < BENCHMARK_MOTOR_COUNT * RPM_FILTER_HARMONICS_MAX; i++) {
+        rpmFilterUpdate();
+    }
+
+    sampleIndex = 0;
+}
+
+static void BM_gyroFiltering(benchmark::State &state)
+{
+    setupFilters();
+
+    for (auto _ : state) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            gyro.sampleSum[axis] = noiseSample(axis);
+        }
+        gyro.sampleCount = 1;
+        sampleIndex++;
+
+        gyroFiltering(0);
+        benchmark::DoNotOptimize(gyro.gyroADCf);
+    }
+    state.SetItemsPerIteration(XYZ_AXIS_COUNT);
+}
+BENCHMARK(BM_gyroFiltering);
+
+static void BM_rpmFilterApply(benchmark::State &state)
+{
+    setupFilters();
+
+    float values[XYZ_AXIS_COUNT] = { 0.0f, 0.0f, 0.0f };
+    for (auto _ : state) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            values[axis] += 1.0f;
+        }
+        rpmFilterApply(values);
+        benchmark::DoNotOptimize(values);
+    }
+    state.SetItemsPerIteration(XYZ_AXIS_COUNT);
+}
+BENCHMARK(BM_rpmFilterApply);
+
+static void BM_rpmFilterUpdate(benchmark::State &state)
+{
+    setupFilters();
+
+    for (auto _ : state) {
+        rpmFilterUpdate();
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_rpmFilterUpdate);
+
+static void BM_dynNotchFilter(benchmark::State &state)
+{
+    setupFilters();
+
+    float value = 0.0f;
+    for (auto _ : state) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            value = dynNotchFilter(axis, value + 1.0f);
+        }
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsPerIteration(XYZ_AXIS_COUNT);
+}
+BENCHMARK(BM_dynNotchFilter);
+
+static void dynNotchUpdateBenchmark(benchmark::State &state, dynNotchEstimator_e estimator, dynNotchFftSize_e fftSize)
+{
+    setupFilters();
+
+    dynNotchConfigMutable()->dyn_notch_estimator = estimator;
+    dynNotchConfigMutable()->dyn_notch_fft_size = fftSize;
+    dynNotchInit(dynNotchConfig(), gyro.targetLooptime);
+
+    for (auto _ : state) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            dynNotchPush(axis, noiseSample(axis));
+        }
+        sampleIndex++;
+        dynNotchUpdate();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsPerIteration(XYZ_AXIS_COUNT);
+}
+
+static void BM_dynNotchUpdate(benchmark::State &state)
+{
+    dynNotchUpdateBenchmark(state, DYN_NOTCH_ESTIMATOR_SDFT, DYN_NOTCH_FFT_SIZE_128);
+}
+BENCHMARK(BM_dynNotchUpdate);
+
+static void BM_dynNotchUpdateFft256(benchmark::State &state)
+{
+    dynNotchUpdateBenchmark(state, DYN_NOTCH_ESTIMATOR_FFT, DYN_NOTCH_FFT_SIZE_256);
+}
+BENCHMARK(BM_dynNotchUpdateFft256);
+
+static void BM_dynNotchUpdateGoertzel256(benchmark::State &state)
+{
+    dynNotchUpdateBenchmark(state, DYN_NOTCH_ESTIMATOR_GOERTZEL, DYN_NOTCH_FFT_SIZE_256);
+}
+BENCHMARK(BM_dynNotchUpdateGoertzel256);
+
+BENCHMARK_MAIN();
+
+// STUBS
+
+extern "C" {
+
+bool useDshotTelemetry = true;
+uint8_t detectedSensors[] = { GYRO_NONE, ACC_NONE };
+
+uint32_t micros(void) { return 0; }
+void beeper(beeperMode_e) {}
+timeDelta_t getGyroUpdateRate(void) { return gyro.targetLooptime; }
+void sensorsSet(uint32_t) {}
+void schedulerResetTaskStatistics(taskId_e) {}
+int getArmingDisableFlags(void) { return 0; }
+void writeEEPROM(void) {}
+uint8_t getMotorCount(void) { return BENCHMARK_MOTOR_COUNT; }
+float getMotorFrequencyHz(uint8_t motorIndex) { return motorFrequencyHz[motorIndex]; }
+float schedulerGetCycleTimeMultiplier(void) { return 1.0f; }
+uint8_t calculateThrottlePercentAbs(void) { return 50; }
+bool featureIsEnabled(uint32_t) { return false; }
+
+}
@@ -0,0 +1,248 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "build/debug.h"
+
+    #include "blackbox/blackbox.h"
+    #include "blackbox/blackbox_io.h"
+    #include "blackbox/blackbox_virtual.h"
+
+    #include "pg/pg.h"
+    #include "pg/pg_ids.h"
+
+    #include "drivers/serial.h"
+    #include "io/serial.h"
+
+    PG_REGISTER(blackboxConfig_t, blackboxConfig, PG_BLACKBOX_CONFIG, 0);
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+// BLACKBOX_VIRTUAL_BUFFER_SIZE in blackbox_virtual.c
+#define VIRTUAL_BUFFER_SIZE (256 * 1024)
+
+// Each serialWriteBuf() call, to check that frames are written in one go
+static std::vector<std::vector<uint8_t>> serialWrites;
+
+static char logDir[] = "/tmp/blackbox_io_unittestXXXXXX";
+
+static std::vector<uint8_t> testFrame(unsigned length, unsigned seed)
+{
+    std::vector<uint8_t> frame(length);
+    for (unsigned i = 0; i < length; i++) {
+        frame[i] = (i * 7 + seed * 13) & 0xff;
+    }
+    return frame;
+}
+
+static void writeFrame(const std::vector<uint8_t> &frame)
+{
+    blackboxFrameBegin();
+    for (const uint8_t value : frame) {
+        blackboxWrite(value);
+    }
+    blackboxFrameEnd();
+}
+
+static std::vector<uint8_t> readLog(int32_t logNumber)
+{
+    char filename[32];
+    snprintf(filename, sizeof(filename), "LOG%05d.BFL", logNumber);
+    std::vector<uint8_t> data;
+    FILE *file = fopen(filename, "rb");
+    EXPECT_NE(nullptr, file) << filename;
+    if (file) {
+        int ch;
+        while ((ch = fgetc(file)) != EOF) {
+            data.push_back(ch);
+        }
+        fclose(file);
+    }
+    return data;
+}
+
+static off_t logSize(int32_t logNumber)
+{
+    char filename[32];
+    snprintf(filename, sizeof(filename), "LOG%05d.BFL", logNumber);
+    struct stat st;
+    return stat(filename, &st) == 0 ? st.st_size : -1;
+}
+
+class BlackboxIoTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite()
+    {
+        // the virtual device logs to the current directory
+        ASSERT_NE(nullptr, mkdtemp(logDir));
+        ASSERT_EQ(0, chdir(logDir));
+    }
+
+    static void TearDownTestSuite()
+    {
+        for (int32_t logNumber = 1; logNumber <= blackboxVirtualLogFileNumber(); logNumber++) {
+            char filename[32];
+            snprintf(filename, sizeof(filename), "LOG%05d.BFL", logNumber);
+            unlink(filename);
+        }
+        EXPECT_EQ(0, chdir("/"));
+        rmdir(logDir);
+    }
+
+    virtual void SetUp()
+    {
+        serialWrites.clear();
+        blackboxConfigMutable()->device = BLACKBOX_DEVICE_SERIAL;
+    }
+};
+
+TEST_F(BlackboxIoTest, TestFrameWrittenInOneGo)
+{
+    ASSERT_TRUE(blackboxDeviceOpen());
+
+    const std::vector<uint8_t> frame = testFrame(40, 1);
+    blackboxFrameBegin();
+    for (const uint8_t value : frame) {
+        blackboxWrite(value);
+    }
+    // nothing reaches the device before the end of the frame
+    EXPECT_EQ(0U, serialWrites.size());
+    blackboxFrameEnd();
+
+    ASSERT_EQ(1U, serialWrites.size());
+    EXPECT_EQ(frame, serialWrites[0]);
+
+    // outside a frame bytes are written as they come
+    blackboxWrite(0x42);
+    ASSERT_EQ(2U, serialWrites.size());
+    EXPECT_EQ(std::vector<uint8_t>{0x42}, serialWrites[1]);
+
+    blackboxDeviceClose();
+}
+
+TEST_F(BlackboxIoTest, TestLongFrameWrittenInParts)
+{
+    ASSERT_TRUE(blackboxDeviceOpen());
+
+    // a frame longer than the frame buffer is passed on each time the buffer fills
+    const std::vector<uint8_t> frame = testFrame(BLACKBOX_FRAME_BUFFER_SIZE + 10, 2);
+    writeFrame(frame);
+
+    ASSERT_EQ(2U, serialWrites.size());
+    EXPECT_EQ(BLACKBOX_FRAME_BUFFER_SIZE, serialWrites[0].size());
+    EXPECT_EQ(10U, serialWrites[1].size());
+
+    std::vector<uint8_t> written = serialWrites[0];
+    written.insert(written.end(), serialWrites[1].begin(), serialWrites[1].end());
+    EXPECT_EQ(frame, written);
+
+    blackboxDeviceClose();
+}
+
+TEST_F(BlackboxIoTest, TestVirtualLogDoubleBuffered)
+{
+    blackboxConfigMutable()->device = BLACKBOX_DEVICE_VIRTUAL;
+    ASSERT_TRUE(blackboxDeviceOpen());
+    ASSERT_TRUE(blackboxDeviceBeginLog());
+    const int32_t logNumber = blackboxGetLogNumber();
+
+    // frames of 1000 bytes, one of them straddles the end of the first buffer
+    std::vector<uint8_t> expected;
+    unsigned seed = 0;
+    while (expected.size() < VIRTUAL_BUFFER_SIZE + 10000) {
+        const std::vector<uint8_t> frame = testFrame(1000, seed++);
+        writeFrame(frame);
+        expected.insert(expected.end(), frame.begin(), frame.end());
+    }
+    EXPECT_NE(0U, VIRTUAL_BUFFER_SIZE % 1000);
+
+    // the full buffer is written in the background, the rest stays in the other buffer
+    for (int i = 0; i < 1000 && logSize(logNumber) < VIRTUAL_BUFFER_SIZE; i++) {
+        usleep(1000);
+    }
+    EXPECT_EQ(VIRTUAL_BUFFER_SIZE, logSize(logNumber));
+
+    // closing the log writes the rest
+    EXPECT_TRUE(blackboxDeviceEndLog(true));
+    blackboxDeviceClose();
+
+    EXPECT_EQ(expected, readLog(logNumber));
+}
+
+TEST_F(BlackboxIoTest, TestVirtualLogFlush)
+{
+    blackboxConfigMutable()->device = BLACKBOX_DEVICE_VIRTUAL;
+    ASSERT_TRUE(blackboxDeviceOpen());
+    ASSERT_TRUE(blackboxDeviceBeginLog());
+    const int32_t logNumber = blackboxGetLogNumber();
+
+    const std::vector<uint8_t> frame = testFrame(100, 3);
+    writeFrame(frame);
+    EXPECT_EQ(0, logSize(logNumber));
+
+    // a forced flush returns once the data is in the file
+    EXPECT_TRUE(blackboxDeviceFlushForce());
+    EXPECT_EQ(frame, readLog(logNumber));
+
+    EXPECT_TRUE(blackboxDeviceEndLog(true));
+    blackboxDeviceClose();
+    EXPECT_EQ(frame, readLog(logNumber));
+}
+
+// STUBS
+extern "C" {
+
+uint8_t debugMode = 0;
+int16_t debug[DEBUG16_VALUE_COUNT];
+
+uint32_t targetPidLooptime;
+
+uint32_t millis(void) { return 0; }
+
+void serialWrite(serialPort_t *, uint8_t ch) { serialWrites.push_back(std::vector<uint8_t>{ch}); }
+void serialWriteBuf(serialPort_t *, const uint8_t *data, int count) { serialWrites.push_back(std::vector<uint8_t>(data, data + count)); }
+uint32_t serialTxBytesFree(const serialPort_t *) { return 4096; }
+bool isSerialTransmitBufferEmpty(const serialPort_t *) { return true; }
+const uint32_t baudRates[] = {0, 9600, 19200, 38400, 57600, 115200, 230400, 250000,
+        400000, 460800, 500000, 921600, 1000000, 1500000, 2000000, 2470000}; // see baudRate_e
+static const serialPortConfig_t blackboxPortConfig = { .identifier = SERIAL_PORT_USART1, .blackbox_baudrateIndex = BAUD_2000000 };
+static serialPort_t blackboxSerialPort;
+const serialPortConfig_t *findSerialPortConfig(serialPortFunction_e) { return &blackboxPortConfig; }
+serialPort_t *findSharedSerialPort(uint16_t, serialPortFunction_e) { return NULL; }
+serialPort_t *openSerialPort(serialPortIdentifier_e, serialPortFunction_e, serialReceiveCallbackPtr, void *, uint32_t, portMode_e, portOptions_e) { return &blackboxSerialPort; }
+void closeSerialPort(serialPort_t *) {}
+portSharing_e determinePortSharing(const serialPortConfig_t *, serialPortFunction_e) { return PORTSHARING_UNUSED; }
+void mspSerialAllocatePorts(void) {}
+void mspSerialReleasePortIfAllocated(serialPort_t *) {}
+
+}
@@ -17,12 +17,15 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <vector>
+
 extern "C" {
     #include "platform.h"
 
     #include "build/debug.h"
 
     #include "blackbox/blackbox.h"
+    #include "blackbox/blackbox_fielddefs.h"
     #include "common/utils.h"
 
     #include "pg/pg.h"
@@ -40,6 +43,7 @@ extern "C" {
 
     #include "fc/rc_controls.h"
     #include "fc/rc_modes.h"
+    #include "fc/runtime_config.h"
 
     #include "io/gps.h"
     #include "io/serial.h"
@@ -51,6 +55,7 @@ extern "C" {
 
     extern int16_t blackboxIInterval;
     extern int16_t blackboxPInterval;
+    extern boxBitmask_t rcModeActivationMask;
 }
 
 #include "unittest_macros.h"
@@ -58,6 +63,10 @@ extern "C" {
 
 gyroDev_t gyroDev;
 
+static std::vector<uint8_t> serialOutput;
+static uint32_t testMillis;
+static uint32_t armingBeepTimeUs;
+
 TEST(BlackboxTest, TestInitIntervals)
 {
     blackboxConfigMutable()->sample_rate = 4; // sample_rate = PID loop frequency / 16
@@ -264,6 +273,109 @@ TEST(BlackboxTest, Test_CalculatePDenom)
     EXPECT_EQ(16, blackboxCalculatePDenom(1, 16));
 }
 
+#ifdef USE_BLACKBOX_TASK
+TEST(BlackboxTest, Test_QueueIteration)
+{
+    // 1kHz PIDloop, logging every other iteration
+    targetPidLooptime = 1000;
+    blackboxConfigMutable()->sample_rate = 1;
+    blackboxInit();
+    EXPECT_EQ(0U, blackboxQueuedFrames());
+
+    // One I-frame and 15 P-frames are queued for the blackbox task
+    for (int ii = 0; ii < 32; ++ii) {
+        blackboxQueueIteration(0, false);
+        blackboxAdvanceIterationTimers();
+    }
+    EXPECT_EQ(16U, blackboxQueuedFrames());
+
+    // Frames are dropped once the ring is full
+    for (int ii = 0; ii < 64; ++ii) {
+        blackboxQueueIteration(0, false);
+        blackboxAdvanceIterationTimers();
+    }
+    EXPECT_EQ(32U, blackboxQueuedFrames()); // BLACKBOX_RING_SIZE
+}
+
+// Logs iterations after the headers and returns the bytes written, queued for taskBlackbox() or encoded inline
+static std::vector<uint8_t> logIterations(bool queued)
+{
+    // 1kHz PIDloop, logging every other iteration
+    targetPidLooptime = 1000;
+    blackboxConfigMutable()->device = BLACKBOX_DEVICE_SERIAL;
+    blackboxConfigMutable()->sample_rate = 1;
+    blackboxInit();
+
+    armingBeepTimeUs = 0;
+    stateFlags = 0;
+    memset(&rcModeActivationMask, 0, sizeof(rcModeActivationMask));
+    ENABLE_ARMING_FLAG(ARMED);
+
+    // Start the log, then write the headers until the first I-frame is queued, and encode it
+    blackboxUpdate(0);
+    for (int ii = 0; ii < 1000 && blackboxQueuedFrames() == 0; ++ii) {
+        testMillis += 100;
+        blackboxUpdate(0);
+    }
+    EXPECT_EQ(1U, blackboxQueuedFrames());
+    taskBlackbox(0);
+    serialOutput.clear();
+
+    for (uint32_t ii = 1; ii < 200; ++ii) {
+        const timeUs_t currentTimeUs = ii * 1000;
+
+        // Log an arming beep event, and a flight mode event with a slow frame, from iterations without a frame
+        if (ii == 41) {
+            armingBeepTimeUs = currentTimeUs;
+        }
+        if (ii == 75) {
+            rcModeActivationMask.bits[0] |= 1 << BOXANGLE;
+        }
+        // Log an event from another task, it's queued without encoding the frames before it
+        if (ii == 103) {
+            const uint32_t queuedFrames = blackboxQueuedFrames();
+            EXPECT_EQ(queued ? 1U : 0U, queuedFrames);
+            flightLogEvent_inflightAdjustment_t eventData = { .newValue = 42, .newFloatValue = 0, .adjustmentFunction = 3, .floatFlag = false };
+            blackboxLogEvent(FLIGHT_LOG_EVENT_INFLIGHT_ADJUSTMENT, (flightLogEventData_t *)&eventData);
+            EXPECT_EQ(queuedFrames, blackboxQueuedFrames());
+            EXPECT_EQ(1U, blackboxQueuedEvents());
+            if (!queued) {
+                // No frames are queued, so this only writes the event
+                taskBlackbox(currentTimeUs);
+            }
+        }
+
+        if (queued) {
+            blackboxQueueIteration(currentTimeUs, false);
+            if (ii % 4 == 0) {
+                taskBlackbox(currentTimeUs);
+            }
+        } else {
+            blackboxLogIteration(currentTimeUs);
+        }
+        blackboxAdvanceIterationTimers();
+    }
+    if (queued) {
+        taskBlackbox(200 * 1000);
+        EXPECT_EQ(0U, blackboxQueuedFrames());
+    }
+    EXPECT_EQ(0U, blackboxQueuedEvents());
+
+    DISABLE_ARMING_FLAG(ARMED);
+    blackboxConfigMutable()->device = BLACKBOX_DEVICE_NONE;
+    return serialOutput;
+}
+
+TEST(BlackboxTest, Test_QueuedFramesMatchInline)
+{
+    const std::vector<uint8_t> inlineOutput = logIterations(false);
+    const std::vector<uint8_t> queuedOutput = logIterations(true);
+
+    EXPECT_GT(inlineOutput.size(), 200U);
+    EXPECT_EQ(inlineOutput, queuedOutput);
+}
+#endif
+
 TEST(BlackboxTest, Test_CalculateRates)
 {
     // 1kHz PIDloop
@@ -353,30 +465,33 @@ gpsLocation_t GPS_home_llh;
 gyro_t gyro;
 
 float motor_disarmed[MAX_SUPPORTED_MOTORS];
-struct pidProfile_s;
-struct pidProfile_s *currentPidProfile;
+static pidProfile_t pidProfile;
+pidProfile_t *currentPidProfile = &pidProfile;
 uint32_t targetPidLooptime;
 
 boxBitmask_t rcModeActivationMask;
 
 void mspSerialAllocatePorts(void) {}
-uint32_t getArmingBeepTimeMicros(void) {return 0;}
+uint32_t getArmingBeepTimeMicros(void) {return armingBeepTimeUs;}
 uint16_t getBatteryVoltageLatest(void) {return 0;}
 bool hasServos(void) { return false; }
 uint8_t getMotorCount(void) {return 4;}
 bool areMotorsRunning(void) { return false; }
 bool IS_RC_MODE_ACTIVE(boxId_e) {return false;}
 bool isModeActivationConditionPresent(boxId_e) {return false;}
-uint32_t millis(void) {return 0;}
+uint32_t millis(void) {return testMillis;}
 bool sensors(uint32_t) {return false;}
-void serialWrite(serialPort_t *, uint8_t) {}
-uint32_t serialTxBytesFree(const serialPort_t *) {return 0;}
-bool isSerialTransmitBufferEmpty(const serialPort_t *) {return false;}
+void serialWrite(serialPort_t *, uint8_t ch) {serialOutput.push_back(ch);}
+void serialWriteBuf(serialPort_t *, const uint8_t *data, int count) {serialOutput.insert(serialOutput.end(), data, data + count);}
+uint32_t serialTxBytesFree(const serialPort_t *) {return 4096;}
+bool isSerialTransmitBufferEmpty(const serialPort_t *) {return true;}
 bool featureIsEnabled(uint32_t) {return false;}
 void mspSerialReleasePortIfAllocated(serialPort_t *) {}
-const serialPortConfig_t *findSerialPortConfig(serialPortFunction_e ) {return NULL;}
+static const serialPortConfig_t blackboxPortConfig = { .identifier = SERIAL_PORT_USART1, .blackbox_baudrateIndex = BAUD_2000000 };
+static serialPort_t blackboxSerialPort;
+const serialPortConfig_t *findSerialPortConfig(serialPortFunction_e ) {return &blackboxPortConfig;}
 serialPort_t *findSharedSerialPort(uint16_t , serialPortFunction_e ) {return NULL;}
-serialPort_t *openSerialPort(serialPortIdentifier_e, serialPortFunction_e, serialReceiveCallbackPtr, void *, uint32_t, portMode_e, portOptions_e) {return NULL;}
+serialPort_t *openSerialPort(serialPortIdentifier_e, serialPortFunction_e, serialReceiveCallbackPtr, void *, uint32_t, portMode_e, portOptions_e) {return &blackboxSerialPort;}
 void closeSerialPort(serialPort_t *) {}
 portSharing_e determinePortSharing(const serialPortConfig_t *, serialPortFunction_e ) {return PORTSHARING_UNUSED;}
 failsafePhase_e failsafePhase(void) {return FAILSAFE_IDLE;}
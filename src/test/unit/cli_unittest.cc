@@ -63,6 +63,12 @@ extern "C" {
     void cliSet(const char *cmdName, char *cmdline);
     int cliGetSettingIndex(char *name, uint8_t length);
     void *cliGetValuePointer(const clivalue_t *value);
+    void processCharacter(const char c);
+
+    extern uint16_t commandBatchLine;
+    extern uint16_t commandBatchCommandCount;
+    extern uint16_t commandBatchErrorCount;
+    extern uint16_t commandBatchFirstErrorLine;
 
     const clivalue_t valueTable[] = {
         { .name = "array_unit_test",   .type = VAR_INT8  | MODE_ARRAY  | MASTER_VALUE, .config = { .array = { .length = 3}},                     .pgn = PG_RESERVED_FOR_TESTING_1, .offset = 0 },
@@ -70,6 +76,7 @@ extern "C" {
         { .name = "wos_unit_test",     .type = VAR_UINT8 | MODE_STRING | MASTER_VALUE, .config = { .string = { 0, 16, STRING_FLAGS_WRITEONCE }}, .pgn = PG_RESERVED_FOR_TESTING_1, .offset = 0 },
     };
     const uint16_t valueTableEntryCount = ARRAYLEN(valueTable);
+    uint16_t valueTableNameIndex[ARRAYLEN(valueTable)];
     const lookupTableEntry_t lookupTables[] = {};
     const char * const lookupTableOsdDisplayPortDevice[] = {};
     const char * const buildKey = NULL;
@@ -98,7 +105,7 @@ extern "C" {
     PG_REGISTER(gpsConfig_t, gpsConfig, PG_GPS_CONFIG, 0);
     PG_REGISTER(gpsRescueConfig_t, gpsRescueConfig, PG_GPS_RESCUE, 0);
 
-    PG_REGISTER_WITH_RESET_FN(int8_t, unitTestData, PG_RESERVED_FOR_TESTING_1, 0);
+    PG_REGISTER_ARRAY_WITH_RESET_FN(int8_t, 16, unitTestData, PG_RESERVED_FOR_TESTING_1, 0);
 }
 
 #include "unittest_macros.h"
@@ -106,6 +113,30 @@ extern "C" {
 
 const bool PRINT_TEST_DATA = false;
 
+static int readEEPROMCount;
+
+static void processInput(const char *input)
+{
+    cliMode = true;
+    while (*input) {
+        processCharacter(*input++);
+    }
+}
+
+TEST(CLIUnittest, TestCliGetSettingIndex)
+{
+    for (uint16_t i = 0; i < valueTableEntryCount; i++) {
+        EXPECT_EQ(i, cliGetSettingIndex((char *)valueTable[i].name, strlen(valueTable[i].name)));
+    }
+
+    // only exact, case insensitive, matches are found
+    EXPECT_EQ(1, cliGetSettingIndex((char *)"STR_Unit_Test = 1", 13));
+    EXPECT_EQ(valueTableEntryCount, cliGetSettingIndex((char *)"str_unit", 8));
+    EXPECT_EQ(valueTableEntryCount, cliGetSettingIndex((char *)"str_unit_test_", 14));
+    EXPECT_EQ(valueTableEntryCount, cliGetSettingIndex((char *)"aaa", 3));
+    EXPECT_EQ(valueTableEntryCount, cliGetSettingIndex((char *)"zzz", 3));
+}
+
 TEST(CLIUnittest, TestCliSetArray)
 {
     char *str = (char *)"array_unit_test    =   123,  -3  , 1";
@@ -206,6 +237,49 @@ TEST(CLIUnittest, TestCliSetStringWriteOnce)
     EXPECT_EQ(0,   data[6]);
 }
 
+TEST(CLIUnittest, TestCliBatchSuccess)
+{
+    readEEPROMCount = 0;
+    processInput(
+        "batch start quiet\n"
+        "set array_unit_test = 1,2,3\n"
+        "set str_unit_test = BATCH\n");
+
+    EXPECT_EQ(2, commandBatchCommandCount);
+    EXPECT_EQ(0, commandBatchErrorCount);
+
+    processInput("batch end\n");
+    EXPECT_EQ(0, readEEPROMCount);
+}
+
+TEST(CLIUnittest, TestCliBatchErrors)
+{
+    readEEPROMCount = 0;
+    // an unsaved change from before the batch
+    processInput("set array_unit_test = 1,2,3\r\n");
+    processInput(
+        "batch start quiet\r\n"
+        // lines are numbered from the one after "batch start"
+        "# comment lines and blank lines are counted\r\n"
+        "\r\n"
+        "set array_unit_test = 4,5,6\r\n"
+        "set no_such_setting = 1\r\n"
+        "set array_unit_test = 7,8,9\r\n"
+        // prints two error lines, but is only one failed command
+        "set str_unit_test = THIS_STRING_IS_TOO_LONG\r\n");
+
+    EXPECT_EQ(6, commandBatchLine);
+    EXPECT_EQ(4, commandBatchCommandCount);
+    EXPECT_EQ(2, commandBatchErrorCount);
+    EXPECT_EQ(4, commandBatchFirstErrorLine);
+    EXPECT_EQ(7, unitTestData_SystemArray[0]);
+
+    // A failed quiet batch discards its changes, and keeps the ones from before it
+    processInput("batch end\r\n");
+    EXPECT_EQ(0, readEEPROMCount);
+    EXPECT_EQ(1, unitTestData_SystemArray[0]);
+}
+
 // STUBS
 extern "C" {
 
@@ -310,6 +384,7 @@ uint8_t getCurrentControlRateProfileIndex(void){ return 1; }
 void changeControlRateProfile(uint8_t) {}
 void resetAllRxChannelRangeConfigurations(rxChannelRangeConfig_t *) {}
 void writeEEPROM() {}
+bool readEEPROM(void) { readEEPROMCount++; return true; }
 serialPortConfig_t *serialFindPortConfigurationMutable(serialPortIdentifier_e) {return NULL; }
 baudRate_e lookupBaudRateIndex(uint32_t){return BAUD_9600; }
 serialPortUsage_t *findSerialPortUsageByIdentifier(serialPortIdentifier_e){ return NULL; }
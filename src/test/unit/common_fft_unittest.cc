@@ -0,0 +1,169 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <math.h>
+
+extern "C" {
+    #include "common/fft.h"
+    #include "common/goertzel.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static void fillTone(float *samples, int count, float bin, int size)
+{
+    for (int i = 0; i < count; i++) {
+        samples[i] = sinf(2.0f * (float)M_PI * bin * i / size);
+    }
+}
+
+static int peakBin(const float *data, int startBin, int endBin)
+{
+    int peak = startBin;
+    for (int i = startBin; i <= endBin; i++) {
+        if (data[i] > data[peak]) {
+            peak = i;
+        }
+    }
+    return peak;
+}
+
+TEST(FftUnittest, TestFftInitSize)
+{
+    fft_t fft;
+
+    fftInit(&fft, 128);
+    EXPECT_EQ(128, fft.size);
+    EXPECT_EQ(7, fft.log2Size);
+    EXPECT_FALSE(fftIsBusy(&fft));
+
+    // sizes are rounded up to the next power of two within limits
+    fftInit(&fft, 100);
+    EXPECT_EQ(128, fft.size);
+    fftInit(&fft, 16);
+    EXPECT_EQ(FFT_SIZE_MIN, fft.size);
+    fftInit(&fft, 4096);
+    EXPECT_EQ(FFT_SIZE_MAX, fft.size);
+}
+
+TEST(FftUnittest, TestFftTonePeak)
+{
+    static fft_t fft;
+    float samples[256];
+    float data[FFT_BIN_COUNT_MAX];
+
+    fillTone(samples, 256, 20.0f, 256);
+
+    fftInit(&fft, 256);
+    fftStart(&fft, samples, 0);
+    EXPECT_TRUE(fftIsBusy(&fft));
+    EXPECT_TRUE(fftStep(&fft, fftOpCount(256)));
+    EXPECT_FALSE(fftIsBusy(&fft));
+
+    fftMagSq(&fft, 1, 127, data);
+    EXPECT_EQ(20, peakBin(data, 1, 127));
+
+    // Hann window leaks into the neighbouring bins only
+    EXPECT_GT(data[19], 100.0f * data[17]);
+    EXPECT_GT(data[21], 100.0f * data[23]);
+}
+
+TEST(FftUnittest, TestFftBudgetedMatchesSingleStep)
+{
+    static fft_t single;
+    static fft_t budgeted;
+    float samples[128];
+
+    for (int i = 0; i < 128; i++) {
+        samples[i] = sinf(0.3f * i) + 0.5f * cosf(1.1f * i);
+    }
+
+    fftInit(&single, 128);
+    fftStart(&single, samples, 37);
+    EXPECT_TRUE(fftStep(&single, fftOpCount(128)));
+
+    fftInit(&budgeted, 128);
+    fftStart(&budgeted, samples, 37);
+    int calls = 1;
+    while (!fftStep(&budgeted, 10)) {
+        calls++;
+    }
+    EXPECT_EQ((fftOpCount(128) + 9) / 10, calls);
+
+    for (int i = 0; i < 128; i++) {
+        EXPECT_FLOAT_EQ(single.re[i], budgeted.re[i]);
+        EXPECT_FLOAT_EQ(single.im[i], budgeted.im[i]);
+    }
+}
+
+TEST(GoertzelUnittest, TestGoertzelTonePeak)
+{
+    static goertzel_t goertzel;
+    float samples[128];
+    float data[GOERTZEL_BIN_COUNT_MAX];
+
+    // 16 bins from bin 10 to bin 40 of a 128 sample block, the tone is on bin 24 (index 7)
+    fillTone(samples, 128, 24.0f, 128);
+    goertzelInit(&goertzel, 10.0f, 2.0f, 16, 128, 3);
+
+    for (int i = 0; i < 128; i++) {
+        EXPECT_FALSE(goertzelIsReady(&goertzel));
+        for (int batch = 0; batch < 3; batch++) {
+            goertzelPushBatch(&goertzel, samples[i], batch);
+        }
+    }
+    EXPECT_TRUE(goertzelIsReady(&goertzel));
+
+    goertzelMagSq(&goertzel, data);
+    EXPECT_FALSE(goertzelIsReady(&goertzel));
+    EXPECT_EQ(7, peakBin(data, 0, 15));
+}
+
+TEST(GoertzelUnittest, TestGoertzelMatchesFft)
+{
+    static fft_t fft;
+    static goertzel_t goertzel;
+    float samples[64];
+    float fftData[FFT_BIN_COUNT_MAX];
+    float goertzelData[GOERTZEL_BIN_COUNT_MAX];
+
+    for (int i = 0; i < 64; i++) {
+        samples[i] = sinf(0.7f * i) + 0.25f * sinf(2.1f * i);
+    }
+
+    fftInit(&fft, 64);
+    fftStart(&fft, samples, 0);
+    fftStep(&fft, fftOpCount(64));
+    fftMagSq(&fft, 1, 31, fftData);
+
+    goertzelInit(&goertzel, 1.0f, 1.0f, 31, 64, 1);
+    for (int i = 0; i < 64; i++) {
+        goertzelPushBatch(&goertzel, samples[i], 0);
+    }
+    goertzelMagSq(&goertzel, goertzelData);
+
+    for (int bin = 1; bin <= 31; bin++) {
+        EXPECT_NEAR(fftData[bin], goertzelData[bin - 1], 1e-3f * fftData[peakBin(fftData, 1, 31)]);
+    }
+}
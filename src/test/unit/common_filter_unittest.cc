@@ -114,3 +114,98 @@ TEST(FilterUnittest, TestSlewFilter)
     slewFilterApply(&filter, 200.0f);
     EXPECT_EQ(200, filter.state);
 }
+
+static const float vec3TestInput[][XYZ_AXIS_COUNT] = {
+    { 1800.0f, -300.0f, 5.0f },
+    { -1800.0f, 250.0f, -5.0f },
+    { -200.0f, 900.0f, 0.0f },
+    { 350.0f, -900.0f, 120.0f },
+    { 0.0f, 0.0f, -120.0f },
+};
+
+TEST(FilterUnittest, TestFilterVec3None)
+{
+    filterVec3_t filter;
+    filterVec3InitNone(&filter);
+
+    float values[XYZ_AXIS_COUNT] = { 1.0f, -2.0f, 3.0f };
+    filterVec3Apply(&filter, values);
+    EXPECT_EQ(1.0f, values[0]);
+    EXPECT_EQ(-2.0f, values[1]);
+    EXPECT_EQ(3.0f, values[2]);
+}
+
+TEST(FilterUnittest, TestFilterVec3MatchesScalarPtN)
+{
+    const float k = pt1FilterGain(100.0f, 0.000125f);
+
+    pt1Filter_t pt1[XYZ_AXIS_COUNT];
+    pt2Filter_t pt2[XYZ_AXIS_COUNT];
+    pt3Filter_t pt3[XYZ_AXIS_COUNT];
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        pt1FilterInit(&pt1[axis], k);
+        pt2FilterInit(&pt2[axis], k);
+        pt3FilterInit(&pt3[axis], k);
+    }
+
+    filterVec3_t pt1Vec3, pt2Vec3, pt3Vec3;
+    filterVec3InitPt1(&pt1Vec3, k);
+    filterVec3InitPt2(&pt2Vec3, k);
+    filterVec3InitPt3(&pt3Vec3, k);
+
+    for (const auto &input : vec3TestInput) {
+        float pt1Values[XYZ_AXIS_COUNT], pt2Values[XYZ_AXIS_COUNT], pt3Values[XYZ_AXIS_COUNT];
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            pt1Values[axis] = pt2Values[axis] = pt3Values[axis] = input[axis];
+        }
+        filterVec3Apply(&pt1Vec3, pt1Values);
+        filterVec3Apply(&pt2Vec3, pt2Values);
+        filterVec3Apply(&pt3Vec3, pt3Values);
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            EXPECT_FLOAT_EQ(pt1FilterApply(&pt1[axis], input[axis]), pt1Values[axis]);
+            EXPECT_FLOAT_EQ(pt2FilterApply(&pt2[axis], input[axis]), pt2Values[axis]);
+            EXPECT_FLOAT_EQ(pt3FilterApply(&pt3[axis], input[axis]), pt3Values[axis]);
+        }
+    }
+}
+
+TEST(FilterUnittest, TestFilterVec3MatchesScalarBiquad)
+{
+    const uint32_t looptimeUs = 125;
+    const float notchQ = filterGetNotchQ(260.0f, 160.0f);
+
+    biquadFilter_t notch[XYZ_AXIS_COUNT];
+    biquadFilter_t lowpass[XYZ_AXIS_COUNT];
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        biquadFilterInit(&notch[axis], 260.0f, looptimeUs, notchQ, FILTER_NOTCH, 1.0f);
+        biquadFilterInitLPF(&lowpass[axis], 150.0f, looptimeUs);
+    }
+
+    filterVec3_t notchVec3, lowpassVec3;
+    filterVec3InitBiquad(&notchVec3, 260.0f, looptimeUs, notchQ, FILTER_NOTCH, false);
+    filterVec3InitBiquadLPF(&lowpassVec3, 150.0f, looptimeUs, true);
+
+    for (const auto &input : vec3TestInput) {
+        float notchValues[XYZ_AXIS_COUNT], lowpassValues[XYZ_AXIS_COUNT];
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            notchValues[axis] = lowpassValues[axis] = input[axis];
+        }
+        filterVec3Apply(&notchVec3, notchValues);
+        filterVec3Apply(&lowpassVec3, lowpassValues);
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            EXPECT_FLOAT_EQ(biquadFilterApply(&notch[axis], input[axis]), notchValues[axis]);
+            EXPECT_FLOAT_EQ(biquadFilterApplyDF1(&lowpass[axis], input[axis]), lowpassValues[axis]);
+        }
+    }
+
+    // coefficient updates keep the filter state, as with biquadFilterUpdateLPF()
+    biquadFilterVec3UpdateLPF(&lowpassVec3.biquad, 300.0f, looptimeUs);
+    float values[XYZ_AXIS_COUNT] = { 10.0f, 20.0f, 30.0f };
+    filterVec3Apply(&lowpassVec3, values);
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        biquadFilterUpdateLPF(&lowpass[axis], 300.0f, looptimeUs);
+        EXPECT_FLOAT_EQ(biquadFilterApplyDF1(&lowpass[axis], 10.0f * (axis + 1)), values[axis]);
+    }
+}
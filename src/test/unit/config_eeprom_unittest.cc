@@ -0,0 +1,168 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/utils.h"
+
+    #include "config/config_eeprom.h"
+    #include "config/config_streamer.h"
+
+    #include "drivers/system.h"
+
+    #include "pg/pg.h"
+    #include "pg/pg_ids.h"
+
+    typedef struct smallConfig_s {
+        uint8_t value;
+    } smallConfig_t;
+
+    typedef struct largeConfig_s {
+        uint8_t values[100];
+    } largeConfig_t;
+
+    PG_DECLARE(smallConfig_t, smallConfig);
+    PG_DECLARE(largeConfig_t, largeConfig);
+
+    PG_REGISTER(smallConfig_t, smallConfig, PG_RESERVED_FOR_TESTING_1, 0);
+    PG_REGISTER(largeConfig_t, largeConfig, PG_RESERVED_FOR_TESTING_2, 0);
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static void resetStore(void)
+{
+    memset(eepromData, 0, sizeof(eepromData));
+    smallConfigMutable()->value = 1;
+    memset(largeConfigMutable()->values, 1, sizeof(largeConfig()->values));
+    writeConfigToEEPROM();
+}
+
+TEST(ConfigEepromUnittest, TestFullWrite)
+{
+    resetStore();
+
+    EXPECT_TRUE(isEEPROMVersionValid());
+    EXPECT_TRUE(isEEPROMStructureValid());
+
+    smallConfigMutable()->value = 0;
+    largeConfigMutable()->values[50] = 0;
+    EXPECT_TRUE(loadEEPROM());
+    EXPECT_EQ(1, smallConfig()->value);
+    EXPECT_EQ(1, largeConfig()->values[50]);
+}
+
+TEST(ConfigEepromUnittest, TestOnlyChangedGroupIsAppended)
+{
+    resetStore();
+    const uint16_t fullSize = getEEPROMConfigSize();
+    uint8_t before[EEPROM_SIZE];
+    memcpy(before, eepromData, sizeof(before));
+
+    smallConfigMutable()->value = 2;
+    writeConfigToEEPROM();
+
+    // The image written before is untouched, one small record follows it
+    EXPECT_EQ(0, memcmp(before, eepromData, fullSize));
+    EXPECT_EQ(fullSize + CONFIG_STREAMER_BUFFER_SIZE, getEEPROMConfigSize());
+
+    // Saving again without changes writes nothing
+    const uint16_t appendedSize = getEEPROMConfigSize();
+    writeConfigToEEPROM();
+    EXPECT_EQ(appendedSize, getEEPROMConfigSize());
+
+    smallConfigMutable()->value = 3;
+    writeConfigToEEPROM();
+
+    smallConfigMutable()->value = 0;
+    EXPECT_TRUE(isEEPROMStructureValid());
+    EXPECT_TRUE(loadEEPROM());
+    EXPECT_EQ(3, smallConfig()->value);
+    EXPECT_EQ(1, largeConfig()->values[50]);
+}
+
+TEST(ConfigEepromUnittest, TestCompactionWhenFull)
+{
+    resetStore();
+    const uint16_t fullSize = getEEPROMConfigSize();
+
+    uint8_t value = 0;
+    bool compacted = false;
+    for (int i = 0; i < 20 && !compacted; i++) {
+        const uint16_t previousSize = getEEPROMConfigSize();
+        largeConfigMutable()->values[0] = ++value;
+        writeConfigToEEPROM();
+        compacted = getEEPROMConfigSize() < previousSize;
+    }
+    EXPECT_TRUE(compacted);
+    EXPECT_EQ(fullSize, getEEPROMConfigSize());
+
+    largeConfigMutable()->values[0] = 0;
+    EXPECT_TRUE(isEEPROMStructureValid());
+    EXPECT_TRUE(loadEEPROM());
+    EXPECT_EQ(value, largeConfig()->values[0]);
+}
+
+TEST(ConfigEepromUnittest, TestStaleRecordsIgnored)
+{
+    resetStore();
+    const uint16_t fullSize = getEEPROMConfigSize();
+    smallConfigMutable()->value = 2;
+    writeConfigToEEPROM();
+    uint8_t withRecord[EEPROM_SIZE];
+    memcpy(withRecord, eepromData, sizeof(withRecord));
+    smallConfigMutable()->value = 1;
+
+    // Fill the store up, then compact back to exactly the image the record was appended to
+    for (int i = 0; getEEPROMConfigSize() + sizeof(largeConfig_t) <= EEPROM_SIZE; i++) {
+        largeConfigMutable()->values[0] = 2 + (i & 1);
+        writeConfigToEEPROM();
+    }
+    const uint16_t previousSize = getEEPROMConfigSize();
+    largeConfigMutable()->values[0] = 1;
+    writeConfigToEEPROM();
+    EXPECT_GT(previousSize, getEEPROMConfigSize());
+
+    // On flash the old record would still follow it, it must not come back
+    memcpy(eepromData + fullSize, withRecord + fullSize, sizeof(eepromData) - fullSize);
+
+    smallConfigMutable()->value = 0;
+    EXPECT_TRUE(isEEPROMStructureValid());
+    EXPECT_EQ(fullSize, getEEPROMConfigSize());
+    EXPECT_TRUE(loadEEPROM());
+    EXPECT_EQ(1, smallConfig()->value);
+}
+
+// STUBS
+
+extern "C" {
+    void failureMode(failureMode_e mode)
+    {
+        UNUSED(mode);
+        FAIL();
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/crc.h"
+    #include "common/utils.h"
+    #include "common/streambuf.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static const uint8_t checkData[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+// Bit serial reference implementations
+static uint16_t crc16CcittReference(uint16_t crc, const uint8_t *data, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint8_t crc8Reference(uint8_t crc, const uint8_t *data, uint32_t length, uint8_t poly)
+{
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (crc << 1) ^ poly : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static void fillPseudoRandom(uint8_t *data, uint32_t length)
+{
+    uint32_t state = 0x12345678;
+    for (uint32_t i = 0; i < length; i++) {
+        state = state * 1664525 + 1013904223;
+        data[i] = state >> 24;
+    }
+}
+
+TEST(CrcUnittest, TestCheckValues)
+{
+    // CRC-16/XMODEM and CRC-8/DVB-S2 check values
+    EXPECT_EQ(0x31C3, crc16_ccitt_update(0, checkData, sizeof(checkData)));
+    EXPECT_EQ(0xBC, crc8_dvb_s2_update(0, checkData, sizeof(checkData)));
+
+    uint16_t crc16 = 0;
+    uint8_t crc8 = 0;
+    for (unsigned i = 0; i < sizeof(checkData); i++) {
+        crc16 = crc16_ccitt(crc16, checkData[i]);
+        crc8 = crc8_dvb_s2(crc8, checkData[i]);
+    }
+    EXPECT_EQ(0x31C3, crc16);
+    EXPECT_EQ(0xBC, crc8);
+}
+
+TEST(CrcUnittest, TestCrc16MatchesReference)
+{
+    uint8_t data[300];
+    fillPseudoRandom(data, sizeof(data));
+
+    // Every length and alignment around the slice size, with non zero initial CRCs
+    for (uint32_t offset = 0; offset < 8; offset++) {
+        for (uint32_t length = 0; length < 40; length++) {
+            const uint16_t initial = offset * 0x1357;
+            EXPECT_EQ(crc16CcittReference(initial, data + offset, length), crc16_ccitt_update(initial, data + offset, length));
+        }
+    }
+    EXPECT_EQ(crc16CcittReference(0xFFFF, data, sizeof(data)), crc16_ccitt_update(0xFFFF, data, sizeof(data)));
+}
+
+TEST(CrcUnittest, TestCrc8MatchesReference)
+{
+    uint8_t data[300];
+    fillPseudoRandom(data, sizeof(data));
+
+    // 0xD5 and 0xBA use tables, 0x07 the bit serial engine
+    const uint8_t polys[] = { 0xD5, 0xBA, 0x07 };
+    for (unsigned i = 0; i < ARRAYLEN(polys); i++) {
+        for (uint32_t offset = 0; offset < 8; offset++) {
+            for (uint32_t length = 0; length < 40; length++) {
+                const uint8_t initial = offset * 0x35;
+                EXPECT_EQ(crc8Reference(initial, data + offset, length, polys[i]), crc8_update(initial, data + offset, length, polys[i]));
+            }
+        }
+        EXPECT_EQ(crc8Reference(0, data, sizeof(data), polys[i]), crc8_update(0, data, sizeof(data), polys[i]));
+        EXPECT_EQ(crc8Reference(0x5A, data, 1, polys[i]), crc8_calc(0x5A, data[0], polys[i]));
+    }
+}
+
+TEST(CrcUnittest, TestSbufAppend)
+{
+    uint8_t buf[32];
+    sbuf_t sbuf;
+    sbufInit(&sbuf, buf, buf + sizeof(buf));
+    sbufWriteData(&sbuf, checkData, sizeof(checkData));
+    crc16_ccitt_sbuf_append(&sbuf, buf);
+    EXPECT_EQ(0xC3, buf[sizeof(checkData)]);
+    EXPECT_EQ(0x31, buf[sizeof(checkData) + 1]);
+
+    crc8_dvb_s2_sbuf_append(&sbuf, buf);
+    EXPECT_EQ(crc8Reference(0, buf, sizeof(checkData) + 2, 0xD5), buf[sizeof(checkData) + 2]);
+}
@@ -0,0 +1,202 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "drivers/display.h"
+    #include "drivers/osd.h"
+
+    #include "io/displayport_msp.h"
+
+    #include "msp/msp.h"
+    #include "msp/msp_protocol.h"
+
+    #include "osd/osd.h"
+
+    #include "pg/pg.h"
+    #include "pg/pg_ids.h"
+    #include "pg/vcd.h"
+
+    PG_REGISTER(osdConfig_t, osdConfig, PG_OSD_CONFIG, 0);
+    PG_REGISTER(vcdProfile_t, vcdProfile, PG_VCD_CONFIG, 0);
+    PG_REGISTER(displayPortProfile_t, displayPortProfileMsp, PG_DISPLAY_PORT_MSP_CONFIG, 0);
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+// The MSP_DISPLAYPORT packets pushed, as strings
+static std::vector<std::string> packets;
+static bool txFull;
+
+static displayPort_t *displayPort;
+
+static std::string writeString(int row, int col, const char *text)
+{
+    std::string packet = { MSP_DP_WRITE_STRING, (char)row, (char)col, 0 };
+    return packet + text;
+}
+
+static void initDisplayPort(void)
+{
+    osdConfigMutable()->canvas_cols = OSD_HD_COLS;
+    osdConfigMutable()->canvas_rows = OSD_HD_ROWS;
+    vcdProfileMutable()->video_system = VIDEO_SYSTEM_HD;
+
+    displayPort = displayPortMspInit();
+    packets.clear();
+}
+
+static void commit(void)
+{
+    packets.clear();
+    displayCommitTransaction(displayPort);
+}
+
+TEST(DisplayPortMspUnittest, TestInitClearsDisplay)
+{
+    osdConfigMutable()->canvas_cols = OSD_HD_COLS;
+    osdConfigMutable()->canvas_rows = OSD_HD_ROWS;
+    vcdProfileMutable()->video_system = VIDEO_SYSTEM_HD;
+
+    packets.clear();
+    displayPort = displayPortMspInit();
+
+    ASSERT_LE(2U, packets.size());
+    EXPECT_EQ(std::string(1, MSP_DP_CLEAR_SCREEN), packets[packets.size() - 2]);
+    EXPECT_EQ(std::string(1, MSP_DP_DRAW_SCREEN), packets.back());
+}
+
+TEST(DisplayPortMspUnittest, TestOnlyChangesAreSent)
+{
+    initDisplayPort();
+
+    displayClearScreen(displayPort, DISPLAY_CLEAR_NONE);
+    displayWrite(displayPort, 1, 2, DISPLAYPORT_SEVERITY_NORMAL, "ALT 12");
+    commit();
+    ASSERT_EQ(1U, packets.size());
+    EXPECT_EQ(writeString(2, 1, "ALT 12"), packets[0]);
+
+    // The OSD clears and redraws everything every refresh, unchanged text isn't sent again
+    displayClearScreen(displayPort, DISPLAY_CLEAR_NONE);
+    displayWrite(displayPort, 1, 2, DISPLAYPORT_SEVERITY_NORMAL, "ALT 12");
+    commit();
+    EXPECT_EQ(0U, packets.size());
+
+    displayClearScreen(displayPort, DISPLAY_CLEAR_NONE);
+    displayWrite(displayPort, 1, 2, DISPLAYPORT_SEVERITY_NORMAL, "ALT 13");
+    commit();
+    ASSERT_EQ(1U, packets.size());
+    EXPECT_EQ(writeString(2, 6, "3"), packets[0]);
+
+    // Text no longer drawn is erased
+    displayClearScreen(displayPort, DISPLAY_CLEAR_NONE);
+    commit();
+    ASSERT_EQ(1U, packets.size());
+    EXPECT_EQ(writeString(2, 1, "      "), packets[0]);
+}
+
+TEST(DisplayPortMspUnittest, TestNearbyChangesAreCoalesced)
+{
+    initDisplayPort();
+
+    displayClearScreen(displayPort, DISPLAY_CLEAR_NONE);
+    displayWrite(displayPort, 0, 5, DISPLAYPORT_SEVERITY_NORMAL, "A   B");
+    displayWrite(displayPort, 40, 5, DISPLAYPORT_SEVERITY_NORMAL, "C");
+    commit();
+
+    // A short gap is sent along, a long one starts a new packet
+    ASSERT_EQ(2U, packets.size());
+    EXPECT_EQ(writeString(5, 0, "A   B"), packets[0]);
+    EXPECT_EQ(writeString(5, 40, "C"), packets[1]);
+}
+
+TEST(DisplayPortMspUnittest, TestDroppedWritesAreRetried)
+{
+    initDisplayPort();
+
+    displayClearScreen(displayPort, DISPLAY_CLEAR_NONE);
+    displayWrite(displayPort, 3, 4, DISPLAYPORT_SEVERITY_NORMAL, "V");
+    txFull = true;
+    commit();
+    txFull = false;
+    EXPECT_EQ(0U, packets.size());
+
+    commit();
+    ASSERT_EQ(1U, packets.size());
+    EXPECT_EQ(writeString(4, 3, "V"), packets[0]);
+}
+
+TEST(DisplayPortMspUnittest, TestRedrawResendsEverything)
+{
+    initDisplayPort();
+
+    displayClearScreen(displayPort, DISPLAY_CLEAR_NONE);
+    displayWrite(displayPort, 3, 7, DISPLAYPORT_SEVERITY_NORMAL, "GPS");
+    commit();
+
+    packets.clear();
+    displayRedraw(displayPort);
+    ASSERT_EQ(3U, packets.size());
+    EXPECT_EQ(std::string(1, MSP_DP_CLEAR_SCREEN), packets[0]);
+    EXPECT_EQ(writeString(7, 3, "GPS"), packets[1]);
+    EXPECT_EQ(std::string(1, MSP_DP_DRAW_SCREEN), packets[2]);
+}
+
+TEST(DisplayPortMspUnittest, TestRowsAreRefreshedInTurn)
+{
+    initDisplayPort();
+
+    displayClearScreen(displayPort, DISPLAY_CLEAR_NONE);
+    displayWrite(displayPort, 0, 0, DISPLAYPORT_SEVERITY_NORMAL, "X");
+    commit();
+
+    // Unchanged text is sent again once every rows updates, for a display that connected late
+    int resent = 0;
+    for (int i = 0; i < OSD_HD_ROWS; i++) {
+        commit();
+        resent += packets.size();
+    }
+    EXPECT_EQ(1, resent);
+}
+
+// STUBS
+
+extern "C" {
+    int mspSerialPush(serialPortIdentifier_e, uint8_t cmd, uint8_t *data, int datalen, mspDirection_e, mspVersion_e)
+    {
+        EXPECT_EQ(MSP_DISPLAYPORT, cmd);
+        if (txFull) {
+            return 0;
+        }
+        packets.push_back(std::string((const char *)data, datalen));
+        return datalen + 6;
+    }
+
+    uint32_t mspSerialTxBytesFree(void) { return 256; }
+}
@@ -0,0 +1,206 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "build/debug.h"
+
+    #include "common/utils.h"
+
+    #include "drivers/dshot.h"
+    #include "drivers/dshot_bitbang_decode.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define TEST_BUFFER_LENGTH 140
+
+static uint16_t portBuffer[TEST_BUFFER_LENGTH];
+
+// Returns the 21 bit line code of a telemetry value, the leading 1 is the start bit
+static uint32_t encodeTelemetry(uint16_t value)
+{
+    static const uint8_t gcr[16] = {
+        0x19, 0x1b, 0x12, 0x13, 0x1d, 0x15, 0x16, 0x17, 0x1a, 0x09, 0x0a, 0x0b, 0x1e, 0x0d, 0x0e, 0x0f };
+
+    const uint16_t csum = (~(value ^ (value >> 4) ^ (value >> 8))) & 0xf;
+    const uint16_t word = (value << 4) | csum;
+
+    uint32_t code = 1;
+    for (int nibble = 3; nibble >= 0; nibble--) {
+        code = (code << 5) | gcr[(word >> (4 * nibble)) & 0xf];
+    }
+    return code;
+}
+
+// Writes the inverted DShot response of one pin, a 1 in the line code is a transition. samplesPerBit
+// cycles through the given pattern to imitate the jitter of the 3x oversampling.
+static void writePin(unsigned pin, uint32_t lead, uint16_t value, const uint8_t *samplesPerBit, unsigned pattern)
+{
+    const uint32_t code = encodeTelemetry(value);
+    bool level = true;
+    uint32_t index = 0;
+
+    for (; index < lead; index++) {
+        portBuffer[index] |= 1 << pin;
+    }
+    for (int bit = 20; bit >= 0; bit--) {
+        if (code & (1 << bit)) {
+            level = !level;
+        }
+        const unsigned samples = samplesPerBit[bit % pattern];
+        for (unsigned i = 0; i < samples && index < TEST_BUFFER_LENGTH; i++, index++) {
+            if (level) {
+                portBuffer[index] |= 1 << pin;
+            }
+        }
+    }
+    // Back to idle
+    for (; index < TEST_BUFFER_LENGTH; index++) {
+        portBuffer[index] |= 1 << pin;
+    }
+}
+
+#ifdef USE_DSHOT_BITBAND
+// Emulated bit-band alias of portBuffer, one word per bit of each sample. The unrolled edge search may read a few samples past the end.
+static uint32_t bitBandBuffer[(TEST_BUFFER_LENGTH + 4) * DSHOT_BB_DECODE_PIN_COUNT];
+#endif
+
+// The per pin decoder of the target, decode_bb_port() has to match it
+static uint32_t decodePin(unsigned pin)
+{
+#ifdef USE_DSHOT_BITBAND
+    return decode_bb_bitband(portBuffer, TEST_BUFFER_LENGTH, pin);
+#else
+    return decode_bb(portBuffer, TEST_BUFFER_LENGTH, pin);
+#endif
+}
+
+static void idlePin(unsigned pin)
+{
+    for (unsigned i = 0; i < TEST_BUFFER_LENGTH; i++) {
+        portBuffer[i] |= 1 << pin;
+    }
+}
+
+class DshotBitbangDecodeTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        // A frame starting at the beginning of the buffer leaves no preamble to skip
+        memset(portBuffer, 0, sizeof(portBuffer));
+        static const uint8_t exact[] = { 3 };
+        writePin(0, 0, 0x123, exact, 1);
+        decodePin(0);
+
+        memset(portBuffer, 0, sizeof(portBuffer));
+    }
+};
+
+TEST_F(DshotBitbangDecodeTest, TestSinglePin)
+{
+    static const uint8_t exact[] = { 3 };
+    writePin(5, 10, 0x2a7, exact, 1);
+    idlePin(2);
+
+    EXPECT_EQ(0x2a7U, decodePin(5));
+
+    uint32_t values[DSHOT_BB_DECODE_PIN_COUNT];
+    values[2] = 0;
+    values[6] = 0;
+    decode_bb_port(portBuffer, TEST_BUFFER_LENGTH, (1 << 5) | (1 << 2), values);
+    EXPECT_EQ(0x2a7U, values[5]);
+    // An idle line has no start bit
+    EXPECT_EQ((uint32_t)DSHOT_TELEMETRY_NOEDGE, values[2]);
+    // Pins not asked for are left alone
+    EXPECT_EQ(0U, values[6]);
+}
+
+TEST_F(DshotBitbangDecodeTest, TestFourMotorsWithJitter)
+{
+    static const uint8_t jitter[] = { 3, 3, 2, 3, 4, 3, 3 };
+    static const uint16_t telemetry[] = { 0x0e00, 0x1ff, 0x6a5, 0xfff };
+    static const unsigned pins[] = { 0, 3, 8, 15 };
+
+    for (unsigned motor = 0; motor < ARRAYLEN(pins); motor++) {
+        writePin(pins[motor], 8 + 3 * motor, telemetry[motor], jitter + motor, ARRAYLEN(jitter) - motor);
+    }
+
+    uint32_t values[DSHOT_BB_DECODE_PIN_COUNT];
+    decode_bb_port(portBuffer, TEST_BUFFER_LENGTH, (1 << 0) | (1 << 3) | (1 << 8) | (1 << 15), values);
+
+    for (unsigned motor = 0; motor < ARRAYLEN(pins); motor++) {
+        EXPECT_EQ(telemetry[motor], values[pins[motor]]);
+    }
+}
+
+TEST_F(DshotBitbangDecodeTest, TestMatchesSinglePinDecoder)
+{
+    // Corrupted and late frames on all 16 pins must decode as the per pin decoder does
+    uint32_t state = 0x12345678;
+    for (int round = 0; round < 200; round++) {
+        memset(portBuffer, 0, sizeof(portBuffer));
+        for (unsigned pin = 0; pin < DSHOT_BB_DECODE_PIN_COUNT; pin++) {
+            state = state * 1664525 + 1013904223;
+            const uint8_t jitter[] = { 3, (uint8_t)(2 + ((state >> 8) & 3)), 3, (uint8_t)(2 + ((state >> 10) & 1)) };
+            writePin(pin, (state >> 12) % 80, (state >> 20) & 0xfff, jitter, ARRAYLEN(jitter));
+            if (state & 0x10) {
+                portBuffer[(state >> 5) % TEST_BUFFER_LENGTH] ^= 1 << pin;
+            }
+        }
+
+        uint32_t values[DSHOT_BB_DECODE_PIN_COUNT];
+        decode_bb_port(portBuffer, TEST_BUFFER_LENGTH, 0xffff, values);
+
+        for (unsigned pin = 0; pin < DSHOT_BB_DECODE_PIN_COUNT; pin++) {
+            EXPECT_EQ(decodePin(pin), values[pin]) << "round " << round << " pin " << pin;
+        }
+    }
+}
+
+// STUBS
+
+extern "C" {
+    int16_t debug[DEBUG16_VALUE_COUNT];
+    uint8_t debugMode;
+
+    uint32_t micros(void) { return 0; }
+
+#ifdef USE_DSHOT_BITBAND
+    uint32_t *bitBandAlias(uint16_t buffer[], uint32_t bit)
+    {
+        memset(bitBandBuffer, 0, sizeof(bitBandBuffer));
+        for (unsigned i = 0; i < TEST_BUFFER_LENGTH; i++) {
+            for (unsigned pin = 0; pin < DSHOT_BB_DECODE_PIN_COUNT; pin++) {
+                bitBandBuffer[i * DSHOT_BB_DECODE_PIN_COUNT + pin] = (buffer[i] >> pin) & 1;
+            }
+        }
+        return &bitBandBuffer[bit];
+    }
+#endif
+}
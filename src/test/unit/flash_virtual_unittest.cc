@@ -0,0 +1,380 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <string.h>
+#include <unistd.h>
+
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "build/debug.h"
+
+    #include "drivers/flash/flash.h"
+    #include "drivers/flash/flash_virtual.h"
+
+    #include "io/flashfs.h"
+
+    #include "pg/flash.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define TEST_FLASH_FILENAME "flash_virtual_unittest.bin"
+
+// Time only passes on explicit delays, as in SITL lockstep mode
+static uint32_t cycleCounter;
+
+static std::vector<uint8_t> testData(uint32_t length)
+{
+    std::vector<uint8_t> data(length);
+    uint32_t state = 0x12345678;
+    for (uint32_t i = 0; i < length; i++) {
+        state = state * 1664525 + 1013904223;
+        data[i] = state >> 24;
+    }
+    return data;
+}
+
+static void initFlash(const char *geometry, const char *timing)
+{
+    static const flashConfig_t config = { 0 };
+
+    ASSERT_TRUE(virtualFlashSetGeometry(geometry));
+    ASSERT_TRUE(virtualFlashSetTiming(timing));
+    ASSERT_TRUE(flashInit(&config));
+    flashfsInit();
+}
+
+// Log data the way blackbox does, asynchronously while the flash is busy
+static void logData(const std::vector<uint8_t> &data)
+{
+    const uint32_t chunk = 32;
+    for (uint32_t i = 0; i < data.size(); i += chunk) {
+        const uint32_t len = std::min<uint32_t>(chunk, data.size() - i);
+        while (flashfsGetWriteBufferFreeSpace() < len) {
+            cycleCounter += 50;
+            flashfsFlushAsync(false);
+        }
+        flashfsWrite(&data[i], len, false);
+    }
+    flashfsFlushSync();
+}
+
+// Log frames the way blackbox does at a fixed rate, without waiting for the flash
+static void logFrames(const std::vector<uint8_t> &data, uint32_t frameLen, uint32_t frameIntervalUs)
+{
+    for (uint32_t i = 0; i < data.size(); i += frameLen) {
+        cycleCounter += frameIntervalUs;
+        flashfsWrite(&data[i], std::min<uint32_t>(frameLen, data.size() - i), false);
+        flashfsFlushAsync(false);
+    }
+    flashfsFlushSync();
+}
+
+static std::vector<uint8_t> readFile(uint32_t offset, uint32_t length)
+{
+    std::vector<uint8_t> data(length);
+    FILE *fd = fopen(TEST_FLASH_FILENAME, "rb");
+    EXPECT_NE(nullptr, fd);
+    if (fd) {
+        fseek(fd, offset, SEEK_SET);
+        EXPECT_EQ(length, fread(data.data(), 1, length, fd));
+        fclose(fd);
+    }
+    return data;
+}
+
+class VirtualFlashTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        unlink(TEST_FLASH_FILENAME);
+        virtualFlashSetFile(TEST_FLASH_FILENAME);
+        virtualFlashResetStats();
+        cycleCounter = 0;
+    }
+
+    virtual void TearDown()
+    {
+        virtualFlashClose();
+        unlink(TEST_FLASH_FILENAME);
+    }
+};
+
+TEST_F(VirtualFlashTest, TestGeometry)
+{
+    EXPECT_FALSE(virtualFlashSetGeometry("255,16,64"));
+    EXPECT_FALSE(virtualFlashSetGeometry("4096,16,64"));
+    EXPECT_FALSE(virtualFlashSetGeometry("256,0,64"));
+    EXPECT_FALSE(virtualFlashSetGeometry("256,16,64,flash"));
+    EXPECT_FALSE(virtualFlashSetGeometry("256"));
+    EXPECT_FALSE(virtualFlashSetTiming("700"));
+
+    initFlash("256,16,64", "700,1000");
+
+    const flashGeometry_t *geometry = flashGetGeometry();
+    EXPECT_EQ(FLASH_TYPE_NOR, geometry->flashType);
+    EXPECT_EQ(256, geometry->pageSize);
+    EXPECT_EQ(16, geometry->pagesPerSector);
+    EXPECT_EQ(64, geometry->sectors);
+    EXPECT_EQ(256U * 16, geometry->sectorSize);
+    EXPECT_EQ(256U * 16 * 64, geometry->totalSize);
+
+    // A new file is created erased
+    EXPECT_EQ(geometry->totalSize, flashfsGetSize());
+    EXPECT_EQ(0U, flashfsGetOffset());
+    const std::vector<uint8_t> file = readFile(0, geometry->totalSize);
+    EXPECT_EQ(std::vector<uint8_t>(geometry->totalSize, 0xff), file);
+}
+
+TEST_F(VirtualFlashTest, TestNoChipUnlessRequested)
+{
+    static const flashConfig_t config = { 0 };
+
+    virtualFlashSetFile(NULL);
+    EXPECT_FALSE(flashInit(&config));
+
+    // A geometry alone adds the chip, backed by the default file
+    EXPECT_TRUE(virtualFlashSetGeometry("256,16,64"));
+    EXPECT_TRUE(flashInit(&config));
+    EXPECT_EQ(0, access(VIRTUAL_FLASH_FILENAME, F_OK));
+
+    virtualFlashClose();
+    unlink(VIRTUAL_FLASH_FILENAME);
+}
+
+TEST_F(VirtualFlashTest, TestProgramAndEraseLatency)
+{
+    initFlash("256,16,64", "700,1000");
+
+    const std::vector<uint8_t> data = testData(256);
+    flashPageProgram(0, data.data(), 128, NULL);
+
+    // Half a page takes half the page program time
+    EXPECT_FALSE(flashIsReady());
+    cycleCounter += 300;
+    EXPECT_FALSE(flashIsReady());
+    cycleCounter += 100;
+    EXPECT_TRUE(flashIsReady());
+
+    flashEraseSector(256 * 16);
+    cycleCounter += 900;
+    EXPECT_FALSE(flashIsReady());
+    cycleCounter += 200;
+    EXPECT_TRUE(flashIsReady());
+
+    const virtualFlashStats_t *stats = virtualFlashGetStats();
+    EXPECT_EQ(1U, stats->programCount);
+    EXPECT_EQ(128U, stats->bytesProgrammed);
+    EXPECT_EQ(1U, stats->eraseCount);
+    EXPECT_EQ(350U + 1000, stats->busyUs);
+    EXPECT_GT(stats->busyPolls, 0U);
+}
+
+TEST_F(VirtualFlashTest, TestProgramOnlyClearsBits)
+{
+    initFlash("256,16,64", "1,1");
+
+    const uint8_t high = 0xf0;
+    const uint8_t low = 0x0f;
+    uint8_t value;
+
+    flashPageProgram(100, &high, 1, NULL);
+    flashReadBytes(100, &value, 1);
+    EXPECT_EQ(0xf0, value);
+
+    flashPageProgram(100, &low, 1, NULL);
+    flashReadBytes(100, &value, 1);
+    EXPECT_EQ(0x00, value);
+
+    flashEraseSector(0);
+    flashReadBytes(100, &value, 1);
+    EXPECT_EQ(0xff, value);
+}
+
+TEST_F(VirtualFlashTest, TestLogAndReadBack)
+{
+    initFlash("256,16,64", "700,1000");
+
+    const std::vector<uint8_t> data = testData(20000);
+    logData(data);
+
+    EXPECT_EQ(data.size(), flashfsGetOffset());
+
+    std::vector<uint8_t> readBack(data.size());
+    for (uint32_t i = 0; i < data.size(); i += 1000) {
+        EXPECT_EQ(1000, flashfsReadAbs(i, &readBack[i], 1000));
+    }
+    EXPECT_EQ(data, readBack);
+    EXPECT_EQ(data, readFile(0, data.size()));
+    EXPECT_EQ(0xff, readFile(data.size(), 1)[0]);
+
+    const virtualFlashStats_t *stats = virtualFlashGetStats();
+    EXPECT_EQ(data.size(), stats->bytesProgrammed);
+    EXPECT_GE(stats->programCount, data.size() / 256);
+    EXPECT_GE(stats->busyUs, 700U * data.size() / 256);
+}
+
+TEST_F(VirtualFlashTest, TestFreeSpaceFoundAfterRestart)
+{
+    initFlash("256,16,64", "700,1000");
+
+    logData(testData(5000));
+    virtualFlashClose();
+
+    initFlash("256,16,64", "700,1000");
+
+    // Free space is found with a granularity of 2kB
+    EXPECT_EQ(6144U, flashfsGetOffset());
+    EXPECT_EQ(testData(5000), readFile(0, 5000));
+}
+
+TEST_F(VirtualFlashTest, TestNandProgramsWholePages)
+{
+    initFlash("2048,4,16,nand", "250,2000");
+    EXPECT_EQ(FLASH_TYPE_NAND, flashGetGeometry()->flashType);
+
+    const std::vector<uint8_t> data = testData(3000);
+    const virtualFlashStats_t *stats = virtualFlashGetStats();
+
+    // A page is programmed as soon as it is complete
+    logData(std::vector<uint8_t>(data.begin(), data.begin() + 2048));
+    EXPECT_EQ(1U, stats->programCount);
+
+    // The incomplete second page is still in the page buffer of the chip
+    logData(std::vector<uint8_t>(data.begin() + 2048, data.end()));
+    EXPECT_EQ(1U, stats->programCount);
+    EXPECT_EQ(250U, stats->busyUs);
+    std::vector<uint8_t> readBack(data.size());
+    flashfsReadAbs(0, readBack.data(), data.size());
+    EXPECT_TRUE(std::equal(data.begin(), data.begin() + 2048, readBack.begin()));
+    EXPECT_EQ(0xff, readBack[2048]);
+
+    flashfsClose();
+
+    EXPECT_EQ(2U, stats->programCount);
+    EXPECT_EQ(4096U, flashfsGetOffset());
+    flashfsReadAbs(0, readBack.data(), data.size());
+    EXPECT_EQ(data, readBack);
+}
+
+TEST_F(VirtualFlashTest, TestNorProgramsAlignedPages)
+{
+    initFlash("256,16,64", "700,1000");
+
+    // Start part way into a page
+    const std::vector<uint8_t> data = testData(100 + 40 * 256);
+    logData(std::vector<uint8_t>(data.begin(), data.begin() + 100));
+    virtualFlashResetStats();
+
+    logFrames(std::vector<uint8_t>(data.begin() + 100, data.end()), 50, 200);
+
+    // The rest of the first page, then whole pages, then the remainder flushed at the end
+    const virtualFlashStats_t *stats = virtualFlashGetStats();
+    EXPECT_EQ(1U + 39 + 1, stats->programCount);
+    EXPECT_EQ(40U * 256, stats->bytesProgrammed);
+    EXPECT_EQ(data, readFile(0, data.size()));
+}
+
+TEST_F(VirtualFlashTest, TestBytesProgrammedWhenPageComplete)
+{
+    initFlash("256,16,64", "700,1000");
+
+    const std::vector<uint8_t> data = testData(2 * 256);
+    const virtualFlashStats_t *stats = virtualFlashGetStats();
+
+    // Nothing is programmed until the byte that completes the page
+    for (uint32_t i = 0; i < 255; i++) {
+        flashfsWriteByte(data[i]);
+    }
+    EXPECT_EQ(0U, stats->programCount);
+    flashfsWriteByte(data[255]);
+    EXPECT_EQ(1U, stats->programCount);
+
+    // The second page completes while the first is still being programmed, so the periodic flush writes it
+    for (uint32_t i = 256; i < data.size(); i++) {
+        flashfsWriteByte(data[i]);
+    }
+    EXPECT_EQ(1U, stats->programCount);
+    cycleCounter += 1000;
+    flashfsFlushAsync(false);
+    EXPECT_EQ(2U, stats->programCount);
+
+    flashfsFlushSync();
+    EXPECT_EQ(data, readFile(0, data.size()));
+}
+
+TEST_F(VirtualFlashTest, TestNandLoggingContinuesDuringSlowProgram)
+{
+    // Each page program stalls the device for 3ms, while 64 byte frames arrive every 100us
+    initFlash("2048,4,16,nand", "3000,2000");
+
+    const std::vector<uint8_t> data = testData(10 * 2048);
+    logFrames(data, 64, 100);
+
+    EXPECT_EQ(data.size(), flashfsGetOffset());
+    EXPECT_EQ(data, readFile(0, data.size()));
+
+    const virtualFlashStats_t *stats = virtualFlashGetStats();
+    EXPECT_EQ(10U, stats->programCount);
+    EXPECT_GT(stats->busyPolls, 0U);
+}
+
+TEST_F(VirtualFlashTest, TestFrameDroppedWholeWhenBufferFull)
+{
+    initFlash("256,16,64", "100000,1000");
+
+    // The first page program keeps the device busy while the buffer fills up
+    const std::vector<uint8_t> data = testData(2 * FLASHFS_WRITE_BUFFER_SIZE);
+    uint32_t written = 0;
+    while (flashfsGetWriteBufferFreeSpace() >= 100) {
+        flashfsWrite(&data[written], 100, false);
+        written += 100;
+    }
+    const uint32_t offset = flashfsGetOffset();
+    EXPECT_EQ(written, offset);
+
+    flashfsWrite(&data[written], 100, false);
+    EXPECT_EQ(offset, flashfsGetOffset());
+
+    flashfsFlushSync();
+    EXPECT_EQ(std::vector<uint8_t>(data.begin(), data.begin() + written), readFile(0, written));
+    EXPECT_EQ(0xff, readFile(written, 1)[0]);
+}
+
+// STUBS
+
+extern "C" {
+    int16_t debug[DEBUG16_VALUE_COUNT];
+    uint8_t debugMode;
+
+    uint32_t getCycleCounter(void) { return cycleCounter; }
+    void delayMicroseconds(uint32_t us) { cycleCounter += us; }
+    uint32_t clockMicrosToCycles(uint32_t micros) { return micros; }
+
+    void ioPreinitByTag(ioTag_t, ioConfig_t, ioPreinitPinState_e) {}
+}
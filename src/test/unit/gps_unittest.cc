@@ -0,0 +1,248 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <string.h>
+
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "build/debug.h"
+
+    #include "common/maths.h"
+
+    #include "config/feature.h"
+
+    #include "drivers/serial.h"
+
+    #include "io/beeper.h"
+    #include "io/dashboard.h"
+    #include "io/gps.h"
+    #include "io/serial.h"
+
+    #include "pg/pg.h"
+    #include "pg/pg_ids.h"
+    #include "pg/gps.h"
+    #include "pg/gps_rescue.h"
+
+    #include "scheduler/scheduler.h"
+
+    PG_REGISTER(gpsConfig_t, gpsConfig, PG_GPS_CONFIG, 0);
+    PG_REGISTER(gpsRescueConfig_t, gpsRescueConfig, PG_GPS_RESCUE, 0);
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define TEST_RX_BUFFER_SIZE 256
+
+static uint8_t rxBuffer[TEST_RX_BUFFER_SIZE];
+
+static uint32_t ringRxWaiting(const serialPort_t *instance)
+{
+    return (instance->rxBufferHead - instance->rxBufferTail) & (instance->rxBufferSize - 1);
+}
+
+static uint8_t ringRead(serialPort_t *instance)
+{
+    const uint8_t ch = instance->rxBuffer[instance->rxBufferTail];
+    instance->rxBufferTail = (instance->rxBufferTail + 1) % instance->rxBufferSize;
+    return ch;
+}
+
+static void stubWrite(serialPort_t *, uint8_t) {}
+static uint32_t stubTxFree(const serialPort_t *) { return 256; }
+static void stubSetBaudRate(serialPort_t *, uint32_t) {}
+static bool stubTxEmpty(const serialPort_t *) { return true; }
+static void stubSetMode(serialPort_t *, portMode_e) {}
+
+static const struct serialPortVTable ringVTable = {
+    .serialWrite = stubWrite,
+    .serialTotalRxWaiting = ringRxWaiting,
+    .serialTotalTxFree = stubTxFree,
+    .serialRead = ringRead,
+    .serialSetBaudRate = stubSetBaudRate,
+    .isSerialTransmitBufferEmpty = stubTxEmpty,
+    .setMode = stubSetMode,
+    .peekRx = serialRingPeekRx,
+    .skipRx = serialRingSkipRx,
+};
+
+static serialPort_t gpsTestPort;
+
+static void appendFrame(std::vector<uint8_t> &stream, uint8_t msgClass, uint8_t msgId, const uint8_t *payload, uint16_t length)
+{
+    const size_t start = stream.size();
+    stream.push_back(0xB5);
+    stream.push_back(0x62);
+    stream.push_back(msgClass);
+    stream.push_back(msgId);
+    stream.push_back(length & 0xff);
+    stream.push_back(length >> 8);
+    stream.insert(stream.end(), payload, payload + length);
+
+    uint8_t checksumA = 0;
+    uint8_t checksumB = 0;
+    for (size_t i = start + 2; i < stream.size(); i++) {
+        checksumB += (checksumA += stream[i]);
+    }
+    stream.push_back(checksumA);
+    stream.push_back(checksumB);
+}
+
+static void appendNavPvt(std::vector<uint8_t> &stream, int32_t lat, int32_t lon, uint8_t numSV)
+{
+    uint8_t payload[92] = { 0 };
+    payload[20] = 3;        // fixType
+    payload[21] = 1;        // flags, fix valid
+    payload[23] = numSV;
+    memcpy(&payload[24], &lon, sizeof(lon));
+    memcpy(&payload[28], &lat, sizeof(lat));
+    appendFrame(stream, 0x01, 0x07, payload, sizeof(payload));
+}
+
+// Writes the stream into the receive ring starting at offset, so that it may wrap
+static void receive(const std::vector<uint8_t> &stream, uint32_t offset)
+{
+    ASSERT_LT(stream.size(), (size_t)TEST_RX_BUFFER_SIZE);
+
+    for (size_t i = 0; i < stream.size(); i++) {
+        rxBuffer[(offset + i) % TEST_RX_BUFFER_SIZE] = stream[i];
+    }
+    gpsTestPort.rxBufferTail = offset % TEST_RX_BUFFER_SIZE;
+    gpsTestPort.rxBufferHead = (offset + stream.size()) % TEST_RX_BUFFER_SIZE;
+
+    gpsUpdate(0);
+}
+
+class GpsUbloxTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        memset(&gpsTestPort, 0, sizeof(gpsTestPort));
+        gpsTestPort.vTable = &ringVTable;
+        gpsTestPort.rxBuffer = rxBuffer;
+        gpsTestPort.rxBufferSize = TEST_RX_BUFFER_SIZE;
+
+        gpsConfigMutable()->provider = GPS_UBLOX;
+        gpsInit();
+        memset(&gpsSol, 0, sizeof(gpsSol));
+    }
+};
+
+TEST_F(GpsUbloxTest, TestNavPvtInOneSpan)
+{
+    std::vector<uint8_t> stream = { 0x00, 0x12, 0xB5, 0x00 };
+    appendNavPvt(stream, 473977420, 85455940, 12);
+
+    receive(stream, 0);
+
+    EXPECT_EQ(473977420, gpsSol.llh.lat);
+    EXPECT_EQ(85455940, gpsSol.llh.lon);
+    EXPECT_EQ(12, gpsSol.numSat);
+    EXPECT_EQ(0U, serialRxBytesWaiting(&gpsTestPort));
+}
+
+TEST_F(GpsUbloxTest, TestNavPvtAcrossWrap)
+{
+    std::vector<uint8_t> stream;
+    appendNavPvt(stream, -337000000, 1512000000, 7);
+
+    receive(stream, TEST_RX_BUFFER_SIZE - 40);
+
+    EXPECT_EQ(-337000000, gpsSol.llh.lat);
+    EXPECT_EQ(1512000000, gpsSol.llh.lon);
+    EXPECT_EQ(7, gpsSol.numSat);
+}
+
+TEST_F(GpsUbloxTest, TestBadChecksumIsIgnored)
+{
+    std::vector<uint8_t> stream;
+    appendNavPvt(stream, 100, 200, 5);
+    stream[30] ^= 0x01;
+    appendNavPvt(stream, 300, 400, 6);
+
+    receive(stream, 0);
+
+    EXPECT_EQ(300, gpsSol.llh.lat);
+    EXPECT_EQ(400, gpsSol.llh.lon);
+    EXPECT_EQ(6, gpsSol.numSat);
+}
+
+TEST_F(GpsUbloxTest, TestNavSat)
+{
+    uint8_t payload[8 + 12 * 3] = { 0 };
+    payload[5] = 3;         // numSvs
+    for (int i = 0; i < 3; i++) {
+        payload[8 + 12 * i + 0] = 6;            // gnssId
+        payload[8 + 12 * i + 1] = 10 + i;       // svId
+        payload[8 + 12 * i + 2] = 40 + i;       // cno
+        payload[8 + 12 * i + 8] = 0x1f;         // flags
+    }
+    std::vector<uint8_t> stream;
+    appendFrame(stream, 0x01, 0x35, payload, sizeof(payload));
+
+    receive(stream, 3);
+
+    EXPECT_EQ(GPS_SV_MAXSATS_M8N, GPS_numCh);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(6, GPS_svinfo[i].chn);
+        EXPECT_EQ(10 + i, GPS_svinfo[i].svid);
+        EXPECT_EQ(40 + i, GPS_svinfo[i].cno);
+        EXPECT_EQ(0x1f, GPS_svinfo[i].quality);
+    }
+    EXPECT_EQ(255, GPS_svinfo[3].chn);
+}
+
+// STUBS
+
+extern "C" {
+    static serialPortConfig_t gpsPortConfig = { .identifier = SERIAL_PORT_USART1 };
+
+    const serialPortConfig_t *findSerialPortConfig(serialPortFunction_e) { return &gpsPortConfig; }
+    serialType_e serialType(serialPortIdentifier_e) { return SERIALTYPE_UART; }
+    serialPort_t *openSerialPort(serialPortIdentifier_e, serialPortFunction_e, serialReceiveCallbackPtr, void *, uint32_t, portMode_e, portOptions_e)
+    {
+        return &gpsTestPort;
+    }
+    const uint32_t baudRates[BAUD_COUNT] = { 0 };
+    baudRate_e lookupBaudRateIndex(uint32_t) { return BAUD_AUTO; }
+    void waitForSerialPortToFinishTransmitting(serialPort_t *) {}
+    void serialPassthrough(serialPort_t *, serialPort_t *, serialConsumer *, serialConsumer *) {}
+
+    int16_t debug[DEBUG16_VALUE_COUNT];
+    uint8_t debugMode;
+
+    bool featureIsEnabled(const uint32_t) { return false; }
+    void beeper(beeperMode_e) {}
+    void beeperConfirmationBeeps(uint8_t) {}
+    void dashboardUpdate(timeUs_t) {}
+    void dashboardShowFixedPage(pageId_e) {}
+
+    void rescheduleTask(taskId_e, timeDelta_t) {}
+    void schedulerSetNextStateTime(timeDelta_t) {}
+
+    uint32_t micros(void) { return 0; }
+    uint32_t millis(void) { return 0; }
+}
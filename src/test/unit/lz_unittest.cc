@@ -0,0 +1,253 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/lz.h"
+    #include "common/utils.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define CHUNK_SIZE 256
+
+static lzState_t state;
+
+// Host side decoder, as a configurator would use
+static bool lzDecode(const uint8_t *in, size_t inLen, std::vector<uint8_t> &out)
+{
+    const uint8_t *end = in + inLen;
+    while (in < end) {
+        const uint8_t token = *in++;
+
+        size_t literalCount = token >> 4;
+        if (literalCount == 15) {
+            uint8_t extra;
+            do {
+                if (in >= end) {
+                    return false;
+                }
+                extra = *in++;
+                literalCount += extra;
+            } while (extra == 255);
+        }
+        if (literalCount > (size_t)(end - in)) {
+            return false;
+        }
+        out.insert(out.end(), in, in + literalCount);
+        in += literalCount;
+
+        size_t matchCode = token & 0xf;
+        if (matchCode == 0) {
+            continue;
+        }
+        if (end - in < 2) {
+            return false;
+        }
+        const size_t offset = in[0] | (in[1] << 8);
+        in += 2;
+        if (matchCode == 15) {
+            uint8_t extra;
+            do {
+                if (in >= end) {
+                    return false;
+                }
+                extra = *in++;
+                matchCode += extra;
+            } while (extra == 255);
+        }
+        if (offset == 0 || offset > LZ_WINDOW_SIZE || offset > out.size()) {
+            return false;
+        }
+        // Byte by byte, the match may overlap its own output
+        for (size_t i = 0; i < matchCode + LZ_MIN_MATCH - 1; i++) {
+            out.push_back(out[out.size() - offset]);
+        }
+    }
+    return true;
+}
+
+// Returns -1 once the output is full
+static int encode(const std::vector<uint8_t> &data, uint8_t *outBuf, uint16_t outBufLen)
+{
+    lzInit(&state, outBuf, outBufLen);
+    for (size_t pos = 0; pos < data.size(); pos += CHUNK_SIZE) {
+        const int status = lzEncodeBufStreaming(&state, &data[pos], std::min((size_t)CHUNK_SIZE, data.size() - pos));
+        if (status != 0) {
+            return status;
+        }
+    }
+    return lzFlush(&state);
+}
+
+static void expectRoundTrip(const std::vector<uint8_t> &data)
+{
+    static uint8_t outBuf[UINT16_MAX];
+    EXPECT_EQ(0, encode(data, outBuf, sizeof(outBuf)));
+    EXPECT_EQ(data.size(), state.encodedCount);
+
+    std::vector<uint8_t> decoded;
+    EXPECT_TRUE(lzDecode(outBuf, state.bytesWritten, decoded));
+    EXPECT_TRUE(data == decoded);
+}
+
+// Blackbox like data, slowly changing fields in frames with a few distinct headers
+static std::vector<uint8_t> logData(size_t length)
+{
+    std::vector<uint8_t> data;
+    uint32_t state = 1;
+    for (uint32_t frame = 0; data.size() < length; frame++) {
+        state = state * 1664525 + 1013904223;
+        data.push_back(frame % 32 ? 'P' : 'I');
+        data.push_back(frame & 0x7f);
+        for (int field = 0; field < 12; field++) {
+            data.push_back(field < 8 ? 0 : (state >> (field + 8)) & 1);
+        }
+        if (frame % 8 == 0) {
+            data.push_back('S');
+            data.push_back(0x02);
+        }
+    }
+    data.resize(length);
+    return data;
+}
+
+TEST(LzUnittest, TestRoundTrip)
+{
+    expectRoundTrip(std::vector<uint8_t>());
+    expectRoundTrip(std::vector<uint8_t>{ 'a', 'b', 'c' });
+    expectRoundTrip(std::vector<uint8_t>(10000, 0xff));
+    expectRoundTrip(logData(9000));
+
+    std::vector<uint8_t> random(5000);
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < random.size(); i++) {
+        seed = seed * 1664525 + 1013904223;
+        random[i] = seed >> 24;
+    }
+    expectRoundTrip(random);
+
+    // Repeats further back than the window can't be matched, but must still decode
+    std::vector<uint8_t> repeated(random.begin(), random.begin() + 1500);
+    repeated.insert(repeated.end(), random.begin(), random.begin() + 1500);
+    expectRoundTrip(repeated);
+}
+
+TEST(LzUnittest, TestCompressesRepeatedData)
+{
+    static uint8_t outBuf[4096];
+
+    // Erased flash, one match with length bytes
+    EXPECT_EQ(0, encode(std::vector<uint8_t>(60000, 0xff), outBuf, sizeof(outBuf)));
+    EXPECT_LT(state.bytesWritten, 60000 / 240);
+
+    EXPECT_EQ(0, encode(logData(4096), outBuf, sizeof(outBuf)));
+    EXPECT_LT(state.bytesWritten, 4096 * 3 / 4);
+}
+
+TEST(LzUnittest, TestOutputLimit)
+{
+    static uint8_t outBuf[1024 + 16];
+    const std::vector<uint8_t> data = logData(20000);
+
+    // Bytes beyond the limit must not be touched
+    memset(outBuf, 0xa5, sizeof(outBuf));
+    EXPECT_EQ(-1, encode(data, outBuf, 1024));
+    EXPECT_LE(state.bytesWritten, 1024);
+    EXPECT_GT(state.bytesWritten, 1000);
+    for (size_t i = 1024; i < sizeof(outBuf); i++) {
+        EXPECT_EQ(0xa5, outBuf[i]);
+    }
+
+    // The encoded count covers exactly the input in the output
+    std::vector<uint8_t> decoded;
+    EXPECT_TRUE(lzDecode(outBuf, state.bytesWritten, decoded));
+    ASSERT_EQ(state.encodedCount, decoded.size());
+    EXPECT_TRUE(std::equal(decoded.begin(), decoded.end(), data.begin()));
+}
+
+TEST(LzUnittest, TestRandomisedStreams)
+{
+    static uint8_t outBuf[8192];
+    uint32_t seed = 42;
+    auto random = [&seed](uint32_t range) {
+        seed = seed * 1664525 + 1013904223;
+        return (seed >> 8) % range;
+    };
+
+    for (int round = 0; round < 200; round++) {
+        // Runs, copies of earlier data near and beyond the window and noise
+        std::vector<uint8_t> data;
+        while (data.size() < 6000) {
+            const uint32_t length = 1 + random(400);
+            switch (random(3)) {
+            case 0:
+                data.insert(data.end(), length, random(256));
+                break;
+            case 1:
+                if (data.size() > 0) {
+                    const size_t from = data.size() - 1 - random(std::min<size_t>(data.size(), 1500));
+                    for (uint32_t i = 0; i < length; i++) {
+                        data.push_back(data[from + i]);
+                    }
+                    break;
+                }
+                FALLTHROUGH;
+            default:
+                for (uint32_t i = 0; i < length; i++) {
+                    data.push_back(random(256));
+                }
+                break;
+            }
+        }
+
+        const uint16_t outBufLen = 16 + random(sizeof(outBuf) - 16);
+        lzInit(&state, outBuf, outBufLen);
+        int status = 0;
+        for (size_t pos = 0; pos < data.size() && status == 0;) {
+            const size_t chunk = std::min<size_t>(1 + random(700), data.size() - pos);
+            status = lzEncodeBufStreaming(&state, &data[pos], chunk);
+            pos += chunk;
+        }
+        if (status == 0) {
+            status = lzFlush(&state);
+        }
+        ASSERT_LE(state.bytesWritten, outBufLen);
+
+        std::vector<uint8_t> decoded;
+        ASSERT_TRUE(lzDecode(outBuf, state.bytesWritten, decoded)) << "round " << round;
+        ASSERT_EQ(state.encodedCount, decoded.size()) << "round " << round;
+        ASSERT_TRUE(std::equal(decoded.begin(), decoded.end(), data.begin())) << "round " << round;
+        if (status == 0) {
+            EXPECT_EQ(data.size(), decoded.size());
+        }
+    }
+}
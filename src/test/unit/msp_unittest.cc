@@ -0,0 +1,542 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "blackbox/blackbox.h"
+
+    #include "build/debug.h"
+    #include "build/version.h"
+
+    #include "common/huffman.h"
+    #include "common/streambuf.h"
+
+    #include "config/config.h"
+
+    #include "drivers/accgyro/accgyro.h"
+    #include "drivers/compass/compass.h"
+    #include "drivers/flash/flash.h"
+    #include "drivers/transponder_ir.h"
+    #include "drivers/motor.h"
+    #include "drivers/system.h"
+
+    #include "fc/controlrate_profile.h"
+    #include "fc/core.h"
+    #include "fc/rc_adjustments.h"
+    #include "fc/rc_controls.h"
+    #include "fc/rc_modes.h"
+    #include "fc/runtime_config.h"
+
+    #include "flight/failsafe.h"
+    #include "flight/imu.h"
+    #include "flight/mixer.h"
+    #include "flight/pid.h"
+    #include "flight/servos.h"
+
+    #include "io/beeper.h"
+    #include "io/flashfs.h"
+    #include "io/gps.h"
+    #include "io/ledstrip.h"
+    #include "io/serial.h"
+    #include "io/transponder_ir.h"
+
+    #include "msp/msp.h"
+    #include "msp/msp_box.h"
+    #include "msp/msp_protocol.h"
+    #include "msp/msp_protocol_v2_betaflight.h"
+
+    #include "pg/beeper.h"
+    #include "pg/gps.h"
+    #include "pg/gyrodev.h"
+    #include "pg/motor.h"
+    #include "pg/pg.h"
+    #include "pg/pg_ids.h"
+    #include "pg/pilot.h"
+    #include "pg/rx.h"
+
+    #include "rx/rx.h"
+
+    #include "scheduler/scheduler.h"
+
+    #include "sensors/acceleration.h"
+    #include "sensors/barometer.h"
+    #include "sensors/battery.h"
+    #include "sensors/boardalignment.h"
+    #include "sensors/compass.h"
+    #include "sensors/current.h"
+    #include "sensors/gyro.h"
+    #include "sensors/voltage.h"
+
+    #include "telemetry/telemetry.h"
+
+    int mspProcessorCached(int16_t cmdMSP);
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static uint8_t subscription[64];
+static int subscriptionSize;
+static uint16_t subscriptionIntervalMs;
+static int subscribeCount;
+static int writeEEPROMCount;
+static int resetEEPROMCount;
+static int motorSetCount;
+
+#define TEST_FLASH_SIZE 8192
+static uint8_t testFlash[TEST_FLASH_SIZE];
+
+static uint8_t requestBuf[64];
+static uint8_t replyBuf[512];
+
+class MspTest : public ::testing::Test {
+protected:
+    sbuf_t request;
+    mspPacket_t reply;
+
+    virtual void SetUp()
+    {
+        sbufInit(&request, requestBuf, ARRAYEND(requestBuf));
+        subscribeCount = 0;
+        writeEEPROMCount = 0;
+        resetEEPROMCount = 0;
+        motorSetCount = 0;
+    }
+
+    void addCommand(uint16_t cmd, const uint8_t *arg = NULL, uint8_t argSize = 0)
+    {
+        sbufWriteU16(&request, cmd);
+        sbufWriteU8(&request, argSize);
+        sbufWriteData(&request, arg, argSize);
+    }
+
+    mspResult_e process(uint16_t cmd)
+    {
+        mspPacket_t command = {
+            .buf = { .ptr = requestBuf, .end = request.ptr, },
+            .cmd = (int16_t)cmd,
+            .result = 0,
+            .flags = 0,
+            .direction = MSP_DIRECTION_REQUEST,
+        };
+        reply = {
+            .buf = { .ptr = replyBuf, .end = ARRAYEND(replyBuf), },
+            .cmd = -1,
+            .result = 0,
+            .flags = 0,
+            .direction = MSP_DIRECTION_REPLY,
+        };
+        const mspResult_e result = mspFcProcessCommand(0, &command, &reply, NULL);
+        sbufSwitchToReader(&reply.buf, replyBuf);
+        return result;
+    }
+
+    mspResult_e subscribe(uint16_t intervalMs)
+    {
+        // prepend the interval to the command list
+        const int listSize = request.ptr - requestBuf;
+        memmove(requestBuf + 2, requestBuf, listSize);
+        requestBuf[0] = intervalMs & 0xff;
+        requestBuf[1] = intervalMs >> 8;
+        request.ptr += 2;
+        return process(MSP2_SUBSCRIBE);
+    }
+};
+
+TEST_F(MspTest, TestMultipleMsp)
+{
+    const uint8_t name[] = { 'Q', 'U', 'A', 'D' };
+    addCommand(MSP_API_VERSION);
+    addCommand(MSP_SET_NAME, name, sizeof(name));
+    addCommand(MSP_NAME);
+    addCommand(MSP2_MULTIPLE_MSP);
+
+    EXPECT_EQ(MSP_RESULT_ACK, process(MSP2_MULTIPLE_MSP));
+
+    // { uint16 command, int8 result, uint16 size, reply } for each command in order
+    EXPECT_EQ(MSP_API_VERSION, sbufReadU16(&reply.buf));
+    EXPECT_EQ(MSP_RESULT_ACK, (int8_t)sbufReadU8(&reply.buf));
+    EXPECT_EQ(3, sbufReadU16(&reply.buf));
+    EXPECT_EQ(MSP_PROTOCOL_VERSION, sbufReadU8(&reply.buf));
+    EXPECT_EQ(API_VERSION_MAJOR, sbufReadU8(&reply.buf));
+    EXPECT_EQ(API_VERSION_MINOR, sbufReadU8(&reply.buf));
+
+    EXPECT_EQ(MSP_SET_NAME, sbufReadU16(&reply.buf));
+    EXPECT_EQ(MSP_RESULT_ACK, (int8_t)sbufReadU8(&reply.buf));
+    EXPECT_EQ(0, sbufReadU16(&reply.buf));
+
+    EXPECT_EQ(MSP_NAME, sbufReadU16(&reply.buf));
+    EXPECT_EQ(MSP_RESULT_ACK, (int8_t)sbufReadU8(&reply.buf));
+    EXPECT_EQ(4, sbufReadU16(&reply.buf));
+    EXPECT_EQ(0, memcmp(sbufPtr(&reply.buf), name, sizeof(name)));
+    sbufAdvance(&reply.buf, sizeof(name));
+
+    // nested requests are rejected
+    EXPECT_EQ(MSP2_MULTIPLE_MSP, sbufReadU16(&reply.buf));
+    EXPECT_EQ(MSP_RESULT_ERROR, (int8_t)sbufReadU8(&reply.buf));
+    EXPECT_EQ(0, sbufReadU16(&reply.buf));
+
+    EXPECT_EQ(0, sbufBytesRemaining(&reply.buf));
+}
+
+TEST_F(MspTest, TestSubscribeQueries)
+{
+    addCommand(MSP_API_VERSION);
+    addCommand(MSP_NAME);
+    const uint8_t expected[] = { MSP_API_VERSION & 0xff, MSP_API_VERSION >> 8, 0, MSP_NAME & 0xff, MSP_NAME >> 8, 0 };
+
+    EXPECT_EQ(MSP_RESULT_ACK, subscribe(100));
+    EXPECT_EQ(1, subscribeCount);
+    EXPECT_EQ(100, subscriptionIntervalMs);
+    ASSERT_EQ((int)sizeof(expected), subscriptionSize);
+    EXPECT_EQ(0, memcmp(subscription, expected, sizeof(expected)));
+
+    // an interval of 0 with no commands ends the subscription
+    sbufInit(&request, requestBuf, ARRAYEND(requestBuf));
+    EXPECT_EQ(MSP_RESULT_ACK, subscribe(0));
+    EXPECT_EQ(2, subscribeCount);
+    EXPECT_EQ(0, subscriptionSize);
+}
+
+TEST_F(MspTest, TestSubscribeRejectsCommandsWithSideEffects)
+{
+    const uint16_t commands[] = { MSP_SET_MOTOR, MSP_EEPROM_WRITE, MSP_RESET_CONF, MSP_SET_RAW_RC, MSP_REBOOT, MSP2_MULTIPLE_MSP, MSP2_SUBSCRIBE };
+
+    for (unsigned i = 0; i < ARRAYLEN(commands); i++) {
+        sbufInit(&request, requestBuf, ARRAYEND(requestBuf));
+        addCommand(MSP_API_VERSION);
+        addCommand(commands[i]);
+
+        EXPECT_EQ(MSP_RESULT_ERROR, subscribe(100)) << "command " << commands[i];
+    }
+    EXPECT_EQ(0, subscribeCount);
+    EXPECT_EQ(0, writeEEPROMCount);
+    EXPECT_EQ(0, resetEEPROMCount);
+    EXPECT_EQ(0, motorSetCount);
+}
+
+TEST_F(MspTest, TestSubscribeRejectsArguments)
+{
+    // a query with an argument, and a truncated entry
+    const uint8_t page = 1;
+    addCommand(MSP_BOXNAMES, &page, sizeof(page));
+    EXPECT_EQ(MSP_RESULT_ERROR, subscribe(100));
+
+    sbufInit(&request, requestBuf, ARRAYEND(requestBuf));
+    sbufWriteU16(&request, MSP_API_VERSION);
+    EXPECT_EQ(MSP_RESULT_ERROR, subscribe(100));
+
+    EXPECT_EQ(0, subscribeCount);
+}
+
+TEST_F(MspTest, TestSubscribeRejectedInMultipleMsp)
+{
+    // MSP2_SUBSCRIBE { 100ms, MSP_API_VERSION } as a sub-command
+    const uint8_t subscribeArg[] = { 100, 0, MSP_API_VERSION & 0xff, MSP_API_VERSION >> 8, 0 };
+    addCommand(MSP2_SUBSCRIBE, subscribeArg, sizeof(subscribeArg));
+
+    EXPECT_EQ(MSP_RESULT_ACK, process(MSP2_MULTIPLE_MSP));
+    EXPECT_EQ(MSP2_SUBSCRIBE, sbufReadU16(&reply.buf));
+    EXPECT_EQ(MSP_RESULT_ERROR, (int8_t)sbufReadU8(&reply.buf));
+    EXPECT_EQ(0, subscribeCount);
+}
+
+// see mspProcessor_e
+enum { PROCESSOR_COMMON_OUT = 0, PROCESSOR_OUT, PROCESSOR_OUT_WITH_ARG, PROCESSOR_IN };
+
+TEST_F(MspTest, TestProcessorCacheHit)
+{
+    const uint8_t name1[] = { 'O', 'N', 'E' };
+    sbufWriteData(&request, name1, sizeof(name1));
+    EXPECT_EQ(MSP_RESULT_ACK, process(MSP_SET_NAME));
+    EXPECT_EQ(PROCESSOR_IN, mspProcessorCached(MSP_SET_NAME));
+
+    // the next request starts at the processor which handled the last one
+    const uint8_t name2[] = { 'T', 'W', 'O' };
+    sbufInit(&request, requestBuf, ARRAYEND(requestBuf));
+    sbufWriteData(&request, name2, sizeof(name2));
+    EXPECT_EQ(MSP_RESULT_ACK, process(MSP_SET_NAME));
+    EXPECT_EQ(PROCESSOR_IN, mspProcessorCached(MSP_SET_NAME));
+
+    sbufInit(&request, requestBuf, ARRAYEND(requestBuf));
+    EXPECT_EQ(MSP_RESULT_ACK, process(MSP_NAME));
+    EXPECT_EQ(PROCESSOR_OUT, mspProcessorCached(MSP_NAME));
+    EXPECT_EQ(sizeof(name2), (unsigned)sbufBytesRemaining(&reply.buf));
+    EXPECT_EQ(0, memcmp(sbufPtr(&reply.buf), name2, sizeof(name2)));
+}
+
+TEST_F(MspTest, TestProcessorFallthrough)
+{
+    // not handled by the out processors, so it falls through to the one that handles it
+    EXPECT_EQ(PROCESSOR_COMMON_OUT, mspProcessorCached(MSP_BOXIDS));
+    EXPECT_EQ(MSP_RESULT_ACK, process(MSP_BOXIDS));
+    EXPECT_EQ(PROCESSOR_OUT_WITH_ARG, mspProcessorCached(MSP_BOXIDS));
+
+    // and again from the cached processor
+    EXPECT_EQ(MSP_RESULT_ACK, process(MSP_BOXIDS));
+    EXPECT_EQ(PROCESSOR_OUT_WITH_ARG, mspProcessorCached(MSP_BOXIDS));
+}
+
+TEST_F(MspTest, TestUnknownCommand)
+{
+    // falls through all processors, and isn't remembered
+    const uint16_t unknownCommand = 199;
+    EXPECT_EQ(MSP_RESULT_ERROR, process(unknownCommand));
+    EXPECT_EQ(unknownCommand, reply.cmd);
+    EXPECT_EQ(PROCESSOR_COMMON_OUT, mspProcessorCached(unknownCommand));
+    EXPECT_EQ(MSP_RESULT_ERROR, process(unknownCommand));
+
+    // commands outside the cached ranges
+    const uint16_t uncachedCommand = 0x2000;
+    EXPECT_EQ(-1, mspProcessorCached(uncachedCommand));
+    EXPECT_EQ(MSP_RESULT_ERROR, process(uncachedCommand));
+}
+
+TEST_F(MspTest, TestDataflashReadPicksSmallerCompressionPerRegion)
+{
+    enum { HUFFMAN = 1, LZ = 2 };
+
+    // erased flash, LZ codes the runs
+    memset(testFlash, 0xff, sizeof(testFlash));
+    sbufWriteU32(&request, 0);
+    sbufWriteU16(&request, 256);
+    sbufWriteU8(&request, LZ);
+
+    EXPECT_EQ(MSP_RESULT_ACK, process(MSP_DATAFLASH_READ));
+    EXPECT_EQ(0U, sbufReadU32(&reply.buf));
+    const uint16_t lzSize = sbufReadU16(&reply.buf);
+    EXPECT_EQ(LZ, sbufReadU8(&reply.buf));
+    EXPECT_GT(sbufReadU16(&reply.buf), 10 * lzSize);
+
+    // small values, as in blackbox frames, are shorter in Huffman codes than in LZ sequences
+    uint32_t state = 0x12345678;
+    for (unsigned i = 0; i < sizeof(testFlash); i++) {
+        state = state * 1664525 + 1013904223;
+        testFlash[i] = (state >> 24) & 0x03;
+    }
+
+    // the first reply of a region is LZ, and finds Huffman smaller
+    sbufInit(&request, requestBuf, ARRAYEND(requestBuf));
+    sbufWriteU32(&request, 0);
+    sbufWriteU16(&request, 256);
+    sbufWriteU8(&request, LZ);
+
+    EXPECT_EQ(MSP_RESULT_ACK, process(MSP_DATAFLASH_READ));
+    EXPECT_EQ(0U, sbufReadU32(&reply.buf));
+    sbufReadU16(&reply.buf);
+    EXPECT_EQ(LZ, sbufReadU8(&reply.buf));
+    const uint16_t lzCount = sbufReadU16(&reply.buf);
+    EXPECT_GT(lzCount, 0);
+
+    // the region continues in Huffman
+    sbufInit(&request, requestBuf, ARRAYEND(requestBuf));
+    sbufWriteU32(&request, lzCount);
+    sbufWriteU16(&request, 256);
+    sbufWriteU8(&request, LZ);
+
+    EXPECT_EQ(MSP_RESULT_ACK, process(MSP_DATAFLASH_READ));
+    EXPECT_EQ(lzCount, sbufReadU32(&reply.buf));
+    const uint16_t huffmanSize = sbufReadU16(&reply.buf);
+    EXPECT_EQ(HUFFMAN, sbufReadU8(&reply.buf));
+    EXPECT_LE(huffmanSize, 256 + HUFFMAN_INFO_SIZE);
+    EXPECT_GT(sbufReadU16(&reply.buf), huffmanSize);
+
+    // a seek starts a new region
+    sbufInit(&request, requestBuf, ARRAYEND(requestBuf));
+    sbufWriteU32(&request, 0);
+    sbufWriteU16(&request, 256);
+    sbufWriteU8(&request, LZ);
+
+    EXPECT_EQ(MSP_RESULT_ACK, process(MSP_DATAFLASH_READ));
+    EXPECT_EQ(0U, sbufReadU32(&reply.buf));
+    sbufReadU16(&reply.buf);
+    EXPECT_EQ(LZ, sbufReadU8(&reply.buf));
+}
+
+// STUBS
+
+extern "C" {
+    PG_REGISTER(accelerometerConfig_t, accelerometerConfig, PG_ACCELEROMETER_CONFIG, 0);
+    PG_REGISTER_ARRAY(adjustmentRange_t, MAX_ADJUSTMENT_RANGE_COUNT, adjustmentRanges, PG_ADJUSTMENT_RANGE_CONFIG, 0);
+    PG_REGISTER(armingConfig_t, armingConfig, PG_ARMING_CONFIG, 0);
+    PG_REGISTER(barometerConfig_t, barometerConfig, PG_BAROMETER_CONFIG, 0);
+    PG_REGISTER(batteryConfig_t, batteryConfig, PG_BATTERY_CONFIG, 0);
+    PG_REGISTER(blackboxConfig_t, blackboxConfig, PG_BLACKBOX_CONFIG, 0);
+    PG_REGISTER(boardAlignment_t, boardAlignment, PG_BOARD_ALIGNMENT, 0);
+    PG_REGISTER(compassConfig_t, compassConfig, PG_COMPASS_CONFIG, 0);
+    PG_REGISTER(currentSensorADCConfig_t, currentSensorADCConfig, PG_CURRENT_SENSOR_ADC_CONFIG, 0);
+    PG_REGISTER_ARRAY(servoMixer_t, MAX_SERVO_RULES, customServoMixers, PG_SERVO_MIXER, 0);
+    PG_REGISTER(failsafeConfig_t, failsafeConfig, PG_FAILSAFE_CONFIG, 0);
+    PG_REGISTER(flight3DConfig_t, flight3DConfig, PG_MOTOR_3D_CONFIG, 0);
+    PG_REGISTER(gyroConfig_t, gyroConfig, PG_GYRO_CONFIG, 0);
+    PG_REGISTER(imuConfig_t, imuConfig, PG_IMU_CONFIG, 0);
+    PG_REGISTER(ledStripConfig_t, ledStripConfig, PG_LED_STRIP_CONFIG, 0);
+    PG_REGISTER(ledStripStatusModeConfig_t, ledStripStatusModeConfig, PG_LED_STRIP_STATUS_MODE_CONFIG, 0);
+    PG_REGISTER(mixerConfig_t, mixerConfig, PG_MIXER_CONFIG, 0);
+    PG_REGISTER_ARRAY(modeActivationCondition_t, MAX_MODE_ACTIVATION_CONDITION_COUNT, modeActivationConditions, PG_MODE_ACTIVATION_PROFILE, 0);
+    PG_REGISTER(motorConfig_t, motorConfig, PG_MOTOR_CONFIG, 0);
+    PG_REGISTER(pidConfig_t, pidConfig, PG_PID_CONFIG, 0);
+    PG_REGISTER(rcControlsConfig_t, rcControlsConfig, PG_RC_CONTROLS_CONFIG, 0);
+    PG_REGISTER_ARRAY(rxFailsafeChannelConfig_t, MAX_SUPPORTED_RC_CHANNEL_COUNT, rxFailsafeChannelConfigs, PG_RX_FAILSAFE_CHANNEL_CONFIG, 0);
+    PG_REGISTER(serialConfig_t, serialConfig, PG_SERIAL_CONFIG, 0);
+    PG_REGISTER_ARRAY(servoParam_t, MAX_SUPPORTED_SERVOS, servoParams, PG_SERVO_PARAMS, 0);
+    PG_REGISTER(systemConfig_t, systemConfig, PG_SYSTEM_CONFIG, 0);
+    PG_REGISTER(transponderConfig_t, transponderConfig, PG_TRANSPONDER_CONFIG, 0);
+    PG_REGISTER_ARRAY(voltageSensorADCConfig_t, MAX_VOLTAGE_SENSOR_ADC, voltageSensorADCConfig, PG_VOLTAGE_SENSOR_ADC_CONFIG, 0);
+
+    const char * const targetName = "UNITTEST";
+    const char * const buildDate = "Jan 01 2017";
+    const char * const buildTime = "00:00:00";
+    const char * const buildKey = "";
+    const char * const releaseName = "";
+    const char * const shortGitRevision = "MASTER";
+    const char pidNames[] = "ROLL;PITCH;YAW;LEVEL;MAG;";
+
+    int16_t debug[DEBUG16_VALUE_COUNT];
+    int16_t GPS_directionToHome;
+    uint16_t GPS_distanceToHome;
+    uint8_t GPS_numCh;
+    GPS_svinfo_t GPS_svinfo[GPS_SV_MAXSATS_M8N];
+    uint8_t GPS_update;
+    gpsSolutionData_t gpsSol;
+    acc_t acc;
+    mag_t mag;
+    gyro_t gyro;
+    attitudeEulerAngles_t attitude;
+    int16_t magHold;
+    controlRateConfig_t *currentControlRateProfile;
+    pidProfile_t *currentPidProfile;
+    uint8_t detectedSensors[SENSOR_INDEX_COUNT];
+    float motor_disarmed[MAX_SUPPORTED_MOTORS];
+    float rcData[MAX_SUPPORTED_RC_CHANNEL_COUNT];
+    rxRuntimeState_t rxRuntimeState;
+    rssiSource_e rssiSource;
+    int16_t servo[MAX_SUPPORTED_SERVOS];
+    const uint8_t currentMeterIds[] = { 0 };
+    const uint8_t voltageMeterIds[] = { 0 };
+    const uint8_t supportedCurrentMeterCount = 0;
+    const uint8_t supportedVoltageMeterCount = 0;
+    const uint8_t voltageMeterADCtoIDMap[MAX_VOLTAGE_SENSOR_ADC] = { 0 };
+    const transponderRequirement_t transponderRequirements[TRANSPONDER_PROVIDER_COUNT] = {};
+
+    bool mspSerialSubscribe(mspDescriptor_t, uint16_t intervalMs, const uint8_t *request, int requestSize)
+    {
+        subscribeCount++;
+        subscriptionIntervalMs = intervalMs;
+        subscriptionSize = requestSize;
+        memcpy(subscription, request, requestSize);
+        return true;
+    }
+
+    uint32_t flashfsGetSize(void) { return TEST_FLASH_SIZE; }
+    uint32_t flashfsGetOffset(void) { return 0; }
+    bool flashfsIsSupported(void) { return true; }
+    bool flashfsIsReady(void) { return true; }
+    int flashfsReadAbs(uint32_t offset, uint8_t *data, unsigned int len)
+    {
+        len = MIN(len, TEST_FLASH_SIZE - offset);
+        memcpy(data, testFlash + offset, len);
+        return len;
+    }
+    flashPartition_t *flashPartitionFindByType(flashPartitionType_e) { return NULL; }
+    void blackboxEraseAll(void) {}
+
+    void writeEEPROM(void) { writeEEPROMCount++; }
+    bool resetEEPROM(void) { resetEEPROMCount++; return true; }
+    bool readEEPROM(void) { return true; }
+    float motorConvertFromExternal(uint16_t) { motorSetCount++; return 0.0f; }
+
+    bool accHasBeenCalibrated(void) { return true; }
+    void accStartCalibration(void) {}
+    void activeAdjustmentRangeReset(void) {}
+    void beeperConfirmationBeeps(uint8_t) {}
+    int blackboxCalculatePDenom(int, int) { return 0; }
+    uint8_t blackboxCalculateSampleRate(uint16_t) { return 0; }
+    uint16_t blackboxGetPRatio(void) { return 0; }
+    uint8_t blackboxGetRateDenom(void) { return 0; }
+    bool blackboxMayEditConfig(void) { return true; }
+    void changeControlRateProfile(uint8_t) {}
+    void changePidProfile(uint8_t) {}
+    bool checkMotorProtocolEnabled(const motorDevConfig_t *, bool *) { return false; }
+    void compassStartCalibration(void) {}
+    void copyControlRateProfile(const uint8_t, const uint8_t) {}
+    void currentMeterRead(currentMeterId_e, currentMeter_t *) {}
+    void disarm(flightLogDisarmReason_e) {}
+    const box_t *findBoxByBoxId(boxId_e) { return NULL; }
+    const box_t *findBoxByPermanentId(uint8_t) { return NULL; }
+    int firstEnabledGyro(void) { return 0; }
+    uint32_t fnv_update(uint32_t hash, const void *, uint32_t) { return hash; }
+    int32_t getAmperage(void) { return 0; }
+    uint16_t getAverageSystemLoadPercent(void) { return 0; }
+    uint8_t getBatteryCellCount(void) { return 0; }
+    batteryState_e getBatteryState(void) { return BATTERY_OK; }
+    uint16_t getBatteryVoltage(void) { return 0; }
+    uint8_t getCurrentControlRateProfileIndex(void) { return 0; }
+    uint8_t getCurrentPidProfileIndex(void) { return 0; }
+    int32_t getEstimatedAltitudeCm(void) { return 0; }
+    uint8_t getGyroDetectedFlags(void) { return 0; }
+    uint16_t getLegacyBatteryVoltage(void) { return 0; }
+    int32_t getMAhDrawn(void) { return 0; }
+    mcuTypeId_e getMcuTypeId(void) { return MCU_TYPE_UNKNOWN; }
+    const char *getMcuTypeName(void) { return "UNIT_TEST"; }
+    uint8_t getMotorCount(void) { return 4; }
+    bool getRebootRequired(void) { return false; }
+    uint16_t getRssi(void) { return 0; }
+    timeDelta_t getTaskDeltaTimeUs(taskId_e) { return 0; }
+    void gpsSetFixState(bool) {}
+    void gyroInitFilters(void) {}
+    int16_t gyroRateDps(int) { return 0; }
+    void initActiveBoxIds(void) {}
+    void initEscEndpoints(void) {}
+    void initRcProcessing(void) {}
+    void loadCustomServoMixer(void) {}
+    void mixerInitProfile(void) {}
+    void motorShutdown(void) {}
+    int packFlightModeFlags(boxBitmask_t *) { return 0; }
+    void parseRcChannels(const char *, rxConfig_t *) {}
+    void pidCopyProfile(uint8_t, uint8_t) {}
+    void pidInitConfig(const pidProfile_t *) {}
+    void pidInitFilters(const pidProfile_t *) {}
+    void rcControlsInit(void) {}
+    void reevaluateLedConfig(void) {}
+    void resetPidProfile(pidProfile_t *) {}
+    void rxMspFrameReceive(const uint16_t *, int) {}
+    void sbufWriteBuildInfoFlags(sbuf_t *) {}
+    void schedulerIgnoreTaskStateTime(void) {}
+    serialPortConfig_t *serialFindPortConfigurationMutable(serialPortIdentifier_e) { return NULL; }
+    bool serialIsPortAvailable(serialPortIdentifier_e) { return false; }
+    int serializeBoxNameFn(sbuf_t *, const box_t *) { return 0; }
+    int serializeBoxPermanentIdFn(sbuf_t *, const box_t *) { return 0; }
+    void serializeBoxReply(sbuf_t *, int, serializeBoxFn *) {}
+    bool setModeColor(ledModeIndex_e, int, int) { return false; }
+    void setRebootRequired(void) {}
+    void setRssiMsp(uint8_t) {}
+    void systemReset(void) {}
+    void systemResetToBootloader(bootloaderRequestType_e) {}
+    void transponderStopRepeating(void) {}
+    void transponderUpdateData(void) {}
+    void validateAndFixGyroConfig(void) {}
+    void voltageMeterRead(voltageMeterId_e, voltageMeter_t *) {}
+}
@@ -858,6 +858,45 @@ TEST_F(OsdTest, TestElementMahDrawn)
     displayPortTestBufferSubstring(1, 11, "1042%c", SYM_MAH);
 }
 
+/*
+ * Tests that an element with a value key is redrawn while its value is unchanged.
+ */
+TEST_F(OsdTest, TestElementValueKey)
+{
+    // given
+    osdElementConfigMutable()->item_pos[OSD_MAH_DRAWN] = OSD_POS(1, 11) | OSD_PROFILE_1_FLAG;
+
+    osdAnalyzeActiveElements();
+
+    simulationMahDrawn = 246;
+    displayClearScreen(&testDisplayPort, DISPLAY_CLEAR_WAIT);
+    osdRefresh();
+
+    // when
+    displayClearScreen(&testDisplayPort, DISPLAY_CLEAR_WAIT);
+    osdRefresh();
+
+    // then
+    displayPortTestBufferSubstring(1, 11, " 246%c", SYM_MAH);
+
+    // when
+    simulationMahDrawn = 247;
+    displayClearScreen(&testDisplayPort, DISPLAY_CLEAR_WAIT);
+    osdRefresh();
+
+    // then
+    displayPortTestBufferSubstring(1, 11, " 247%c", SYM_MAH);
+
+    // when
+    osdElementConfigMutable()->item_pos[OSD_MAH_DRAWN] = OSD_POS(2, 12) | OSD_PROFILE_1_FLAG;
+    osdAnalyzeActiveElements();
+    displayClearScreen(&testDisplayPort, DISPLAY_CLEAR_WAIT);
+    osdRefresh();
+
+    // then
+    displayPortTestBufferSubstring(2, 12, " 247%c", SYM_MAH);
+}
+
 /*
  * Tests the instantaneous electrical power OSD element.
  */
@@ -55,6 +55,13 @@ PG_RESET_TEMPLATE(motorConfig_t, motorConfig,
     .kv = 1000,
     .motorPoleCount = 14,
 );
+
+typedef struct testConfig_s {
+    uint8_t value;
+} testConfig_t;
+
+PG_DECLARE(testConfig_t, testConfig);
+PG_REGISTER(testConfig_t, testConfig, PG_RESERVED_FOR_TESTING_1, 0);
 }
 
 
@@ -95,6 +102,17 @@ TEST(ParameterGroupsfTest, Test_pgFind)
     EXPECT_EQ(400, motorConfig3.dev.motorPwmRate);
 }
 
+TEST(ParameterGroupsfTest, Test_pgFindAll)
+{
+    // every registered group is found, whatever its position in the registry
+    PG_FOREACH(reg) {
+        EXPECT_EQ(reg, pgFind(pgN(reg)));
+    }
+    EXPECT_EQ((uint8_t *)testConfigMutable(), pgFind(PG_RESERVED_FOR_TESTING_1)->address);
+    EXPECT_EQ(NULL, pgFind(PG_RESERVED_FOR_TESTING_2));
+    EXPECT_EQ(NULL, pgFind(0));
+}
+
 // STUBS
 
 extern "C" {
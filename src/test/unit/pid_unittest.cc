@@ -896,6 +896,39 @@ TEST(pidControllerTest, testDtermFiltering)
 // TODO
 }
 
+TEST(pidControllerTest, testDtermLpf2BiquadAboveNyquist)
+{
+    resetTest();
+
+    const uint32_t pidFrequencyNyquist = pidRuntime.pidFrequency / 2;
+
+    pidProfile->dterm_lpf1_type = FILTER_PT1;
+    pidProfile->dterm_lpf1_static_hz = pidFrequencyNyquist / 2;
+    pidProfile->dterm_lpf1_dyn_min_hz = 0;
+    pidProfile->dterm_lpf2_type = FILTER_PT2;
+    pidProfile->dterm_lpf2_static_hz = pidFrequencyNyquist / 2;
+    pidInitFilters(pidProfile);
+
+    EXPECT_EQ(FILTER_VEC3_PT1, pidRuntime.dtermLowpass.type);
+    EXPECT_EQ(FILTER_VEC3_PT2, pidRuntime.dtermLowpass2.type);
+
+    // A biquad above Nyquist disables the second lowpass and leaves the first one alone
+    pidProfile->dterm_lpf2_type = FILTER_BIQUAD;
+    pidProfile->dterm_lpf2_static_hz = pidFrequencyNyquist + 1;
+    pidInitFilters(pidProfile);
+
+    EXPECT_EQ(FILTER_VEC3_PT1, pidRuntime.dtermLowpass.type);
+    EXPECT_EQ(FILTER_VEC3_NONE, pidRuntime.dtermLowpass2.type);
+
+    pidProfile->dterm_lpf2_static_hz = pidFrequencyNyquist - 1;
+    pidInitFilters(pidProfile);
+
+    EXPECT_EQ(FILTER_VEC3_PT1, pidRuntime.dtermLowpass.type);
+    EXPECT_EQ(FILTER_VEC3_BIQUAD, pidRuntime.dtermLowpass2.type);
+
+    resetTest();
+}
+
 TEST(pidControllerTest, testItermRotationHandling)
 {
     resetTest();
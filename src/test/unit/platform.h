@@ -40,6 +40,8 @@
 #define FAST_CODE_PREF
 #define FAST_DATA_ZERO_INIT
 #define FAST_DATA
+#define MMFLASH_CODE
+#define MMFLASH_CODE_NOINLINE
 
 
 #define PID_PROFILE_COUNT 4
@@ -0,0 +1,217 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <math.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "build/debug.h"
+
+    #include "common/axis.h"
+    #include "common/filter.h"
+    #include "common/maths.h"
+
+    #include "drivers/dshot.h"
+
+    #include "flight/mixer.h"
+    #include "flight/rpm_filter.h"
+
+    #include "scheduler/scheduler.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define TEST_MOTOR_COUNT    4
+#define TEST_LOOPTIME_US    125
+// Notches are updated in a round robin, this many rpmFilterUpdate() calls update all of them
+#define TEST_UPDATE_CALLS   6
+#define TEST_TOLERANCE      1e-3f
+
+static float motorFrequencyHz[TEST_MOTOR_COUNT];
+
+static const rpmFilterConfig_t testConfig = {
+    .rpm_filter_harmonics = 3,
+    .rpm_filter_weights = { 100, 0, 60 },
+    .rpm_filter_min_hz = 100,
+    .rpm_filter_fade_range_hz = 50,
+    .rpm_filter_q = 500,
+    .rpm_filter_lpf_hz = 150,
+};
+
+// One biquadFilterApplyDF1Weighted() notch per harmonic, motor and axis, as the filter was before the notch bank
+static biquadFilter_t referenceNotch[RPM_FILTER_HARMONICS_MAX][TEST_MOTOR_COUNT][XYZ_AXIS_COUNT];
+
+static void referenceInit(void)
+{
+    for (int i = 0; i < testConfig.rpm_filter_harmonics; i++) {
+        for (int motor = 0; motor < TEST_MOTOR_COUNT; motor++) {
+            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+                biquadFilterInit(&referenceNotch[i][motor][axis], testConfig.rpm_filter_min_hz * i, TEST_LOOPTIME_US, testConfig.rpm_filter_q / 100.0f, FILTER_NOTCH, 0.0f);
+            }
+        }
+    }
+}
+
+static void referenceUpdate(void)
+{
+    const float minHz = testConfig.rpm_filter_min_hz;
+    const float maxHz = 0.48f * 1e6f / TEST_LOOPTIME_US;
+
+    for (int i = 0; i < testConfig.rpm_filter_harmonics; i++) {
+        if (testConfig.rpm_filter_weights[i] == 0) {
+            continue;
+        }
+        for (int motor = 0; motor < TEST_MOTOR_COUNT; motor++) {
+            const float frequencyHz = constrainf((i + 1) * motorFrequencyHz[motor], minHz, maxHz);
+            const float marginHz = frequencyHz - minHz;
+            float weight = testConfig.rpm_filter_weights[i] / 100.0f;
+            if (marginHz < testConfig.rpm_filter_fade_range_hz) {
+                weight *= marginHz / testConfig.rpm_filter_fade_range_hz;
+            }
+            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+                biquadFilterUpdate(&referenceNotch[i][motor][axis], frequencyHz, TEST_LOOPTIME_US, testConfig.rpm_filter_q / 100.0f, FILTER_NOTCH, weight);
+            }
+        }
+    }
+}
+
+static float referenceApply(int axis, float value)
+{
+    for (int i = 0; i < testConfig.rpm_filter_harmonics; i++) {
+        if (testConfig.rpm_filter_weights[i] == 0) {
+            continue;
+        }
+        for (int motor = 0; motor < TEST_MOTOR_COUNT; motor++) {
+            value = biquadFilterApplyDF1Weighted(&referenceNotch[i][motor][axis], value);
+        }
+    }
+    return value;
+}
+
+static void setMotorFrequencies(float hz)
+{
+    for (int motor = 0; motor < TEST_MOTOR_COUNT; motor++) {
+        motorFrequencyHz[motor] = hz + 7.0f * motor;
+    }
+}
+
+static void updateNotches(void)
+{
+    for (int i = 0; i < TEST_UPDATE_CALLS; i++) {
+        rpmFilterUpdate();
+    }
+    referenceUpdate();
+}
+
+// Filters a block of gyro samples with both implementations, returns the largest difference
+static float filterBlock(int *sample, int count)
+{
+    float maxError = 0.0f;
+
+    for (int n = 0; n < count; n++, (*sample)++) {
+        const float t = *sample * TEST_LOOPTIME_US * 1e-6f;
+        float values[XYZ_AXIS_COUNT];
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            values[axis] = 100.0f * sinf(2 * M_PIf * 210 * t + axis) + 40.0f * sinf(2 * M_PIf * 630 * t) + 10.0f * axis;
+        }
+
+        float expected[XYZ_AXIS_COUNT];
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            expected[axis] = referenceApply(axis, values[axis]);
+        }
+
+        rpmFilterApply(values);
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            maxError = MAX(maxError, fabsf(values[axis] - expected[axis]));
+        }
+    }
+
+    return maxError;
+}
+
+class RpmFilterTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        rpmFilterInit(&testConfig, TEST_LOOPTIME_US);
+        referenceInit();
+    }
+};
+
+TEST_F(RpmFilterTest, TestMatchesBiquadNotches)
+{
+    ASSERT_TRUE(isRpmFilterEnabled());
+
+    setMotorFrequencies(210.0f);
+    updateNotches();
+
+    int sample = 0;
+    EXPECT_LT(filterBlock(&sample, 2000), TEST_TOLERANCE);
+}
+
+TEST_F(RpmFilterTest, TestMatchesWhileFadingOutAndIn)
+{
+    int sample = 0;
+
+    // Sweep the motors from well above the fade range to below minHz and back, so the notches
+    // of the first harmonic fade out completely and in again
+    for (int step = 0; step <= 80; step++) {
+        const float hz = 60.0f + 4.0f * abs(step - 40);
+        setMotorFrequencies(hz);
+        updateNotches();
+
+        EXPECT_LT(filterBlock(&sample, 32), TEST_TOLERANCE) << "at " << hz << "Hz";
+    }
+}
+
+TEST_F(RpmFilterTest, TestZeroWeightPassesInput)
+{
+    // All notches are below minHz, so they have a weight of 0
+    setMotorFrequencies(10.0f);
+    updateNotches();
+
+    int sample = 0;
+    EXPECT_LT(filterBlock(&sample, 200), TEST_TOLERANCE);
+
+    float values[XYZ_AXIS_COUNT] = { 12.5f, -3.0f, 400.0f };
+    rpmFilterApply(values);
+    EXPECT_FLOAT_EQ(12.5f, values[X]);
+    EXPECT_FLOAT_EQ(-3.0f, values[Y]);
+    EXPECT_FLOAT_EQ(400.0f, values[Z]);
+}
+
+// STUBS
+
+extern "C" {
+    int16_t debug[DEBUG16_VALUE_COUNT];
+    uint8_t debugMode;
+
+    bool useDshotTelemetry = true;
+
+    float getMotorFrequencyHz(uint8_t motorIndex) { return motorFrequencyHz[motorIndex]; }
+    uint8_t getMotorCount(void) { return TEST_MOTOR_COUNT; }
+    float schedulerGetCycleTimeMultiplier(void) { return 1.0f; }
+}
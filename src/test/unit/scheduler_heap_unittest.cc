@@ -0,0 +1,287 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+
+extern "C" {
+    #include "drivers/accgyro/accgyro.h"
+    #include "platform.h"
+    #include "scheduler/scheduler.h"
+    #include "scheduler_stubs.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+const int TEST_UPDATE_ACCEL_TIME = 32;
+const int TEST_UPDATE_ATTITUDE_TIME = 28;
+const int TEST_HANDLE_SERIAL_TIME = 30;
+const int TEST_UPDATE_BATTERY_TIME = 1;
+const int TEST_UPDATE_RX_CHECK_TIME = 34;
+const int TEST_UPDATE_RX_MAIN_TIME = 1;
+const int TEST_IMU_UPDATE_TIME = 5;
+const int TEST_DISPATCH_TIME = 200;
+
+extern "C" {
+    extern task_t *unittest_scheduler_selectedTask;
+
+    int16_t debug[1];
+    uint8_t debugMode = 0;
+    bool rxSignalled = false;
+
+    void rxFrameCheck(timeUs_t, timeDelta_t) {}
+
+    uint32_t simulatedTime = 0;
+    uint32_t micros(void) { return simulatedTime; }
+    uint32_t millis(void) { return simulatedTime/1000; }
+    int32_t clockCyclesToMicros(int32_t x) { return x/10;}
+    int32_t clockCyclesTo10thMicros(int32_t x) { return x;}
+    int32_t clockCyclesTo100thMicros(int32_t x) { return x * 10;}
+    uint32_t clockMicrosToCycles(uint32_t x) { return x*10;}
+    uint32_t getCycleCounter(void) {return simulatedTime * 10;}
+
+    bool gyroFilterReady(void) { return false; }
+    gyroDev_t gyro;
+    gyroDev_t *gyroActiveDev(void) { return &gyro; }
+    bool pidLoopReady(void) { return false; }
+    void failsafeCheckDataFailurePeriod(void) {}
+    void failsafeUpdateState(void) {}
+    void taskGyroSample(timeUs_t) {}
+    void taskFiltering(timeUs_t) {}
+    void taskMainPidLoop(timeUs_t) {}
+    void taskUpdateAccelerometer(timeUs_t) { simulatedTime += TEST_UPDATE_ACCEL_TIME; }
+    void taskHandleSerial(timeUs_t) { simulatedTime += TEST_HANDLE_SERIAL_TIME; }
+    void taskUpdateBatteryVoltage(timeUs_t) { simulatedTime += TEST_UPDATE_BATTERY_TIME; }
+    bool rxUpdateCheck(timeUs_t, timeDelta_t) { simulatedTime += TEST_UPDATE_RX_CHECK_TIME; return rxSignalled; }
+    void taskUpdateRxMain(timeUs_t) { simulatedTime += TEST_UPDATE_RX_MAIN_TIME; rxSignalled = false; }
+    void imuUpdateAttitude(timeUs_t) { simulatedTime += TEST_IMU_UPDATE_TIME; }
+    void dispatchProcess(timeUs_t) { simulatedTime += TEST_DISPATCH_TIME; }
+    bool osdUpdateCheck(timeUs_t, timeDelta_t) { return false; }
+    void osdUpdate(timeUs_t) {}
+
+    extern int taskQueueSize;
+    extern task_t *taskHeap[];
+    extern int taskHeapSize;
+    extern task_t *eventTaskArray[];
+    extern int eventTaskCount;
+
+    task_t tasks[TASK_COUNT];
+
+    task_t *getTask(unsigned taskId)
+    {
+        return &tasks[taskId];
+    }
+}
+
+static void expectHeapOrdered(void)
+{
+    for (int i = 0; i < taskHeapSize; i++) {
+        EXPECT_EQ(i, taskHeap[i]->heapIndex);
+        EXPECT_EQ(taskHeap[i]->lastExecutedAtUs + taskHeap[i]->attribute->desiredPeriodUs, taskHeap[i]->nextDueAtUs);
+        if (i > 0) {
+            EXPECT_LE(cmpTimeUs(taskHeap[(i - 1) / 2]->nextDueAtUs, taskHeap[i]->nextDueAtUs), 0);
+        }
+    }
+}
+
+static void disableAllTasks(void)
+{
+    for (int taskId = 0; taskId < TASK_COUNT; ++taskId) {
+        setTaskEnabled(static_cast<taskId_e>(taskId), false);
+    }
+}
+
+TEST(SchedulerHeapUnittest, SetupTasks)
+{
+    for (int i = 0; i < TASK_COUNT; ++i) {
+        tasks[i].attribute = &task_attributes[i];
+    }
+    schedulerInit();
+    EXPECT_EQ(1, taskQueueSize);
+    EXPECT_EQ(1, taskHeapSize);
+    EXPECT_EQ(&tasks[TASK_SYSTEM], taskHeap[0]);
+    EXPECT_EQ(0, eventTaskCount);
+}
+
+TEST(SchedulerHeapUnittest, TestHeapAddAndRemove)
+{
+    disableAllTasks();
+    EXPECT_EQ(0, taskHeapSize);
+
+    simulatedTime = 50000;
+    const taskId_e timeTasks[] = { TASK_SYSTEM, TASK_ACCEL, TASK_ATTITUDE, TASK_SERIAL, TASK_DISPATCH, TASK_BATTERY_VOLTAGE };
+    for (unsigned i = 0; i < ARRAYLEN(timeTasks); i++) {
+        tasks[timeTasks[i]].lastExecutedAtUs = simulatedTime - 100 * i;
+        setTaskEnabled(timeTasks[i], true);
+        expectHeapOrdered();
+    }
+    // Realtime tasks are run by the scheduler directly, event driven tasks are polled
+    setTaskEnabled(TASK_GYRO, true);
+    setTaskEnabled(TASK_RX, true);
+
+    EXPECT_EQ(8, taskQueueSize);
+    EXPECT_EQ(6, taskHeapSize);
+    EXPECT_EQ(1, eventTaskCount);
+    EXPECT_EQ(&tasks[TASK_RX], eventTaskArray[0]);
+
+    // ACCEL and DISPATCH both have a 1ms period, DISPATCH ran 300us earlier
+    EXPECT_EQ(&tasks[TASK_DISPATCH], taskHeap[0]);
+
+    setTaskEnabled(TASK_DISPATCH, false);
+    expectHeapOrdered();
+    EXPECT_EQ(5, taskHeapSize);
+    EXPECT_EQ(&tasks[TASK_ACCEL], taskHeap[0]);
+
+    setTaskEnabled(TASK_ACCEL, false);
+    setTaskEnabled(TASK_RX, false);
+    expectHeapOrdered();
+    EXPECT_EQ(4, taskHeapSize);
+    EXPECT_EQ(0, eventTaskCount);
+    // Removing a task twice is harmless
+    setTaskEnabled(TASK_ACCEL, false);
+    EXPECT_EQ(4, taskHeapSize);
+}
+
+TEST(SchedulerHeapUnittest, TestReschedule)
+{
+    disableAllTasks();
+    simulatedTime = 50000;
+    tasks[TASK_ACCEL].lastExecutedAtUs = simulatedTime;
+    tasks[TASK_SERIAL].lastExecutedAtUs = simulatedTime;
+    setTaskEnabled(TASK_ACCEL, true);
+    setTaskEnabled(TASK_SERIAL, true);
+    EXPECT_EQ(&tasks[TASK_ACCEL], taskHeap[0]);
+
+    // Slowing ACCEL down below SERIAL moves it behind in the heap
+    rescheduleTask(TASK_ACCEL, TASK_PERIOD_HZ(50));
+    expectHeapOrdered();
+    EXPECT_EQ(&tasks[TASK_SERIAL], taskHeap[0]);
+
+    rescheduleTask(TASK_ACCEL, TASK_PERIOD_HZ(1000));
+    expectHeapOrdered();
+    EXPECT_EQ(&tasks[TASK_ACCEL], taskHeap[0]);
+}
+
+TEST(SchedulerHeapUnittest, TestOnlyDueTasksRun)
+{
+    disableAllTasks();
+
+    // TASK_ACCEL has a 1ms period, TASK_ATTITUDE 10ms
+    static const uint32_t startTime = 4000;
+    simulatedTime = startTime;
+    tasks[TASK_ACCEL].lastExecutedAtUs = simulatedTime;
+    tasks[TASK_ATTITUDE].lastExecutedAtUs = simulatedTime - TEST_UPDATE_ATTITUDE_TIME;
+    setTaskEnabled(TASK_ACCEL, true);
+    setTaskEnabled(TASK_ATTITUDE, true);
+
+    scheduler();
+    EXPECT_EQ(static_cast<task_t*>(0), unittest_scheduler_selectedTask);
+
+    simulatedTime += 500;
+    scheduler();
+    EXPECT_EQ(static_cast<task_t*>(0), unittest_scheduler_selectedTask);
+
+    simulatedTime += 500;
+    scheduler();
+    EXPECT_EQ(&tasks[TASK_ACCEL], unittest_scheduler_selectedTask);
+    EXPECT_EQ(5000 + TEST_UPDATE_ACCEL_TIME, simulatedTime);
+    // The task that ran is due again one period after it ran
+    EXPECT_EQ(5000U + 1000, tasks[TASK_ACCEL].nextDueAtUs);
+    expectHeapOrdered();
+
+    scheduler();
+    EXPECT_EQ(static_cast<task_t*>(0), unittest_scheduler_selectedTask);
+
+    simulatedTime = startTime + 10500;
+    // TASK_ACCEL has aged by more periods, so runs first
+    scheduler();
+    EXPECT_EQ(&tasks[TASK_ACCEL], unittest_scheduler_selectedTask);
+    scheduler();
+    EXPECT_EQ(&tasks[TASK_ATTITUDE], unittest_scheduler_selectedTask);
+    expectHeapOrdered();
+}
+
+TEST(SchedulerHeapUnittest, TestEqualPriorityPrefersStaticPriority)
+{
+    disableAllTasks();
+
+    // TASK_SERIAL (LOW) aged by three periods and TASK_ATTITUDE (MEDIUM) aged by two periods have the same
+    // dynamic priority, SERIAL is due earlier so is visited first in the heap
+    simulatedTime = 100000;
+    tasks[TASK_SERIAL].lastExecutedAtUs = simulatedTime - 30000;
+    tasks[TASK_ATTITUDE].lastExecutedAtUs = simulatedTime - 20000;
+    setTaskEnabled(TASK_SERIAL, true);
+    setTaskEnabled(TASK_ATTITUDE, true);
+    EXPECT_EQ(&tasks[TASK_SERIAL], taskHeap[0]);
+
+    // As with the queue order, the higher static priority wins the tie
+    scheduler();
+    EXPECT_EQ(&tasks[TASK_ATTITUDE], unittest_scheduler_selectedTask);
+    scheduler();
+    EXPECT_EQ(&tasks[TASK_SERIAL], unittest_scheduler_selectedTask);
+}
+
+TEST(SchedulerHeapUnittest, TestEqualPriorityFollowsQueueOrder)
+{
+    disableAllTasks();
+
+    // TASK_ATTITUDE and TASK_BATTERY_VOLTAGE (both MEDIUM) are each aged by one period, so have the same
+    // dynamic priority. BATTERY_VOLTAGE is due earlier so is at the top of the heap, but ATTITUDE was
+    // enabled first so is ahead of it in the queue
+    simulatedTime = 100000;
+    tasks[TASK_ATTITUDE].lastExecutedAtUs = simulatedTime - 10000;
+    tasks[TASK_BATTERY_VOLTAGE].lastExecutedAtUs = simulatedTime - 39999;
+    setTaskEnabled(TASK_ATTITUDE, true);
+    setTaskEnabled(TASK_BATTERY_VOLTAGE, true);
+    EXPECT_EQ(&tasks[TASK_BATTERY_VOLTAGE], taskHeap[0]);
+
+    // As with the queue scan, the task earlier in the queue wins the tie
+    scheduler();
+    EXPECT_EQ(&tasks[TASK_ATTITUDE], unittest_scheduler_selectedTask);
+    scheduler();
+    EXPECT_EQ(&tasks[TASK_BATTERY_VOLTAGE], unittest_scheduler_selectedTask);
+}
+
+TEST(SchedulerHeapUnittest, TestEventTask)
+{
+    disableAllTasks();
+
+    simulatedTime = 200000;
+    tasks[TASK_ACCEL].lastExecutedAtUs = simulatedTime - 1000;
+    tasks[TASK_RX].lastExecutedAtUs = simulatedTime - 1000;
+    tasks[TASK_RX].dynamicPriority = 0;
+    setTaskEnabled(TASK_ACCEL, true);
+    setTaskEnabled(TASK_RX, true);
+
+    // RX isn't signalled, so only ACCEL is due
+    rxSignalled = false;
+    scheduler();
+    EXPECT_EQ(&tasks[TASK_ACCEL], unittest_scheduler_selectedTask);
+
+    // Once signalled the HIGH priority RX task wins over the MEDIUM priority ACCEL task
+    simulatedTime += 1000;
+    rxSignalled = true;
+    scheduler();
+    EXPECT_EQ(&tasks[TASK_RX], unittest_scheduler_selectedTask);
+    EXPECT_FALSE(rxSignalled);
+
+    scheduler();
+    EXPECT_EQ(&tasks[TASK_ACCEL], unittest_scheduler_selectedTask);
+}
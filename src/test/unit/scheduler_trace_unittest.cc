@@ -0,0 +1,160 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "fc/tasks.h"
+
+    #include "scheduler/scheduler.h"
+    #include "scheduler/scheduler_trace.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static void drainTrace(void)
+{
+    schedTraceStop();
+    schedTraceClear();
+}
+
+TEST(SchedulerTraceUnittest, TestRecordAndRead)
+{
+    drainTrace();
+    schedTraceStart();
+
+    SCHED_TRACE_AT(100, SCHED_TRACE_TASK_BEGIN, TASK_GYRO, 0);
+    SCHED_TRACE_AT(110, SCHED_TRACE_TASK_END, TASK_GYRO, 0);
+    SCHED_TRACE_AT(120, SCHED_TRACE_SELECT, TASK_SERIAL, 7);
+
+    EXPECT_EQ(3U, schedTracePending());
+
+    schedTraceEvent_t events[4];
+    EXPECT_EQ(3U, schedTraceRead(events, 4));
+    EXPECT_EQ(0U, schedTracePending());
+
+    EXPECT_EQ(100U, events[0].timeUs);
+    EXPECT_EQ(SCHED_TRACE_TASK_BEGIN, events[0].type);
+    EXPECT_EQ(TASK_GYRO, events[0].id);
+    EXPECT_EQ(110U, events[1].timeUs);
+    EXPECT_EQ(SCHED_TRACE_TASK_END, events[1].type);
+    EXPECT_EQ(SCHED_TRACE_SELECT, events[2].type);
+    EXPECT_EQ(TASK_SERIAL, events[2].id);
+    EXPECT_EQ(7, events[2].arg);
+}
+
+TEST(SchedulerTraceUnittest, TestInactiveRecordsNothing)
+{
+    drainTrace();
+
+    SCHED_TRACE_AT(100, SCHED_TRACE_TASK_BEGIN, TASK_GYRO, 0);
+
+    EXPECT_EQ(0U, schedTracePending());
+}
+
+TEST(SchedulerTraceUnittest, TestDropWhenFull)
+{
+    drainTrace();
+    schedTraceStart();
+
+    // The ring keeps the oldest events and counts the ones that didn't fit
+    for (unsigned i = 0; i < SCHED_TRACE_BUFFER_SIZE + 3; i++) {
+        SCHED_TRACE_AT(i, SCHED_TRACE_TASK_BEGIN, TASK_GYRO, 0);
+    }
+
+    EXPECT_EQ((uint32_t)SCHED_TRACE_BUFFER_SIZE, schedTracePending());
+    EXPECT_EQ(3U, schedTraceDropped());
+
+    schedTraceEvent_t events[SCHED_TRACE_BUFFER_SIZE];
+    EXPECT_EQ(2U, schedTraceRead(events, 2));
+    EXPECT_EQ(0U, events[0].timeUs);
+    EXPECT_EQ(1U, events[1].timeUs);
+
+    // Room for new events once the consumer has caught up, across the wrap of the ring
+    SCHED_TRACE_AT(1000, SCHED_TRACE_TASK_END, TASK_GYRO, 0);
+    SCHED_TRACE_AT(1001, SCHED_TRACE_TASK_END, TASK_GYRO, 0);
+    SCHED_TRACE_AT(1002, SCHED_TRACE_TASK_END, TASK_GYRO, 0);
+    EXPECT_EQ(4U, schedTraceDropped());
+
+    EXPECT_EQ((uint32_t)SCHED_TRACE_BUFFER_SIZE, schedTraceRead(events, SCHED_TRACE_BUFFER_SIZE));
+    EXPECT_EQ(SCHED_TRACE_BUFFER_SIZE - 1U, events[SCHED_TRACE_BUFFER_SIZE - 3].timeUs);
+    EXPECT_EQ(1000U, events[SCHED_TRACE_BUFFER_SIZE - 2].timeUs);
+    EXPECT_EQ(1001U, events[SCHED_TRACE_BUFFER_SIZE - 1].timeUs);
+
+    schedTraceStart();
+    EXPECT_EQ(0U, schedTraceDropped());
+}
+
+TEST(SchedulerTraceUnittest, TestArgSaturates)
+{
+    drainTrace();
+    schedTraceStart();
+
+    SCHED_TRACE_AT(0, SCHED_TRACE_LATE, TASK_SERIAL, 100000);
+
+    schedTraceEvent_t event;
+    EXPECT_EQ(1U, schedTraceRead(&event, 1));
+    EXPECT_EQ(UINT16_MAX, event.arg);
+}
+
+TEST(SchedulerTraceUnittest, TestFormatChromeTrace)
+{
+    char buf[SCHED_TRACE_JSON_MAX];
+
+    schedTraceEvent_t begin = { .timeUs = 1234, .type = SCHED_TRACE_TASK_BEGIN, .id = TASK_GYRO, .arg = 0 };
+    schedTraceFormatEvent(&begin, buf);
+    EXPECT_STREQ("{\"name\":\"GYRO\",\"cat\":\"task\",\"ph\":\"B\",\"ts\":1234,\"pid\":1,\"tid\":1}", buf);
+
+    schedTraceEvent_t stage = { .timeUs = 1240, .type = SCHED_TRACE_STAGE_END, .id = SCHED_TRACE_STAGE_PID_CONTROLLER, .arg = 0 };
+    schedTraceFormatEvent(&stage, buf);
+    EXPECT_STREQ("{\"name\":\"PID_CONTROLLER\",\"cat\":\"stage\",\"ph\":\"E\",\"ts\":1240,\"pid\":1,\"tid\":1}", buf);
+
+    schedTraceEvent_t select = { .timeUs = 1250, .type = SCHED_TRACE_SELECT, .id = TASK_SERIAL, .arg = 12 };
+    schedTraceFormatEvent(&select, buf);
+    EXPECT_STREQ("{\"name\":\"select SERIAL\",\"ph\":\"i\",\"s\":\"t\",\"ts\":1250,\"pid\":1,\"tid\":1,\"args\":{\"priority\":12}}", buf);
+
+    schedTraceEvent_t late = { .timeUs = 4294967295U, .type = SCHED_TRACE_LATE, .id = TASK_SERIAL, .arg = 65535 };
+    EXPECT_GT(SCHED_TRACE_JSON_MAX, schedTraceFormatEvent(&late, buf));
+    EXPECT_STREQ("{\"name\":\"late SERIAL\",\"ph\":\"i\",\"s\":\"t\",\"ts\":4294967295,\"pid\":1,\"tid\":1,\"args\":{\"us\":65535}}", buf);
+}
+
+// STUBS
+
+extern "C" {
+    static task_attribute_t gyroAttribute = { .taskName = "GYRO" };
+    static task_attribute_t serialAttribute = { .taskName = "SERIAL" };
+    static task_t stubTasks[] = {
+        { .attribute = &gyroAttribute },
+        { .attribute = &serialAttribute },
+    };
+
+    task_t *getTask(unsigned taskId)
+    {
+        return taskId == TASK_GYRO ? &stubTasks[0] : &stubTasks[1];
+    }
+
+    uint32_t micros(void) { return 0; }
+}
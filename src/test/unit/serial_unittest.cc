@@ -0,0 +1,145 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "drivers/serial.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define TEST_RX_BUFFER_SIZE 8
+
+static uint8_t rxBuffer[TEST_RX_BUFFER_SIZE];
+
+static uint32_t ringRxWaiting(const serialPort_t *instance)
+{
+    return (instance->rxBufferHead - instance->rxBufferTail) & (instance->rxBufferSize - 1);
+}
+
+static uint8_t ringRead(serialPort_t *instance)
+{
+    const uint8_t ch = instance->rxBuffer[instance->rxBufferTail];
+    instance->rxBufferTail = (instance->rxBufferTail + 1) % instance->rxBufferSize;
+    return ch;
+}
+
+static const struct serialPortVTable zeroCopyVTable = {
+    .serialTotalRxWaiting = ringRxWaiting,
+    .serialRead = ringRead,
+    .peekRx = serialRingPeekRx,
+    .skipRx = serialRingSkipRx,
+};
+
+static const struct serialPortVTable byteVTable = {
+    .serialTotalRxWaiting = ringRxWaiting,
+    .serialRead = ringRead,
+};
+
+static void initPort(serialPort_t *port, const struct serialPortVTable *vTable, uint32_t tail)
+{
+    memset(port, 0, sizeof(*port));
+    port->vTable = vTable;
+    port->rxBuffer = rxBuffer;
+    port->rxBufferSize = TEST_RX_BUFFER_SIZE;
+    port->rxBufferHead = tail;
+    port->rxBufferTail = tail;
+}
+
+static void receive(serialPort_t *port, const char *str)
+{
+    for (; *str; str++) {
+        rxBuffer[port->rxBufferHead] = *str;
+        port->rxBufferHead = (port->rxBufferHead + 1) % port->rxBufferSize;
+    }
+}
+
+TEST(SerialUnittest, TestPeekReturnsContiguousSpans)
+{
+    serialPort_t port;
+    initPort(&port, &zeroCopyVTable, 5);
+    receive(&port, "abcde");
+
+    const uint8_t *data;
+    uint8_t byte;
+
+    // The data wraps at the end of the buffer, so is returned in two spans
+    EXPECT_EQ(3U, serialPeekRx(&port, &data, &byte));
+    EXPECT_EQ(&rxBuffer[5], data);
+    EXPECT_EQ(0, memcmp("abc", data, 3));
+
+    // Nothing is released before the skip
+    EXPECT_EQ(3U, serialPeekRx(&port, &data, &byte));
+    serialSkipRx(&port, 2);
+    EXPECT_EQ(1U, serialPeekRx(&port, &data, &byte));
+    EXPECT_EQ('c', data[0]);
+    serialSkipRx(&port, 1);
+
+    EXPECT_EQ(2U, serialPeekRx(&port, &data, &byte));
+    EXPECT_EQ(&rxBuffer[0], data);
+    EXPECT_EQ(0, memcmp("de", data, 2));
+    serialSkipRx(&port, 2);
+
+    EXPECT_EQ(0U, serialPeekRx(&port, &data, &byte));
+    EXPECT_EQ(0U, serialRxBytesWaiting(&port));
+}
+
+TEST(SerialUnittest, TestPeekFallsBackToBytes)
+{
+    serialPort_t port;
+    initPort(&port, &byteVTable, 6);
+    receive(&port, "xyz");
+
+    const uint8_t *data;
+    uint8_t byte;
+
+    // Without zero-copy receive the byte has already been read
+    EXPECT_EQ(1U, serialPeekRx(&port, &data, &byte));
+    EXPECT_EQ(&byte, data);
+    EXPECT_EQ('x', byte);
+    serialSkipRx(&port, 1);
+    EXPECT_EQ(2U, serialRxBytesWaiting(&port));
+}
+
+TEST(SerialUnittest, TestReadBuf)
+{
+    uint8_t buf[TEST_RX_BUFFER_SIZE];
+    serialPort_t port;
+
+    initPort(&port, &zeroCopyVTable, 6);
+    receive(&port, "12345");
+    EXPECT_EQ(4U, serialReadBuf(&port, buf, 4));
+    EXPECT_EQ(0, memcmp("1234", buf, 4));
+    EXPECT_EQ(1U, serialReadBuf(&port, buf, sizeof(buf)));
+    EXPECT_EQ('5', buf[0]);
+
+    initPort(&port, &byteVTable, 6);
+    receive(&port, "12345");
+    EXPECT_EQ(5U, serialReadBuf(&port, buf, sizeof(buf)));
+    EXPECT_EQ(0, memcmp("12345", buf, 5));
+    EXPECT_EQ(0U, serialReadBuf(&port, buf, sizeof(buf)));
+}